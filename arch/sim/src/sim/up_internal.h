@@ -31,6 +31,7 @@
 
 #ifndef __ASSEMBLY__
 #  include <sys/types.h>
+#  include <sys/uio.h>
 #  include <stdbool.h>
 #  include <netinet/in.h>
 #endif
@@ -254,6 +255,7 @@ void tapdev_init(void *priv,
 int tapdev_avail(void);
 unsigned int tapdev_read(unsigned char *buf, unsigned int buflen);
 void tapdev_send(unsigned char *buf, unsigned int buflen);
+void tapdev_sendv(const struct iovec *iov, int iovcnt);
 void tapdev_ifup(in_addr_t ifaddr);
 void tapdev_ifdown(void);
 
@@ -261,6 +263,7 @@ void tapdev_ifdown(void);
 #  define netdev_avail()              tapdev_avail()
 #  define netdev_read(buf,buflen)     tapdev_read(buf,buflen)
 #  define netdev_send(buf,buflen)     tapdev_send(buf,buflen)
+#  define netdev_sendv(iov,iovcnt)    tapdev_sendv(iov,iovcnt)
 #  define netdev_ifup(ifaddr)         tapdev_ifup(ifaddr)
 #  define netdev_ifdown()             tapdev_ifdown()
 #endif
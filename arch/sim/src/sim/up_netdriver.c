@@ -59,6 +59,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/uio.h>
 #include <debug.h>
 #include <string.h>
 
@@ -71,6 +72,19 @@
 
 #include "up_internal.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Scatter-gather is used when the host interface can gather the packet
+ * from several segments.
+ */
+
+#if defined(CONFIG_NETDEV_IOB_SG) && defined(netdev_sendv)
+#  define SIM_NETDEV_SG     1
+#  define SIM_NETDEV_NIOVEC 8
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -89,6 +103,31 @@ static struct net_driver_s g_sim_dev;
  * Private Functions
  ****************************************************************************/
 
+static void netdriver_send(FAR struct net_driver_s *dev)
+{
+#ifdef SIM_NETDEV_SG
+  struct iovec iov[SIM_NETDEV_NIOVEC];
+  int iovcnt;
+
+  /* Gather the headers in d_buf and the payload in d_iob without copying
+   * them together.
+   */
+
+  iovcnt = netdev_iob_iovec(dev, iov, SIM_NETDEV_NIOVEC);
+  if (iovcnt > 0)
+    {
+      netdev_sendv(iov, iovcnt);
+      netdev_iob_release(dev);
+      return;
+    }
+#endif
+
+  /* Otherwise, copy any payload in d_iob into d_buf */
+
+  netdev_iob_linearize(dev);
+  netdev_send(dev->d_buf, dev->d_len);
+}
+
 static void netdriver_reply(FAR struct net_driver_s *dev)
 {
   /* If the receiving resulted in data that should be sent out on
@@ -122,7 +161,7 @@ static void netdriver_reply(FAR struct net_driver_s *dev)
       /* Send the packet */
 
       NETDEV_TXPACKETS(dev);
-      netdev_send(dev->d_buf, dev->d_len);
+      netdriver_send(dev);
       NETDEV_TXDONE(dev);
     }
 }
@@ -275,7 +314,7 @@ static int netdriver_txpoll(FAR struct net_driver_s *dev)
           /* Send the packet */
 
           NETDEV_TXPACKETS(dev);
-          netdev_send(dev->d_buf, dev->d_len);
+          netdriver_send(dev);
           NETDEV_TXDONE(dev);
         }
     }
@@ -394,6 +433,10 @@ int netdriver_init(void)
   dev->d_ifdown  = netdriver_ifdown;
   dev->d_txavail = netdriver_txavail;
 
+#ifdef SIM_NETDEV_SG
+  dev->d_features |= NETDEV_FEATURE_SG;
+#endif
+
   /* Register the device with the OS so that socket IOCTLs can be performed */
 
   return netdev_register(dev, NET_LL_ETHERNET);
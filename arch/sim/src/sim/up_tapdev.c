@@ -360,6 +360,57 @@ void tapdev_send(unsigned char *buf, unsigned int buflen)
     }
 }
 
+void tapdev_sendv(const struct iovec *iov, int iovcnt)
+{
+  int buflen = 0;
+  int ret;
+  int i;
+
+  if (gtapdevfd < 0)
+    {
+      return;
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      buflen += iov[i].iov_len;
+    }
+
+#ifdef TAPDEV_DEBUG
+  syslog(LOG_INFO, "tapdev_sendv: sending %d bytes\n", buflen);
+
+  gdrop++;
+  if (gdrop % 8 == 7)
+    {
+      syslog(LOG_ERR, "TAPDEV: Dropped a packet!\n");
+      return;
+    }
+#endif
+
+  ret = writev(gtapdevfd, iov, iovcnt);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "TAPDEV: write failed: %d\n", -ret);
+      exit(1);
+    }
+
+  dump_ethhdr("write", iov[0].iov_base, buflen);
+
+  /* Emulate TX done interrupt */
+
+  if (g_tx_done_intr_cb != NULL)
+    {
+      g_tx_done_intr_cb(g_priv);
+    }
+
+  /* Emulate RX ready interrupt */
+
+  if (g_rx_ready_intr_cb != NULL && tapdev_avail())
+    {
+      g_rx_ready_intr_cb(g_priv);
+    }
+}
+
 void tapdev_ifup(in_addr_t ifaddr)
 {
   struct ifreq ifr;
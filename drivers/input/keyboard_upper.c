@@ -29,6 +29,7 @@
 #include <fcntl.h>
 #include <poll.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/input/keyboard.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/list.h>
@@ -110,14 +111,7 @@ static void keyboard_notify(FAR struct keyboard_opriv_s *opriv)
       fds->revents |= (fds->events & POLLIN);
       if (fds->revents != 0)
         {
-          /* report event log */
-
-          int semcount;
-          nxsem_get_value(fds->sem, &semcount);
-          if (semcount < 1)
-            {
-              nxsem_post(fds->sem);
-            }
+          poll_notify(fds);
         }
     }
 }
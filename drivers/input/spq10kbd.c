@@ -457,7 +457,7 @@ static void spq10kbd_pollnotify(FAR struct spq10kbd_dev_s *priv)
           if (fds->revents != 0)
             {
               uinfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -34,6 +34,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/input/touchscreen.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/list.h>
@@ -112,14 +113,7 @@ static void touch_notify(FAR struct touch_openpriv_s *openpriv,
       fd->revents |= (fd->events & eventset);
       if (fd->revents != 0)
         {
-          /* report event log */
-
-          int semcount;
-          nxsem_get_value(fd->sem, &semcount);
-          if (semcount < 1)
-            {
-              nxsem_post(fd->sem);
-            }
+          poll_notify(fd);
         }
     }
 }
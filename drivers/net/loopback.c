@@ -158,6 +158,10 @@ static int lo_txpoll(FAR struct net_driver_s *dev)
        NETDEV_TXPACKETS(&priv->lo_dev);
        NETDEV_RXPACKETS(&priv->lo_dev);
 
+      /* The input logic needs the whole packet in d_buf */
+
+      netdev_iob_linearize(&priv->lo_dev);
+
 #ifdef CONFIG_NET_PKT
       /* When packet sockets are enabled, feed the frame into the tap */
 
@@ -171,7 +175,7 @@ static int lo_txpoll(FAR struct net_driver_s *dev)
         {
           ninfo("IPv4 frame\n");
           NETDEV_RXIPV4(&priv->lo_dev);
-          ipv4_input(&priv->lo_dev);
+          ipv4_gro_input(&priv->lo_dev, lo_txpoll);
         }
       else
 #endif
@@ -232,6 +236,15 @@ static void lo_poll_work(FAR void *arg)
 
       priv->lo_txdone = false;
       devif_poll(&priv->lo_dev, lo_txpoll);
+
+      /* Pass on the TCP segments held back for merging once nothing more
+       * is looped back.  Their response starts another round.
+       */
+
+      if (!priv->lo_txdone)
+        {
+          devif_gro_flush(&priv->lo_dev, lo_txpoll);
+        }
     }
 
   /* Setup the watchdog poll timer again */
@@ -374,6 +387,11 @@ static void lo_txavail_work(FAR void *arg)
 
           priv->lo_txdone = false;
           devif_timer(&priv->lo_dev, 0, lo_txpoll);
+
+          if (!priv->lo_txdone)
+            {
+              devif_gro_flush(&priv->lo_dev, lo_txpoll);
+            }
         }
       while (priv->lo_txdone);
     }
@@ -511,6 +529,9 @@ int localhost_initialize(void)
 #endif
   priv->lo_dev.d_buf     = g_iobuffer;   /* Attach the IO buffer */
   priv->lo_dev.d_private = priv;         /* Used to recover private state from dev */
+#ifdef CONFIG_NETDEV_IOB_SG
+  priv->lo_dev.d_features = NETDEV_FEATURE_SG; /* Payload may be in d_iob */
+#endif
 
   /* Register the loopabck device with the OS so that socket IOCTLs can b
    * performed.
@@ -76,6 +76,23 @@
 # define CONFIG_SKELETON_NINTERFACES 1
 #endif
 
+/* CONFIG_SKELETON_NQUEUES determines the number of RX/TX queue pairs of a
+ * multi-queue interface.  Each queue has its own interrupt, following the
+ * interrupt of the interface.
+ */
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+#  ifndef CONFIG_SKELETON_NQUEUES
+#    define CONFIG_SKELETON_NQUEUES 2
+#  endif
+
+#  if CONFIG_SKELETON_NQUEUES > CONFIG_NETDEV_MAXQUEUES
+#    error CONFIG_SKELETON_NQUEUES exceeds CONFIG_NETDEV_MAXQUEUES
+#  endif
+
+#  define SKELETON_QIRQ(q) (CONFIG_SKELETON_IRQ + 1 + (q)->q_index)
+#endif
+
 /* TX poll delay = 1 seconds.
  * CLK_TCK is the number of clock ticks per second
  */
@@ -106,6 +123,12 @@ struct skel_driver_s
   struct work_s sk_irqwork;    /* For deferring interrupt work to the work queue */
   struct work_s sk_pollwork;   /* For deferring poll work to the work queue */
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  /* The RX/TX queue pairs of the interface */
+
+  struct netdev_queue_s sk_queues[CONFIG_SKELETON_NQUEUES];
+#endif
+
   /* This holds the information visible to the NuttX network */
 
   struct net_driver_s sk_dev;  /* Interface understood by the network */
@@ -133,6 +156,13 @@ struct skel_driver_s
 
 static uint8_t g_pktbuf[MAX_NETDEV_PKTSIZE + CONFIG_NET_GUARDSIZE];
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+/* A multi-queue interface needs one packet buffer for each queue */
+
+static uint8_t g_qpktbuf[CONFIG_SKELETON_NQUEUES]
+                        [MAX_NETDEV_PKTSIZE + CONFIG_NET_GUARDSIZE];
+#endif
+
 /* Driver state structure */
 
 static struct skel_driver_s g_skel[CONFIG_SKELETON_NINTERFACES];
@@ -149,12 +179,18 @@ static int  skel_txpoll(FAR struct net_driver_s *dev);
 /* Interrupt handling */
 
 static void skel_reply(struct skel_driver_s *priv)
+static void skel_input(FAR struct skel_driver_s *priv);
 static void skel_receive(FAR struct skel_driver_s *priv);
 static void skel_txdone(FAR struct skel_driver_s *priv);
 
 static void skel_interrupt_work(FAR void *arg);
 static int  skel_interrupt(int irq, FAR void *context, FAR void *arg);
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+static void skel_queue_work(FAR void *arg);
+static int  skel_queue_interrupt(int irq, FAR void *context, FAR void *arg);
+#endif
+
 /* Watchdog timer expirations */
 
 static void skel_txtimeout_work(FAR void *arg);
@@ -218,7 +254,20 @@ static int skel_transmit(FAR struct skel_driver_s *priv)
 
   /* Increment statistics */
 
-  NETDEV_TXPACKETS(priv->sk_dev);
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  /* The packet is sent on the TX ring of the queue that is processed, if
+   * any, or else on the TX ring of the first queue.
+   */
+
+  if (priv->sk_dev.d_queue != NULL)
+    {
+      NETDEV_QTXPACKETS(priv->sk_dev.d_queue);
+    }
+  else
+#endif
+    {
+      NETDEV_TXPACKETS(priv->sk_dev);
+    }
 
   /* Send the packet: address=priv->sk_dev.d_buf, length=priv->sk_dev.d_len */
 
@@ -369,10 +418,11 @@ static void skel_reply(struct skel_driver_s *priv)
 }
 
 /****************************************************************************
- * Name: skel_receive
+ * Name: skel_input
  *
  * Description:
- *   An interrupt was received indicating the availability of a new RX packet
+ *   Dispatch the received packet in priv->sk_dev.d_buf to the network and
+ *   send the reply, if any.
  *
  * Input Parameters:
  *   priv - Reference to the driver state structure
@@ -385,91 +435,115 @@ static void skel_reply(struct skel_driver_s *priv)
  *
  ****************************************************************************/
 
-static void skel_receive(FAR struct skel_driver_s *priv)
+static void skel_input(FAR struct skel_driver_s *priv)
 {
-  do
-    {
-      /* Check for errors and update statistics */
-
-      /* Check if the packet is a valid size for the network buffer
-       * configuration.
-       */
-
-      /* Copy the data data from the hardware to priv->sk_dev.d_buf.  Set
-       * amount of data in priv->sk_dev.d_len
-       */
-
 #ifdef CONFIG_NET_PKT
-      /* When packet sockets are enabled, feed the frame into the tap */
+  /* When packet sockets are enabled, feed the frame into the tap */
 
-       pkt_input(&priv->sk_dev);
+  pkt_input(&priv->sk_dev);
 #endif
 
 #ifdef CONFIG_NET_IPv4
-      /* Check for an IPv4 packet */
+  /* Check for an IPv4 packet */
 
-      if (BUF->type == HTONS(ETHTYPE_IP))
-        {
-          ninfo("IPv4 frame\n");
-          NETDEV_RXIPV4(&priv->sk_dev);
+  if (BUF->type == HTONS(ETHTYPE_IP))
+    {
+      ninfo("IPv4 frame\n");
+      NETDEV_RXIPV4(&priv->sk_dev);
 
-          /* Handle ARP on input, then dispatch IPv4 packet to the network
-           * layer.
-           */
+      /* Handle ARP on input, then dispatch IPv4 packet to the network
+       * layer.
+       */
 
-          arp_ipin(&priv->sk_dev);
-          ipv4_input(&priv->sk_dev);
+      arp_ipin(&priv->sk_dev);
+      ipv4_input(&priv->sk_dev);
 
-          /* Check for a reply to the IPv4 packet */
+      /* Check for a reply to the IPv4 packet */
 
-          skel_reply(priv);
-        }
-      else
+      skel_reply(priv);
+    }
+  else
 #endif
 #ifdef CONFIG_NET_IPv6
-      /* Check for an IPv6 packet */
+  /* Check for an IPv6 packet */
 
-      if (BUF->type == HTONS(ETHTYPE_IP6))
-        {
-          ninfo("IPv6 frame\n");
-          NETDEV_RXIPV6(&priv->sk_dev);
+  if (BUF->type == HTONS(ETHTYPE_IP6))
+    {
+      ninfo("IPv6 frame\n");
+      NETDEV_RXIPV6(&priv->sk_dev);
 
-          /* Dispatch IPv6 packet to the network layer */
+      /* Dispatch IPv6 packet to the network layer */
 
-          ipv6_input(&priv->sk_dev);
+      ipv6_input(&priv->sk_dev);
 
-          /* Check for a reply to the IPv6 packet */
+      /* Check for a reply to the IPv6 packet */
 
-          skel_reply(priv);
-        }
-      else
+      skel_reply(priv);
+    }
+  else
 #endif
 #ifdef CONFIG_NET_ARP
-      /* Check for an ARP packet */
+  /* Check for an ARP packet */
 
-      if (BUF->type == HTONS(ETHTYPE_ARP))
-        {
-          /* Dispatch ARP packet to the network layer */
+  if (BUF->type == HTONS(ETHTYPE_ARP))
+    {
+      /* Dispatch ARP packet to the network layer */
 
-          arp_arpin(&priv->sk_dev);
-          NETDEV_RXARP(&priv->sk_dev);
+      arp_arpin(&priv->sk_dev);
+      NETDEV_RXARP(&priv->sk_dev);
 
-          /* If the above function invocation resulted in data that should be
-           * sent out on the network, the field  d_len will set to a value
-           * > 0.
-           */
+      /* If the above function invocation resulted in data that should be
+       * sent out on the network, the field  d_len will set to a value
+       * > 0.
+       */
 
-          if (priv->sk_dev.d_len > 0)
-            {
-              skel_transmit(priv);
-            }
-        }
-      else
-#endif
+      if (priv->sk_dev.d_len > 0)
         {
-          NETDEV_RXDROPPED(&priv->sk_dev);
+          skel_transmit(priv);
         }
     }
+  else
+#endif
+    {
+      NETDEV_RXDROPPED(&priv->sk_dev);
+    }
+}
+
+/****************************************************************************
+ * Name: skel_receive
+ *
+ * Description:
+ *   An interrupt was received indicating the availability of a new RX packet
+ *
+ * Input Parameters:
+ *   priv - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void skel_receive(FAR struct skel_driver_s *priv)
+{
+  do
+    {
+      /* Check for errors and update statistics */
+
+      /* Check if the packet is a valid size for the network buffer
+       * configuration.
+       */
+
+      /* Copy the data data from the hardware to priv->sk_dev.d_buf.  Set
+       * amount of data in priv->sk_dev.d_len
+       */
+
+      /* Dispatch the packet to the network */
+
+      skel_input(priv);
+    }
   while (); /* While there are more packets to be processed */
 }
 
@@ -614,6 +688,125 @@ static int skel_interrupt(int irq, FAR void *context, FAR void *arg)
   return OK;
 }
 
+/****************************************************************************
+ * Name: skel_queue_work
+ *
+ * Description:
+ *   Perform the interrupt related work of one RX/TX queue from the worker
+ *   thread of the queue's CPU
+ *
+ * Input Parameters:
+ *   arg - The queue, as passed to netdev_queue_schedule()
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Runs on a worker thread.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+static void skel_queue_work(FAR void *arg)
+{
+  FAR struct netdev_queue_s *q = (FAR struct netdev_queue_s *)arg;
+  FAR struct skel_driver_s *priv =
+    (FAR struct skel_driver_s *)q->q_dev->d_private;
+
+  /* Get and clear the interrupt status bits of the queue */
+
+  /* Process the packets in the RX ring of the queue.  The hardware has
+   * already steered each flow to one queue by its RSS hash.  Hardware
+   * without RSS would instead take each packet from a single RX ring,
+   * select its queue with netdev_flowhash() and netdev_queue_rxselect(),
+   * and schedule that queue.
+   */
+
+  do
+    {
+      /* Check for errors and update statistics with NETDEV_QRXERRORS() */
+
+      /* The packet buffer of the queue belongs to whoever has entered the
+       * queue.  skel_txavail_work() may be polling into it on another
+       * worker thread, so the packet is only copied after
+       * netdev_queue_enter().
+       */
+
+      netdev_queue_enter(q);
+
+      /* Copy the data from the RX ring of the queue to priv->sk_dev.d_buf
+       * (which is now q->q_buf) and set the amount of data in
+       * priv->sk_dev.d_len.
+       */
+
+      NETDEV_QRXPACKETS(q);
+
+      /* Dispatch the packet to the network.  d_buf is now q->q_buf, so a
+       * reply is sent on the TX ring of this queue.
+       */
+
+      skel_input(priv);
+      netdev_queue_leave(q);
+
+      /* Return the RX descriptor to the hardware */
+    }
+  while (); /* While there are more packets in the RX ring of the queue */
+
+  /* Check if a packet transmission on the queue just completed.  If so,
+   * poll the network for new TX data to send on the queue.
+   */
+
+  netdev_queue_enter(q);
+  NETDEV_QTXDONE(q);
+  devif_poll(&priv->sk_dev, skel_txpoll);
+  netdev_queue_leave(q);
+
+  /* Re-enable the interrupt of the queue */
+
+  up_enable_irq(SKELETON_QIRQ(q));
+}
+#endif
+
+/****************************************************************************
+ * Name: skel_queue_interrupt
+ *
+ * Description:
+ *   Interrupt handler of one RX/TX queue.  The interrupt controller should
+ *   deliver the interrupt to the queue's CPU (q_cpu), so that the work of
+ *   the queue is queued and performed on that CPU.
+ *
+ * Input Parameters:
+ *   irq     - Number of the IRQ that generated the interrupt
+ *   context - Interrupt register state save info (architecture-specific)
+ *   arg     - The queue
+ *
+ * Returned Value:
+ *   OK on success
+ *
+ * Assumptions:
+ *   Runs in the context of a the queue interrupt handler.  Local
+ *   interrupts are disabled by the interrupt logic.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+static int skel_queue_interrupt(int irq, FAR void *context, FAR void *arg)
+{
+  FAR struct netdev_queue_s *q = (FAR struct netdev_queue_s *)arg;
+
+  DEBUGASSERT(q != NULL);
+
+  /* Disable further interrupts of the queue until its work is done */
+
+  up_disable_irq(irq);
+
+  /* Schedule the work of the queue on the worker thread of its CPU */
+
+  netdev_queue_schedule(q, skel_queue_work);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: skel_txtimeout_work
  *
@@ -785,6 +978,9 @@ static int skel_ifup(FAR struct net_driver_s *dev)
 {
   FAR struct skel_driver_s *priv =
     (FAR struct skel_driver_s *)dev->d_private;
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  int i;
+#endif
 
 #ifdef CONFIG_NET_IPv4
   ninfo("Bringing up: %d.%d.%d.%d\n",
@@ -817,6 +1013,16 @@ static int skel_ifup(FAR struct net_driver_s *dev)
 
   priv->sk_bifup = true;
   up_enable_irq(CONFIG_SKELETON_IRQ);
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  /* Enable the interrupts of the queues */
+
+  for (i = 0; i < CONFIG_SKELETON_NQUEUES; i++)
+    {
+      up_enable_irq(SKELETON_QIRQ(&priv->sk_queues[i]));
+    }
+#endif
+
   return OK;
 }
 
@@ -842,12 +1048,24 @@ static int skel_ifdown(FAR struct net_driver_s *dev)
   FAR struct skel_driver_s *priv =
     (FAR struct skel_driver_s *)dev->d_private;
   irqstate_t flags;
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  int i;
+#endif
 
   /* Disable the Ethernet interrupt */
 
   flags = enter_critical_section();
   up_disable_irq(CONFIG_SKELETON_IRQ);
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  /* Disable the interrupts of the queues */
+
+  for (i = 0; i < CONFIG_SKELETON_NQUEUES; i++)
+    {
+      up_disable_irq(SKELETON_QIRQ(&priv->sk_queues[i]));
+    }
+#endif
+
   /* Cancel the TX poll timer and TX timeout timers */
 
   wd_cancel(&priv->sk_txpoll);
@@ -885,14 +1103,24 @@ static int skel_ifdown(FAR struct net_driver_s *dev)
 static void skel_txavail_work(FAR void *arg)
 {
   FAR struct skel_driver_s *priv = (FAR struct skel_driver_s *)arg;
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  FAR struct netdev_queue_s *q = netdev_queue_txselect(&priv->sk_dev);
+#endif
 
   /* Lock the network and serialize driver operations if necessary.
    * NOTE: Serialization is only required in the case where the driver work
    * is performed on an LP worker thread and where more than one LP worker
    * thread has been configured.
+   *
+   * A multi-queue interface sends on the TX queue of the CPU that runs
+   * this work.
    */
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  netdev_queue_enter(q);
+#else
   net_lock();
+#endif
 
   /* Ignore the notification if the interface is not yet up */
 
@@ -905,7 +1133,11 @@ static void skel_txavail_work(FAR void *arg)
       devif_timer(&priv->sk_dev, 0, skel_txpoll);
     }
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  netdev_queue_leave(q);
+#else
   net_unlock();
+#endif
 }
 
 /****************************************************************************
@@ -1142,6 +1374,10 @@ static int skel_ioctl(FAR struct net_driver_s *dev, int cmd,
 int skel_initialize(int intf)
 {
   FAR struct skel_driver_s *priv;
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  FAR struct netdev_queue_s *q;
+  int i;
+#endif
 
   /* Get the interface structure associated with this interface number. */
 
@@ -1175,6 +1411,27 @@ int skel_initialize(int intf)
 #endif
   priv->sk_dev.d_private = g_skel;        /* Used to recover private state from dev */
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  /* Give each RX/TX queue pair its packet buffer and attach its interrupt.
+   * netdev_register() sets up the rest of the queues, which also assigns
+   * each queue the CPU that processes it.
+   */
+
+  for (i = 0; i < CONFIG_SKELETON_NQUEUES; i++)
+    {
+      q        = &priv->sk_queues[i];
+      q->q_buf = g_qpktbuf[i];
+
+      if (irq_attach(CONFIG_SKELETON_IRQ + 1 + i, skel_queue_interrupt, q))
+        {
+          return -EAGAIN;
+        }
+    }
+
+  priv->sk_dev.d_queues  = priv->sk_queues;
+  priv->sk_dev.d_nqueues = CONFIG_SKELETON_NQUEUES;
+#endif
+
   /* Put the interface in the down state.  This usually amounts to resetting
    * the device and/or calling skel_ifdown().
    */
@@ -58,6 +58,7 @@
 #endif
 
 #include <nuttx/arch.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/irq.h>
 #include <nuttx/wdog.h>
 #include <nuttx/wqueue.h>
@@ -314,7 +315,7 @@ static void tun_pollnotify(FAR struct tun_device_s *priv,
   if (eventset != 0)
     {
       fds->revents |= eventset;
-      nxsem_post(fds->sem);
+      poll_notify(fds);
     }
 }
 
@@ -123,11 +123,7 @@ static int battery_charger_notify(FAR struct battery_charger_priv_s *priv,
   if (priv->mask)
     {
       fd->revents |= POLLIN;
-      nxsem_get_value(fd->sem, &semcnt);
-      if (semcnt < 1)
-        {
-          nxsem_post(fd->sem);
-        }
+      poll_notify(fd);
 
       nxsem_get_value(&priv->wait, &semcnt);
       if (semcnt < 1)
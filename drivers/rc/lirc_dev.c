@@ -31,6 +31,7 @@
 #include <poll.h>
 #include <fcntl.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mm/circbuf.h>
 #include <nuttx/rc/lirc_dev.h>
@@ -116,8 +117,6 @@ static const struct file_operations g_lirc_fops =
 static void lirc_pollnotify(FAR struct lirc_fh_s *fh,
                             pollevent_t eventset)
 {
-  int semcount;
-
   if (fh->fd)
     {
       fh->fd->revents |= (fh->fd->events & eventset);
@@ -125,12 +124,7 @@ static void lirc_pollnotify(FAR struct lirc_fh_s *fh,
       if (fh->fd->revents != 0)
         {
           rcinfo("Report events: %02x\n", fh->fd->revents);
-
-          nxsem_get_value(fh->fd->sem, &semcount);
-          if (semcount < 1)
-            {
-              nxsem_post(fh->fd->sem);
-            }
+          poll_notify(fh->fd);
         }
     }
 }
@@ -34,6 +34,7 @@
 
 #include <poll.h>
 #include <fcntl.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mm/circbuf.h>
 #include <nuttx/sensors/sensor.h>
@@ -155,7 +156,6 @@ static void sensor_pollnotify(FAR struct sensor_upperhalf_s *upper,
                               pollevent_t eventset)
 {
   FAR struct pollfd *fd;
-  int semcount;
   int i;
 
   for (i = 0; i < CONFIG_SENSORS_NPOLLWAITERS; i++)
@@ -168,12 +168,7 @@ static void sensor_pollnotify(FAR struct sensor_upperhalf_s *upper,
           if (fd->revents != 0)
             {
               sninfo("Report events: %02x\n", fd->revents);
-
-              nxsem_get_value(fd->sem, &semcount);
-              if (semcount < 1)
-                {
-                  nxsem_post(fd->sem);
-                }
+              poll_notify(fd);
             }
         }
     }
@@ -125,7 +125,7 @@ static void uart_bth4_pollnotify(FAR struct uart_bth4_s *dev,
 
           if (fds->revents != 0)
             {
-              uart_bth4_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -419,7 +419,7 @@ static void usbhost_pollnotify(FAR struct usbhost_cdcmbim_s *priv)
           if (fds->revents != 0)
             {
               uinfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -944,7 +944,7 @@ static void fusb303_notify(FAR struct fusb303_dev_s *priv)
         {
           fds->revents |= POLLIN;
           fusb303_info("Report events: %02x\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_notify(fds);
         }
     }
 }
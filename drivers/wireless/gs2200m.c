@@ -46,6 +46,7 @@
 
 #include <nuttx/ascii.h>
 #include <nuttx/arch.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/spi/spi.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/wqueue.h>
@@ -422,7 +423,7 @@ static void _notif_q_push(FAR struct gs2200m_dev_s *dev, char cid)
       /* If poll() waits and cid has been pushed to the queue, notify  */
 
       dev->pfd->revents |= POLLIN;
-      nxsem_post(dev->pfd->sem);
+      poll_notify(dev->pfd);
     }
 
   wlinfo("+++ pushed %c count=%d\n", cid, dev->notif_q.count);
@@ -3148,7 +3149,7 @@ static int gs2200m_poll(FAR struct file *filep, FAR struct pollfd *fds,
       if (0 < n)
         {
           dev->pfd->revents |= POLLIN;
-          nxsem_post(dev->pfd->sem);
+          poll_notify(dev->pfd);
           wlinfo("==== _notif_q_count=%d\n", n);
         }
     }
@@ -35,6 +35,7 @@
 #include <time.h>
 #include <fcntl.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/signal.h>
@@ -1230,7 +1231,7 @@ static int sx127x_poll(FAR struct file *filep, FAR struct pollfd *fds,
           /* Data available for input */
 
           dev->pfd->revents |= POLLIN;
-          nxsem_post(dev->pfd->sem);
+          poll_notify(dev->pfd);
         }
 
       nxsem_post(&dev->rx_buffer_sem);
@@ -1316,7 +1317,7 @@ static int sx127x_lora_isr0_process(FAR struct sx127x_dev_s *dev)
                       dev->pfd->revents |= POLLIN;
 
                       wlinfo("Wake up polled fd\n");
-                      nxsem_post(dev->pfd->sem);
+                      poll_notify(dev->pfd);
                     }
 
                   /* Wake-up any thread waiting in recv */
@@ -1451,7 +1452,7 @@ static int sx127x_fskook_isr0_process(FAR struct sx127x_dev_s *dev)
                       dev->pfd->revents |= POLLIN;
 
                       wlinfo("Wake up polled fd\n");
-                      nxsem_post(dev->pfd->sem);
+                      poll_notify(dev->pfd);
                     }
 
                   /* Wake-up any thread waiting in recv */
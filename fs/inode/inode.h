@@ -419,6 +419,17 @@ int foreach_inode(foreach_inode_t handler, FAR void *arg);
 int files_allocate(FAR struct inode *inode, int oflags, off_t pos,
                    FAR void *priv, int minfd);
 
+/****************************************************************************
+ * Name: epoll_fileclose
+ *
+ * Description:
+ *   Remove a file that is about to be closed from every epoll instance it
+ *   is registered with.
+ *
+ ****************************************************************************/
+
+void epoll_fileclose(FAR struct file *filep);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
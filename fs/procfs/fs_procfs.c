@@ -65,9 +65,11 @@ extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations irq_operations;
 extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations critmon_operations;
+extern const struct procfs_operations balance_operations;
 extern const struct procfs_operations meminfo_operations;
 extern const struct procfs_operations memdump_operations;
 extern const struct procfs_operations iobinfo_operations;
+extern const struct procfs_operations slabinfo_operations;
 extern const struct procfs_operations module_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
@@ -102,6 +104,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "[0-9]*",        &proc_operations,            PROCFS_DIR_TYPE    },
 #endif
 
+#if defined(CONFIG_SMP_LOAD_BALANCE)
+  { "balance",       &balance_operations,         PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_SCHED_CPULOAD) && !defined(CONFIG_FS_PROCFS_EXCLUDE_CPULOAD)
   { "cpuload",       &cpuload_operations,         PROCFS_FILE_TYPE   },
 #endif
@@ -163,6 +169,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "self/**",       &proc_operations,            PROCFS_UNKOWN_TYPE },
 #endif
 
+#if defined(CONFIG_MM_SLAB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SLABINFO)
+  { "slabinfo",      &slabinfo_operations,        PROCFS_FILE_TYPE   },
+#endif
+
 #if !defined(CONFIG_FS_PROCFS_EXCLUDE_UPTIME)
   { "uptime",        &uptime_operations,          PROCFS_FILE_TYPE   },
 #endif
@@ -248,6 +248,48 @@ static ssize_t critmon_read_cpu(FAR struct critmon_file_s *attr,
   return totalsize;
 }
 
+/****************************************************************************
+ * Name: critmon_read_site
+ ****************************************************************************/
+
+#if CONFIG_SCHED_CRITMONITOR_SITES > 0
+static ssize_t critmon_read_site(FAR struct critmon_file_s *attr,
+                                 FAR char *buffer, size_t buflen,
+                                 FAR off_t *offset,
+                                 FAR struct critmon_site_s *site)
+{
+  struct timespec maxtime;
+  size_t linesize;
+
+  /* Convert the maximum time in the critical section */
+
+  if (site->max > 0)
+    {
+      up_perf_convert(site->max, &maxtime);
+    }
+  else
+    {
+      maxtime.tv_sec = 0;
+      maxtime.tv_nsec = 0;
+    }
+
+  /* Generate output for the call site */
+
+  linesize = procfs_snprintf(attr->line, CRITMON_LINELEN,
+                             "%p,%lu,%lu.%09lu\n", site->caller,
+                             (unsigned long)site->count,
+                             (unsigned long)maxtime.tv_sec,
+                             (unsigned long)maxtime.tv_nsec);
+
+  /* Reset the count and the maximum, but keep the entry of the call site */
+
+  site->count = 0;
+  site->max   = 0;
+
+  return procfs_memcpy(attr->line, linesize, buffer, buflen, offset);
+}
+#endif
+
 /****************************************************************************
  * Name: critmon_read
  ****************************************************************************/
@@ -259,6 +301,9 @@ static ssize_t critmon_read(FAR struct file *filep, FAR char *buffer,
   off_t offset;
   ssize_t ret;
   int cpu;
+#if CONFIG_SCHED_CRITMONITOR_SITES > 0
+  int i;
+#endif
 
   finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
 
@@ -286,6 +331,31 @@ static ssize_t critmon_read(FAR struct file *filep, FAR char *buffer,
       offset += nbytes;
     }
 
+#if CONFIG_SCHED_CRITMONITOR_SITES > 0
+  /* Then the status for each call site that entered the critical section */
+
+  for (i = 0; i < CONFIG_SCHED_CRITMONITOR_SITES && ret <= buflen; i++)
+    {
+      ssize_t nbytes;
+
+      if (g_crit_sites[i].caller == NULL)
+        {
+          break;
+        }
+
+      nbytes = critmon_read_site(attr, buffer + ret, buflen - ret,
+                                 &offset, &g_crit_sites[i]);
+
+      ret += nbytes;
+      if (ret > buflen)
+        {
+          break;
+        }
+
+      offset += nbytes;
+    }
+#endif
+
   if (ret > 0)
     {
       filep->f_pos += ret;
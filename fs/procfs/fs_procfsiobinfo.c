@@ -159,6 +159,16 @@ static FAR const char *g_iob_user_names[] =
   "global",
 };
 
+/* The names of the pools of I/O buffers, in the order of the pool index */
+
+static FAR const char *g_iob_pool_names[IOB_NPOOLS] =
+{
+  "small",
+#ifdef CONFIG_IOB_LARGE
+  "large",
+#endif
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -254,6 +264,7 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct iobinfo_file_s *iobfile;
   FAR struct iob_userstats_s *userstats;
+  struct iob_poolstats_s poolstats;
   size_t linesize;
   size_t copysize;
   size_t totalsize;
@@ -332,6 +343,46 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
       totalsize += copysize;
     }
 
+  /* Then the usage of each pool of I/O buffers */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(iobfile->line, IOBINFO_LINELEN,
+                                   "\n%-8s%10s%10s%10s%16s%16s\n",
+                                   "POOL", "BUFSIZE", "NBUFFERS", "FREE",
+                                   "ALLOCATED", "FAILED");
+
+      copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (i = 0; i < IOB_NPOOLS; i++)
+    {
+      if (totalsize < buflen)
+        {
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          iob_getpoolstats(i, &poolstats);
+          linesize   = procfs_snprintf(iobfile->line, IOBINFO_LINELEN,
+                                       "%-8s%10u%10u%10u%16lu%16lu\n",
+                                       g_iob_pool_names[i],
+                                       poolstats.bufsize,
+                                       poolstats.nbuffers,
+                                       poolstats.nfree,
+                                       poolstats.nalloc,
+                                       poolstats.nfail);
+
+          copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
+                                     &offset);
+          totalsize += copysize;
+        }
+    }
+
   /* Update the file offset */
 
   filep->f_pos += totalsize;
@@ -54,7 +54,11 @@
  * to handle the longest line generated by this logic.
  */
 
-#define MEMINFO_LINELEN 80
+#ifdef CONFIG_MM_HEAP_TIMING
+#  define MEMINFO_LINELEN 104
+#else
+#  define MEMINFO_LINELEN 80
+#endif
 
 /****************************************************************************
  * Private Types
@@ -288,9 +292,16 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
 
   /* The first line is the headers */
 
+#ifdef CONFIG_MM_HEAP_TIMING
+  linesize  = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                              "%13s%11s%11s%11s%11s%7s%7s%11s%11s\n", "",
+                              "total", "used", "free", "largest", "nused",
+                              "nfree", "mxmalloc", "mxfree");
+#else
   linesize  = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
                               "%13s%11s%11s%11s%11s%7s%7s\n", "", "total",
                               "used", "free", "largest", "nused", "nfree");
+#endif
 
   copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
                             &offset);
@@ -312,6 +323,20 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
           /* Show heap information */
 
           mm_mallinfo(entry->heap, &minfo);
+#ifdef CONFIG_MM_HEAP_TIMING
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       "%12s:%11lu%11lu%11lu%11lu%7lu%7lu"
+                                       "%11lu%11lu\n",
+                                       entry->name,
+                                       (unsigned long)minfo.arena,
+                                       (unsigned long)minfo.uordblks,
+                                       (unsigned long)minfo.fordblks,
+                                       (unsigned long)minfo.mxordblk,
+                                       (unsigned long)minfo.aordblks,
+                                       (unsigned long)minfo.ordblks,
+                                       (unsigned long)minfo.mxmalloc,
+                                       (unsigned long)minfo.mxfree);
+#else
           linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
                                        "%12s:%11lu%11lu%11lu%11lu%7lu%7lu\n",
                                        entry->name,
@@ -321,6 +346,7 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
                                        (unsigned long)minfo.mxordblk,
                                        (unsigned long)minfo.aordblks,
                                        (unsigned long)minfo.ordblks);
+#endif
           copysize   = procfs_memcpy(procfile->line, linesize, buffer,
                                      buflen, &offset);
           totalsize += copysize;
@@ -385,6 +411,55 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
     }
 #endif
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+  /* Followed by the statistics of the per-CPU small allocation caches */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%13s%11s%11s%11s%11s\n", "cache",
+                                   "size", "hits", "misses", "cached");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      struct mm_cacheinfo_s cinfo;
+      int ndx;
+
+      for (ndx = 0;
+           totalsize < buflen &&
+           mm_cacheinfo(entry->heap, ndx, &cinfo) >= 0;
+           ndx++)
+        {
+          /* Skip the sizes that were never requested */
+
+          if (cinfo.hits == 0 && cinfo.misses == 0)
+            {
+              continue;
+            }
+
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       "%12s:%11lu%11lu%11lu%11lu\n",
+                                       entry->name,
+                                       (unsigned long)cinfo.size,
+                                       cinfo.hits, cinfo.misses,
+                                       cinfo.cached);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
   /* Update the file offset */
 
   filep->f_pos += totalsize;
@@ -0,0 +1,336 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsslabinfo.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/slab.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_SLAB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SLABINFO)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define SLABINFO_LINELEN 96
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct slabinfo_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  unsigned int linesize;          /* Number of valid characters in line[] */
+  char line[SLABINFO_LINELEN];    /* Pre-allocated buffer for formatted lines */
+};
+
+/* This structure carries the read state through slab_foreach() */
+
+struct slabinfo_read_s
+{
+  FAR struct slabinfo_file_s *slabfile;
+  FAR char *buffer;               /* User buffer */
+  size_t buflen;                  /* Remaining space in the user buffer */
+  size_t copysize;                /* Size of the last copy */
+  size_t totalsize;               /* Total bytes returned */
+  off_t offset;                   /* File offset still to be skipped */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     slabinfo_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     slabinfo_close(FAR struct file *filep);
+static ssize_t slabinfo_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     slabinfo_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     slabinfo_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations slabinfo_operations =
+{
+  slabinfo_open,   /* open */
+  slabinfo_close,  /* close */
+  slabinfo_read,   /* read */
+  NULL,            /* write */
+  slabinfo_dup,    /* dup */
+  NULL,            /* opendir */
+  NULL,            /* closedir */
+  NULL,            /* readdir */
+  NULL,            /* rewinddir */
+  slabinfo_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: slabinfo_line
+ *
+ * Description:
+ *   Copy one formatted line to the user buffer, skipping the part before
+ *   the current file offset.
+ *
+ ****************************************************************************/
+
+static void slabinfo_line(FAR struct slabinfo_read_s *ctx, size_t linesize)
+{
+  if (ctx->totalsize < ctx->buflen)
+    {
+      ctx->copysize   = procfs_memcpy(ctx->slabfile->line, linesize,
+                                      ctx->buffer + ctx->totalsize,
+                                      ctx->buflen - ctx->totalsize,
+                                      &ctx->offset);
+      ctx->totalsize += ctx->copysize;
+    }
+}
+
+/****************************************************************************
+ * Name: slabinfo_cache
+ *
+ * Description:
+ *   slab_foreach() callback:  Format the statistics of one cache.
+ *
+ ****************************************************************************/
+
+static void slabinfo_cache(SLAB_HANDLE handle, FAR void *arg)
+{
+  FAR struct slabinfo_read_s *ctx = (FAR struct slabinfo_read_s *)arg;
+  struct slabinfo_s info;
+  size_t linesize;
+
+  if (ctx->totalsize < ctx->buflen)
+    {
+      slab_info(handle, &info);
+
+      linesize = procfs_snprintf(ctx->slabfile->line, SLABINFO_LINELEN,
+                                 "%-16s%8lu%8u%8u%8lu%10lu%8lu%8lu%8lu\n",
+                                 info.name,
+                                 (unsigned long)info.objsize,
+                                 info.objsperslab, info.nslabs,
+                                 (unsigned long)info.ninuse,
+                                 (unsigned long)info.nalloc,
+                                 (unsigned long)info.nfail,
+                                 (unsigned long)info.ngrow,
+                                 (unsigned long)info.nreclaim);
+      slabinfo_line(ctx, linesize);
+    }
+}
+
+/****************************************************************************
+ * Name: slabinfo_open
+ ****************************************************************************/
+
+static int slabinfo_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct slabinfo_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct slabinfo_file_s *)
+    kmm_zalloc(sizeof(struct slabinfo_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: slabinfo_close
+ ****************************************************************************/
+
+static int slabinfo_close(FAR struct file *filep)
+{
+  FAR struct slabinfo_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct slabinfo_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: slabinfo_read
+ ****************************************************************************/
+
+static ssize_t slabinfo_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  struct slabinfo_read_s ctx;
+  size_t linesize;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  ctx.slabfile  = (FAR struct slabinfo_file_s *)filep->f_priv;
+  DEBUGASSERT(ctx.slabfile);
+
+  ctx.buffer    = buffer;
+  ctx.buflen    = buflen;
+  ctx.copysize  = 0;
+  ctx.totalsize = 0;
+  ctx.offset    = filep->f_pos;
+
+  /* The first line is the headers */
+
+  linesize = procfs_snprintf(ctx.slabfile->line, SLABINFO_LINELEN,
+                             "%-16s%8s%8s%8s%8s%10s%8s%8s%8s\n",
+                             "NAME", "OBJSIZE", "PERSLAB", "SLABS",
+                             "INUSE", "ALLOCS", "FAILS", "GROWS",
+                             "RECLAIM");
+  slabinfo_line(&ctx, linesize);
+
+  /* Then one line for each object cache */
+
+  slab_foreach(slabinfo_cache, &ctx);
+
+  /* Update the file offset */
+
+  filep->f_pos += ctx.totalsize;
+  return ctx.totalsize;
+}
+
+/****************************************************************************
+ * Name: slabinfo_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int slabinfo_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct slabinfo_file_s *oldattr;
+  FAR struct slabinfo_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct slabinfo_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct slabinfo_file_s *)
+    kmm_malloc(sizeof(struct slabinfo_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct slabinfo_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: slabinfo_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int slabinfo_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "slabinfo" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_MM_SLAB && !CONFIG_FS_PROCFS_EXCLUDE_SLABINFO */
@@ -65,6 +65,12 @@ int file_close(FAR struct file *filep)
 
   if (inode)
     {
+      /* Tear down any epoll registrations of the file while the driver
+       * state that they refer to is still valid.
+       */
+
+      epoll_fileclose(filep);
+
       /* Close the file, driver, or mountpoint. */
 
       if (inode->u.i_ops && inode->u.i_ops->close)
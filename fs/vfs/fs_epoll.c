@@ -27,7 +27,9 @@
 #include <sys/epoll.h>
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <queue.h>
 #include <poll.h>
 #include <errno.h>
 #include <string.h>
@@ -35,8 +37,12 @@
 #include <semaphore.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/signal.h>
 
 #include "inode/inode.h"
 
@@ -44,16 +50,56 @@
  * Private Types
  ****************************************************************************/
 
+/* This describes one file descriptor registered with an epoll instance.
+ *
+ * The poll is set up on the file once, when the descriptor is added, and
+ * stays armed until the descriptor is removed (or, for EPOLLONESHOT, until
+ * it fires).  The driver reports events through poll_notify(), which calls
+ * epoll_notify() to append the node to the ready list of the epoll_head
+ * and post its waitsem.  epoll_pwait() therefore only visits descriptors
+ * that are ready.
+ *
+ * Nodes are keyed on the open file of the registering task, not on the
+ * descriptor number, and hold no reference to it.  When the file is
+ * closed, file_close() calls epoll_fileclose() first, which tears down the
+ * poll and drops the node from every epoll instance, as if EPOLL_CTL_DEL
+ * had been used.  A descriptor number that is reused afterwards can be
+ * registered again.
+ */
+
+struct epoll_head;
+
+struct epoll_node
+{
+  dq_entry_t node;                  /* Entry in the used or free list */
+  FAR struct epoll_node *hnext;     /* Next node in the fd hash chain */
+  FAR struct epoll_node *rnext;     /* Next node in the re-arm list */
+  FAR struct epoll_node *rdnext;    /* Next node in the ready list */
+  FAR struct epoll_head *eph;       /* The epoll instance */
+  FAR struct file *filep;           /* The registered file */
+  uint32_t events;                  /* Requested events (EPOLLET etc.) */
+  epoll_data_t data;                /* User data returned with events */
+  bool armed;                       /* True: poll is set up on file */
+  bool ready;                       /* True: node is in the ready list */
+  struct pollfd pfd;                /* Poll structure given to the driver */
+};
+
 struct epoll_head
 {
+  dq_entry_t node;                  /* Entry in g_epoll_heads */
   int size;
   int occupied;
   int crefs;
-  sem_t sem;
+  sem_t sem;                        /* Exclusive access to this structure */
+  sem_t waitsem;                    /* Posted by drivers on any event */
   struct file fp;
   struct inode in;
-  FAR epoll_data_t *data;
-  FAR struct pollfd *poll;
+  dq_queue_t used;                  /* Registered descriptors */
+  dq_queue_t free;                  /* Unused epoll_node structures */
+  FAR struct epoll_node *rearm;     /* Level-triggered nodes to re-arm */
+  FAR struct epoll_node *ready;     /* Nodes with reported events */
+  FAR struct epoll_node **rdtail;   /* Tail of the ready list */
+  FAR struct epoll_node **hash;     /* file -> epoll_node hash table */
 };
 
 /****************************************************************************
@@ -83,6 +129,14 @@ static const struct file_operations g_epoll_ops =
 #endif
 };
 
+/* All epoll instances, so that epoll_fileclose() can find the nodes of a
+ * file that is closed.  g_epoll_sem protects the list and is always taken
+ * before the sem of an epoll instance.
+ */
+
+static dq_queue_t g_epoll_heads;
+static sem_t g_epoll_sem = SEM_INITIALIZER(1);
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -112,6 +166,246 @@ static FAR struct epoll_head *epoll_head_from_fd(int fd)
   return (FAR struct epoll_head *)filep->f_inode->i_private;
 }
 
+static FAR struct epoll_node **epoll_hash_slot(FAR struct epoll_head *eph,
+                                               FAR struct file *filep)
+{
+  uintptr_t key = (uintptr_t)filep / sizeof(struct file);
+
+  return &eph->hash[key % (unsigned int)eph->size];
+}
+
+static FAR struct epoll_node *epoll_find(FAR struct epoll_head *eph,
+                                         FAR struct file *filep)
+{
+  FAR struct epoll_node *epn;
+
+  for (epn = *epoll_hash_slot(eph, filep); epn != NULL; epn = epn->hnext)
+    {
+      if (epn->filep == filep)
+        {
+          break;
+        }
+    }
+
+  return epn;
+}
+
+static void epoll_notify(FAR struct pollfd *fds)
+{
+  FAR struct epoll_node *epn = container_of(fds, struct epoll_node, pfd);
+  FAR struct epoll_head *eph = epn->eph;
+  irqstate_t flags;
+
+  /* This may be called from an interrupt handler */
+
+  flags = enter_critical_section();
+  if (!epn->ready)
+    {
+      epn->ready   = true;
+      epn->rdnext  = NULL;
+      *eph->rdtail = epn;
+      eph->rdtail  = &epn->rdnext;
+      nxsem_post(&eph->waitsem);
+    }
+
+  leave_critical_section(flags);
+}
+
+static void epoll_ready_remove(FAR struct epoll_head *eph,
+                               FAR struct epoll_node *epn)
+{
+  FAR struct epoll_node **link;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (epn->ready)
+    {
+      for (link = &eph->ready; *link != NULL; link = &(*link)->rdnext)
+        {
+          if (*link == epn)
+            {
+              *link = epn->rdnext;
+              if (eph->rdtail == &epn->rdnext)
+                {
+                  eph->rdtail = link;
+                }
+
+              break;
+            }
+        }
+
+      epn->ready  = false;
+      epn->rdnext = NULL;
+    }
+
+  leave_critical_section(flags);
+}
+
+static int epoll_arm(FAR struct epoll_head *eph, FAR struct epoll_node *epn)
+{
+  int ret;
+
+  epn->pfd.events  = (pollevent_t)(epn->events & (EPOLLIN | EPOLLPRI |
+                                                  EPOLLOUT)) |
+                     POLLERR | POLLHUP;
+  epn->pfd.revents = 0;
+  epn->pfd.sem     = &eph->waitsem;
+  epn->pfd.priv    = NULL;
+  epn->pfd.cb      = epoll_notify;
+  epn->pfd.arg     = NULL;
+
+  ret = file_poll(epn->filep, &epn->pfd, true);
+  if (ret >= 0)
+    {
+      epn->armed = true;
+    }
+
+  return ret;
+}
+
+static void epoll_disarm(FAR struct epoll_node *epn)
+{
+  if (epn->armed)
+    {
+      file_poll(epn->filep, &epn->pfd, false);
+      epn->armed = false;
+    }
+}
+
+static void epoll_rearm_remove(FAR struct epoll_head *eph,
+                               FAR struct epoll_node *epn)
+{
+  FAR struct epoll_node **link;
+
+  for (link = &eph->rearm; *link != NULL; link = &(*link)->rnext)
+    {
+      if (*link == epn)
+        {
+          *link      = epn->rnext;
+          epn->rnext = NULL;
+          break;
+        }
+    }
+}
+
+static void epoll_remove(FAR struct epoll_head *eph,
+                         FAR struct epoll_node *epn)
+{
+  FAR struct epoll_node **link;
+
+  epoll_disarm(epn);
+  epoll_rearm_remove(eph, epn);
+  epoll_ready_remove(eph, epn);
+
+  for (link = epoll_hash_slot(eph, epn->filep); *link != NULL;
+       link = &(*link)->hnext)
+    {
+      if (*link == epn)
+        {
+          *link = epn->hnext;
+          break;
+        }
+    }
+
+  dq_rem(&epn->node, &eph->used);
+  dq_addlast(&epn->node, &eph->free);
+  eph->occupied--;
+}
+
+static int epoll_collect(FAR struct epoll_head *eph,
+                         FAR struct epoll_event *evs, int maxevents)
+{
+  FAR struct epoll_node *epn;
+  FAR struct epoll_node *next;
+  FAR struct epoll_node *last;
+  FAR struct epoll_node **tail;
+  pollevent_t revents;
+  irqstate_t flags;
+  int i = 0;
+
+  /* Re-arm the level-triggered descriptors reported by the previous wait.
+   * This re-evaluates their state so that they are reported again (through
+   * the ready list) only if they are still ready.
+   */
+
+  for (epn = eph->rearm; epn != NULL; epn = next)
+    {
+      next       = epn->rnext;
+      epn->rnext = NULL;
+
+      epoll_disarm(epn);
+      epoll_arm(eph, epn);
+    }
+
+  eph->rearm = NULL;
+  tail       = &eph->rearm;
+
+  /* Take the descriptors that the drivers have reported */
+
+  flags       = enter_critical_section();
+  epn         = eph->ready;
+  eph->ready  = NULL;
+  eph->rdtail = &eph->ready;
+  leave_critical_section(flags);
+
+  for (; epn != NULL && i < maxevents; epn = next)
+    {
+      flags = enter_critical_section();
+      next             = epn->rdnext;
+      epn->ready       = false;
+      epn->rdnext      = NULL;
+      revents          = epn->pfd.revents;
+      epn->pfd.revents = 0;
+      leave_critical_section(flags);
+
+      if (!epn->armed || revents == 0)
+        {
+          continue;
+        }
+
+      evs[i].data     = epn->data;
+      evs[i++].events = revents;
+
+      if ((epn->events & EPOLLONESHOT) != 0)
+        {
+          /* Disable the descriptor until it is re-enabled by MOD */
+
+          epoll_disarm(epn);
+        }
+      else if ((epn->events & EPOLLET) == 0)
+        {
+          /* Level-triggered: check again on the next wait */
+
+          *tail = epn;
+          tail  = &epn->rnext;
+        }
+    }
+
+  /* If the caller's buffer filled up, put the descriptors that were not
+   * reported back at the head of the ready list so that the next wait
+   * reports them first.
+   */
+
+  if (epn != NULL)
+    {
+      flags = enter_critical_section();
+      for (last = epn; last->rdnext != NULL; last = last->rdnext)
+        {
+        }
+
+      last->rdnext = eph->ready;
+      if (eph->ready == NULL)
+        {
+          eph->rdtail = &last->rdnext;
+        }
+
+      eph->ready = epn;
+      leave_critical_section(flags);
+    }
+
+  return i;
+}
+
 static int epoll_do_open(FAR struct file *filep)
 {
   FAR struct epoll_head *eph = filep->f_inode->i_private;
@@ -131,6 +425,7 @@ static int epoll_do_open(FAR struct file *filep)
 static int epoll_do_close(FAR struct file *filep)
 {
   FAR struct epoll_head *eph = filep->f_inode->i_private;
+  FAR struct epoll_node *epn;
   int ret;
 
   ret = nxsem_wait(&eph->sem);
@@ -143,6 +438,21 @@ static int epoll_do_close(FAR struct file *filep)
   nxsem_post(&eph->sem);
   if (eph->crefs <= 0)
     {
+      /* Keep epoll_fileclose() from finding the instance any more */
+
+      nxsem_wait_uninterruptible(&g_epoll_sem);
+      dq_rem(&eph->node, &g_epoll_heads);
+      nxsem_post(&g_epoll_sem);
+
+      /* Tear down the polls that are still set up on registered files */
+
+      while ((epn = (FAR struct epoll_node *)dq_peek(&eph->used)) != NULL)
+        {
+          epoll_remove(eph, epn);
+        }
+
+      nxsem_destroy(&eph->waitsem);
+      nxsem_destroy(&eph->sem);
       kmm_free(eph);
     }
 
@@ -158,13 +468,20 @@ static int epoll_do_poll(FAR struct file *filep,
 static int epoll_do_create(int size, int flags)
 {
   FAR struct epoll_head *eph;
-  int reserve = size + 1;
+  FAR struct epoll_node *epn;
   int fd;
+  int i;
+
+  if (size <= 0)
+    {
+      set_errno(EINVAL);
+      return -1;
+    }
 
   eph = (FAR struct epoll_head *)
         kmm_zalloc(sizeof(struct epoll_head) +
-                   sizeof(epoll_data_t) * reserve +
-                   sizeof(struct pollfd) * reserve);
+                   sizeof(struct epoll_node) * size +
+                   sizeof(FAR struct epoll_node *) * size);
   if (eph == NULL)
     {
       set_errno(ENOMEM);
@@ -173,29 +490,45 @@ static int epoll_do_create(int size, int flags)
 
   nxsem_init(&eph->sem, 0, 0);
   nxsem_set_protocol(&eph->sem, SEM_PRIO_NONE);
-  eph->size = size;
-  eph->data = (FAR epoll_data_t *)(eph + 1);
-  eph->poll = (FAR struct pollfd *)(eph->data + reserve);
+
+  /* This semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&eph->waitsem, 0, 0);
+  nxsem_set_protocol(&eph->waitsem, SEM_PRIO_NONE);
+
+  eph->size   = size;
+  eph->rdtail = &eph->ready;
+  epn         = (FAR struct epoll_node *)(eph + 1);
+  eph->hash   = (FAR struct epoll_node **)(epn + size);
+
+  for (i = 0; i < size; i++)
+    {
+      dq_addlast(&epn[i].node, &eph->free);
+    }
 
   INODE_SET_DRIVER(&eph->in);
   eph->in.u.i_ops = &g_epoll_ops;
   eph->fp.f_inode = &eph->in;
   eph->in.i_private = eph;
 
-  eph->poll[0].ptr = &eph->fp;
-  eph->poll[0].events = POLLIN | POLLFILE;
-
   /* Alloc the file descriptor */
 
   fd = files_allocate(&eph->in, flags, 0, eph, 0);
   if (fd < 0)
     {
+      nxsem_destroy(&eph->waitsem);
       nxsem_destroy(&eph->sem);
       kmm_free(eph);
       set_errno(-fd);
       return -1;
     }
 
+  nxsem_wait_uninterruptible(&g_epoll_sem);
+  dq_addlast(&eph->node, &g_epoll_heads);
+  nxsem_post(&g_epoll_sem);
+
   nxsem_post(&eph->sem);
   return fd;
 }
@@ -266,7 +599,9 @@ void epoll_close(int epfd)
 int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
 {
   FAR struct epoll_head *eph;
-  int i;
+  FAR struct epoll_node *epn;
+  FAR struct file *filep;
+  int ret;
 
   eph = epoll_head_from_fd(epfd);
   if (eph == NULL)
@@ -274,88 +609,107 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
       return -1;
     }
 
+  ret = fs_getfilep(fd, &filep);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return -1;
+    }
+
+  ret = nxsem_wait(&eph->sem);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return -1;
+    }
+
+  epn = epoll_find(eph, filep);
+
   switch (op)
     {
       case EPOLL_CTL_ADD:
         finfo("%08x CTL ADD(%d): fd=%d ev=%08" PRIx32 "\n",
               epfd, eph->occupied, fd, ev->events);
-        if (eph->occupied >= eph->size)
+        if (epn != NULL)
           {
-            set_errno(ENOMEM);
-            return -1;
+            ret = -EEXIST;
+            break;
           }
 
-        for (i = 1; i <= eph->occupied; i++)
+        epn = (FAR struct epoll_node *)dq_remfirst(&eph->free);
+        if (epn == NULL)
           {
-            if (eph->poll[i].fd == fd)
-              {
-                set_errno(EEXIST);
-                return -1;
-              }
+            ret = -ENOMEM;
+            break;
           }
 
-        eph->data[++eph->occupied]      = ev->data;
-        eph->poll[eph->occupied].events = ev->events | POLLERR | POLLHUP;
-        eph->poll[eph->occupied].fd     = fd;
+        memset(epn, 0, sizeof(struct epoll_node));
+        epn->eph    = eph;
+        epn->events = ev->events;
+        epn->data   = ev->data;
+        epn->filep  = filep;
+        epn->pfd.fd = fd;
 
-        break;
+        /* Set up the poll on the file once.  If the file is already
+         * ready, the driver reports it right away.
+         */
 
-      case EPOLL_CTL_DEL:
-        for (i = 1; i <= eph->occupied; i++)
+        ret = epoll_arm(eph, epn);
+        if (ret < 0)
           {
-            if (eph->poll[i].fd == fd)
-              {
-                if (i != eph->occupied)
-                  {
-                    memmove(&eph->data[i], &eph->data[i + 1],
-                            sizeof(epoll_data_t) * (eph->occupied - i));
-                    memmove(&eph->poll[i], &eph->poll[i + 1],
-                            sizeof(struct pollfd) * (eph->occupied - i));
-                  }
-
-                break;
-              }
+            dq_addlast(&epn->node, &eph->free);
+            break;
           }
 
-        if (i > eph->occupied)
+        epn->hnext = *epoll_hash_slot(eph, filep);
+        *epoll_hash_slot(eph, filep) = epn;
+        dq_addlast(&epn->node, &eph->used);
+        eph->occupied++;
+        break;
+
+      case EPOLL_CTL_DEL:
+        finfo("%08x CTL DEL(%d): fd=%d\n", epfd, eph->occupied, fd);
+        if (epn == NULL)
           {
-            set_errno(ENOENT);
-            return -1;
+            ret = -ENOENT;
+            break;
           }
 
-        eph->occupied--;
+        epoll_remove(eph, epn);
         break;
 
       case EPOLL_CTL_MOD:
         finfo("%08x CTL MOD(%d): fd=%d ev=%08" PRIx32 "\n",
               epfd, eph->occupied, fd, ev->events);
-        for (i = 1; i <= eph->occupied; i++)
+        if (epn == NULL)
           {
-            if (eph->poll[i].fd == fd)
-              {
-                eph->data[i]        = ev->data;
-                eph->poll[i].events = ev->events | POLLERR | POLLHUP;
-                break;
-              }
+            ret = -ENOENT;
+            break;
           }
 
-        if (i > eph->occupied)
-          {
-            set_errno(ENOENT);
-            return -1;
-          }
+        /* Re-arm with the new events (this also re-enables a descriptor
+         * disabled by EPOLLONESHOT).
+         */
 
+        epoll_disarm(epn);
+        epoll_rearm_remove(eph, epn);
+        epoll_ready_remove(eph, epn);
+        epn->events = ev->events;
+        epn->data   = ev->data;
+        ret = epoll_arm(eph, epn);
         break;
 
       default:
-        set_errno(EINVAL);
-        return -1;
+        ret = -EINVAL;
+        break;
     }
 
-  if (eph->poll[0].sem)
+  nxsem_post(&eph->sem);
+
+  if (ret < 0)
     {
-      eph->poll[0].revents |= eph->poll[0].events;
-      nxsem_post(eph->poll[0].sem);
+      set_errno(-ret);
+      return -1;
     }
 
   return 0;
@@ -369,12 +723,10 @@ int epoll_pwait(int epfd, FAR struct epoll_event *evs,
                 int maxevents, int timeout, FAR const sigset_t *sigmask)
 {
   FAR struct epoll_head *eph;
-  struct timespec expire;
-  struct timespec curr;
-  struct timespec diff;
-  int counter;
-  int rc;
-  int i;
+  sigset_t oldsigmask;
+  clock_t start;
+  int ret;
+  int n;
 
   eph = epoll_head_from_fd(epfd);
   if (eph == NULL)
@@ -382,61 +734,72 @@ int epoll_pwait(int epfd, FAR struct epoll_event *evs,
       return -1;
     }
 
-  if (timeout >= 0)
+  if (evs == NULL || maxevents <= 0)
     {
-      expire.tv_sec  = timeout / 1000;
-      expire.tv_nsec = timeout % 1000 * 1000;
-
-      clock_systime_timespec(&curr);
-      clock_timespec_add(&curr, &expire, &expire);
+      set_errno(EINVAL);
+      return -1;
     }
 
-again:
-  if (timeout < 0)
+  if (sigmask != NULL)
     {
-      rc = ppoll(eph->poll, eph->occupied + 1, NULL, sigmask);
+      nxsig_procmask(SIG_SETMASK, sigmask, &oldsigmask);
     }
-  else
-    {
-      clock_systime_timespec(&curr);
-      clock_timespec_subtract(&expire, &curr, &diff);
 
-      rc = ppoll(eph->poll, eph->occupied + 1, &diff, sigmask);
-    }
+  start = clock_systime_ticks();
 
-  if (rc <= 0)
+  for (; ; )
     {
-      return rc;
-    }
-  else if (eph->poll[0].revents != 0)
-    {
-      if (--rc == 0)
+      ret = nxsem_wait(&eph->sem);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      n = epoll_collect(eph, evs, maxevents);
+      nxsem_post(&eph->sem);
+
+      if (n > 0 || timeout == 0)
         {
-          goto again;
+          ret = n;
+          break;
+        }
+
+      /* Nothing is ready: wait for any armed descriptor to report an
+       * event.  The polls themselves stay set up between calls.
+       */
+
+      if (timeout < 0)
+        {
+          ret = nxsem_wait(&eph->waitsem);
+        }
+      else
+        {
+          ret = nxsem_tickwait(&eph->waitsem, start, MSEC2TICK(timeout));
+        }
+
+      if (ret == -ETIMEDOUT)
+        {
+          ret = 0;
+          break;
+        }
+      else if (ret < 0)
+        {
+          break;
         }
     }
 
-  if (rc > maxevents)
+  if (sigmask != NULL)
     {
-      rc = maxevents;
+      nxsig_procmask(SIG_SETMASK, &oldsigmask, NULL);
     }
 
-  /* Iterate over non NULL event fds */
-
-  for (i = 0, counter = 1; i < rc && counter <= eph->occupied; counter++)
+  if (ret < 0)
     {
-      if (eph->poll[counter].revents != 0)
-        {
-          evs[i].data     = eph->data[counter];
-          evs[i++].events = eph->poll[counter].revents;
-          if (eph->poll[counter].events & EPOLLONESHOT)
-            {
-              eph->poll[counter].events = 0; /* Disable oneshot internally */
-            }
-        }
+      set_errno(-ret);
+      return -1;
     }
 
-  return i;
+  return ret;
 }
 
 /****************************************************************************
@@ -455,3 +818,47 @@ int epoll_wait(int epfd, FAR struct epoll_event *evs,
 {
   return epoll_pwait(epfd, evs, maxevents, timeout, NULL);
 }
+
+/****************************************************************************
+ * Name: epoll_fileclose
+ *
+ * Description:
+ *   Remove a file that is about to be closed from every epoll instance it
+ *   is registered with.  The poll on the file is torn down while the
+ *   driver state is still valid.  Called by file_close().
+ *
+ * Input Parameters:
+ *   filep - The file that is closed
+ *
+ ****************************************************************************/
+
+void epoll_fileclose(FAR struct file *filep)
+{
+  FAR struct epoll_head *eph;
+  FAR struct epoll_node *epn;
+
+  /* Most systems never create an epoll instance */
+
+  if (dq_empty(&g_epoll_heads))
+    {
+      return;
+    }
+
+  nxsem_wait_uninterruptible(&g_epoll_sem);
+
+  for (eph = (FAR struct epoll_head *)dq_peek(&g_epoll_heads);
+       eph != NULL;
+       eph = (FAR struct epoll_head *)dq_next(&eph->node))
+    {
+      nxsem_wait_uninterruptible(&eph->sem);
+      epn = epoll_find(eph, filep);
+      if (epn != NULL)
+        {
+          epoll_remove(eph, epn);
+        }
+
+      nxsem_post(&eph->sem);
+    }
+
+  nxsem_post(&g_epoll_sem);
+}
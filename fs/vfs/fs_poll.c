@@ -120,6 +120,8 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds,
       fds[i].sem     = sem;
       fds[i].revents = 0;
       fds[i].priv    = NULL;
+      fds[i].cb      = NULL;
+      fds[i].arg     = NULL;
 
       /* Check for invalid descriptors. "If the value of fd is less than 0,
        * events shall be ignored, and revents shall be set to 0 in that entry
@@ -330,7 +332,7 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
               fds->revents |= (fds->events & (POLLIN | POLLOUT));
               if (fds->revents != 0)
                 {
-                  nxsem_post(fds->sem);
+                  poll_notify(fds);
                 }
             }
 
@@ -340,7 +342,7 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
   else
     {
       fds->revents |= (POLLERR | POLLHUP);
-      nxsem_post(fds->sem);
+      poll_notify(fds);
 
       ret = OK;
     }
@@ -348,6 +350,40 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
   return ret;
 }
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Report the events that a driver has set in fds->revents to the thread
+ *   waiting on the pollfd.  This calls fds->cb if one was provided by the
+ *   owner of the pollfd (for example, epoll) and otherwise posts fds->sem.
+ *   Drivers must use this function rather than posting fds->sem directly.
+ *
+ * Input Parameters:
+ *   fds - The pollfd structure with the reported events
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd *fds)
+{
+  DEBUGASSERT(fds != NULL);
+
+  if (fds->cb != NULL)
+    {
+      fds->cb(fds);
+    }
+  else
+    {
+      poll_semgive(fds->sem);
+    }
+}
+
 /****************************************************************************
  * Name: nx_poll
  *
@@ -31,6 +31,7 @@
 
 #include <debug.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/wdog.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/spinlock.h>
@@ -190,7 +191,7 @@ static void timerfd_pollnotify(FAR struct timerfd_priv_s *dev,
 
           if (fds->revents != 0)
             {
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
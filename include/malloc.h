@@ -50,6 +50,10 @@ struct mallinfo
                  * chunks handed out by malloc. */
   int fordblks; /* This is the total size of memory occupied
                  * by free (not in use) chunks. */
+  int mxmalloc; /* Worst-case time spent in malloc, in units of
+                 * up_perf_gettime().  Zero unless measured. */
+  int mxfree;   /* Worst-case time spent in free, in units of
+                 * up_perf_gettime().  Zero unless measured. */
 };
 
 #ifdef CONFIG_DEBUG_MM
@@ -163,6 +163,12 @@
 
 #  define noinstrument_function __attribute__ ((no_instrument_function))
 
+/* The return_address() macro returns the return address of the current
+ * function (level 0) or of one of its callers.
+ */
+
+#  define return_address(x) __builtin_return_address(x)
+
 /* The nostackprotect_function attribute disables stack protection in
  * sensitive functions, e.g., stack coloration routines.
  */
@@ -451,6 +457,7 @@
 #  define noinline_function
 #  define noinstrument_function
 #  define nostackprotect_function
+#  define return_address(x) 0
 
 #  define unused_code
 #  define unused_data
@@ -593,6 +600,7 @@
 #  define noinline_function
 #  define noinstrument_function
 #  define nostackprotect_function
+#  define return_address(x) 0
 #  define unused_code
 #  define unused_data
 #  define used_code
@@ -706,6 +714,7 @@
 #  define noinline_function
 #  define noinstrument_function
 #  define nostackprotect_function
+#  define return_address(x) 0
 #  define unused_code
 #  define unused_data
 #  define used_code
@@ -774,6 +783,7 @@
 #  define noinline_function
 #  define noinstrument_function
 #  define nostackprotect_function
+#  define return_address(x) 0
 #  define unused_code
 #  define unused_data
 #  define used_code
@@ -1323,6 +1323,28 @@ int nx_fcntl(int fd, int cmd, ...);
 
 int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup);
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Report the events that a driver has set in fds->revents to the thread
+ *   waiting on the pollfd.  This calls fds->cb if one was provided by the
+ *   owner of the pollfd (for example, epoll) and otherwise posts fds->sem.
+ *   Drivers must use this function rather than posting fds->sem directly.
+ *
+ * Input Parameters:
+ *   fds - The pollfd structure with the reported events
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd *fds);
+
 /****************************************************************************
  * Name: nx_poll
  *
@@ -70,10 +70,34 @@
 #  error CONFIG_IOB_NBUFFERS <= CONFIG_IOB_THROTTLE
 #endif
 
+/* The optional pool of large I/O buffers.  CONFIG_IOB_BUFSIZE remains the
+ * minimum payload size of any I/O buffer.
+ */
+
+#ifdef CONFIG_IOB_LARGE
+#  if CONFIG_IOB_LARGE_NBUFFERS < 1
+#    error CONFIG_IOB_LARGE_NBUFFERS is zero
+#  endif
+
+#  if CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#    error CONFIG_IOB_LARGE_BUFSIZE must be larger than CONFIG_IOB_BUFSIZE
+#  endif
+
+#  define IOB_NPOOLS     2
+#else
+#  define IOB_NPOOLS     1
+#endif
+
 /* IOB helpers */
 
+#ifdef CONFIG_IOB_LARGE
+#  define IOB_BUFSIZE(p) ((p)->io_bufsize)
+#else
+#  define IOB_BUFSIZE(p) CONFIG_IOB_BUFSIZE
+#endif
+
 #define IOB_DATA(p)      (&(p)->io_data[(p)->io_offset])
-#define IOB_FREESPACE(p) (CONFIG_IOB_BUFSIZE - (p)->io_len - (p)->io_offset)
+#define IOB_FREESPACE(p) (IOB_BUFSIZE(p) - (p)->io_len - (p)->io_offset)
 
 #if CONFIG_IOB_NCHAINS > 0
 /* Queue helpers */
@@ -99,7 +123,7 @@ struct iob_s
 
   /* Payload */
 
-#if CONFIG_IOB_BUFSIZE < 256
+#if CONFIG_IOB_BUFSIZE < 256 && !defined(CONFIG_IOB_LARGE)
   uint8_t  io_len;      /* Length of the data in the entry */
   uint8_t  io_offset;   /* Data begins at this offset */
 #else
@@ -108,7 +132,16 @@ struct iob_s
 #endif
   unsigned int io_pktlen; /* Total length of the packet */
 
+#ifdef CONFIG_IOB_LARGE
+  /* With more than one pool, the payload size differs between pools and
+   * the payload memory is set up once, when the pool is initialized.
+   */
+
+  uint16_t io_bufsize;  /* Size of io_data[] */
+  FAR uint8_t *io_data;
+#else
   uint8_t  io_data[CONFIG_IOB_BUFSIZE];
+#endif
 };
 
 #if CONFIG_IOB_NCHAINS > 0
@@ -219,6 +252,17 @@ struct iob_userstats_s
   int totalproduced;
 };
 
+/* Usage statistics of one pool of I/O buffers */
+
+struct iob_poolstats_s
+{
+  unsigned int bufsize;   /* Payload size of each I/O buffer */
+  unsigned int nbuffers;  /* Number of I/O buffers in the pool */
+  unsigned int nfree;     /* Number of free I/O buffers */
+  unsigned long nalloc;   /* Number of I/O buffers allocated */
+  unsigned long nfail;    /* Number of failed attempts to allocate */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -272,6 +316,39 @@ FAR struct iob_s *iob_alloc(bool throttled, enum iob_user_e consumerid);
 
 FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid);
 
+/****************************************************************************
+ * Name: iob_alloc_size
+ *
+ * Description:
+ *   Allocate an I/O buffer from the pool that best fits 'size' bytes of
+ *   payload.  A large I/O buffer is used only if one is free; otherwise
+ *   this behaves like iob_alloc().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_LARGE
+FAR struct iob_s *iob_alloc_size(bool throttled, unsigned int size,
+                                 enum iob_user_e consumerid);
+#else
+#  define iob_alloc_size(t,s,c) iob_alloc(t,c)
+#endif
+
+/****************************************************************************
+ * Name: iob_tryalloc_size
+ *
+ * Description:
+ *   Try to allocate an I/O buffer from the pool that best fits 'size'
+ *   bytes of payload without waiting for a buffer to become free.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_LARGE
+FAR struct iob_s *iob_tryalloc_size(bool throttled, unsigned int size,
+                                    enum iob_user_e consumerid);
+#else
+#  define iob_tryalloc_size(t,s,c) iob_tryalloc(t,c)
+#endif
+
 /****************************************************************************
  * Name: iob_navail
  *
@@ -646,5 +723,26 @@ void iob_dump(FAR const char *msg, FAR struct iob_s *iob, unsigned int len,
 FAR struct iob_userstats_s * iob_getuserstats(enum iob_user_e userid);
 #endif
 
+/****************************************************************************
+ * Name: iob_getpoolstats
+ *
+ * Description:
+ *   Return the usage statistics of one pool of I/O buffers
+ *
+ * Input Parameters:
+ *   pool  - The pool index, 0 through IOB_NPOOLS - 1.  Pool 0 holds the
+ *           I/O buffers of CONFIG_IOB_BUFSIZE.
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+void iob_getpoolstats(int pool, FAR struct iob_poolstats_s *stats);
+#endif
+
 #endif /* CONFIG_MM_IOB */
 #endif /* __INCLUDE_NUTTX_MM_IOB_H */
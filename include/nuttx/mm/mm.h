@@ -98,6 +98,18 @@
 
 struct mm_heap_s; /* Forward reference */
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+/* Statistics of the per-CPU caches of one allocation size */
+
+struct mm_cacheinfo_s
+{
+  size_t size;            /* Largest allocation served by these caches */
+  unsigned long hits;     /* Allocations satisfied from the caches */
+  unsigned long misses;   /* Allocations that had to go to the heap */
+  unsigned long cached;   /* Chunks currently held in the caches */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -311,6 +323,13 @@ struct mallinfo_task kmm_mallinfo_task(pid_t pid);
 #  endif
 #endif
 
+/* Functions contained in mm_cache.c ****************************************/
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+int mm_cacheinfo(FAR struct mm_heap_s *heap, int ndx,
+                 FAR struct mm_cacheinfo_s *info);
+#endif
+
 /* Functions contained in mm_memdump.c **************************************/
 
 void mm_memdump(FAR struct mm_heap_s *heap, pid_t pid);
@@ -0,0 +1,189 @@
+/****************************************************************************
+ * include/nuttx/mm/slab.h
+ * Object cache (slab) allocator for fixed-size kernel objects.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_SLAB_H
+#define __INCLUDE_NUTTX_MM_SLAB_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#ifdef CONFIG_MM_SLAB
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* An opaque reference to an object cache */
+
+typedef FAR void *SLAB_HANDLE;
+
+/* An object constructor.  It is called once for each object when a new
+ * slab is added to the cache, not on each allocation.
+ */
+
+typedef CODE void (*slab_ctor_t)(FAR void *obj, FAR void *arg);
+
+/* The callback for slab_foreach() */
+
+typedef CODE void (*slab_handler_t)(SLAB_HANDLE handle, FAR void *arg);
+
+/* Form in which the state of an object cache is returned */
+
+struct slabinfo_s
+{
+  FAR const char *name;   /* The name of the cache */
+  size_t   objsize;       /* The size of one object */
+  uint16_t objsperslab;   /* The number of objects in one slab */
+  uint16_t nslabs;        /* The number of slabs allocated */
+  uint32_t ninuse;        /* The number of objects allocated */
+  uint32_t nalloc;        /* The total number of allocations */
+  uint32_t nfail;         /* The number of failed allocations */
+  uint32_t ngrow;         /* The number of slabs added */
+  uint32_t nreclaim;      /* The number of slabs returned to the heap */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: slab_create
+ *
+ * Description:
+ *   Create a cache of fixed-size objects.  The objects are carved from
+ *   slabs allocated from the kernel heap.  Slabs are added when the cache
+ *   runs out of objects and released again when they are no longer used.
+ *
+ * Input Parameters:
+ *   name     - The name of the cache, shown in /proc/slabinfo.  The string
+ *              is not copied.
+ *   objsize  - The size of one object
+ *   nreserve - The number of objects to allocate immediately.  The slabs
+ *              holding them are never released.  Since slabs are not added
+ *              from interrupt handlers, these are the only objects that
+ *              an interrupt handler can rely on.
+ *   ctor     - An optional constructor called for each new object.  Freed
+ *              objects must be returned in their constructed state.
+ *   arg      - The argument passed to the constructor
+ *
+ * Returned Value:
+ *   On success, a non-NULL handle is returned that may be used with other
+ *   slab interfaces.  NULL is returned if the memory could not be
+ *   allocated.
+ *
+ ****************************************************************************/
+
+SLAB_HANDLE slab_create(FAR const char *name, size_t objsize,
+                        unsigned int nreserve, slab_ctor_t ctor,
+                        FAR void *arg);
+
+/****************************************************************************
+ * Name: slab_destroy
+ *
+ * Description:
+ *   Release an object cache and all of its slabs.  All objects must have
+ *   been freed.
+ *
+ * Input Parameters:
+ *   handle - The handle previously returned by slab_create
+ *
+ ****************************************************************************/
+
+void slab_destroy(SLAB_HANDLE handle);
+
+/****************************************************************************
+ * Name: slab_alloc
+ *
+ * Description:
+ *   Allocate one object from the cache in constant time.  This may be
+ *   called from an interrupt handler, but in that case no slab is added if
+ *   the cache is empty.
+ *
+ * Input Parameters:
+ *   handle - The handle previously returned by slab_create
+ *
+ * Returned Value:
+ *   The allocated object or NULL if no memory is available.
+ *
+ ****************************************************************************/
+
+FAR void *slab_alloc(SLAB_HANDLE handle);
+
+/****************************************************************************
+ * Name: slab_free
+ *
+ * Description:
+ *   Return one object to the cache in constant time.  This may be called
+ *   from an interrupt handler.
+ *
+ * Input Parameters:
+ *   handle - The handle previously returned by slab_create
+ *   obj    - The object previously returned by slab_alloc
+ *
+ ****************************************************************************/
+
+void slab_free(SLAB_HANDLE handle, FAR void *obj);
+
+/****************************************************************************
+ * Name: slab_info
+ *
+ * Description:
+ *   Return information about an object cache.
+ *
+ * Input Parameters:
+ *   handle - The handle previously returned by slab_create
+ *   info   - Memory location to return the cache info.
+ *
+ ****************************************************************************/
+
+void slab_info(SLAB_HANDLE handle, FAR struct slabinfo_s *info);
+
+/****************************************************************************
+ * Name: slab_foreach
+ *
+ * Description:
+ *   Call 'handler' for each object cache in the system.
+ *
+ ****************************************************************************/
+
+void slab_foreach(slab_handler_t handler, FAR void *arg);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_MM_SLAB */
+#endif /* __INCLUDE_NUTTX_MM_SLAB_H */
@@ -29,6 +29,7 @@
 #include <nuttx/compiler.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
 
 #include <sys/types.h>
 #include <stdint.h>
@@ -88,6 +89,7 @@ struct mqueue_inode_s
 {
   FAR struct inode *inode;    /* Containing inode */
   sq_queue_t msglist;         /* Prioritized message list */
+  spinlock_t lock;            /* Protects msglist and nmsgs */
   int16_t maxmsgs;            /* Maximum number of messages in the queue */
   int16_t nmsgs;              /* Number of message in the queue */
   int16_t nwaitnotfull;       /* Number tasks waiting for not full */
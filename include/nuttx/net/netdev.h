@@ -69,6 +69,10 @@
 #  include <nuttx/net/mld.h>
 #endif
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+#  include <nuttx/wqueue.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -93,6 +97,10 @@
 #  define RADIO_MAX_ADDRLEN CONFIG_PKTRADIO_ADDRLEN
 #endif
 
+/* Driver capabilities that may be set in d_features */
+
+#define NETDEV_FEATURE_SG       (1 << 0) /* Can transmit from IOB chains */
+
 /* Helper macros for network device statistics */
 
 #ifdef CONFIG_NETDEV_STATISTICS
@@ -132,9 +140,44 @@
 #  define NETDEV_TXDONE(dev)      _NETDEV_STATISTIC(dev,tx_done)
 #  define NETDEV_TXERRORS(dev)    _NETDEV_ERROR(dev,tx_errors)
 #  define NETDEV_TXTIMEOUTS(dev)  _NETDEV_ERROR(dev,tx_timeouts)
+#  ifdef CONFIG_NETDEV_IOB_SG
+#    define NETDEV_TXSG(dev)      _NETDEV_STATISTIC(dev,tx_sg)
+#    define NETDEV_TXLINEAR(dev)  _NETDEV_STATISTIC(dev,tx_linear)
+#  else
+#    define NETDEV_TXSG(dev)
+#    define NETDEV_TXLINEAR(dev)
+#  endif
 
 #  define NETDEV_ERRORS(dev)      _NETDEV_STATISTIC(dev,errors)
 
+/* The per-queue counters of multi-queue devices also count for the
+ * device as a whole.
+ */
+
+#  ifdef CONFIG_NETDEV_MULTIQUEUE
+#    define _NETDEV_QSTATISTIC(q,name) \
+       do \
+         { \
+           (q)->q_statistics.name++; \
+           _NETDEV_STATISTIC((q)->q_dev,name); \
+         } \
+       while (0)
+#    define _NETDEV_QERROR(q,name) \
+       do \
+         { \
+           (q)->q_statistics.name++; \
+           _NETDEV_ERROR((q)->q_dev,name); \
+         } \
+       while (0)
+
+#    define NETDEV_QRXPACKETS(q)  _NETDEV_QSTATISTIC(q,rx_packets)
+#    define NETDEV_QRXERRORS(q)   _NETDEV_QERROR(q,rx_errors)
+#    define NETDEV_QRXDROPPED(q)  _NETDEV_QSTATISTIC(q,rx_dropped)
+#    define NETDEV_QTXPACKETS(q)  _NETDEV_QSTATISTIC(q,tx_packets)
+#    define NETDEV_QTXDONE(q)     _NETDEV_QSTATISTIC(q,tx_done)
+#    define NETDEV_QTXERRORS(q)   _NETDEV_QERROR(q,tx_errors)
+#  endif
+
 #else
 #  define NETDEV_RESET_STATISTICS(dev)
 #  define NETDEV_RXPACKETS(dev)
@@ -149,8 +192,17 @@
 #  define NETDEV_TXDONE(dev)
 #  define NETDEV_TXERRORS(dev)
 #  define NETDEV_TXTIMEOUTS(dev)
+#  define NETDEV_TXSG(dev)
+#  define NETDEV_TXLINEAR(dev)
 
 #  define NETDEV_ERRORS(dev)
+
+#  define NETDEV_QRXPACKETS(q)
+#  define NETDEV_QRXERRORS(q)
+#  define NETDEV_QRXDROPPED(q)
+#  define NETDEV_QTXPACKETS(q)
+#  define NETDEV_QTXDONE(q)
+#  define NETDEV_QTXERRORS(q)
 #endif
 
 /****************************************************************************
@@ -187,11 +239,56 @@ struct netdev_statistics_s
   uint32_t tx_done;        /* Number of packets completed */
   uint32_t tx_errors;      /* Number of receive errors (incl timeouts) */
   uint32_t tx_timeouts;    /* Number of Tx timeout errors */
+#ifdef CONFIG_NETDEV_IOB_SG
+  uint32_t tx_sg;          /* Number of packets gathered from IOB chains */
+  uint32_t tx_linear;      /* Number of IOB payloads copied to d_buf */
+#endif
 
   /* Other status */
 
   uint32_t errors;         /* Total number of errors */
 };
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+/* The counts of one queue of a multi-queue device */
+
+struct netdev_qstatistics_s
+{
+  uint32_t rx_packets;     /* Number of packets received */
+  uint32_t rx_errors;      /* Number of receive errors */
+  uint32_t rx_dropped;     /* Unsupported Rx packets received */
+  uint32_t tx_packets;     /* Number of Tx packets queued */
+  uint32_t tx_done;        /* Number of packets completed */
+  uint32_t tx_errors;      /* Number of transmit errors */
+};
+#endif
+#endif
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+/* One RX/TX queue pair of a multi-queue device.  The driver provides an
+ * array of these, each with its own packet buffer, in d_queues.  Received
+ * packets are steered to a queue by flow, so the packets of one flow are
+ * always processed in order by the same queue, and each queue is processed
+ * by its own work item.  netdev_register() fills in the fields other than
+ * q_buf.  q_buf and q_len belong to whoever has entered the queue with
+ * netdev_queue_enter().
+ */
+
+struct net_driver_s;      /* Forward reference */
+
+struct netdev_queue_s
+{
+  FAR struct net_driver_s *q_dev; /* The device that owns the queue */
+  FAR uint8_t *q_buf;             /* Packet buffer of the queue */
+  FAR uint8_t *q_devbuf;          /* d_buf of the device, while in d_buf */
+  uint16_t q_len;                 /* Length of the packet in q_buf */
+  uint8_t  q_index;               /* Index of the queue in d_queues */
+  uint8_t  q_cpu;                 /* The CPU that processes the queue */
+  struct work_s q_work;           /* Processes the queue */
+#ifdef CONFIG_NETDEV_STATISTICS
+  struct netdev_qstatistics_s q_statistics;
+#endif
+};
 #endif
 
 #if defined(CONFIG_NET_6LOWPAN) || defined(CONFIG_NET_BLUETOOTH) || \
@@ -221,6 +318,8 @@ struct netdev_varaddr_s
  */
 
 struct devif_callback_s; /* Forward reference */
+struct iob_s;            /* Forward reference */
+struct iovec;            /* Forward reference */
 
 struct net_driver_s
 {
@@ -250,6 +349,7 @@ struct net_driver_s
 
   uint8_t d_lltype;             /* See enum net_lltype_e */
   uint8_t d_llhdrlen;           /* Link layer header size */
+  uint8_t d_features;           /* Driver capabilities, see NETDEV_FEATURE_* */
 #ifdef CONFIG_NETDEV_IFINDEX
   uint8_t d_ifindex;            /* Device index */
 #endif
@@ -344,6 +444,41 @@ struct net_driver_s
 
   uint16_t d_sndlen;
 
+#ifdef CONFIG_NETDEV_IOB_SG
+  /* If the driver sets NETDEV_FEATURE_SG, the application data of an
+   * outgoing packet may be left in the I/O buffer chain that holds it
+   * instead of being copied to d_appdata.  In that case d_iob is non-NULL
+   * and the packet consists of the first d_len - d_ioblen bytes of d_buf,
+   * followed by d_ioblen bytes of d_iob starting at offset d_iobofs.
+   *
+   * d_iob is only valid until the packet has been transmitted.  The driver
+   * must call netdev_iob_release() after sending any packet.
+   */
+
+  FAR struct iob_s *d_iob;      /* I/O buffer chain holding the payload */
+  uint16_t d_iobofs;            /* Offset of the payload in d_iob */
+  uint16_t d_ioblen;            /* Length of the payload in d_iob */
+  int8_t d_iobuser;             /* IOB user owning d_iob, or IOBUSER_UNKNOWN
+                                 * if d_iob is only borrowed */
+  int32_t d_iobsum;             /* Raw checksum of the payload in d_iob if
+                                 * already known, otherwise -1 */
+#endif
+
+#ifdef CONFIG_NET_TCP_GSO
+  /* While TCP connections are polled, d_gsomax is the largest TCP payload
+   * that may be sent as one super-segment.  If the packet in d_buf is such
+   * a super-segment, d_gsosize is the size of the segments that it must be
+   * split into before it is passed to the driver.
+   */
+
+  uint16_t d_gsomax;            /* Maximum payload of a super-segment */
+  uint16_t d_gsosize;           /* Segment size of a super-segment, or 0 */
+#endif
+
+#ifdef CONFIG_NET_TCP_GRO
+  bool d_gro;                   /* d_buf holds TCP segments merged by GRO */
+#endif
+
   /* Multicast group support */
 
 #ifdef CONFIG_NET_IGMP
@@ -362,6 +497,17 @@ struct net_driver_s
   struct netdev_statistics_s d_statistics;
 #endif
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  /* Devices with more than one RX/TX queue pair set d_queues and
+   * d_nqueues before calling netdev_register().  d_queue is the queue whose
+   * packet buffer is in d_buf while the network processes it, or NULL.
+   */
+
+  FAR struct netdev_queue_s *d_queues;
+  FAR struct netdev_queue_s *d_queue;
+  uint8_t d_nqueues;
+#endif
+
   /* Application callbacks:
    *
    * Network device event handlers are retained in a 'list' and are called
@@ -484,6 +630,47 @@ int ipv4_input(FAR struct net_driver_s *dev);
 int ipv6_input(FAR struct net_driver_s *dev);
 #endif
 
+/****************************************************************************
+ * Name: ipv4_gro_input and devif_gro_flush
+ *
+ * Description:
+ *   ipv4_gro_input() may be called instead of ipv4_input() by drivers that
+ *   receive packets in batches.  In-order TCP data segments of the same
+ *   connection are then held back and merged, so that the TCP input logic
+ *   handles them as one segment.  Other packets are passed to ipv4_input()
+ *   as usual, after the held segments.  The callback is the function that
+ *   the driver passes to devif_poll(); it is used to send the response to
+ *   the held segments if the driver's buffer is needed for that.
+ *
+ *   The driver must call devif_gro_flush() after each batch of received
+ *   packets and before the network is unlocked, to pass on the segments
+ *   that are still held:
+ *
+ *     while (packet = devicedriver_receive())
+ *       {
+ *         ipv4_gro_input(dev, driver_callback);
+ *         if (dev->d_len > 0)
+ *           {
+ *             devicedriver_send();
+ *           }
+ *       }
+ *
+ *     devif_gro_flush(dev, driver_callback);
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_GRO
+int ipv4_gro_input(FAR struct net_driver_s *dev,
+                   devif_poll_callback_t callback);
+void devif_gro_flush(FAR struct net_driver_s *dev,
+                     devif_poll_callback_t callback);
+#else
+#  ifdef CONFIG_NET_IPv4
+#    define ipv4_gro_input(dev,callback) ipv4_input(dev)
+#  endif
+#  define devif_gro_flush(dev,callback)
+#endif
+
 #ifdef CONFIG_NET_6LOWPAN
 struct radio_driver_s;   /* Forward reference.  See radiodev.h */
 struct iob_s;            /* Forward reference See iob.h */
@@ -743,4 +930,227 @@ uint16_t ipv4_chksum(FAR struct net_driver_s *dev);
 
 int netdev_lladdrsize(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: netdev_iob_iovec
+ *
+ * Description:
+ *   Describe the outgoing packet as a list of contiguous segments for
+ *   scatter-gather transmission.  The first segment holds the part of the
+ *   packet in d_buf; if d_iob is non-NULL, the following segments hold the
+ *   payload in the I/O buffer chain.  This is only used by drivers that
+ *   set NETDEV_FEATURE_SG.
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure with the packet to send
+ *   iov    - The segment list to fill in
+ *   iovcnt - The number of entries in iov
+ *
+ * Returned Value:
+ *   The number of segments on success; -E2BIG if the packet needs more
+ *   than iovcnt segments.  In that case the driver may call
+ *   netdev_iob_linearize() and send d_buf instead.
+ *
+ * Assumptions:
+ *   Called from the network driver with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_SG
+int netdev_iob_iovec(FAR struct net_driver_s *dev, FAR struct iovec *iov,
+                     int iovcnt);
+#endif
+
+/****************************************************************************
+ * Name: netdev_iob_linearize
+ *
+ * Description:
+ *   If the payload of the outgoing packet is held in d_iob, copy it to
+ *   d_buf behind the headers and release d_iob, so that the whole packet
+ *   is contiguous in d_buf.  This is for drivers that set
+ *   NETDEV_FEATURE_SG but cannot gather a particular packet, and for logic
+ *   that feeds the packet back into the network.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure with the packet to send
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_SG
+void netdev_iob_linearize(FAR struct net_driver_s *dev);
+#else
+#  define netdev_iob_linearize(dev)
+#endif
+
+/****************************************************************************
+ * Name: netdev_iob_release
+ *
+ * Description:
+ *   Detach the I/O buffer chain holding the payload of the outgoing packet
+ *   from the device, freeing it if the device owns it.  Drivers that set
+ *   NETDEV_FEATURE_SG must call this after sending each packet.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_SG
+void netdev_iob_release(FAR struct net_driver_s *dev);
+#else
+#  define netdev_iob_release(dev)
+#endif
+
+/****************************************************************************
+ * Name: netdev_flowhash
+ *
+ * Description:
+ *   Calculate the RSS (Toeplitz) hash of the flow that a received packet
+ *   belongs to from its IP addresses and, for TCP and UDP, its ports.  The
+ *   standard RSS key is used, so the hash matches the one reported by
+ *   hardware that implements RSS with its default key.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure that received the packet
+ *   buf - The packet, starting with the link layer header
+ *   len - The length of the packet
+ *
+ * Returned Value:
+ *   The flow hash, or zero if the packet is not an IP packet.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+uint32_t netdev_flowhash(FAR struct net_driver_s *dev,
+                         FAR const uint8_t *buf, unsigned int len);
+#endif
+
+/****************************************************************************
+ * Name: netdev_queue_rxselect
+ *
+ * Description:
+ *   Select the queue that processes the packets of a flow.
+ *
+ * Input Parameters:
+ *   dev  - The multi-queue device
+ *   hash - The flow hash, from netdev_flowhash() or from the hardware
+ *
+ * Returned Value:
+ *   The queue for the flow.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+FAR struct netdev_queue_s *
+netdev_queue_rxselect(FAR struct net_driver_s *dev, uint32_t hash);
+#endif
+
+/****************************************************************************
+ * Name: netdev_queue_txselect
+ *
+ * Description:
+ *   Select the queue that the calling CPU transmits on, so that CPUs do not
+ *   contend for the TX queues.
+ *
+ * Input Parameters:
+ *   dev - The multi-queue device
+ *
+ * Returned Value:
+ *   The queue for the calling CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+FAR struct netdev_queue_s *
+netdev_queue_txselect(FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: netdev_queue_schedule
+ *
+ * Description:
+ *   Schedule the work item of a queue, usually from the interrupt handler
+ *   of the queue.  Each queue has its own work item, which runs on the low
+ *   priority worker threads of the queue's CPU (q_cpu) if the work queues
+ *   are per-CPU (CONFIG_SCHED_WORKQUEUE_PERCPU).  The queues are then
+ *   serviced in parallel by different CPUs.
+ *
+ * Input Parameters:
+ *   q      - The queue to service
+ *   worker - The driver function that services the queue.  It receives q
+ *            as its argument.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+int netdev_queue_schedule(FAR struct netdev_queue_s *q, worker_t worker);
+#endif
+
+/****************************************************************************
+ * Name: netdev_queue_enter
+ *
+ * Description:
+ *   Lock the network and make the packet buffer of a queue the device's
+ *   d_buf, with d_len set to q_len.  The driver then passes the received
+ *   packet to the network or polls for packets to send on this queue as
+ *   usual; its poll callback finds the queue in d_queue.  Each call must
+ *   be paired with netdev_queue_leave().
+ *
+ *   The RX work and the TX polls of a queue may run at the same time on
+ *   different worker threads, so the packet buffer of the queue belongs
+ *   to whoever has entered the queue.  A received packet is only copied
+ *   into it after netdev_queue_enter().  Only the driver work outside of
+ *   netdev_queue_enter() and netdev_queue_leave(), such as handling the
+ *   descriptor rings and interrupts, runs in parallel with other queues.
+ *
+ *   A typical RX work function:
+ *
+ *     while (<the hardware has a packet for q>)
+ *       {
+ *         netdev_queue_enter(q);
+ *         <copy the packet into dev->d_buf and set dev->d_len>
+ *         NETDEV_QRXPACKETS(q);
+ *         ipv4_input(dev);
+ *         if (dev->d_len > 0)
+ *           {
+ *             <send d_buf on q>
+ *           }
+ *
+ *         netdev_queue_leave(q);
+ *         <return the RX descriptor to the hardware>
+ *       }
+ *
+ * Input Parameters:
+ *   q - The queue to process
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+void netdev_queue_enter(FAR struct netdev_queue_s *q);
+#endif
+
+/****************************************************************************
+ * Name: netdev_queue_leave
+ *
+ * Description:
+ *   Record the length of the packet left in the queue's buffer in q_len,
+ *   restore the device's d_buf and unlock the network.
+ *
+ * Input Parameters:
+ *   q - The queue passed to netdev_queue_enter()
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+void netdev_queue_leave(FAR struct netdev_queue_s *q);
+#endif
+
 #endif /* __INCLUDE_NUTTX_NET_NETDEV_H */
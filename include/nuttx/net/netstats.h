@@ -80,6 +80,19 @@
  * Public Type Definitions
  ****************************************************************************/
 
+/* Network lock statistics.  Each network lock keeps its own statistics,
+ * updated while that lock is held.
+ */
+
+struct netlock_stats_s
+{
+  uint32_t acquired;      /* Number of times the lock was taken */
+  uint32_t contended;     /* Number of times the caller had to wait for the
+                           * lock */
+  uint32_t waitus;        /* Total time spent waiting (microseconds) */
+  uint32_t maxwait;       /* Longest single wait (microseconds) */
+};
+
 /* The structure holding the networking statistics that are gathered if
  * CONFIG_NET_STATISTICS is defined.
  */
@@ -77,10 +77,16 @@
 #define TCP_OPT_NOOP      1   /* "No-operation" TCP option */
 #define TCP_OPT_MSS       2   /* Maximum segment size TCP option */
 #define TCP_OPT_WS        3   /* Window size scaling factor */
+#define TCP_OPT_SACK_PERM 4   /* Selective acknowledgment permitted */
+#define TCP_OPT_SACK      5   /* Selective acknowledgment blocks */
+#define TCP_OPT_TS        8   /* Timestamps */
 
 #define TCP_OPT_NOOP_LEN  1   /* Length of TCP NOOP option. */
 #define TCP_OPT_MSS_LEN   4   /* Length of TCP MSS option. */
 #define TCP_OPT_WS_LEN    3   /* Length of TCP WS option. */
+#define TCP_OPT_SACK_PERM_LEN 2 /* Length of TCP SACK permitted option. */
+#define TCP_OPT_SACK_BLOCK    8 /* Length of one TCP SACK block. */
+#define TCP_OPT_TS_LEN    10  /* Length of TCP timestamps option. */
 
 /* The TCP states used in the struct tcp_conn_s tcpstateflags field */
 
@@ -194,6 +200,10 @@ struct tcp_stats_s
   net_stats_t syndrop;    /* Number of dropped SYNs due to too few
                            * available connections */
   net_stats_t synrst;     /* Number of SYNs for closed ports triggering a RST */
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+  net_stats_t ofoqueued;  /* Number of out-of-order segments retained */
+  net_stats_t ofodrop;    /* Number of out-of-order segments dropped */
+#endif
 };
 #endif
 
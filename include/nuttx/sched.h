@@ -693,6 +693,9 @@ struct tcb_s
   uint32_t crit_max;                     /* Max time in critical section        */
   uint32_t run_start;                    /* Time when thread begin run          */
   uint32_t run_max;                      /* Max time thread run                 */
+#if CONFIG_SCHED_CRITMONITOR_SITES > 0
+  FAR void *crit_caller;                 /* Caller that entered csection        */
+#endif
 #endif
 
   /* State save areas *******************************************************/
@@ -795,6 +798,19 @@ begin_packed_struct struct tcbinfo_s
 
 typedef CODE void (*nxsched_foreach_t)(FAR struct tcb_s *tcb, FAR void *arg);
 
+#if defined(CONFIG_SCHED_CRITMONITOR) && CONFIG_SCHED_CRITMONITOR_SITES > 0
+/* The longest time that the critical section was held after it was
+ * entered from one place in the code.
+ */
+
+struct critmon_site_s
+{
+  FAR void *caller;           /* Caller of enter_critical_section() */
+  uint32_t count;             /* Number of times entered */
+  uint32_t max;               /* Max time in critical section */
+};
+#endif
+
 #endif /* __ASSEMBLY__ */
 
 /****************************************************************************
@@ -816,8 +832,21 @@ extern "C"
 
 EXTERN uint32_t g_premp_max[CONFIG_SMP_NCPUS];
 EXTERN uint32_t g_crit_max[CONFIG_SMP_NCPUS];
+
+#if CONFIG_SCHED_CRITMONITOR_SITES > 0
+/* Maximum time within critical section for each call site. */
+
+EXTERN struct critmon_site_s g_crit_sites[CONFIG_SCHED_CRITMONITOR_SITES];
+#endif
 #endif /* CONFIG_SCHED_CRITMONITOR */
 
+#ifdef CONFIG_SMP_LOAD_BALANCE
+/* Tasks stolen by each CPU and moved off its run queue by load balancing */
+
+EXTERN uint32_t g_cpu_steals[CONFIG_SMP_NCPUS];
+EXTERN uint32_t g_cpu_migrations[CONFIG_SMP_NCPUS];
+#endif /* CONFIG_SMP_LOAD_BALANCE */
+
 #ifdef CONFIG_DEBUG_TCBINFO
 EXTERN const struct tcbinfo_s g_tcbinfo;
 #endif
@@ -31,6 +31,7 @@
 #include <semaphore.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -449,6 +450,36 @@ int nxsem_get_value(FAR sem_t *sem, FAR int *sval);
 
 int nxsem_reset(FAR sem_t *sem, int16_t count);
 
+/****************************************************************************
+ * Name: nxsem_lock and nxsem_unlock
+ *
+ * Description:
+ *   Protect the count of a semaphore.  In the SMP case, the counts are
+ *   protected by a small set of spinlocks rather than by the global
+ *   critical section, so that semaphores can be posted and taken without
+ *   contention when no thread has to be blocked or awakened.  OS logic that
+ *   modifies sem->semcount directly must hold this lock while doing so.
+ *
+ *   This is an internal OS interface, not available to applications.
+ *
+ * Input Parameters:
+ *   sem   - Semaphore descriptor
+ *   flags - The value returned by nxsem_lock()
+ *
+ * Returned Value:
+ *   nxsem_lock() returns the interrupt state to be restored by
+ *   nxsem_unlock().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+irqstate_t nxsem_lock(FAR sem_t *sem);
+void nxsem_unlock(FAR sem_t *sem, irqstate_t flags);
+#else
+#  define nxsem_lock(s)      ((void)(s), up_irq_save())
+#  define nxsem_unlock(s, f) up_irq_restore(f)
+#endif
+
 /****************************************************************************
  * Name: nxsem_get_protocol
  *
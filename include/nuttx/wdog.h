@@ -66,11 +66,18 @@ typedef CODE void (*wdentry_t)(wdparm_t arg);
 struct wdog_s
 {
   FAR struct wdog_s *next;       /* Support for singly linked lists. */
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  FAR struct wdog_s **pprev;     /* Link that points to this watchdog */
+#endif
   wdentry_t          func;       /* Function to execute when delay expires */
 #ifdef CONFIG_PIC
   FAR void          *picbase;    /* PIC base address */
 #endif
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  clock_t            expire;     /* Time when the delay expires */
+#else
   sclock_t           lag;        /* Timer associated with the delay */
+#endif
   wdparm_t           arg;        /* Callback argument */
 };
 
@@ -73,6 +73,10 @@
  * CONFIG_SCHED_LPWORKSTACKSIZE - The stack size allocated for the lower
  *   priority worker thread.  Default: 2048.
  *
+ * CONFIG_SCHED_WORKQUEUE_PERCPU - In the SMP case, give each kernel-mode
+ *   work queue one queue of pending work and one set of worker threads per
+ *   CPU.  The number of threads of a work queue then applies to each CPU.
+ *
  * The user-mode work queue is only available in the protected or kernel
  * builds.  This those configurations, the user-mode work queue provides the
  * same (non-standard) facility for use by applications.
@@ -238,6 +242,10 @@
 
 typedef CODE void (*worker_t)(FAR void *arg);
 
+/* The kernel-mode work queue is opaque to its users */
+
+struct kwork_wqueue_s;
+
 /* Defines one entry in the work queue.  The user only needs this structure
  * in order to declare instances of the work structure.  Handling of all
  * fields is performed by the work APIs
@@ -256,6 +264,14 @@ struct work_s
   } u;
   worker_t  worker;         /* Work callback */
   FAR void *arg;            /* Callback argument */
+#ifdef CONFIG_SCHED_WORKQUEUE
+  /* The kernel-mode work queue that the work was last queued on.  It is
+   * set by work_queue_wq() and tells the timer expiry of delayed work
+   * where to queue the work.  User-mode work queues do not use it.
+   */
+
+  FAR struct kwork_wqueue_s *wq;
+#endif
 };
 
 /* This is an enumeration of the various events that may be
@@ -359,6 +375,32 @@ int work_usrstart(void);
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, clock_t delay);
 
+/****************************************************************************
+ * Name: work_queue_cpu
+ *
+ * Description:
+ *   Queue kernel-mode work to be performed immediately by the worker
+ *   threads of one CPU.  With CONFIG_SCHED_WORKQUEUE_PERCPU, the work is
+ *   always added to the queue of that CPU.  Otherwise, this is the same as
+ *   work_queue() with no delay.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked
+ *   arg    - The argument that will be passed to the worker callback
+ *   cpu    - The CPU whose worker threads perform the work
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+int work_queue_cpu(int qid, FAR struct work_s *work, worker_t worker,
+                   FAR void *arg, int cpu);
+#endif
+
 /****************************************************************************
  * Name: work_cancel
  *
@@ -381,6 +423,103 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
 
 int work_cancel(int qid, FAR struct work_s *work);
 
+/****************************************************************************
+ * Name: work_queue_create
+ *
+ * Description:
+ *   Create a new kernel-mode work queue with its own pool of worker
+ *   threads.  This lets drivers with heavy deferred work run it at a
+ *   priority of their choice without delaying the work of others on the
+ *   shared HPWORK and LPWORK queues.
+ *
+ * Input Parameters:
+ *   name       - Name of the worker threads
+ *   priority   - Priority of the worker threads
+ *   stack_size - Stack size of each worker thread
+ *   nthreads   - Number of worker threads (per CPU if
+ *                CONFIG_SCHED_WORKQUEUE_PERCPU is selected)
+ *
+ * Returned Value:
+ *   The new work queue on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+FAR struct kwork_wqueue_s *work_queue_create(FAR const char *name,
+                                             int priority, int stack_size,
+                                             int nthreads);
+#endif
+
+/****************************************************************************
+ * Name: work_queue_free
+ *
+ * Description:
+ *   Stop the worker threads of a work queue created by work_queue_create()
+ *   and free the work queue.  Work that is still queued is not performed.
+ *   The caller must make sure that no more work is queued.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue to free
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+int work_queue_free(FAR struct kwork_wqueue_s *wqueue);
+#endif
+
+/****************************************************************************
+ * Name: work_queue_wq
+ *
+ * Description:
+ *   Queue work to be performed on a kernel-mode work queue.  This is the
+ *   same as work_queue() but takes the work queue itself instead of its
+ *   ID.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked
+ *   arg    - The argument that will be passed to the worker callback
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+int work_queue_wq(FAR struct kwork_wqueue_s *wqueue,
+                  FAR struct work_s *work, worker_t worker,
+                  FAR void *arg, clock_t delay);
+#endif
+
+/****************************************************************************
+ * Name: work_cancel_wq
+ *
+ * Description:
+ *   Cancel work previously queued with work_queue_wq().
+ *
+ * Input Parameters:
+ *   wqueue - The work queue
+ *   work   - The previously queued work structure to cancel
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ *   -ENOENT - There is no such work queued.
+ *   -EINVAL - An invalid work queue was specified
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+int work_cancel_wq(FAR struct kwork_wqueue_s *wqueue,
+                   FAR struct work_s *work);
+#endif
+
 /****************************************************************************
  * Name: work_available
  *
@@ -97,6 +97,13 @@ typedef unsigned int nfds_t;
 
 typedef uint8_t pollevent_t;
 
+/* The type of the function called by poll_notify() when events are
+ * reported on a pollfd.
+ */
+
+struct pollfd;
+typedef CODE void (*pollcb_t)(FAR struct pollfd *fds);
+
 /* This is the NuttX variant of the standard pollfd structure.  The poll()
  * interfaces receive a variable length array of such structures.
  *
@@ -119,6 +126,8 @@ struct pollfd
   FAR void    *ptr;     /* The psock or file being polled */
   FAR sem_t   *sem;     /* Pointer to semaphore used to post output event */
   FAR void    *priv;    /* For use by drivers */
+  pollcb_t     cb;      /* If non-NULL, called instead of posting sem */
+  FAR void    *arg;     /* For use by cb */
 };
 
 /****************************************************************************
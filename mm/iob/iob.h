@@ -30,6 +30,7 @@
 #include <debug.h>
 
 #include <nuttx/mm/iob.h>
+#include <nuttx/mm/slab.h>
 #include <nuttx/semaphore.h>
 
 #ifdef CONFIG_MM_IOB
@@ -48,6 +49,19 @@
 #  define iobinfo                _none
 #endif /* CONFIG_DEBUG_FEATURES && CONFIG_IOB_DEBUG */
 
+/* Indices of the pools of I/O buffers */
+
+#define IOB_POOL_SMALL           0  /* CONFIG_IOB_BUFSIZE */
+#define IOB_POOL_LARGE           1  /* CONFIG_IOB_LARGE_BUFSIZE */
+
+#ifdef CONFIG_IOB_LARGE
+/* Is this I/O buffer in the pool of large I/O buffers? */
+
+#  define IOB_ISLARGE(p) \
+     ((p) >= g_iob_large_pool && \
+      (p) < &g_iob_large_pool[CONFIG_IOB_LARGE_NBUFFERS])
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -68,6 +82,31 @@ extern FAR struct iob_qentry_s *g_iob_freeqlist;
 /* A list of I/O buffer queue containers that are committed for allocation */
 
 extern FAR struct iob_qentry_s *g_iob_qcommitted;
+
+#ifdef CONFIG_MM_SLAB
+/* The pre-allocated I/O buffer queue containers */
+
+extern struct iob_qentry_s g_iob_qpool[CONFIG_IOB_NCHAINS];
+
+/* The slab cache of additional queue containers, used when the
+ * pre-allocated containers are exhausted.
+ */
+
+extern SLAB_HANDLE g_iob_qslab;
+#endif
+#endif
+
+#ifdef CONFIG_IOB_LARGE
+/* The pre-allocated large I/O buffers */
+
+extern struct iob_s g_iob_large_pool[CONFIG_IOB_LARGE_NBUFFERS];
+
+/* A list of all free, unallocated large I/O buffers and their number.
+ * Nothing ever waits for a large I/O buffer so no semaphore is needed.
+ */
+
+extern FAR struct iob_s *g_iob_large_freelist;
+extern int g_iob_large_navail;
 #endif
 
 /* Counting semaphores that tracks the number of free IOBs/qentries */
@@ -183,5 +222,27 @@ void iob_stats_onalloc(enum iob_user_e consumerid);
 void iob_stats_onfree(enum iob_user_e producerid);
 #endif
 
+/****************************************************************************
+ * Name: iob_stats_onpool
+ *
+ * Description:
+ *   An attempt to allocate an IOB from a pool has just succeeded or failed.
+ *   This is a hook for the per-pool statistics to be updated when
+ *   /proc/iobinfo is enabled.
+ *
+ * Input Parameters:
+ *   pool    - IOB_POOL_SMALL or IOB_POOL_LARGE
+ *   success - True if an IOB was allocated
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+void iob_stats_onpool(int pool, bool success);
+#endif
+
 #endif /* CONFIG_MM_IOB */
 #endif /* __MM_IOB_IOB_H */
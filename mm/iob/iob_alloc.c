@@ -29,6 +29,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/sched.h>
 #include <nuttx/mm/iob.h>
 
@@ -77,6 +78,7 @@ static FAR struct iob_s *iob_alloc_committed(enum iob_user_e consumerid)
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
       iob_stats_onalloc(consumerid);
+      iob_stats_onpool(IOB_POOL_SMALL, true);
 #endif
     }
 
@@ -178,14 +180,11 @@ static FAR struct iob_s *iob_allocwait(bool throttled, unsigned int timeout,
 #if CONFIG_IOB_THROTTLE > 0
           else
             {
-              if (throttled)
-                {
-                  g_iob_sem.semcount--;
-                }
-              else
-                {
-                  g_throttle_sem.semcount--;
-                }
+              FAR sem_t *other = throttled ? &g_iob_sem : &g_throttle_sem;
+              irqstate_t lflags = nxsem_lock(other);
+
+              other->semcount--;
+              nxsem_unlock(other, lflags);
             }
 #endif
         }
@@ -257,6 +256,7 @@ FAR struct iob_s *iob_alloc(bool throttled, enum iob_user_e consumerid)
 FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
 {
   FAR struct iob_s *iob;
+  irqstate_t lflags;
   irqstate_t flags;
 #if CONFIG_IOB_THROTTLE > 0
   FAR sem_t *sem;
@@ -300,8 +300,10 @@ FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
            * so a simple decrement is all that is needed.
            */
 
+          lflags = nxsem_lock(&g_iob_sem);
           g_iob_sem.semcount--;
           DEBUGASSERT(g_iob_sem.semcount >= 0);
+          nxsem_unlock(&g_iob_sem, lflags);
 
 #if CONFIG_IOB_THROTTLE > 0
           /* The throttle semaphore is a little more complicated because
@@ -311,12 +313,15 @@ FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
            * But it can be smaller than that if there are blocking threads.
            */
 
+          lflags = nxsem_lock(&g_throttle_sem);
           g_throttle_sem.semcount--;
+          nxsem_unlock(&g_throttle_sem, lflags);
 #endif
 
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
           iob_stats_onalloc(consumerid);
+          iob_stats_onpool(IOB_POOL_SMALL, true);
 #endif
 
           leave_critical_section(flags);
@@ -331,6 +336,11 @@ FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
         }
     }
 
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  iob_stats_onpool(IOB_POOL_SMALL, false);
+#endif
+
   leave_critical_section(flags);
   return NULL;
 }
@@ -29,6 +29,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
 
 #include "iob.h"
@@ -193,6 +194,7 @@ FAR struct iob_qentry_s *iob_alloc_qentry(void)
 FAR struct iob_qentry_s *iob_tryalloc_qentry(void)
 {
   FAR struct iob_qentry_s *iobq;
+  irqstate_t lflags;
   irqstate_t flags;
 
   /* We don't know what context we are called from so we use extreme measures
@@ -217,8 +219,10 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void)
        * so a simple decrement is all that is needed.
        */
 
+      lflags = nxsem_lock(&g_qentry_sem);
       g_qentry_sem.semcount--;
       DEBUGASSERT(g_qentry_sem.semcount >= 0);
+      nxsem_unlock(&g_qentry_sem, lflags);
 
       /* Put the I/O buffer in a known state */
 
@@ -226,6 +230,23 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void)
     }
 
   leave_critical_section(flags);
+
+#ifdef CONFIG_MM_SLAB
+  /* The pre-allocated containers are exhausted.  Unless we were called
+   * from an interrupt handler, take a container from the slab cache
+   * instead.  These containers are not counted by g_qentry_sem.
+   */
+
+  if (iobq == NULL && !up_interrupt_context())
+    {
+      iobq = (FAR struct iob_qentry_s *)slab_alloc(g_iob_qslab);
+      if (iobq != NULL)
+        {
+          iobq->qe_head = NULL; /* Nothing is contained */
+        }
+    }
+#endif
+
   return iobq;
 }
 
@@ -0,0 +1,153 @@
+/****************************************************************************
+ * mm/iob/iob_alloc_size.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef CONFIG_IOB_LARGE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_tryalloc_large
+ *
+ * Description:
+ *   Try to allocate a large I/O buffer by taking the buffer at the head of
+ *   the free list of large I/O buffers.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *iob_tryalloc_large(enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  /* We don't know what context we are called from so we use extreme measures
+   * to protect the free list:  We disable interrupts very briefly.
+   */
+
+  flags = enter_critical_section();
+
+  iob = g_iob_large_freelist;
+  if (iob != NULL)
+    {
+      g_iob_large_freelist = iob->io_flink;
+      g_iob_large_navail--;
+      DEBUGASSERT(g_iob_large_navail >= 0);
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+      iob_stats_onalloc(consumerid);
+#endif
+    }
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  iob_stats_onpool(IOB_POOL_LARGE, iob != NULL);
+#endif
+
+  leave_critical_section(flags);
+
+  if (iob != NULL)
+    {
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+    }
+
+  return iob;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_alloc_size
+ *
+ * Description:
+ *   Allocate an I/O buffer from the pool that best fits 'size' bytes of
+ *   payload.  A large I/O buffer is used only if one is free; otherwise
+ *   this behaves like iob_alloc().
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_size(bool throttled, unsigned int size,
+                                 enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob = NULL;
+
+  if (size > CONFIG_IOB_BUFSIZE)
+    {
+      iob = iob_tryalloc_large(consumerid);
+    }
+
+  if (iob == NULL)
+    {
+      iob = iob_alloc(throttled, consumerid);
+    }
+
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_size
+ *
+ * Description:
+ *   Try to allocate an I/O buffer from the pool that best fits 'size'
+ *   bytes of payload without waiting for a buffer to become free.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_size(bool throttled, unsigned int size,
+                                    enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob = NULL;
+
+  if (size > CONFIG_IOB_BUFSIZE)
+    {
+      iob = iob_tryalloc_large(consumerid);
+    }
+
+  if (iob == NULL)
+    {
+      iob = iob_tryalloc(throttled, consumerid);
+    }
+
+  return iob;
+}
+
+#endif /* CONFIG_IOB_LARGE */
@@ -121,6 +121,28 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
 
   flags = enter_critical_section();
 
+#ifdef CONFIG_IOB_LARGE
+  /* Large I/O buffers go back to their own free list.  Nothing waits for
+   * them, so there is nothing to signal.
+   */
+
+  if (IOB_ISLARGE(iob))
+    {
+      iob->io_flink        = g_iob_large_freelist;
+      g_iob_large_freelist = iob;
+      g_iob_large_navail++;
+      DEBUGASSERT(g_iob_large_navail <= CONFIG_IOB_LARGE_NBUFFERS);
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+      iob_stats_onfree(producerid);
+#endif
+
+      leave_critical_section(flags);
+      return next;
+    }
+#endif
+
   /* Which list?  If there is a task waiting for an IOB, then put
    * the IOB on either the free list or on the committed list where
    * it is reserved for that allocation (and not available to
@@ -52,6 +52,18 @@ FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq)
   FAR struct iob_qentry_s *nextq = iobq->qe_flink;
   irqstate_t flags;
 
+#ifdef CONFIG_MM_SLAB
+  /* Containers that did not come from the pre-allocated pool were taken
+   * from the slab cache.  Return them there; nobody waits for them.
+   */
+
+  if (iobq < &g_iob_qpool[0] || iobq >= &g_iob_qpool[CONFIG_IOB_NCHAINS])
+    {
+      slab_free(g_iob_qslab, iobq);
+      return nextq;
+    }
+#endif
+
   /* Free the I/O buffer chain container by adding it to the head of the
    * free or the committed list. We don't know what context we are called
    * from so we use extreme measures to protect the free list:  We disable
@@ -24,7 +24,9 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <stdbool.h>
+#include <assert.h>
 
 #include <nuttx/mm/iob.h>
 
@@ -38,6 +40,14 @@
 #  define NULL ((FAR void *)0)
 #endif
 
+/* The payload memory of each I/O buffer is kept aligned like the payload
+ * embedded in struct iob_s would be.
+ */
+
+#ifdef CONFIG_IOB_LARGE
+#  define IOB_NWORDS(s) (((s) + sizeof(uintptr_t) - 1) / sizeof(uintptr_t))
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -45,7 +55,13 @@
 /* This is a pool of pre-allocated I/O buffers */
 
 static struct iob_s        g_iob_pool[CONFIG_IOB_NBUFFERS];
-#if CONFIG_IOB_NCHAINS > 0
+#ifdef CONFIG_IOB_LARGE
+static uintptr_t g_iob_buffer[CONFIG_IOB_NBUFFERS]
+                             [IOB_NWORDS(CONFIG_IOB_BUFSIZE)];
+static uintptr_t g_iob_large_buffer[CONFIG_IOB_LARGE_NBUFFERS]
+                                   [IOB_NWORDS(CONFIG_IOB_LARGE_BUFSIZE)];
+#endif
+#if CONFIG_IOB_NCHAINS > 0 && !defined(CONFIG_MM_SLAB)
 static struct iob_qentry_s g_iob_qpool[CONFIG_IOB_NCHAINS];
 #endif
 
@@ -69,6 +85,29 @@ FAR struct iob_qentry_s *g_iob_freeqlist;
 /* A list of I/O buffer queue containers that are committed for allocation */
 
 FAR struct iob_qentry_s *g_iob_qcommitted;
+
+#ifdef CONFIG_MM_SLAB
+/* The pre-allocated I/O buffer queue containers.  These are the containers
+ * that are managed by g_qentry_sem.
+ */
+
+struct iob_qentry_s g_iob_qpool[CONFIG_IOB_NCHAINS];
+
+/* The slab cache of additional queue containers */
+
+SLAB_HANDLE g_iob_qslab;
+#endif
+#endif
+
+#ifdef CONFIG_IOB_LARGE
+/* The pre-allocated large I/O buffers */
+
+struct iob_s g_iob_large_pool[CONFIG_IOB_LARGE_NBUFFERS];
+
+/* A list of all free, unallocated large I/O buffers and their number */
+
+FAR struct iob_s *g_iob_large_freelist;
+int g_iob_large_navail;
 #endif
 
 /* Counting semaphores that tracks the number of free IOBs/qentries */
@@ -110,12 +149,35 @@ void iob_initialize(void)
     {
       FAR struct iob_s *iob = &g_iob_pool[i];
 
+#ifdef CONFIG_IOB_LARGE
+      /* Attach the payload memory */
+
+      iob->io_data    = (FAR uint8_t *)g_iob_buffer[i];
+      iob->io_bufsize = CONFIG_IOB_BUFSIZE;
+#endif
+
       /* Add the pre-allocate I/O buffer to the head of the free list */
 
       iob->io_flink  = g_iob_freelist;
       g_iob_freelist = iob;
     }
 
+#ifdef CONFIG_IOB_LARGE
+  /* Add each large I/O buffer to the free list of large I/O buffers */
+
+  for (i = 0; i < CONFIG_IOB_LARGE_NBUFFERS; i++)
+    {
+      FAR struct iob_s *iob = &g_iob_large_pool[i];
+
+      iob->io_data         = (FAR uint8_t *)g_iob_large_buffer[i];
+      iob->io_bufsize      = CONFIG_IOB_LARGE_BUFSIZE;
+      iob->io_flink        = g_iob_large_freelist;
+      g_iob_large_freelist = iob;
+    }
+
+  g_iob_large_navail = CONFIG_IOB_LARGE_NBUFFERS;
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
       /* Add each I/O buffer chain queue container to the free list */
 
@@ -130,5 +192,13 @@ void iob_initialize(void)
       iobq->qe_flink  = g_iob_freeqlist;
       g_iob_freeqlist = iobq;
     }
+
+#ifdef CONFIG_MM_SLAB
+  /* Create the cache of additional containers.  It starts empty. */
+
+  g_iob_qslab = slab_create("iob_qentry", sizeof(struct iob_qentry_s), 0,
+                            NULL, NULL);
+  DEBUGASSERT(g_iob_qslab != NULL);
+#endif
 #endif
 }
@@ -32,6 +32,8 @@
 
 #include <nuttx/mm/iob.h>
 
+#include "iob.h"
+
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
 
@@ -41,6 +43,11 @@
 
 struct iob_userstats_s g_iobuserstats[IOBUSER_NENTRIES];
 
+/* Allocation counts of each pool of I/O buffers */
+
+static unsigned long g_iobpoolalloc[IOB_NPOOLS];
+static unsigned long g_iobpoolfail[IOB_NPOOLS];
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -116,5 +123,75 @@ FAR struct iob_userstats_s * iob_getuserstats(enum iob_user_e userid)
   return &g_iobuserstats[userid];
 }
 
+/****************************************************************************
+ * Name: iob_stats_onpool
+ *
+ * Description:
+ *   An attempt to allocate an IOB from a pool has just succeeded or failed.
+ *   This is a hook for the per-pool statistics to be updated when
+ *   /proc/iobinfo is enabled.
+ *
+ * Input Parameters:
+ *   pool    - IOB_POOL_SMALL or IOB_POOL_LARGE
+ *   success - True if an IOB was allocated
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void iob_stats_onpool(int pool, bool success)
+{
+  DEBUGASSERT(pool >= 0 && pool < IOB_NPOOLS);
+
+  if (success)
+    {
+      g_iobpoolalloc[pool]++;
+    }
+  else
+    {
+      g_iobpoolfail[pool]++;
+    }
+}
+
+/****************************************************************************
+ * Name: iob_getpoolstats
+ *
+ * Description:
+ *   Return the usage statistics of one pool of I/O buffers
+ *
+ * Input Parameters:
+ *   pool  - The pool index, 0 through IOB_NPOOLS - 1.  Pool 0 holds the
+ *           I/O buffers of CONFIG_IOB_BUFSIZE.
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void iob_getpoolstats(int pool, FAR struct iob_poolstats_s *stats)
+{
+  DEBUGASSERT(pool >= 0 && pool < IOB_NPOOLS && stats != NULL);
+
+#ifdef CONFIG_IOB_LARGE
+  if (pool == IOB_POOL_LARGE)
+    {
+      stats->bufsize  = CONFIG_IOB_LARGE_BUFSIZE;
+      stats->nbuffers = CONFIG_IOB_LARGE_NBUFFERS;
+      stats->nfree    = g_iob_large_navail;
+    }
+  else
+#endif
+    {
+      stats->bufsize  = CONFIG_IOB_BUFSIZE;
+      stats->nbuffers = CONFIG_IOB_NBUFFERS;
+      stats->nfree    = iob_navail(false);
+    }
+
+  stats->nalloc = g_iobpoolalloc[pool];
+  stats->nfail  = g_iobpoolfail[pool];
+}
+
 #endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
         * !CONFIG_FS_PROCFS_EXCLUDE_IOBINFO */
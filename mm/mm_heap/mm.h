@@ -28,6 +28,7 @@
 #include <nuttx/config.h>
 
 #include <nuttx/fs/procfs.h>
+#include <nuttx/spinlock.h>
 
 #include <assert.h>
 #include <execinfo.h>
@@ -111,7 +112,27 @@
 
 #define MM_MIN_CHUNK     (1 << MM_MIN_SHIFT)
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
-#define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
+
+#ifdef CONFIG_MM_TLSF_MANAGER
+/* Two-level segregated fit index:
+ *
+ * MM_SL_SHIFT is the log2 of the number of second level lists that each
+ *   first level (power of two) range is divided into.
+ * MM_FL_SHIFT is the log2 of the smallest chunk size that is mapped by
+ *   its most significant bit.  All smaller chunks share first level list
+ *   zero and are divided linearly in MM_MIN_CHUNK steps.
+ * MM_FL_COUNT is the number of first level lists.  Chunks that are
+ *   MM_MAX_CHUNK or larger all go into the very last list.
+ */
+
+#  define MM_SL_SHIFT    3
+#  define MM_SL_COUNT    (1 << MM_SL_SHIFT)
+#  define MM_FL_SHIFT    (MM_MIN_SHIFT + MM_SL_SHIFT)
+#  define MM_FL_COUNT    (MM_MAX_SHIFT - MM_FL_SHIFT + 1)
+#  define MM_NNODES      (MM_FL_COUNT * MM_SL_COUNT)
+#else
+#  define MM_NNODES      (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
+#endif
 
 #define MM_GRAN_MASK     (MM_MIN_CHUNK - 1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
@@ -140,6 +161,29 @@
 
 #define SIZEOF_MM_FREENODE sizeof(struct mm_freenode_s)
 
+/* Per-CPU caches.  These are only usable where interrupts can be disabled,
+ * i.e. not in the user-space heap of the protected build.
+ *
+ * MM_CACHE_MAXCHUNK is the largest cached chunk size, including the
+ *   allocated node header.
+ * MM_CACHE_NCLASSES is the number of cached sizes (one per MM_MIN_CHUNK).
+ * MM_CACHE_NDX maps a chunk size to its cache.  A chunk may be a little
+ *   larger than its size class if it was not worth splitting.
+ * MM_CACHE_BATCH is the number of chunks moved between a cache and the
+ *   heap at a time.
+ */
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+#  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+#    define MM_PERCPU_CACHE 1
+#  endif
+#  define MM_CACHE_MAXCHUNK \
+     MM_ALIGN_UP(CONFIG_MM_PERCPU_CACHE_MAXSIZE + SIZEOF_MM_ALLOCNODE)
+#  define MM_CACHE_NCLASSES (MM_CACHE_MAXCHUNK >> MM_MIN_SHIFT)
+#  define MM_CACHE_BATCH    (CONFIG_MM_PERCPU_CACHE_DEPTH / 2)
+#  define MM_CACHE_NDX(s)   (((s) >> MM_MIN_SHIFT) - 1)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -192,6 +236,27 @@ struct mm_delaynode_s
   FAR struct mm_delaynode_s *flink;
 };
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+/* A cached chunk is still marked as allocated; the cache links it through
+ * the start of its user memory.
+ */
+
+struct mm_cachenode_s
+{
+  FAR struct mm_cachenode_s *flink;
+};
+
+/* This describes the cache of one chunk size on one CPU */
+
+struct mm_cacheclass_s
+{
+  FAR struct mm_cachenode_s *head;         /* Cached chunks */
+  uint16_t count;                          /* Number of cached chunks */
+  uint32_t hits;                           /* Allocations from the cache */
+  uint32_t misses;                         /* Allocations from the heap */
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -222,12 +287,41 @@ struct mm_heap_s
 
   struct mm_freenode_s mm_nodelist[MM_NNODES];
 
+#ifdef CONFIG_MM_TLSF_MANAGER
+  /* Bitmaps of the non-empty free lists:  Bit n of mm_flbitmap is set
+   * if any list in mm_slbitmap[n] is non-empty.  Bit m of mm_slbitmap[n]
+   * is set if mm_nodelist[n * MM_SL_COUNT + m] is non-empty.
+   */
+
+  uint32_t mm_flbitmap;
+  uint8_t mm_slbitmap[MM_FL_COUNT];
+#endif
+
+#ifdef CONFIG_MM_HEAP_TIMING
+  /* Worst-case time spent in mm_malloc() and mm_free() */
+
+  uint32_t mm_maxmalloc;
+  uint32_t mm_maxfree;
+#endif
+
   /* Free delay list, for some situations where we can't do free
    * immdiately.
    */
 
   FAR struct mm_delaynode_s *mm_delaylist[CONFIG_SMP_NCPUS];
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+  /* Per-CPU caches of small chunks, indexed by CPU and chunk size */
+
+  struct mm_cacheclass_s mm_cache[CONFIG_SMP_NCPUS][MM_CACHE_NCLASSES];
+
+  /* Protects the caches of each CPU.  A CPU normally only takes its own
+   * lock; mm_cache_drain() takes the locks of all CPUs.
+   */
+
+  spinlock_t mm_cachelock[CONFIG_SMP_NCPUS];
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
   struct procfs_meminfo_entry_s mm_procfs;
 #endif
@@ -258,6 +352,30 @@ void mm_shrinkchunk(FAR struct mm_heap_s *heap,
 void mm_addfreechunk(FAR struct mm_heap_s *heap,
                      FAR struct mm_freenode_s *node);
 
+/* Functions contained in mm_delfreechunk.c *********************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node);
+
+/* Functions contained in mm_findfreechunk.c ********************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size);
+
+/* Functions contained in mm_cache.c ****************************************/
+
+#ifdef MM_PERCPU_CACHE
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t size);
+bool mm_cache_fill(FAR struct mm_heap_s *heap, FAR void *mem);
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem,
+                   FAR struct mm_cachenode_s **flush);
+FAR struct mm_cachenode_s *mm_cache_drain(FAR struct mm_heap_s *heap);
+#endif
+
+/* Functions contained in mm_free.c ****************************************/
+
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem);
+
 /* Functions contained in mm_size2ndx.c *************************************/
 
 int mm_size2ndx(size_t size);
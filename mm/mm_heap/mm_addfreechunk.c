@@ -57,12 +57,24 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap,
 
   ndx = mm_size2ndx(node->size);
 
+#ifdef CONFIG_MM_TLSF_MANAGER
+  /* The lists are not ordered:  Just put the new node at the head of its
+   * list and mark the list as non-empty.
+   */
+
+  prev = &heap->mm_nodelist[ndx];
+  next = prev->flink;
+
+  heap->mm_flbitmap |= 1 << (ndx >> MM_SL_SHIFT);
+  heap->mm_slbitmap[ndx >> MM_SL_SHIFT] |= 1 << (ndx & (MM_SL_COUNT - 1));
+#else
   /* Now put the new node into the next */
 
   for (prev = &heap->mm_nodelist[ndx],
        next = heap->mm_nodelist[ndx].flink;
        next && next->size && next->size < node->size;
        prev = next, next = next->flink);
+#endif
 
   /* Does it go in mid next or at the end? */
 
@@ -0,0 +1,303 @@
+/****************************************************************************
+ * mm/mm_heap/mm_cache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef MM_PERCPU_CACHE
+
+/****************************************************************************
+ * Name: mm_cache_alloc
+ *
+ * Description:
+ *   Take a chunk of exactly 'size' bytes (including the allocated node
+ *   header) from the cache of the current CPU.  Only the lock of that
+ *   cache is taken; the heap semaphore is not needed.
+ *
+ * Returned Value:
+ *   The user memory of the chunk, or NULL if the size is not cached or the
+ *   cache is empty.  In the latter case the caller should allocate from
+ *   the heap and refill the cache with mm_cache_fill().
+ *
+ ****************************************************************************/
+
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_cacheclass_s *cls;
+  FAR struct mm_cachenode_s *node;
+  irqstate_t flags;
+  int cpu;
+
+  if (size > MM_CACHE_MAXCHUNK)
+    {
+      return NULL;
+    }
+
+  cpu   = up_cpu_index();
+  flags = spin_lock_irqsave(&heap->mm_cachelock[cpu]);
+
+  cls  = &heap->mm_cache[cpu][MM_CACHE_NDX(size)];
+  node = cls->head;
+  if (node != NULL)
+    {
+      cls->head = node->flink;
+      cls->count--;
+      cls->hits++;
+    }
+  else
+    {
+      cls->misses++;
+    }
+
+  spin_unlock_irqrestore(&heap->mm_cachelock[cpu], flags);
+
+#ifdef CONFIG_DEBUG_MM
+  if (node != NULL)
+    {
+      MM_ADD_BACKTRACE((FAR char *)node - SIZEOF_MM_ALLOCNODE);
+    }
+#endif
+
+  return node;
+}
+
+/****************************************************************************
+ * Name: mm_cache_fill
+ *
+ * Description:
+ *   Add a newly allocated chunk to the cache of the current CPU.  The
+ *   caller holds the heap semaphore and allocated the chunk with a cached
+ *   size.
+ *
+ * Returned Value:
+ *   True if the chunk was cached.  False if the heap returned a chunk
+ *   that is too large for any cache because the remainder was not worth
+ *   splitting off; the caller must then release it to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_cache_fill(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_allocnode_s *alloc;
+  FAR struct mm_cacheclass_s *cls;
+  FAR struct mm_cachenode_s *node = mem;
+  irqstate_t flags;
+  int cpu;
+
+  alloc = (FAR struct mm_allocnode_s *)((FAR char *)mem -
+                                        SIZEOF_MM_ALLOCNODE);
+  if (MM_CACHE_NDX(alloc->size) >= MM_CACHE_NCLASSES)
+    {
+      return false;
+    }
+
+  cpu   = up_cpu_index();
+  flags = spin_lock_irqsave(&heap->mm_cachelock[cpu]);
+
+  cls         = &heap->mm_cache[cpu][MM_CACHE_NDX(alloc->size)];
+  node->flink = cls->head;
+  cls->head   = node;
+  cls->count++;
+
+  spin_unlock_irqrestore(&heap->mm_cachelock[cpu], flags);
+  return true;
+}
+
+/****************************************************************************
+ * Name: mm_cache_free
+ *
+ * Description:
+ *   Try to return a chunk to the cache of the current CPU.  If that cache
+ *   is full, half of its chunks are detached and returned in 'flush'; the
+ *   caller must then release them to the heap.
+ *
+ * Returned Value:
+ *   True if the chunk was cached, false if the caller must release it to
+ *   the heap itself.
+ *
+ ****************************************************************************/
+
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem,
+                   FAR struct mm_cachenode_s **flush)
+{
+  FAR struct mm_allocnode_s *alloc;
+  FAR struct mm_cacheclass_s *cls;
+  FAR struct mm_cachenode_s *node = mem;
+  irqstate_t flags;
+  int cpu;
+
+  *flush = NULL;
+
+  DEBUGASSERT(mm_heapmember(heap, mem));
+  alloc = (FAR struct mm_allocnode_s *)((FAR char *)mem -
+                                        SIZEOF_MM_ALLOCNODE);
+  DEBUGASSERT(alloc->preceding & MM_ALLOC_BIT);
+
+  /* Don't cache large chunks or memory released during a context switch
+   * (see mm_takesemaphore()), which may still be in use.
+   */
+
+  if (MM_CACHE_NDX(alloc->size) >= MM_CACHE_NCLASSES ||
+      (!up_interrupt_context() && getpid() < 0))
+    {
+      return false;
+    }
+
+  cpu   = up_cpu_index();
+  flags = spin_lock_irqsave(&heap->mm_cachelock[cpu]);
+
+  cls = &heap->mm_cache[cpu][MM_CACHE_NDX(alloc->size)];
+  if (cls->count >= CONFIG_MM_PERCPU_CACHE_DEPTH)
+    {
+      FAR struct mm_cachenode_s *last;
+      int i;
+
+      /* Detach the first MM_CACHE_BATCH chunks */
+
+      for (last = cls->head, i = 1; i < MM_CACHE_BATCH; i++)
+        {
+          last = last->flink;
+        }
+
+      *flush      = cls->head;
+      cls->head   = last->flink;
+      cls->count -= MM_CACHE_BATCH;
+      last->flink = NULL;
+    }
+
+  node->flink = cls->head;
+  cls->head   = node;
+  cls->count++;
+
+  spin_unlock_irqrestore(&heap->mm_cachelock[cpu], flags);
+  return true;
+}
+
+/****************************************************************************
+ * Name: mm_cache_drain
+ *
+ * Description:
+ *   Empty the caches of all CPUs.  This is used when the heap itself is
+ *   exhausted, so that memory held by the caches of other CPUs (or of
+ *   other sizes) is not lost to the allocation.  The caller holds the
+ *   heap semaphore and must release the returned chunks to the heap.
+ *
+ * Returned Value:
+ *   A list of the chunks that were cached, or NULL if all caches were
+ *   empty.
+ *
+ ****************************************************************************/
+
+FAR struct mm_cachenode_s *mm_cache_drain(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_cachenode_s *list = NULL;
+  FAR struct mm_cachenode_s *node;
+  FAR struct mm_cacheclass_s *cls;
+  irqstate_t flags;
+  int cpu;
+  int ndx;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      flags = spin_lock_irqsave(&heap->mm_cachelock[cpu]);
+
+      for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++)
+        {
+          cls = &heap->mm_cache[cpu][ndx];
+          while ((node = cls->head) != NULL)
+            {
+              cls->head   = node->flink;
+              node->flink = list;
+              list        = node;
+            }
+
+          cls->count = 0;
+        }
+
+      spin_unlock_irqrestore(&heap->mm_cachelock[cpu], flags);
+    }
+
+  return list;
+}
+
+#endif /* MM_PERCPU_CACHE */
+
+/****************************************************************************
+ * Name: mm_cacheinfo
+ *
+ * Description:
+ *   Return the statistics of the per-CPU caches of one chunk size, summed
+ *   over all CPUs.
+ *
+ * Input Parameters:
+ *   heap - The heap
+ *   ndx  - The index of the cached size, starting at zero
+ *   info - The location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if 'ndx' is beyond the last cached size.
+ *
+ ****************************************************************************/
+
+int mm_cacheinfo(FAR struct mm_heap_s *heap, int ndx,
+                 FAR struct mm_cacheinfo_s *info)
+{
+  int cpu;
+
+  DEBUGASSERT(heap != NULL && info != NULL);
+
+  if (ndx < 0 || ndx >= MM_CACHE_NCLASSES)
+    {
+      return -ENOENT;
+    }
+
+  info->size   = ((ndx + 1) << MM_MIN_SHIFT) - SIZEOF_MM_ALLOCNODE;
+  info->hits   = 0;
+  info->misses = 0;
+  info->cached = 0;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      FAR struct mm_cacheclass_s *cls = &heap->mm_cache[cpu][ndx];
+
+      info->hits   += cls->hits;
+      info->misses += cls->misses;
+      info->cached += cls->count;
+    }
+
+  return OK;
+}
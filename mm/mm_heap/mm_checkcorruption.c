@@ -50,12 +50,14 @@ static void checkcorruption_handler(FAR struct mm_allocnode_s *node,
 
       assert(node->size >= SIZEOF_MM_FREENODE);
       assert(fnode->blink->flink == fnode);
-      assert(fnode->blink->size <= fnode->size);
       assert(fnode->flink == NULL ||
              fnode->flink->blink == fnode);
+#ifndef CONFIG_MM_TLSF_MANAGER
+      assert(fnode->blink->size <= fnode->size);
       assert(fnode->flink == NULL ||
              fnode->flink->size == 0 ||
              fnode->flink->size >= fnode->size);
+#endif
     }
 }
 
@@ -0,0 +1,80 @@
+/****************************************************************************
+ * mm/mm_heap/mm_delfreechunk.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_delfreechunk
+ *
+ * Description:
+ *   Remove a free chunk from the nodes list.  The chunk size must not have
+ *   been changed since it was added with mm_addfreechunk().  It is assumed
+ *   that the caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node)
+{
+  /* Remove the node.  There must be a predecessor, but there may not be
+   * a successor node.
+   */
+
+  DEBUGASSERT(node->blink);
+  DEBUGASSERT(node->blink->flink == node);
+
+  node->blink->flink = node->flink;
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+
+#ifdef CONFIG_MM_TLSF_MANAGER
+  /* Clear the bitmaps if that was the last node in its list */
+
+  if (node->flink == NULL && node->blink->size == 0)
+    {
+      int ndx = mm_size2ndx(node->size);
+      int fl  = ndx >> MM_SL_SHIFT;
+
+      DEBUGASSERT(node->blink == &heap->mm_nodelist[ndx]);
+
+      heap->mm_slbitmap[fl] &= ~(1 << (ndx & (MM_SL_COUNT - 1)));
+      if (heap->mm_slbitmap[fl] == 0)
+        {
+          heap->mm_flbitmap &= ~(1 << fl);
+        }
+    }
+#endif
+}
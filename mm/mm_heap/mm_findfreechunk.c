@@ -0,0 +1,160 @@
+/****************************************************************************
+ * mm/mm_heap/mm_findfreechunk.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <strings.h>
+
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_TLSF_MANAGER
+/****************************************************************************
+ * Name: mm_searchndx
+ *
+ * Description:
+ *   Return the index of the first non-empty list at or above 'ndx' using
+ *   the free list bitmaps, or -1 if there is none.
+ *
+ ****************************************************************************/
+
+static int mm_searchndx(FAR struct mm_heap_s *heap, int ndx)
+{
+  uint32_t map;
+  int fl = ndx >> MM_SL_SHIFT;
+
+  /* Look for a non-empty list in the same first level range */
+
+  map = heap->mm_slbitmap[fl] & (~0u << (ndx & (MM_SL_COUNT - 1)));
+  if (map == 0)
+    {
+      /* None.. look for the next non-empty first level range */
+
+      map = heap->mm_flbitmap & (~0u << (fl + 1));
+      if (map == 0)
+        {
+          return -1;
+        }
+
+      fl  = ffs(map) - 1;
+      map = heap->mm_slbitmap[fl];
+    }
+
+  return (fl << MM_SL_SHIFT) + ffs(map) - 1;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find a free chunk of at least 'size' bytes in the nodes list.  The
+ *   chunk is not removed from the list.  It is assumed that the caller
+ *   holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size)
+{
+  FAR struct mm_freenode_s *node;
+  int ndx;
+
+#ifdef CONFIG_MM_TLSF_MANAGER
+  /* Round the request up to the next list boundary so that every chunk in
+   * the list found is large enough and its head can be taken without a
+   * search ("good fit").  Only the last list, which also holds all chunks
+   * of MM_MAX_CHUNK or more, may contain smaller chunks.
+   */
+
+  if (size < (1 << MM_FL_SHIFT))
+    {
+      ndx = mm_size2ndx(size);
+    }
+  else if (size < MM_MAX_CHUNK)
+    {
+      ndx = mm_size2ndx(size + (1 << (fls(size) - 1 - MM_SL_SHIFT)) - 1);
+    }
+  else
+    {
+      ndx = MM_NNODES - 1;
+    }
+
+  ndx = mm_searchndx(heap, ndx);
+  if (ndx >= 0 && ndx < MM_NNODES - 1)
+    {
+      DEBUGASSERT(heap->mm_nodelist[ndx].flink != NULL);
+      return heap->mm_nodelist[ndx].flink;
+    }
+
+  /* Otherwise search the last list or, if there is no list above the
+   * rounded request with a free chunk, the list that the request size
+   * itself maps to.  It may still hold a large enough chunk.
+   */
+
+  if (ndx < 0)
+    {
+      ndx = mm_size2ndx(size);
+    }
+#else
+  /* Get the location in the node list to start the search. Special case
+   * really big allocations
+   */
+
+  if (size >= MM_MAX_CHUNK)
+    {
+      ndx = MM_NNODES - 1;
+    }
+  else
+    {
+      /* Convert the request size into a nodelist index */
+
+      ndx = mm_size2ndx(size);
+    }
+#endif
+
+  /* Search for a large enough chunk in the list of nodes.  With the
+   * default manager this list is ordered by size, but will have occasional
+   * zero sized nodes as we visit other mm_nodelist[] entries.
+   */
+
+  for (node = heap->mm_nodelist[ndx].flink;
+       node && node->size < size;
+       node = node->flink)
+    {
+      DEBUGASSERT(node->blink->flink == node);
+    }
+
+  return node;
+}
@@ -59,45 +59,19 @@ static void mm_add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_free
+ * Name: mm_freechunk
  *
  * Description:
- *   Returns a chunk of memory to the list of free nodes,  merging with
- *   adjacent free chunks if possible.
+ *   Return a chunk to the list of free nodes, merging with adjacent free
+ *   chunks if possible.  The caller holds the mm semaphore.
  *
  ****************************************************************************/
 
-void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem)
 {
   FAR struct mm_freenode_s *node;
   FAR struct mm_freenode_s *prev;
   FAR struct mm_freenode_s *next;
-  int ret;
-
-  UNUSED(ret);
-  minfo("Freeing %p\n", mem);
-
-  /* Protect against attempts to free a NULL reference */
-
-  if (!mem)
-    {
-      return;
-    }
-
-  kasan_poison(mem, mm_malloc_size(mem));
-
-  if (mm_takesemaphore(heap) == false)
-    {
-      kasan_unpoison(mem, mm_malloc_size(mem));
-
-      /* Meet -ESRCH return, which means we are in situations
-       * during context switching(See mm_takesemaphore() & getpid()).
-       * Then add to the delay list.
-       */
-
-      mm_add_delaylist(heap, mem);
-      return;
-    }
 
   DEBUGASSERT(mm_heapmember(heap, mem));
 
@@ -127,16 +101,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
       andbeyond = (FAR struct mm_allocnode_s *)
                     ((FAR char *)next + next->size);
 
-      /* Remove the next node.  There must be a predecessor,
-       * but there may not be a successor node.
-       */
+      /* Remove the next node from the nodelist */
 
-      DEBUGASSERT(next->blink);
-      next->blink->flink = next->flink;
-      if (next->flink)
-        {
-          next->flink->blink = next->blink;
-        }
+      mm_delfreechunk(heap, next);
 
       /* Then merge the two chunks */
 
@@ -154,16 +121,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   DEBUGASSERT((node->preceding & ~MM_ALLOC_BIT) == prev->size);
   if ((prev->preceding & MM_ALLOC_BIT) == 0)
     {
-      /* Remove the node.  There must be a predecessor, but there may
-       * not be a successor node.
-       */
+      /* Remove the previous node from the nodelist */
 
-      DEBUGASSERT(prev->blink);
-      prev->blink->flink = prev->flink;
-      if (prev->flink)
-        {
-          prev->flink->blink = prev->blink;
-        }
+      mm_delfreechunk(heap, prev);
 
       /* Then merge the two chunks */
 
@@ -175,5 +135,105 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   /* Add the merged node to the nodelist */
 
   mm_addfreechunk(heap, node);
+}
+
+/****************************************************************************
+ * Name: mm_free
+ *
+ * Description:
+ *   Returns a chunk of memory to the list of free nodes,  merging with
+ *   adjacent free chunks if possible.
+ *
+ ****************************************************************************/
+
+void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+#ifdef MM_PERCPU_CACHE
+  FAR struct mm_cachenode_s *flush;
+#endif
+#ifdef CONFIG_MM_HEAP_TIMING
+  uint32_t start;
+  uint32_t elapsed;
+#endif
+  int ret;
+
+  UNUSED(ret);
+  minfo("Freeing %p\n", mem);
+
+  /* Protect against attempts to free a NULL reference */
+
+  if (!mem)
+    {
+      return;
+    }
+
+#ifdef MM_PERCPU_CACHE
+  /* Small chunks go to the cache of this CPU without taking the heap
+   * semaphore.  Only when that cache is full, a batch of its chunks is
+   * released to the heap.
+   */
+
+  if (mm_cache_free(heap, mem, &flush))
+    {
+      if (flush == NULL)
+        {
+          return;
+        }
+
+      mem   = flush;
+      flush = flush->flink;
+    }
+#endif
+
+  kasan_poison(mem, mm_malloc_size(mem));
+
+  if (mm_takesemaphore(heap) == false)
+    {
+      kasan_unpoison(mem, mm_malloc_size(mem));
+
+      /* Meet -ESRCH return, which means we are in situations
+       * during context switching(See mm_takesemaphore() & getpid()).
+       * Then add to the delay list.
+       */
+
+      mm_add_delaylist(heap, mem);
+
+#ifdef MM_PERCPU_CACHE
+      while (flush != NULL)
+        {
+          mem   = flush;
+          flush = flush->flink;
+          mm_add_delaylist(heap, mem);
+        }
+#endif
+
+      return;
+    }
+
+#ifdef CONFIG_MM_HEAP_TIMING
+  start = up_perf_gettime();
+#endif
+
+  mm_freechunk(heap, mem);
+
+#ifdef MM_PERCPU_CACHE
+  /* Release the chunks flushed from the cache as well */
+
+  while (flush != NULL)
+    {
+      mem   = flush;
+      flush = flush->flink;
+      mm_freechunk(heap, mem);
+    }
+#endif
+
+#ifdef CONFIG_MM_HEAP_TIMING
+  elapsed = up_perf_gettime() - start;
+  if (elapsed > heap->mm_maxfree)
+    {
+      heap->mm_maxfree = elapsed;
+    }
+#endif
+
   mm_givesemaphore(heap);
 }
@@ -168,7 +168,9 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
 {
   FAR struct mm_heap_s *heap;
   uintptr_t             heap_adj;
+#ifndef CONFIG_MM_TLSF_MANAGER
   int                   i;
+#endif
 
   minfo("Heap: name=%s, start=%p size=%zu\n", name, heapstart, heapsize);
 
@@ -191,13 +193,17 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
 
   memset(heap, 0, sizeof(struct mm_heap_s));
 
-  /* Initialize the node array */
+#ifndef CONFIG_MM_TLSF_MANAGER
+  /* Initialize the node array.  The TLSF lists are kept separate and are
+   * all empty after the memset above.
+   */
 
   for (i = 1; i < MM_NNODES; i++)
     {
       heap->mm_nodelist[i - 1].flink = &heap->mm_nodelist[i];
       heap->mm_nodelist[i].blink     = &heap->mm_nodelist[i - 1];
     }
+#endif
 
   /* Initialize the malloc semaphore to one (to support one-at-
    * a-time access to private data sets).
@@ -59,12 +59,14 @@ static void mallinfo_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
 
       DEBUGASSERT(node->size >= SIZEOF_MM_FREENODE);
       DEBUGASSERT(fnode->blink->flink == fnode);
-      DEBUGASSERT(fnode->blink->size <= fnode->size);
       DEBUGASSERT(fnode->flink == NULL ||
                   fnode->flink->blink == fnode);
+#ifndef CONFIG_MM_TLSF_MANAGER
+      DEBUGASSERT(fnode->blink->size <= fnode->size);
       DEBUGASSERT(fnode->flink == NULL ||
                   fnode->flink->size == 0 ||
                   fnode->flink->size >= fnode->size);
+#endif
 
       info->ordblks++;
       info->fordblks += node->size;
@@ -125,6 +127,11 @@ int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
 
   DEBUGASSERT(info->uordblks + info->fordblks == heap->mm_heapsize);
 
+#ifdef CONFIG_MM_HEAP_TIMING
+  info->mxmalloc = heap->mm_maxmalloc;
+  info->mxfree   = heap->mm_maxfree;
+#endif
+
   return OK;
 }
 
@@ -81,6 +81,86 @@ static void mm_free_delaylist(FAR struct mm_heap_s *heap)
 #endif
 }
 
+/****************************************************************************
+ * Name: mm_allocchunk
+ *
+ * Description:
+ *   Take a chunk of 'size' bytes from the list of free nodes.  The caller
+ *   holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+static FAR void *mm_allocchunk(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_freenode_s *node;
+
+  /* Search for a large enough chunk in the list of nodes */
+
+  node = mm_findfreechunk(heap, size);
+
+  /* If we found a node with non-zero size, then this is one to use. With
+   * the default manager the list is ordered, so we know that it must be
+   * the best fitting chunk available.
+   */
+
+  if (node)
+    {
+      FAR struct mm_freenode_s *remainder;
+      FAR struct mm_freenode_s *next;
+      size_t remaining;
+
+      /* Remove the node from the nodelist */
+
+      mm_delfreechunk(heap, node);
+
+      /* Check if we have to split the free node into one of the allocated
+       * size and another smaller freenode.  In some cases, the remaining
+       * bytes can be smaller (they may be SIZEOF_MM_ALLOCNODE).  In that
+       * case, we will just carry the few wasted bytes at the end of the
+       * allocation.
+       */
+
+      remaining = node->size - size;
+      if (remaining >= SIZEOF_MM_FREENODE)
+        {
+          /* Get a pointer to the next node in physical memory */
+
+          next = (FAR struct mm_freenode_s *)
+                 (((FAR char *)node) + node->size);
+
+          /* Create the remainder node */
+
+          remainder = (FAR struct mm_freenode_s *)
+            (((FAR char *)node) + size);
+
+          remainder->size      = remaining;
+          remainder->preceding = size;
+
+          /* Adjust the size of the node under consideration */
+
+          node->size = size;
+
+          /* Adjust the 'preceding' size of the (old) next node, preserving
+           * the allocated flag.
+           */
+
+          next->preceding = remaining | (next->preceding & MM_ALLOC_BIT);
+
+          /* Add the remainder back into the nodelist */
+
+          mm_addfreechunk(heap, remainder);
+        }
+
+      /* Handle the case of an exact size match */
+
+      node->preceding |= MM_ALLOC_BIT;
+      MM_ADD_BACKTRACE(node);
+      return (FAR void *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -98,10 +178,12 @@ static void mm_free_delaylist(FAR struct mm_heap_s *heap)
 
 FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 {
-  FAR struct mm_freenode_s *node;
   size_t alignsize;
   FAR void *ret = NULL;
-  int ndx;
+#ifdef CONFIG_MM_HEAP_TIMING
+  uint32_t start;
+  uint32_t elapsed;
+#endif
 
   /* Free the delay list first */
 
@@ -129,107 +211,90 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   DEBUGASSERT(alignsize >= MM_MIN_CHUNK);
   DEBUGASSERT(alignsize >= SIZEOF_MM_FREENODE);
 
-  /* We need to hold the MM semaphore while we muck with the nodelist. */
-
-  DEBUGVERIFY(mm_takesemaphore(heap));
-
-  /* Get the location in the node list to start the search. Special case
-   * really big allocations
-   */
+#ifdef MM_PERCPU_CACHE
+  /* Try the cache of this CPU first.  It does not need the semaphore. */
 
-  if (alignsize >= MM_MAX_CHUNK)
+  ret = mm_cache_alloc(heap, alignsize);
+  if (ret != NULL)
     {
-      ndx = MM_NNODES - 1;
+      goto out;
     }
-  else
-    {
-      /* Convert the request size into a nodelist index */
+#endif
 
-      ndx = mm_size2ndx(alignsize);
-    }
+  /* We need to hold the MM semaphore while we muck with the nodelist. */
 
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
-   */
+  DEBUGVERIFY(mm_takesemaphore(heap));
 
-  for (node = heap->mm_nodelist[ndx].flink;
-       node && node->size < alignsize;
-       node = node->flink)
-    {
-      DEBUGASSERT(node->blink->flink == node);
-    }
+#ifdef CONFIG_MM_HEAP_TIMING
+  start = up_perf_gettime();
+#endif
 
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that it must be the best fitting chunk
-   * available.
-   */
+  ret = mm_allocchunk(heap, alignsize);
 
-  if (node)
+#ifdef MM_PERCPU_CACHE
+  if (ret == NULL)
     {
-      FAR struct mm_freenode_s *remainder;
-      FAR struct mm_freenode_s *next;
-      size_t remaining;
+      FAR struct mm_cachenode_s *node;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
+      /* The heap is exhausted, but the caches of all CPUs may still hold
+       * free memory.  Return it to the heap and try again.
        */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
+      node = mm_cache_drain(heap);
+      if (node != NULL)
         {
-          node->flink->blink = node->blink;
+          while (node != NULL)
+            {
+              FAR void *mem = node;
+
+              node = node->flink;
+              mm_freechunk(heap, mem);
+            }
+
+          ret = mm_allocchunk(heap, alignsize);
         }
+    }
+  else if (alignsize <= MM_CACHE_MAXCHUNK)
+    {
+      FAR void *mem;
+      int i;
 
-      /* Check if we have to split the free node into one of the allocated
-       * size and another smaller freenode.  In some cases, the remaining
-       * bytes can be smaller (they may be SIZEOF_MM_ALLOCNODE).  In that
-       * case, we will just carry the few wasted bytes at the end of the
-       * allocation.
+      /* The cache of this size was empty.  Refill it with a batch of
+       * chunks while we hold the semaphore anyway.
        */
 
-      remaining = node->size - alignsize;
-      if (remaining >= SIZEOF_MM_FREENODE)
+      for (i = 0; i < MM_CACHE_BATCH; i++)
         {
-          /* Get a pointer to the next node in physical memory */
-
-          next = (FAR struct mm_freenode_s *)
-                 (((FAR char *)node) + node->size);
-
-          /* Create the remainder node */
-
-          remainder = (FAR struct mm_freenode_s *)
-            (((FAR char *)node) + alignsize);
-
-          remainder->size      = remaining;
-          remainder->preceding = alignsize;
-
-          /* Adjust the size of the node under consideration */
-
-          node->size = alignsize;
-
-          /* Adjust the 'preceding' size of the (old) next node, preserving
-           * the allocated flag.
-           */
-
-          next->preceding = remaining | (next->preceding & MM_ALLOC_BIT);
-
-          /* Add the remainder back into the nodelist */
-
-          mm_addfreechunk(heap, remainder);
+          mem = mm_allocchunk(heap, alignsize);
+          if (mem == NULL)
+            {
+              break;
+            }
+
+          if (!mm_cache_fill(heap, mem))
+            {
+              mm_freechunk(heap, mem);
+              break;
+            }
         }
+    }
+#endif
 
-      /* Handle the case of an exact size match */
+  DEBUGASSERT(ret == NULL || mm_heapmember(heap, ret));
 
-      node->preceding |= MM_ALLOC_BIT;
-      MM_ADD_BACKTRACE(node);
-      ret = (FAR void *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
+#ifdef CONFIG_MM_HEAP_TIMING
+  elapsed = up_perf_gettime() - start;
+  if (elapsed > heap->mm_maxmalloc)
+    {
+      heap->mm_maxmalloc = elapsed;
     }
+#endif
 
-  DEBUGASSERT(ret == NULL || mm_heapmember(heap, ret));
   mm_givesemaphore(heap);
 
+#ifdef MM_PERCPU_CACHE
+out:
+#endif
   if (ret)
     {
       kasan_unpoison(ret, mm_malloc_size(ret));
@@ -101,12 +101,14 @@ static void memdump_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
 
       DEBUGASSERT(node->size >= SIZEOF_MM_FREENODE);
       DEBUGASSERT(fnode->blink->flink == fnode);
-      DEBUGASSERT(fnode->blink->size <= fnode->size);
       DEBUGASSERT(fnode->flink == NULL ||
                   fnode->flink->blink == fnode);
+#ifndef CONFIG_MM_TLSF_MANAGER
+      DEBUGASSERT(fnode->blink->size <= fnode->size);
       DEBUGASSERT(fnode->flink == NULL ||
                   fnode->flink->size == 0 ||
                   fnode->flink->size >= fnode->size);
+#endif
 
       if (info->pid <= -2)
         {
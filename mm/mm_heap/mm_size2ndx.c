@@ -24,6 +24,8 @@
 
 #include <nuttx/config.h>
 
+#include <strings.h>
+
 #include <nuttx/mm/mm.h>
 
 #include "mm_heap/mm.h"
@@ -42,6 +44,31 @@
 
 int mm_size2ndx(size_t size)
 {
+#ifdef CONFIG_MM_TLSF_MANAGER
+  int fl;
+  int sl;
+
+  if (size >= MM_MAX_CHUNK)
+    {
+      return MM_NNODES - 1;
+    }
+
+  /* Small chunks are mapped linearly into the first level list zero */
+
+  if (size < (1 << MM_FL_SHIFT))
+    {
+      return size >> MM_MIN_SHIFT;
+    }
+
+  /* The first level index is selected by the most significant bit, the
+   * second level index by the MM_SL_SHIFT bits that follow it.
+   */
+
+  fl = fls(size) - 1;
+  sl = (size >> (fl - MM_SL_SHIFT)) & (MM_SL_COUNT - 1);
+
+  return ((fl - MM_FL_SHIFT + 1) << MM_SL_SHIFT) + sl;
+#else
   int ndx = 0;
 
   if (size >= MM_MAX_CHUNK)
@@ -57,4 +84,5 @@ int mm_size2ndx(size_t size)
     }
 
   return ndx;
+#endif
 }
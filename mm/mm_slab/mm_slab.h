@@ -0,0 +1,128 @@
+/****************************************************************************
+ * mm/mm_slab/mm_slab.h
+ * Object cache (slab) allocator for fixed-size kernel objects.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __MM_MM_SLAB_MM_SLAB_H
+#define __MM_MM_SLAB_MM_SLAB_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <queue.h>
+
+#include <nuttx/mm/slab.h>
+
+#ifdef CONFIG_MM_SLAB
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* All objects and the slab header are aligned to MM_SLAB_ALIGN */
+
+#define MM_SLAB_ALIGN        (2 * sizeof(uintptr_t))
+#define MM_SLAB_MASK         (MM_SLAB_ALIGN - 1)
+#define MM_SLAB_ALIGN_UP(a)  (((a) + MM_SLAB_MASK) & ~MM_SLAB_MASK)
+
+#define SIZEOF_MM_SLAB_S     MM_SLAB_ALIGN_UP(sizeof(struct mm_slab_s))
+
+/* Each object is followed by a link word.  While the object is free, the
+ * link points to the next free object of the same slab; while it is
+ * allocated, the link points to the slab that holds the object.  The
+ * object itself is never touched so that it keeps its constructed state.
+ */
+
+#define MM_SLAB_LINK(c,o)    (*(FAR void **)((FAR char *)(o) + (c)->linkoff))
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This describes one slab:  A block of heap memory holding a header
+ * followed by 'objsperslab' objects.
+ */
+
+struct mm_slab_s
+{
+  dq_entry_t node;                 /* Link in one of the slab lists */
+  FAR void *freelist;              /* The first free object */
+  uint16_t ninuse;                 /* Number of objects allocated */
+  bool reserved;                   /* Holds reserved objects; never freed */
+};
+
+/* This describes one object cache */
+
+struct mm_slabcache_s
+{
+  dq_entry_t node;                 /* Link in g_slabcaches */
+  FAR const char *name;            /* Name of the cache */
+  slab_ctor_t ctor;                /* Object constructor (may be NULL) */
+  FAR void *arg;                   /* Constructor argument */
+  size_t objsize;                  /* Size of one object */
+  size_t linkoff;                  /* Offset of the link word */
+  size_t stride;                   /* Distance between objects */
+  uint16_t objsperslab;            /* Objects per slab */
+  uint16_t nslabs;                 /* Number of slabs */
+  dq_queue_t partial;              /* Slabs with free and used objects */
+  dq_queue_t empty;                /* Slabs with only free objects */
+  dq_queue_t full;                 /* Slabs with only used objects */
+
+  /* Statistics */
+
+  uint32_t ninuse;                 /* Objects allocated */
+  uint32_t nalloc;                 /* Successful allocations */
+  uint32_t nfail;                  /* Failed allocations */
+  uint32_t ngrow;                  /* Slabs added */
+  uint32_t nreclaim;               /* Slabs released */
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The list of all object caches */
+
+extern dq_queue_t g_slabcaches;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_slab_grow
+ *
+ * Description:
+ *   Allocate a new slab from the kernel heap, construct its objects and
+ *   add it to the empty list of the cache.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if no memory is available.
+ *
+ ****************************************************************************/
+
+int mm_slab_grow(FAR struct mm_slabcache_s *cache, bool reserved);
+
+#endif /* CONFIG_MM_SLAB */
+#endif /* __MM_MM_SLAB_MM_SLAB_H */
@@ -0,0 +1,128 @@
+/****************************************************************************
+ * mm/mm_slab/mm_slaballoc.c
+ * Object cache (slab) allocator for fixed-size kernel objects.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/slab.h>
+
+#include "mm_slab/mm_slab.h"
+
+#ifdef CONFIG_MM_SLAB
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: slab_alloc
+ *
+ * Description:
+ *   Allocate one object from the cache in constant time.  This may be
+ *   called from an interrupt handler, but in that case no slab is added if
+ *   the cache is empty.
+ *
+ * Input Parameters:
+ *   handle - The handle previously returned by slab_create
+ *
+ * Returned Value:
+ *   The allocated object or NULL if no memory is available.
+ *
+ ****************************************************************************/
+
+FAR void *slab_alloc(SLAB_HANDLE handle)
+{
+  FAR struct mm_slabcache_s *cache = (FAR struct mm_slabcache_s *)handle;
+  FAR struct mm_slab_s *slab;
+  FAR void *obj = NULL;
+  irqstate_t flags;
+
+  DEBUGASSERT(cache != NULL);
+
+  flags = enter_critical_section();
+
+  for (; ; )
+    {
+      /* Prefer a partially used slab, then an unused one */
+
+      slab = (FAR struct mm_slab_s *)dq_peek(&cache->partial);
+      if (slab == NULL)
+        {
+          slab = (FAR struct mm_slab_s *)dq_remfirst(&cache->empty);
+          if (slab != NULL)
+            {
+              dq_addfirst(&slab->node, &cache->partial);
+            }
+        }
+
+      /* Add a new slab if there are no free objects.  The heap cannot be
+       * used from an interrupt handler.
+       */
+
+      if (slab != NULL || up_interrupt_context())
+        {
+          break;
+        }
+
+      leave_critical_section(flags);
+      if (mm_slab_grow(cache, false) < 0)
+        {
+          flags = enter_critical_section();
+          break;
+        }
+
+      flags = enter_critical_section();
+    }
+
+  if (slab != NULL)
+    {
+      /* Take the first free object.  Its link now refers to the slab. */
+
+      obj            = slab->freelist;
+      slab->freelist = MM_SLAB_LINK(cache, obj);
+      MM_SLAB_LINK(cache, obj) = slab;
+
+      if (++slab->ninuse == cache->objsperslab)
+        {
+          dq_rem(&slab->node, &cache->partial);
+          dq_addlast(&slab->node, &cache->full);
+        }
+
+      cache->ninuse++;
+      cache->nalloc++;
+    }
+  else
+    {
+      cache->nfail++;
+    }
+
+  leave_critical_section(flags);
+  return obj;
+}
+
+#endif /* CONFIG_MM_SLAB */
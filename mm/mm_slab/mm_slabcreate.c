@@ -0,0 +1,183 @@
+/****************************************************************************
+ * mm/mm_slab/mm_slabcreate.c
+ * Object cache (slab) allocator for fixed-size kernel objects.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/slab.h>
+
+#include "mm_slab/mm_slab.h"
+
+#ifdef CONFIG_MM_SLAB
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The list of all object caches */
+
+dq_queue_t g_slabcaches;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_slab_grow
+ *
+ * Description:
+ *   Allocate a new slab from the kernel heap, construct its objects and
+ *   add it to the empty list of the cache.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if no memory is available.
+ *
+ ****************************************************************************/
+
+int mm_slab_grow(FAR struct mm_slabcache_s *cache, bool reserved)
+{
+  FAR struct mm_slab_s *slab;
+  FAR char *obj;
+  irqstate_t flags;
+  int i;
+
+  slab = (FAR struct mm_slab_s *)
+    kmm_malloc(SIZEOF_MM_SLAB_S + cache->objsperslab * cache->stride);
+  if (slab == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  slab->freelist = NULL;
+  slab->ninuse   = 0;
+  slab->reserved = reserved;
+
+  /* Construct the objects and put them into the free list in address
+   * order.
+   */
+
+  obj = (FAR char *)slab + SIZEOF_MM_SLAB_S +
+        (cache->objsperslab - 1) * cache->stride;
+
+  for (i = 0; i < cache->objsperslab; i++, obj -= cache->stride)
+    {
+      if (cache->ctor != NULL)
+        {
+          cache->ctor(obj, cache->arg);
+        }
+
+      MM_SLAB_LINK(cache, obj) = slab->freelist;
+      slab->freelist           = obj;
+    }
+
+  flags = enter_critical_section();
+
+  dq_addlast(&slab->node, &cache->empty);
+  cache->nslabs++;
+  cache->ngrow++;
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: slab_create
+ *
+ * Description:
+ *   Create a cache of fixed-size objects.  The objects are carved from
+ *   slabs allocated from the kernel heap.  Slabs are added when the cache
+ *   runs out of objects and released again when they are no longer used.
+ *
+ * Input Parameters:
+ *   name     - The name of the cache, shown in /proc/slabinfo.  The string
+ *              is not copied.
+ *   objsize  - The size of one object
+ *   nreserve - The number of objects to allocate immediately.  The slabs
+ *              holding them are never released.
+ *   ctor     - An optional constructor called for each new object.
+ *   arg      - The argument passed to the constructor
+ *
+ * Returned Value:
+ *   On success, a non-NULL handle is returned that may be used with other
+ *   slab interfaces.  NULL is returned if the memory could not be
+ *   allocated.
+ *
+ ****************************************************************************/
+
+SLAB_HANDLE slab_create(FAR const char *name, size_t objsize,
+                        unsigned int nreserve, slab_ctor_t ctor,
+                        FAR void *arg)
+{
+  FAR struct mm_slabcache_s *cache;
+  irqstate_t flags;
+  unsigned int n;
+
+  DEBUGASSERT(objsize > 0);
+
+  cache = (FAR struct mm_slabcache_s *)
+    kmm_zalloc(sizeof(struct mm_slabcache_s));
+  if (cache == NULL)
+    {
+      return NULL;
+    }
+
+  /* The link word follows the object, aligned to a pointer */
+
+  cache->name        = name;
+  cache->ctor        = ctor;
+  cache->arg         = arg;
+  cache->objsize     = objsize;
+  cache->linkoff     = (objsize + sizeof(FAR void *) - 1) &
+                       ~(sizeof(FAR void *) - 1);
+  cache->stride      = MM_SLAB_ALIGN_UP(cache->linkoff + sizeof(FAR void *));
+  cache->objsperslab = CONFIG_MM_SLAB_NOBJS;
+
+  dq_init(&cache->partial);
+  dq_init(&cache->empty);
+  dq_init(&cache->full);
+
+  flags = enter_critical_section();
+  dq_addlast(&cache->node, &g_slabcaches);
+  leave_critical_section(flags);
+
+  /* Allocate the slabs for the reserved objects */
+
+  for (n = 0; n < nreserve; n += cache->objsperslab)
+    {
+      if (mm_slab_grow(cache, true) < 0)
+        {
+          slab_destroy(cache);
+          return NULL;
+        }
+    }
+
+  return cache;
+}
+
+#endif /* CONFIG_MM_SLAB */
@@ -0,0 +1,75 @@
+/****************************************************************************
+ * mm/mm_slab/mm_slabdestroy.c
+ * Object cache (slab) allocator for fixed-size kernel objects.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/slab.h>
+
+#include "mm_slab/mm_slab.h"
+
+#ifdef CONFIG_MM_SLAB
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: slab_destroy
+ *
+ * Description:
+ *   Release an object cache and all of its slabs.  All objects must have
+ *   been freed.
+ *
+ * Input Parameters:
+ *   handle - The handle previously returned by slab_create
+ *
+ ****************************************************************************/
+
+void slab_destroy(SLAB_HANDLE handle)
+{
+  FAR struct mm_slabcache_s *cache = (FAR struct mm_slabcache_s *)handle;
+  FAR dq_entry_t *slab;
+  irqstate_t flags;
+
+  DEBUGASSERT(cache != NULL && cache->ninuse == 0);
+  DEBUGASSERT(dq_empty(&cache->partial) && dq_empty(&cache->full));
+
+  flags = enter_critical_section();
+  dq_rem(&cache->node, &g_slabcaches);
+  leave_critical_section(flags);
+
+  while ((slab = dq_remfirst(&cache->empty)) != NULL)
+    {
+      kmm_free(slab);
+    }
+
+  kmm_free(cache);
+}
+
+#endif /* CONFIG_MM_SLAB */
@@ -0,0 +1,116 @@
+/****************************************************************************
+ * mm/mm_slab/mm_slabfree.c
+ * Object cache (slab) allocator for fixed-size kernel objects.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/slab.h>
+
+#include "mm_slab/mm_slab.h"
+
+#ifdef CONFIG_MM_SLAB
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: slab_free
+ *
+ * Description:
+ *   Return one object to the cache in constant time.  This may be called
+ *   from an interrupt handler.
+ *
+ * Input Parameters:
+ *   handle - The handle previously returned by slab_create
+ *   obj    - The object previously returned by slab_alloc
+ *
+ ****************************************************************************/
+
+void slab_free(SLAB_HANDLE handle, FAR void *obj)
+{
+  FAR struct mm_slabcache_s *cache = (FAR struct mm_slabcache_s *)handle;
+  FAR struct mm_slab_s *release = NULL;
+  FAR struct mm_slab_s *slab;
+  irqstate_t flags;
+
+  DEBUGASSERT(cache != NULL && obj != NULL);
+
+  flags = enter_critical_section();
+
+  /* The link of an allocated object refers to its slab */
+
+  slab = (FAR struct mm_slab_s *)MM_SLAB_LINK(cache, obj);
+  DEBUGASSERT(slab != NULL && slab->ninuse > 0);
+  DEBUGASSERT((FAR char *)obj >= (FAR char *)slab + SIZEOF_MM_SLAB_S &&
+              (FAR char *)obj < (FAR char *)slab + SIZEOF_MM_SLAB_S +
+                                cache->objsperslab * cache->stride);
+
+  MM_SLAB_LINK(cache, obj) = slab->freelist;
+  slab->freelist           = obj;
+  cache->ninuse--;
+
+  if (slab->ninuse-- == cache->objsperslab)
+    {
+      /* The slab was full; it has a free object again */
+
+      dq_rem(&slab->node, &cache->full);
+      dq_addfirst(&slab->node, &cache->partial);
+    }
+
+  if (slab->ninuse == 0)
+    {
+      dq_rem(&slab->node, &cache->partial);
+
+      /* Keep one unused slab to avoid thrashing the heap; release the
+       * others.  The heap cannot be used from an interrupt handler.
+       */
+
+      if (!slab->reserved && !dq_empty(&cache->empty) &&
+          !up_interrupt_context())
+        {
+          release = slab;
+          cache->nslabs--;
+          cache->nreclaim++;
+        }
+      else
+        {
+          dq_addlast(&slab->node, &cache->empty);
+        }
+    }
+
+  leave_critical_section(flags);
+
+  if (release != NULL)
+    {
+      kmm_free(release);
+    }
+}
+
+#endif /* CONFIG_MM_SLAB */
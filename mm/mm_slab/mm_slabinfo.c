@@ -0,0 +1,101 @@
+/****************************************************************************
+ * mm/mm_slab/mm_slabinfo.c
+ * Object cache (slab) allocator for fixed-size kernel objects.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/slab.h>
+
+#include "mm_slab/mm_slab.h"
+
+#ifdef CONFIG_MM_SLAB
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: slab_info
+ *
+ * Description:
+ *   Return information about an object cache.
+ *
+ * Input Parameters:
+ *   handle - The handle previously returned by slab_create
+ *   info   - Memory location to return the cache info.
+ *
+ ****************************************************************************/
+
+void slab_info(SLAB_HANDLE handle, FAR struct slabinfo_s *info)
+{
+  FAR struct mm_slabcache_s *cache = (FAR struct mm_slabcache_s *)handle;
+  irqstate_t flags;
+
+  DEBUGASSERT(cache != NULL && info != NULL);
+
+  flags = enter_critical_section();
+
+  info->name        = cache->name;
+  info->objsize     = cache->objsize;
+  info->objsperslab = cache->objsperslab;
+  info->nslabs      = cache->nslabs;
+  info->ninuse      = cache->ninuse;
+  info->nalloc      = cache->nalloc;
+  info->nfail       = cache->nfail;
+  info->ngrow       = cache->ngrow;
+  info->nreclaim    = cache->nreclaim;
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: slab_foreach
+ *
+ * Description:
+ *   Call 'handler' for each object cache in the system.  The handler is
+ *   called within a critical section.
+ *
+ ****************************************************************************/
+
+void slab_foreach(slab_handler_t handler, FAR void *arg)
+{
+  FAR dq_entry_t *node;
+  irqstate_t flags;
+
+  DEBUGASSERT(handler != NULL);
+
+  flags = enter_critical_section();
+
+  for (node = dq_peek(&g_slabcaches); node != NULL; node = dq_next(node))
+    {
+      handler((SLAB_HANDLE)node, arg);
+    }
+
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_MM_SLAB */
@@ -154,6 +154,31 @@ struct arp_notify_s
  ****************************************************************************/
 
 #ifdef CONFIG_NET_ARP
+/****************************************************************************
+ * Name: arp_initialize
+ *
+ * Description:
+ *   Initialize the ARP table.  Called once from net_initialize().
+ *
+ ****************************************************************************/
+
+void arp_initialize(void);
+
+/****************************************************************************
+ * Name: arp_timer
+ *
+ * Description:
+ *   Release the expired entries of the ARP table.  Each call examines only
+ *   a few hash chains, continuing where the previous call stopped, so the
+ *   whole table is swept over a number of calls.
+ *
+ * Assumptions:
+ *   Called periodically from devif_timer().  The network must be locked.
+ *
+ ****************************************************************************/
+
+void arp_timer(void);
+
 /****************************************************************************
  * Name: arp_format
  *
@@ -473,6 +498,8 @@ void arp_dump(FAR struct arp_hdr_s *arp);
 
 /* If ARP is disabled, stub out all ARP interfaces */
 
+#  define arp_initialize()
+#  define arp_timer()
 #  define arp_format(d,i);
 #  define arp_send(i) (0)
 #  define arp_poll(d,c) (0)
@@ -86,6 +86,10 @@ void arp_format(FAR struct net_driver_s *dev, in_addr_t ipaddr)
   FAR struct arp_hdr_s *arp = ARPBUF;
   FAR struct eth_hdr_s *eth = ETHBUF;
 
+  /* The ARP request replaces any outgoing packet, including its payload */
+
+  netdev_iob_release(dev);
+
   /* Construct the ARP packet.  Creating both the Ethernet and ARP headers */
 
   memset(eth->dest, 0xff, ETHER_ADDR_LEN);
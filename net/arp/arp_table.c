@@ -49,6 +49,8 @@
 #include <sys/ioctl.h>
 #include <stdint.h>
 #include <string.h>
+#include <assert.h>
+#include <queue.h>
 #include <debug.h>
 
 #include <netinet/in.h>
@@ -72,6 +74,10 @@
 
 #define ARP_MAXAGE_TICK SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
 
+/* The number of hash chains examined by each call to arp_timer() */
+
+#define ARP_AGE_NCHAINS 4
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -82,13 +88,42 @@ struct arp_table_info_s
   FAR struct ether_addr *ai_ethaddr;  /* Location to return the MAC address */
 };
 
+/* One slot of the ARP table.  A slot in use is on one hash chain and on the
+ * LRU list; an unused slot is only on the free list.
+ */
+
+struct arp_table_entry_s
+{
+  dq_entry_t                    ae_node;   /* Free list or LRU list link */
+  FAR struct arp_table_entry_s *ae_hnext;  /* Next slot in the hash chain */
+  struct arp_entry_s            ae_entry;  /* The address mapping */
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
 /* The table of known address mappings */
 
-static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+static struct arp_table_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+
+/* The hash chains, indexed by arp_hash().  There is one chain per slot. */
+
+static FAR struct arp_table_entry_s *g_arphash[CONFIG_NET_ARPTAB_SIZE];
+
+/* The slots in use, least recently updated first.  Since each update moves
+ * the slot to the tail, this is also the order of at_time.
+ */
+
+static dq_queue_t g_arplru;
+
+/* The unused slots */
+
+static dq_queue_t g_arpfree;
+
+/* The next hash chain to be examined by arp_timer() */
+
+static unsigned int g_arpage;
 
 /****************************************************************************
  * Private Functions
@@ -141,38 +176,142 @@ static int arp_match(FAR struct net_driver_s *dev, FAR void *arg)
 }
 
 /****************************************************************************
- * Name: arp_return_old_entry
+ * Name: arp_hash
  *
  * Description:
- *   Compare and return the old ARP table entry.
+ *   Return the hash chain index of an IPv4 address.  All bytes are folded
+ *   in since the host part may be in either half depending on endianness.
  *
  ****************************************************************************/
 
-static FAR struct arp_entry_s *
-arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
+static inline unsigned int arp_hash(in_addr_t ipaddr)
 {
-  if (e1->at_ipaddr == 0)
-    {
-      return e1;
-    }
-  else if (e2->at_ipaddr == 0)
+  uint32_t hash = (uint32_t)ipaddr;
+
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return hash % CONFIG_NET_ARPTAB_SIZE;
+}
+
+/****************************************************************************
+ * Name: arp_hash_find
+ *
+ * Description:
+ *   Find the slot holding an IPv4 address, expired or not.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_table_entry_s *arp_hash_find(in_addr_t ipaddr)
+{
+  FAR struct arp_table_entry_s *ent;
+
+  for (ent = g_arphash[arp_hash(ipaddr)]; ent != NULL; ent = ent->ae_hnext)
     {
-      return e2;
+      if (net_ipv4addr_cmp(ipaddr, ent->ae_entry.at_ipaddr))
+        {
+          return ent;
+        }
     }
-  else if ((int)(e1->at_time - e2->at_time) <= 0)
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: arp_release
+ *
+ * Description:
+ *   Remove a slot from its hash chain and from the LRU list and return it
+ *   to the free list.
+ *
+ ****************************************************************************/
+
+static void arp_release(FAR struct arp_table_entry_s *ent)
+{
+  FAR struct arp_table_entry_s **prev;
+
+  for (prev = &g_arphash[arp_hash(ent->ae_entry.at_ipaddr)];
+       *prev != NULL;
+       prev = &(*prev)->ae_hnext)
     {
-      return e1;
+      if (*prev == ent)
+        {
+          *prev = ent->ae_hnext;
+          break;
+        }
     }
-  else
+
+  ent->ae_hnext = NULL;
+  memset(&ent->ae_entry, 0, sizeof(struct arp_entry_s));
+
+  dq_rem(&ent->ae_node, &g_arplru);
+  dq_addlast(&ent->ae_node, &g_arpfree);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: arp_initialize
+ *
+ * Description:
+ *   Initialize the ARP table.  Called once from net_initialize().
+ *
+ ****************************************************************************/
+
+void arp_initialize(void)
+{
+  int i;
+
+  dq_init(&g_arplru);
+  dq_init(&g_arpfree);
+
+  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; i++)
     {
-      return e2;
+      dq_addlast(&g_arptable[i].ae_node, &g_arpfree);
     }
 }
 
 /****************************************************************************
- * Public Functions
+ * Name: arp_timer
+ *
+ * Description:
+ *   Release the expired entries of the ARP table.  Each call examines only
+ *   ARP_AGE_NCHAINS hash chains, continuing where the previous call
+ *   stopped, so the whole table is swept over a number of calls.
+ *   Expired entries are never returned by arp_lookup() in any case; this
+ *   keeps them from lengthening the hash chains.
+ *
+ * Assumptions:
+ *   Called periodically from devif_timer().  The network must be locked.
+ *
  ****************************************************************************/
 
+void arp_timer(void)
+{
+  FAR struct arp_table_entry_s *ent;
+  FAR struct arp_table_entry_s *next;
+  clock_t now = clock_systime_ticks();
+  int i;
+
+  for (i = 0; i < ARP_AGE_NCHAINS && i < CONFIG_NET_ARPTAB_SIZE; i++)
+    {
+      for (ent = g_arphash[g_arpage]; ent != NULL; ent = next)
+        {
+          next = ent->ae_hnext;
+          if (now - ent->ae_entry.at_time > ARP_MAXAGE_TICK)
+            {
+              arp_release(ent);
+            }
+        }
+
+      if (++g_arpage >= CONFIG_NET_ARPTAB_SIZE)
+        {
+          g_arpage = 0;
+        }
+    }
+}
+
 /****************************************************************************
  * Name: arp_update
  *
@@ -197,44 +336,45 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
 int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
                FAR uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
-  int i;
+  FAR struct arp_table_entry_s *ent;
+  clock_t now = clock_systime_ticks();
+  unsigned int hash;
 
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
+  /* Try to find an entry to update.  If none is found, the IP -> MAC
+   * address mapping is inserted in an unused entry or, if the table is
+   * full, in place of the least recently updated entry.
    */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  ent = arp_hash_find(ipaddr);
+  if (ent != NULL)
     {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
-       */
-
-      if (g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
+      dq_rem(&ent->ae_node, &g_arplru);
+    }
+  else
+    {
+      if (dq_empty(&g_arpfree))
         {
-          /* An old entry found, break. */
-
-          tabptr = &g_arptable[i];
-          break;
+          arp_release((FAR struct arp_table_entry_s *)dq_peek(&g_arplru));
         }
-      else
-        {
-          /* Record the oldest entry. */
 
-          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
-        }
+      ent = (FAR struct arp_table_entry_s *)dq_remfirst(&g_arpfree);
+      DEBUGASSERT(ent != NULL);
+
+      hash                    = arp_hash(ipaddr);
+      ent->ae_entry.at_ipaddr = ipaddr;
+      ent->ae_hnext           = g_arphash[hash];
+      g_arphash[hash]         = ent;
     }
 
-  /* Now, tabptr is the ARP table entry which we will fill with the new
-   * information.
+  /* Now, ent is the ARP table entry which we will fill with the new
+   * information.  It becomes the most recently updated entry.
    */
 
-  tabptr->at_ipaddr = ipaddr;
-  memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
-  tabptr->at_dev = dev;
-  tabptr->at_time = clock_systime_ticks();
+  memcpy(ent->ae_entry.at_ethaddr.ether_addr_octet, ethaddr,
+         ETHER_ADDR_LEN);
+  ent->ae_entry.at_dev  = dev;
+  ent->ae_entry.at_time = now;
+  dq_addlast(&ent->ae_node, &g_arplru);
   return OK;
 }
 
@@ -286,19 +426,22 @@ void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
 
 FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
-  int i;
+  FAR struct arp_table_entry_s *ent;
+  clock_t now = clock_systime_ticks();
 
   /* Check if the IPv4 address is already in the ARP table. */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  ent = arp_hash_find(ipaddr);
+  if (ent != NULL)
     {
-      tabptr = &g_arptable[i];
-      if (net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
+      if (now - ent->ae_entry.at_time <= ARP_MAXAGE_TICK)
         {
-          return tabptr;
+          return &ent->ae_entry;
         }
+
+      /* The entry has expired */
+
+      arp_release(ent);
     }
 
   /* Not found */
@@ -385,16 +528,16 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
 
 void arp_delete(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
+  FAR struct arp_table_entry_s *ent;
 
   /* Check if the IPv4 address is in the ARP table. */
 
-  tabptr = arp_lookup(ipaddr);
-  if (tabptr != NULL)
+  ent = arp_hash_find(ipaddr);
+  if (ent != NULL)
     {
-      /* Yes.. Set the IP address to zero to "delete" it */
+      /* Yes.. Return the entry to the free list */
 
-      tabptr->at_ipaddr = 0;
+      arp_release(ent);
     }
 }
 
@@ -414,13 +557,17 @@ void arp_delete(in_addr_t ipaddr)
 
 void arp_cleanup(FAR struct net_driver_s *dev)
 {
-  int i;
+  FAR struct arp_table_entry_s *ent;
+  FAR struct arp_table_entry_s *next;
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  for (ent = (FAR struct arp_table_entry_s *)dq_peek(&g_arplru);
+       ent != NULL;
+       ent = next)
     {
-      if (dev == g_arptable[i].at_dev)
+      next = (FAR struct arp_table_entry_s *)dq_next(&ent->ae_node);
+      if (dev == ent->ae_entry.at_dev)
         {
-          memset(&g_arptable[i], 0, sizeof(g_arptable[i]));
+          arp_release(ent);
         }
     }
 }
@@ -449,22 +596,21 @@ void arp_cleanup(FAR struct net_driver_s *dev)
 unsigned int arp_snapshot(FAR struct arp_entry_s *snapshot,
                           unsigned int nentries)
 {
-  FAR struct arp_entry_s *tabptr;
+  FAR struct arp_table_entry_s *ent;
   clock_t now;
   unsigned int ncopied;
-  int i;
 
-  /* Copy all non-empty, non-expired entries in the ARP table. */
+  /* Copy all non-expired entries in the ARP table. */
 
-  for (i = 0, now = clock_systime_ticks(), ncopied = 0;
-       nentries > ncopied && i < CONFIG_NET_ARPTAB_SIZE;
-       i++)
+  for (ent = (FAR struct arp_table_entry_s *)dq_peek(&g_arplru),
+       now = clock_systime_ticks(), ncopied = 0;
+       nentries > ncopied && ent != NULL;
+       ent = (FAR struct arp_table_entry_s *)dq_next(&ent->ae_node))
     {
-      tabptr = &g_arptable[i];
-      if (tabptr->at_ipaddr != 0 &&
-          now - tabptr->at_time <= ARP_MAXAGE_TICK)
+      if (now - ent->ae_entry.at_time <= ARP_MAXAGE_TICK)
         {
-          memcpy(&snapshot[ncopied], tabptr, sizeof(struct arp_entry_s));
+          memcpy(&snapshot[ncopied], &ent->ae_entry,
+                 sizeof(struct arp_entry_s));
           ncopied++;
         }
     }
@@ -467,6 +467,11 @@ void devif_send(FAR struct net_driver_s *dev, FAR const void *buf, int len);
  *   This is identical to calling devif_send() except that the data is
  *   in an I/O buffer chain, rather than a flat buffer.
  *
+ *   If the driver can gather the payload from the I/O buffer chain
+ *   (NETDEV_FEATURE_SG), the data is not copied.  The chain is only
+ *   borrowed by the device then and must remain valid until the packet
+ *   has been sent.
+ *
  * Assumptions:
  *   This function must be called with the network locked.
  *
@@ -520,6 +525,61 @@ void devif_can_send(FAR struct net_driver_s *dev, FAR const void *buf,
                     unsigned int len);
 #endif
 
+/****************************************************************************
+ * Name: devif_gso_setup
+ *
+ * Description:
+ *   Allow the TCP connection that is polled next to send a super-segment
+ *   of more than one MSS, if the device can take one.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure that is polled
+ *   conn - The TCP connection that is polled next
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_GSO
+struct tcp_conn_s;
+void devif_gso_setup(FAR struct net_driver_s *dev,
+                     FAR struct tcp_conn_s *conn);
+#else
+#  define devif_gso_setup(dev,conn)
+#endif
+
+/****************************************************************************
+ * Name: devif_gso_output
+ *
+ * Description:
+ *   Pass the TCP packet that polling left in d_buf to the driver.  A
+ *   super-segment is split into segments of d_gsosize bytes first, and the
+ *   driver is called back for each of them.  If the driver stops accepting
+ *   packets, the data of the remaining segments is returned to the write
+ *   queue of the connection.
+ *
+ * Input Parameters:
+ *   dev      - The device driver structure with the packet to send
+ *   conn     - The TCP connection that produced the packet
+ *   callback - The driver callback that sends a packet
+ *
+ * Returned Value:
+ *   The return value of the last call to the callback.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_GSO
+int devif_gso_output(FAR struct net_driver_s *dev,
+                     FAR struct tcp_conn_s *conn,
+                     devif_poll_callback_t callback);
+#else
+#  define devif_gso_output(dev,conn,callback) (callback)(dev)
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
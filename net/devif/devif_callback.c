@@ -32,6 +32,7 @@
 #include <assert.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -48,6 +49,13 @@ static struct devif_callback_s g_cbprealloc[CONFIG_NET_NACTIVESOCKETS];
 #endif
 static FAR struct devif_callback_s *g_cbfreelist = NULL;
 
+/* The free list is shared by all protocols and is protected by a spinlock
+ * of its own rather than by the network lock.  The event lists that the
+ * callbacks are linked into still require the network lock.
+ */
+
+static spinlock_t g_cblock;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -70,23 +78,12 @@ static void devif_callback_free(FAR struct net_driver_s *dev,
 {
   FAR struct devif_callback_s *prev;
   FAR struct devif_callback_s *curr;
+  irqstate_t flags;
 
   if (cb)
     {
       net_lock();
 
-#ifdef CONFIG_DEBUG_FEATURES
-      /* Check for double freed callbacks */
-
-      curr = g_cbfreelist;
-
-      while (curr != NULL)
-        {
-          DEBUGASSERT(cb != curr);
-          curr = curr->nxtconn;
-        }
-#endif
-
       /* Remove the callback structure from the device notification list if
        * it is supposed to be in the device notification list.
        */
@@ -166,9 +163,24 @@ static void devif_callback_free(FAR struct net_driver_s *dev,
 
       /* Put the structure into the free list */
 
+      flags = spin_lock_irqsave(&g_cblock);
+
+#ifdef CONFIG_DEBUG_FEATURES
+      /* Check for double freed callbacks */
+
+      curr = g_cbfreelist;
+
+      while (curr != NULL)
+        {
+          DEBUGASSERT(cb != curr);
+          curr = curr->nxtconn;
+        }
+#endif
+
       cb->nxtconn  = g_cbfreelist;
       cb->nxtdev   = NULL;
       g_cbfreelist = cb;
+      spin_unlock_irqrestore(&g_cblock, flags);
       net_unlock();
     }
 }
@@ -264,8 +276,10 @@ FAR struct devif_callback_s *
 {
   FAR struct devif_callback_s *ret;
 #ifdef CONFIG_NET_ALLOC_CONNS
+  FAR struct devif_callback_s *pool;
   int i;
 #endif
+  irqstate_t flags;
 
   net_lock();
 
@@ -288,32 +302,42 @@ FAR struct devif_callback_s *
       return NULL;
     }
 
-  /* Allocate the callback entry from heap */
+  /* Allocate the callback entry from heap.  The heap may block, so the
+   * new entries are allocated before the free list is locked.
+   */
 
 #ifdef CONFIG_NET_ALLOC_CONNS
   if (g_cbfreelist == NULL)
     {
-      ret = kmm_zalloc(sizeof(struct devif_callback_s) *
-                       CONFIG_NET_NACTIVESOCKETS);
-      if (ret != NULL)
+      pool = kmm_zalloc(sizeof(struct devif_callback_s) *
+                        CONFIG_NET_NACTIVESOCKETS);
+      if (pool != NULL)
         {
+          flags = spin_lock_irqsave(&g_cblock);
           for (i = 0; i < CONFIG_NET_NACTIVESOCKETS; i++)
             {
-              ret[i].nxtconn = g_cbfreelist;
-              g_cbfreelist = &ret[i];
+              pool[i].nxtconn = g_cbfreelist;
+              g_cbfreelist = &pool[i];
             }
+
+          spin_unlock_irqrestore(&g_cblock, flags);
         }
     }
 #endif
 
-  /* Check the head of the free list */
+  /* Remove the next instance from the head of the free list */
 
+  flags = spin_lock_irqsave(&g_cblock);
   ret = g_cbfreelist;
   if (ret)
     {
-      /* Remove the next instance from the head of the free list */
-
       g_cbfreelist = ret->nxtconn;
+    }
+
+  spin_unlock_irqrestore(&g_cblock, flags);
+
+  if (ret)
+    {
       memset(ret, 0, sizeof(struct devif_callback_s));
 
       /* Add the newly allocated instance to the head of the device event
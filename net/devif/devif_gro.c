@@ -0,0 +1,498 @@
+/****************************************************************************
+ * net/devif/devif_gro.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "devif/devif.h"
+#include "tcp/tcp.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_TCP_GRO
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define GRO_BUFSIZE CONFIG_NET_TCP_GRO_MAXSIZE
+#define GRO_BUF     ((FAR uint8_t *)g_gro_buffer)
+
+#define IPv4BUF     ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+#define GROIPv4BUF  ((FAR struct ipv4_hdr_s *)&GRO_BUF[NET_LL_HDRLEN(dev)])
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The TCP segments held back for merging.  There is only one set of held
+ * segments.  Drivers pass them on at the end of each batch of received
+ * packets, while the network is still locked, so no other device will
+ * find them held.
+ */
+
+struct devif_gro_s
+{
+  FAR struct net_driver_s *dev; /* The device holding segments, or NULL */
+  bool     busy;                /* The held segments are being passed on */
+  uint16_t len;                 /* Length of the merged packet in GRO_BUF */
+  uint16_t hdrlen;              /* Length of its link, IP and TCP headers */
+  uint16_t segsize;             /* Payload size of the first segment */
+  uint16_t sum;                 /* Raw checksum of the merged payload */
+  uint32_t nextseq;             /* Sequence number of the next segment */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct devif_gro_s g_gro;
+
+/* The merged packet is built here, link layer header included */
+
+static uint32_t g_gro_buffer[(GRO_BUFSIZE + 3) / 4];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_gro_add
+ *
+ * Description:
+ *   One's complement addition of two raw checksums.
+ *
+ ****************************************************************************/
+
+static inline uint16_t devif_gro_add(uint16_t sum, uint16_t t)
+{
+  sum += t;
+  if (sum < t)
+    {
+      sum++; /* carry */
+    }
+
+  return sum;
+}
+
+/****************************************************************************
+ * Name: devif_gro_hdrsum
+ *
+ * Description:
+ *   Calculate the raw checksum of the TCP pseudo-header and the TCP header
+ *   of an IPv4 packet.
+ *
+ ****************************************************************************/
+
+static uint16_t devif_gro_hdrsum(FAR struct ipv4_hdr_s *ipv4,
+                                 FAR struct tcp_hdr_s *tcp,
+                                 unsigned int tcphdrlen,
+                                 unsigned int paylen)
+{
+  uint16_t sum;
+
+  sum = tcphdrlen + paylen + IP_PROTO_TCP;
+  sum = chksum(sum, (FAR uint8_t *)&ipv4->srcipaddr, 2 * sizeof(in_addr_t));
+  return chksum(sum, (FAR uint8_t *)tcp, tcphdrlen);
+}
+
+/****************************************************************************
+ * Name: devif_gro_candidate
+ *
+ * Description:
+ *   Check if the IPv4 packet in d_buf is a TCP data segment addressed to
+ *   this device that may be merged with others.
+ *
+ * Returned Value:
+ *   The TCP payload length if the packet can be merged, otherwise zero.
+ *
+ ****************************************************************************/
+
+static unsigned int devif_gro_candidate(FAR struct net_driver_s *dev,
+                                        FAR unsigned int *tcphdrlen)
+{
+  FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int llhdrlen = NET_LL_HDRLEN(dev);
+  unsigned int totlen;
+
+  /* The packet in d_buf and the response to the held segments must fit
+   * into the GRO buffer together.
+   */
+
+  if (2 * NETDEV_PKTSIZE(dev) > GRO_BUFSIZE ||
+      dev->d_len < llhdrlen + IPv4_HDRLEN + TCP_HDRLEN)
+    {
+      return 0;
+    }
+
+  /* Plain IPv4 header without options or fragmentation */
+
+  totlen = ((uint16_t)ipv4->len[0] << 8) + ipv4->len[1];
+  if (ipv4->vhl != 0x45 || ipv4->proto != IP_PROTO_TCP ||
+      (ipv4->ipoffset[0] & 0x3f) != 0 || ipv4->ipoffset[1] != 0 ||
+      totlen > dev->d_len - llhdrlen ||
+      totlen < IPv4_HDRLEN + TCP_HDRLEN ||
+      !net_ipv4addr_cmp(net_ip4addr_conv32(ipv4->destipaddr),
+                        dev->d_ipaddr) ||
+      ipv4_chksum(dev) != 0xffff)
+    {
+      return 0;
+    }
+
+  /* Data segments that only carry ACK and maybe PSH */
+
+  tcp        = (FAR struct tcp_hdr_s *)(ipv4 + 1);
+  *tcphdrlen = (tcp->tcpoffset >> 4) << 2;
+  if (*tcphdrlen < TCP_HDRLEN ||
+      *tcphdrlen >= totlen - IPv4_HDRLEN ||
+      (tcp->flags & TCP_CTL & ~TCP_PSH) != TCP_ACK)
+    {
+      return 0;
+    }
+
+  return totlen - IPv4_HDRLEN - *tcphdrlen;
+}
+
+/****************************************************************************
+ * Name: devif_gro_hold
+ *
+ * Description:
+ *   Start a new merged packet with the TCP segment in d_buf.
+ *
+ * Returned Value:
+ *   True if the segment is held, false if its checksum is bad.
+ *
+ ****************************************************************************/
+
+static bool devif_gro_hold(FAR struct net_driver_s *dev,
+                           unsigned int tcphdrlen, unsigned int paylen)
+{
+  FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+  FAR struct tcp_hdr_s *tcp = (FAR struct tcp_hdr_s *)(ipv4 + 1);
+  unsigned int hdrlen;
+  uint16_t sum;
+
+  hdrlen = NET_LL_HDRLEN(dev) + IPv4_HDRLEN + tcphdrlen;
+
+  /* Copy the headers and the payload, summing the payload on the way */
+
+  memcpy(GRO_BUF, dev->d_buf, hdrlen);
+  g_gro.sum = chksum_copy(0, &GRO_BUF[hdrlen], &dev->d_buf[hdrlen],
+                          paylen);
+
+  sum = devif_gro_hdrsum(ipv4, tcp, tcphdrlen, paylen);
+  if (devif_gro_add(sum, g_gro.sum) != 0xffff)
+    {
+      return false;
+    }
+
+  g_gro.dev     = dev;
+  g_gro.len     = hdrlen + paylen;
+  g_gro.hdrlen  = hdrlen;
+  g_gro.segsize = paylen;
+  g_gro.nextseq = tcp_getsequence(tcp->seqno) + paylen;
+  return true;
+}
+
+/****************************************************************************
+ * Name: devif_gro_merge
+ *
+ * Description:
+ *   Append the payload of the TCP segment in d_buf to the merged packet if
+ *   it is the next segment of the same connection.
+ *
+ * Returned Value:
+ *   A negative value if the segment cannot be merged, zero if it was
+ *   merged, and a positive value if it was merged and the merged packet
+ *   should be passed on now.
+ *
+ ****************************************************************************/
+
+static int devif_gro_merge(FAR struct net_driver_s *dev,
+                           unsigned int tcphdrlen, unsigned int paylen)
+{
+  FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+  FAR struct tcp_hdr_s *tcp = (FAR struct tcp_hdr_s *)(ipv4 + 1);
+  FAR struct ipv4_hdr_s *gipv4 = GROIPv4BUF;
+  FAR struct tcp_hdr_s *gtcp = (FAR struct tcp_hdr_s *)(gipv4 + 1);
+  uint16_t paysum;
+  uint16_t sum;
+
+  /* Same connection, same headers apart from the sequence number, the
+   * window and PSH, and the data follows the held data directly.
+   */
+
+  if (g_gro.hdrlen != NET_LL_HDRLEN(dev) + IPv4_HDRLEN + tcphdrlen ||
+      paylen > g_gro.segsize ||
+      g_gro.len + paylen > GRO_BUFSIZE ||
+      ipv4->tos != gipv4->tos || ipv4->ttl != gipv4->ttl ||
+      memcmp(ipv4->srcipaddr, gipv4->srcipaddr, sizeof(in_addr_t)) != 0 ||
+      tcp->srcport != gtcp->srcport || tcp->destport != gtcp->destport ||
+      tcp_getsequence(tcp->seqno) != g_gro.nextseq ||
+      memcmp(tcp->ackno, gtcp->ackno, 4) != 0 ||
+      memcmp(tcp->optdata, gtcp->optdata, tcphdrlen - TCP_HDRLEN) != 0)
+    {
+      return -1;
+    }
+
+  paysum = chksum_copy(0, &GRO_BUF[g_gro.len],
+                       &dev->d_buf[g_gro.hdrlen], paylen);
+
+  sum = devif_gro_hdrsum(ipv4, tcp, tcphdrlen, paylen);
+  if (devif_gro_add(sum, paysum) != 0xffff)
+    {
+      return -1;
+    }
+
+  /* Data that starts at an odd offset forms the opposite halves of the
+   * 16-bit words of the checksum.
+   */
+
+  if (((g_gro.len - g_gro.hdrlen) & 1) != 0)
+    {
+      paysum = (uint16_t)((paysum << 8) | (paysum >> 8));
+    }
+
+  g_gro.sum      = devif_gro_add(g_gro.sum, paysum);
+  g_gro.len     += paylen;
+  g_gro.nextseq += paylen;
+
+  gtcp->wnd[0]   = tcp->wnd[0];
+  gtcp->wnd[1]   = tcp->wnd[1];
+  gtcp->flags   |= tcp->flags & TCP_PSH;
+
+  /* A short segment or PSH ends the burst */
+
+  return (paylen < g_gro.segsize || (tcp->flags & TCP_PSH) != 0) ? 1 : 0;
+}
+
+/****************************************************************************
+ * Name: devif_gro_deliver
+ *
+ * Description:
+ *   Pass the merged packet to ipv4_input() and send the response through
+ *   the driver callback.  If save is true, d_buf holds a received packet
+ *   that has not been handled yet.  It is preserved.
+ *
+ ****************************************************************************/
+
+static void devif_gro_deliver(FAR struct net_driver_s *dev,
+                              devif_poll_callback_t callback, bool save)
+{
+  FAR struct ipv4_hdr_s *ipv4 = GROIPv4BUF;
+  FAR struct tcp_hdr_s *tcp = (FAR struct tcp_hdr_s *)(ipv4 + 1);
+  FAR uint8_t *buf = dev->d_buf;
+  unsigned int tcphdrlen;
+  unsigned int paylen;
+  unsigned int replen;
+  unsigned int saveofs;
+  uint16_t curlen = save ? dev->d_len : 0;
+  uint16_t iplen;
+  uint16_t sum;
+
+  g_gro.dev  = NULL;
+  g_gro.busy = true;
+
+  /* Fix up the headers of the merged packet */
+
+  iplen        = g_gro.len - NET_LL_HDRLEN(dev);
+  tcphdrlen    = g_gro.hdrlen - NET_LL_HDRLEN(dev) - IPv4_HDRLEN;
+  paylen       = g_gro.len - g_gro.hdrlen;
+
+  ipv4->len[0] = iplen >> 8;
+  ipv4->len[1] = iplen & 0xff;
+
+  tcp->tcpchksum = 0;
+  sum            = devif_gro_hdrsum(ipv4, tcp, tcphdrlen, paylen);
+  sum            = devif_gro_add(sum, g_gro.sum);
+  tcp->tcpchksum = ~((sum == 0) ? 0xffff : HTONS(sum));
+
+  /* Let the network process it in the GRO buffer */
+
+  dev->d_buf = GRO_BUF;
+  dev->d_len = g_gro.len;
+
+  ipv4->ipchksum = 0;
+  ipv4->ipchksum = ~ipv4_chksum(dev);
+
+  dev->d_gro = true;
+  ipv4_input(dev);
+  dev->d_gro = false;
+
+  dev->d_buf = buf;
+
+  /* Send the response from the driver's buffer */
+
+  if (dev->d_len > 0)
+    {
+      replen = NET_LL_HDRLEN(dev) + dev->d_len;
+#ifdef CONFIG_NETDEV_IOB_SG
+      if (dev->d_iob != NULL)
+        {
+          replen -= dev->d_ioblen;
+        }
+#endif
+
+      if (replen > NETDEV_PKTSIZE(dev))
+        {
+          nwarn("WARNING: Response too large: %u\n", replen);
+          netdev_iob_release(dev);
+        }
+      else
+        {
+          /* Move the unhandled packet out of the way behind the
+           * response.
+           */
+
+          saveofs = (replen + 3) & ~3;
+          if (curlen > 0)
+            {
+              DEBUGASSERT(saveofs + curlen <= GRO_BUFSIZE);
+              memcpy(&GRO_BUF[saveofs], dev->d_buf, curlen);
+            }
+
+          memcpy(dev->d_buf, GRO_BUF, replen);
+          callback(dev);
+          netdev_iob_release(dev);
+
+          if (curlen > 0)
+            {
+              memcpy(dev->d_buf, &GRO_BUF[saveofs], curlen);
+            }
+        }
+    }
+
+  dev->d_len = curlen;
+  g_gro.busy = false;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv4_gro_input
+ *
+ * Description:
+ *   Handle a received IPv4 packet like ipv4_input(), but hold back in-order
+ *   TCP data segments of the same connection and merge them, so that the
+ *   TCP input logic processes them as one segment.
+ *
+ * Input Parameters:
+ *   dev      - The device driver structure with the received packet
+ *   callback - The driver callback that sends a packet
+ *
+ * Returned Value:
+ *   As for ipv4_input().  A packet that was held back returns OK with
+ *   d_len set to zero.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+int ipv4_gro_input(FAR struct net_driver_s *dev,
+                   devif_poll_callback_t callback)
+{
+  unsigned int tcphdrlen;
+  unsigned int paylen;
+  int ret;
+
+  /* The GRO buffer is in use while held segments are passed on, and
+   * another device would have passed on its segments already.
+   */
+
+  if (g_gro.busy || (g_gro.dev != NULL && g_gro.dev != dev))
+    {
+      return ipv4_input(dev);
+    }
+
+  paylen = devif_gro_candidate(dev, &tcphdrlen);
+  if (g_gro.dev != NULL)
+    {
+      if (paylen > 0)
+        {
+          ret = devif_gro_merge(dev, tcphdrlen, paylen);
+          if (ret >= 0)
+            {
+              dev->d_len = 0;
+              if (ret > 0)
+                {
+                  devif_gro_deliver(dev, callback, false);
+                }
+
+              return OK;
+            }
+        }
+
+      /* Pass on the held segments before this packet */
+
+      devif_gro_deliver(dev, callback, true);
+    }
+
+  if (paylen > 0 && devif_gro_hold(dev, tcphdrlen, paylen))
+    {
+      dev->d_len = 0;
+      return OK;
+    }
+
+  return ipv4_input(dev);
+}
+
+/****************************************************************************
+ * Name: devif_gro_flush
+ *
+ * Description:
+ *   Pass on the TCP segments that the device holds back for merging.  The
+ *   driver must call this at the end of each batch of received packets,
+ *   when its packet buffer is free.
+ *
+ * Input Parameters:
+ *   dev      - The device driver structure
+ *   callback - The driver callback that sends a packet
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+void devif_gro_flush(FAR struct net_driver_s *dev,
+                     devif_poll_callback_t callback)
+{
+  if (g_gro.dev == dev && !g_gro.busy)
+    {
+      devif_gro_deliver(dev, callback, false);
+    }
+}
+
+#endif /* CONFIG_NET_TCP_GRO */
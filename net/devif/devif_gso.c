@@ -0,0 +1,386 @@
+/****************************************************************************
+ * net/devif/devif_gso.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "devif/devif.h"
+#include "inet/inet.h"
+#include "tcp/tcp.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_TCP_GSO
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The IP and TCP headers of a super-segment are saved in a buffer of this
+ * size while it is split.  The IPv6 header is the larger one.
+ */
+
+#ifdef CONFIG_NET_IPv6
+#  define GSO_MAX_HDRLEN (IPv6_HDRLEN + TCP_MAX_HDRLEN)
+#else
+#  define GSO_MAX_HDRLEN (IPv4_HDRLEN + TCP_MAX_HDRLEN)
+#endif
+
+#define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+#define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_gso_header
+ *
+ * Description:
+ *   Adapt the IP and TCP headers copied from the super-segment to one of
+ *   its segments and calculate the checksums.  The payload of the segment
+ *   must already be in place.
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure with the segment in d_buf
+ *   tcp    - The TCP header of the segment in d_buf
+ *   seqno  - The sequence number of the segment
+ *   flags  - The TCP flags of the segment
+ *   first  - True for the first segment of the super-segment
+ *
+ ****************************************************************************/
+
+static void devif_gso_header(FAR struct net_driver_s *dev,
+                             FAR struct tcp_hdr_s *tcp, uint32_t seqno,
+                             uint8_t flags, bool first)
+{
+  tcp_setsequence(tcp->seqno, seqno);
+  tcp->flags     = flags;
+  tcp->tcpchksum = 0;
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+      uint16_t iplen = dev->d_len - IPv6_HDRLEN;
+
+      ipv6->len[0]   = (iplen >> 8);
+      ipv6->len[1]   = (iplen & 0xff);
+      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+      ipv4->len[0]   = (dev->d_len >> 8);
+      ipv4->len[1]   = (dev->d_len & 0xff);
+      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+
+      /* The first segment keeps the IP ID of the super-segment */
+
+      if (!first)
+        {
+          ++g_ipid;
+          ipv4->ipid[0] = g_ipid >> 8;
+          ipv4->ipid[1] = g_ipid & 0xff;
+        }
+
+      ipv4->ipchksum = 0;
+      ipv4->ipchksum = ~ipv4_chksum(dev);
+    }
+#endif /* CONFIG_NET_IPv4 */
+}
+
+/****************************************************************************
+ * Name: devif_gso_looped
+ *
+ * Description:
+ *   Return true if the packets of a TCP connection are looped back to the
+ *   input logic from within the driver callback, either by the loopback
+ *   device or by devif_loopback() because they are addressed to the device
+ *   itself.
+ *
+ ****************************************************************************/
+
+static bool devif_gso_looped(FAR struct net_driver_s *dev,
+                             FAR struct tcp_conn_s *conn)
+{
+  if (dev->d_lltype == NET_LL_LOOPBACK)
+    {
+      return true;
+    }
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (conn->domain == PF_INET6)
+#endif
+    {
+      return net_ipv6addr_cmp(conn->u.ipv6.raddr, dev->d_ipv6addr);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      return net_ipv4addr_cmp(conn->u.ipv4.raddr, dev->d_ipaddr);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_gso_setup
+ *
+ * Description:
+ *   Allow the TCP connection that is polled next to send a super-segment
+ *   of more than one MSS, if the device can take one.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure that is polled
+ *   conn - The TCP connection that is polled next
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+void devif_gso_setup(FAR struct net_driver_s *dev,
+                     FAR struct tcp_conn_s *conn)
+{
+  dev->d_gsosize = 0;
+  dev->d_gsomax  = CONFIG_NET_TCP_GSO_MAXSIZE;
+
+  /* devif_gso_output() splits a super-segment using the I/O buffer chain
+   * of the write buffer, which stays in the write queue.  A looped back
+   * segment is received from within the driver callback, and the ACK
+   * that this produces could trim or free that write buffer before the
+   * remaining segments are sent.  Such connections send one MSS at a
+   * time.
+   */
+
+  if (devif_gso_looped(dev, conn))
+    {
+      dev->d_gsomax = 0;
+    }
+
+#ifdef CONFIG_NET_6LOWPAN
+  /* Packets for radios are converted to frames by 6LoWPAN instead */
+
+  if (dev->d_lltype == NET_LL_IEEE802154 ||
+      dev->d_lltype == NET_LL_PKTRADIO)
+    {
+      dev->d_gsomax = 0;
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: devif_gso_output
+ *
+ * Description:
+ *   Pass the TCP packet that polling left in d_buf to the driver.  A
+ *   super-segment is split into segments of d_gsosize bytes first, and the
+ *   driver is called back for each of them.  If the driver stops accepting
+ *   packets, the data of the remaining segments is returned to the write
+ *   queue of the connection.
+ *
+ *   The payload is used in place in the write buffer, so the callback must
+ *   not pass packets of the connection to the input logic.  This is why
+ *   devif_gso_setup() does not allow super-segments that are looped back.
+ *
+ * Input Parameters:
+ *   dev      - The device driver structure with the packet to send
+ *   conn     - The TCP connection that produced the packet
+ *   callback - The driver callback that sends a packet
+ *
+ * Returned Value:
+ *   The return value of the last call to the callback.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+int devif_gso_output(FAR struct net_driver_s *dev,
+                     FAR struct tcp_conn_s *conn,
+                     devif_poll_callback_t callback)
+{
+  uint8_t hdr[GSO_MAX_HDRLEN];
+  FAR struct tcp_hdr_s *tcp;
+  FAR struct iob_s *iob;
+  unsigned int llhdrlen;
+  unsigned int hdrlen;
+  unsigned int iphdrlen;
+  unsigned int iobofs;
+  unsigned int total;
+  unsigned int offset;
+  unsigned int seglen;
+  uint16_t mss;
+  uint32_t seqno;
+  uint8_t flags;
+  int bstop = 0;
+
+  /* Super-segments are only built while the connection is polled */
+
+  mss            = dev->d_gsosize;
+  dev->d_gsosize = 0;
+  dev->d_gsomax  = 0;
+
+  if (mss == 0 || dev->d_len == 0 || dev->d_iob == NULL ||
+      dev->d_ioblen <= mss)
+    {
+      return callback(dev);
+    }
+
+  /* Save the headers; the driver may replace d_buf while it sends */
+
+  llhdrlen = NET_LL_HDRLEN(dev);
+  hdrlen   = dev->d_len - dev->d_ioblen;
+  if (hdrlen > GSO_MAX_HDRLEN)
+    {
+      nerr("ERROR: Bad super-segment header length: %u\n", hdrlen);
+      netdev_iob_release(dev);
+      dev->d_len = 0;
+      return callback(dev);
+    }
+
+  memcpy(hdr, &dev->d_buf[llhdrlen], hdrlen);
+
+  /* TCP output never adds IP options or IPv6 extension headers */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      iphdrlen = IPv6_HDRLEN;
+    }
+#endif
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      iphdrlen = IPv4_HDRLEN;
+    }
+#endif
+
+  tcp       = (FAR struct tcp_hdr_s *)&hdr[iphdrlen];
+  seqno     = tcp_getsequence(tcp->seqno);
+  flags     = tcp->flags;
+
+  iob       = dev->d_iob;
+  iobofs    = dev->d_iobofs;
+  total     = dev->d_ioblen;
+
+  /* The chain is only borrowed from the write buffer */
+
+  DEBUGASSERT(dev->d_iobuser == IOBUSER_UNKNOWN);
+  netdev_iob_release(dev);
+
+  for (offset = 0; offset < total && !bstop; offset += seglen)
+    {
+      seglen = total - offset;
+      if (seglen > mss)
+        {
+          seglen = mss;
+        }
+
+      memcpy(&dev->d_buf[llhdrlen], hdr, hdrlen);
+      dev->d_len    = hdrlen + seglen;
+      dev->d_sndlen = seglen;
+
+      /* Leave the payload in the I/O buffer chain if the driver can
+       * gather it, otherwise copy it behind the headers.
+       */
+
+      if ((dev->d_features & NETDEV_FEATURE_SG) != 0)
+        {
+          dev->d_iob     = iob;
+          dev->d_iobofs  = iobofs + offset;
+          dev->d_ioblen  = seglen;
+          dev->d_iobuser = IOBUSER_UNKNOWN;
+          dev->d_iobsum  = -1;
+        }
+      else
+        {
+          iob_copyout(&dev->d_buf[llhdrlen + hdrlen], iob, seglen,
+                      iobofs + offset);
+        }
+
+      /* Only the last segment carries FIN and PSH */
+
+      devif_gso_header(dev, (FAR struct tcp_hdr_s *)
+                       &dev->d_buf[llhdrlen + iphdrlen],
+                       seqno + offset,
+                       offset + seglen < total ?
+                       flags & ~(TCP_FIN | TCP_PSH) : flags,
+                       offset == 0);
+
+#ifdef CONFIG_NET_STATISTICS
+      if (offset > 0)
+        {
+          g_netstats.tcp.sent++;
+        }
+#endif
+
+      /* Call back into the driver */
+
+      bstop = callback(dev);
+      netdev_iob_release(dev);
+    }
+
+  /* Requeue the data that the driver did not take */
+
+  if (offset < total)
+    {
+      dev->d_len = 0;
+      tcp_gso_unsent(conn, seqno + offset, total - offset);
+    }
+
+  return bstop;
+}
+
+#endif /* CONFIG_NET_TCP_GSO */
@@ -47,6 +47,11 @@
  *   This is identical to calling devif_send() except that the data is
  *   in an I/O buffer chain, rather than a flat buffer.
  *
+ *   If the driver can gather the payload from the I/O buffer chain
+ *   (NETDEV_FEATURE_SG), the data is not copied.  The chain is only
+ *   borrowed by the device then and must remain valid until the packet
+ *   has been sent.
+ *
  * Assumptions:
  *   Called with the network locked.
  *
@@ -55,7 +60,41 @@
 void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
                     unsigned int len, unsigned int offset)
 {
+#ifdef CONFIG_NET_TCP_GSO
+  DEBUGASSERT(dev && len > 0 &&
+              (len < NETDEV_PKTSIZE(dev) || dev->d_gsosize > 0));
+#else
   DEBUGASSERT(dev && len > 0 && len < NETDEV_PKTSIZE(dev));
+#endif
+
+#ifdef CONFIG_NETDEV_IOB_SG
+  /* Release any payload left over from a packet that was not sent */
+
+  netdev_iob_release(dev);
+
+#ifdef CONFIG_NET_TCP_GSO
+  /* A TCP super-segment does not fit into d_buf.  It is also left in the
+   * I/O buffer chain and split up by devif_gso_output().
+   */
+
+  if ((dev->d_features & NETDEV_FEATURE_SG) != 0 || dev->d_gsosize > 0)
+#else
+  if ((dev->d_features & NETDEV_FEATURE_SG) != 0)
+#endif
+    {
+      /* Leave the data in the I/O buffer chain; the driver will gather it
+       * behind the headers.
+       */
+
+      dev->d_iob     = iob;
+      dev->d_iobofs  = offset;
+      dev->d_ioblen  = len;
+      dev->d_iobuser = IOBUSER_UNKNOWN;
+      dev->d_iobsum  = -1;
+      dev->d_sndlen  = len;
+      return;
+    }
+#endif
 
   /* Copy the data from the I/O buffer chain to the device buffer */
 
@@ -99,6 +99,10 @@ int devif_loopback(FAR struct net_driver_s *dev)
        NETDEV_TXPACKETS(dev);
        NETDEV_RXPACKETS(dev);
 
+      /* The input logic expects the whole packet in d_buf */
+
+      netdev_iob_linearize(dev);
+
 #ifdef CONFIG_NET_PKT
       /* When packet sockets are enabled, feed the frame into the tap */
 
@@ -142,5 +146,6 @@ int devif_loopback(FAR struct net_driver_s *dev)
     }
   while (dev->d_len > 0);
 
+  netdev_iob_release(dev);
   return 1;
 }
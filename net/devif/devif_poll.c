@@ -44,6 +44,7 @@
 #include "igmp/igmp.h"
 #include "icmpv6/icmpv6.h"
 #include "mld/mld.h"
+#include "neighbor/neighbor.h"
 #include "ipforward/ipforward.h"
 #include "sixlowpan/sixlowpan.h"
 
@@ -562,6 +563,12 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
           /* Call back into the driver */
 
           bstop = callback(dev);
+
+          /* Drop any payload left in d_iob, whether or not the driver
+           * sent the packet.
+           */
+
+          netdev_iob_release(dev);
         }
     }
 
@@ -596,17 +603,41 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
 
       if (dev == conn->dev)
         {
-          /* Perform the TCP TX poll */
+          /* The connection may send a super-segment of several MSS */
 
-          tcp_poll(dev, conn);
+          devif_gso_setup(dev, conn);
+
+#ifdef CONFIG_NET_TCP_CONN_TIMER
+          /* Handle an expired timer of this connection or perform the
+           * TCP TX poll.
+           */
+
+          if (conn->timeout)
+            {
+              conn->timeout = false;
+              tcp_timer(dev, conn);
+            }
+          else
+#endif
+            {
+              tcp_poll(dev, conn);
+            }
 
           /* Perform any necessary conversions on outgoing packets */
 
           devif_packet_conversion(dev, DEVIF_TCP);
 
-          /* Call back into the driver */
+          /* Call back into the driver, once for each segment of a
+           * super-segment.
+           */
 
-          bstop = callback(dev);
+          bstop = devif_gso_output(dev, conn, callback);
+
+          /* Drop any payload left in d_iob, whether or not the driver
+           * sent the packet.
+           */
+
+          netdev_iob_release(dev);
         }
     }
 
@@ -629,10 +660,9 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-#ifdef NET_TCP_HAVE_STACK
+#if defined(NET_TCP_HAVE_STACK) && !defined(CONFIG_NET_TCP_CONN_TIMER)
 static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
-                                       devif_poll_callback_t callback,
-                                       int hsec)
+                                       devif_poll_callback_t callback)
 {
   FAR struct tcp_conn_s *conn  = NULL;
   int bstop = 0;
@@ -647,24 +677,36 @@ static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
 
       if (dev == conn->dev)
         {
+          /* The connection may send a super-segment of several MSS */
+
+          devif_gso_setup(dev, conn);
+
           /* Perform the TCP timer poll */
 
-          tcp_timer(dev, conn, hsec);
+          tcp_timer(dev, conn);
 
           /* Perform any necessary conversions on outgoing packets */
 
           devif_packet_conversion(dev, DEVIF_TCP);
 
-          /* Call back into the driver */
+          /* Call back into the driver, once for each segment of a
+           * super-segment.
+           */
 
-          bstop = callback(dev);
+          bstop = devif_gso_output(dev, conn, callback);
+
+          /* Drop any payload left in d_iob, whether or not the driver
+           * sent the packet.
+           */
+
+          netdev_iob_release(dev);
         }
     }
 
   return bstop;
 }
 #else
-# define devif_poll_tcp_timer(dev, callback, hsec) (0)
+# define devif_poll_tcp_timer(dev, callback) (0)
 #endif
 
 /****************************************************************************
@@ -849,18 +891,25 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
 int devif_timer(FAR struct net_driver_s *dev, int delay,
                 devif_poll_callback_t callback)
 {
-#if defined(NET_TCP_HAVE_STACK)
-  int hsec = TICK2HSEC(delay);
-#endif
   int bstop = false;
 
-#ifdef NET_TCP_HAVE_STACK
+#ifdef CONFIG_NET_ARP
+  /* Release a few of the expired ARP table entries */
+
+  arp_timer();
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  /* Release a few of the expired Neighbor table entries */
+
+  neighbor_timer();
+#endif
+
   /* Traverse all of the active TCP connections and perform the
-   * timer action.
+   * timer action, unless each connection runs its own timer.
    */
 
-  bstop = devif_poll_tcp_timer(dev, callback, hsec);
-#endif
+  bstop = devif_poll_tcp_timer(dev, callback);
 
   /* If possible, continue with a normal poll checking for pending
    * network driver actions.
@@ -151,6 +151,12 @@ int ipv4_input(FAR struct net_driver_s *dev)
   g_netstats.ipv4.recv++;
 #endif
 
+  /* d_buf holds a received packet now.  Drop any outgoing payload that
+   * was left in d_iob.
+   */
+
+  netdev_iob_release(dev);
+
   /* Start of IP input header processing code.
    *
    * Check validity of the IP header.
@@ -235,6 +235,12 @@ int ipv6_input(FAR struct net_driver_s *dev)
   g_netstats.ipv6.recv++;
 #endif
 
+  /* d_buf holds a received packet now.  Drop any outgoing payload that
+   * was left in d_iob.
+   */
+
+  netdev_iob_release(dev);
+
   /* Start of IP input header processing code.
    *
    * Check validity of the IP header.
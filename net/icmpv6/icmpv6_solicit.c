@@ -90,6 +90,10 @@ void icmpv6_solicit(FAR struct net_driver_s *dev,
   uint16_t lladdrsize;
   uint16_t l3size;
 
+  /* The solicitation replaces any outgoing packet, including its payload */
+
+  netdev_iob_release(dev);
+
   /* Set up the IPv6 header (most is probably already in place) */
 
   ipv6          = IPv6BUF;
@@ -31,6 +31,7 @@
 #include <sys/un.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <queue.h>
 #include <stdint.h>
 #include <poll.h>
@@ -39,6 +40,8 @@
 #include <nuttx/net/net.h>
 #include <nuttx/semaphore.h>
 
+#include "utils/utils.h"
+
 #ifdef CONFIG_NET_LOCAL
 
 /****************************************************************************
@@ -59,6 +62,21 @@
 #define LOCAL_SYNC_BYTE   0x42     /* Byte in sync sequence */
 #define LOCAL_END_BYTE    0xbd     /* End of sync sequence */
 
+/* Local sockets never exchange packets with a network device, so their
+ * state is protected by a lock of their own rather than by the global
+ * network lock.  The local lock may be taken while holding the network
+ * lock, but the network lock must never be taken while holding the local
+ * lock.
+ */
+
+#define local_lock()   netlock_take(&g_local_lock)
+#define local_unlock() netlock_give(&g_local_lock)
+
+#define local_lockedwait(s) \
+  netlock_timedwait(&g_local_lock, s, true, UINT_MAX)
+#define local_lockedwait_uninterruptible(s) \
+  netlock_timedwait(&g_local_lock, s, false, UINT_MAX)
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -196,6 +214,10 @@ extern "C"
 
 EXTERN const struct sock_intf_s g_local_sockif;
 
+/* The lock that protects all local sockets */
+
+EXTERN struct netlock_s g_local_lock;
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -245,7 +267,7 @@ FAR struct local_conn_s *local_nextconn(FAR struct local_conn_s *conn);
  *   Traverse the connections list to find the peer
  *
  * Assumptions:
- *   This function must be called with the network locked.
+ *   This function must be called with the local sockets locked.
  *
  ****************************************************************************/
 
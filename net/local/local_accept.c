@@ -55,7 +55,7 @@ static int local_waitlisten(FAR struct local_conn_s *server)
     {
       /* No.. wait for a connection or a signal */
 
-      ret = net_lockedwait(&server->lc_waitsem);
+      ret = local_lockedwait(&server->lc_waitsem);
       if (ret < 0)
         {
           return ret;
@@ -91,7 +91,7 @@ static int local_waitlisten(FAR struct local_conn_s *server)
  *   description of accept().
  *
  * Assumptions:
- *   Network is NOT locked.
+ *   The local sockets are NOT locked.
  *
  ****************************************************************************/
 
@@ -122,10 +122,12 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
 
   server = (FAR struct local_conn_s *)psock->s_conn;
 
+  local_lock();
   if (server->lc_proto != SOCK_STREAM ||
       server->lc_state != LOCAL_STATE_LISTENING ||
       server->lc_type  != LOCAL_TYPE_PATHNAME)
     {
+      local_unlock();
       return -EOPNOTSUPP;
     }
 
@@ -245,7 +247,7 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
             }
 
           nxsem_post(&client->lc_waitsem);
-          return ret;
+          break;
         }
 
       /* No.. then there should be no pending connections */
@@ -258,7 +260,8 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
         {
           /* Yes.. return EAGAIN */
 
-          return -EAGAIN;
+          ret = -EAGAIN;
+          break;
         }
 
       /* Otherwise, listen for a connection and try again. */
@@ -266,9 +269,12 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
       ret = local_waitlisten(server);
       if (ret < 0)
         {
-          return ret;
+          break;
         }
     }
+
+  local_unlock();
+  return ret;
 }
 
 #endif /* CONFIG_NET && CONFIG_NET_LOCAL_STREAM */
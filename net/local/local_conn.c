@@ -35,6 +35,14 @@
 
 #include "local/local.h"
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The lock that protects all local sockets */
+
+struct netlock_s g_local_lock = NETLOCK_INITIALIZER;
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -54,7 +62,7 @@ static dq_queue_t g_local_connections;
  *   Traverse the list of local connections
  *
  * Assumptions:
- *   This function must be called with the network locked.
+ *   This function must be called with the local sockets locked.
  *
  ****************************************************************************/
 
@@ -75,7 +83,7 @@ FAR struct local_conn_s *local_nextconn(FAR struct local_conn_s *conn)
  *   Traverse the connections list to find the peer
  *
  * Assumptions:
- *   This function must be called with the network locked.
+ *   This function must be called with the local sockets locked.
  *
  ****************************************************************************/
 
@@ -128,9 +136,9 @@ FAR struct local_conn_s *local_alloc(void)
 
       /* Add the connection structure to the list of listeners */
 
-      net_lock();
+      local_lock();
       dq_addlast(&conn->lc_conn.node, &g_local_connections);
-      net_unlock();
+      local_unlock();
     }
 
   return conn;
@@ -155,7 +163,7 @@ void local_free(FAR struct local_conn_s *conn)
 
   /* Remove the server from the list of listeners. */
 
-  net_lock();
+  local_lock();
   dq_rem(&conn->lc_conn.node, &g_local_connections);
 
 #ifdef CONFIG_NET_LOCAL_SCM
@@ -166,7 +174,7 @@ void local_free(FAR struct local_conn_s *conn)
     }
 #endif /* CONFIG_NET_LOCAL_SCM */
 
-  net_unlock();
+  local_unlock();
 
   /* Make sure that the read-only FIFO is closed */
 
@@ -55,7 +55,7 @@
 
 static inline void _local_semtake(sem_t *sem)
 {
-  net_lockedwait_uninterruptible(sem);
+  local_lockedwait_uninterruptible(sem);
 }
 
 #define _local_semgive(sem) nxsem_post(sem)
@@ -72,7 +72,7 @@ static inline void _local_semtake(sem_t *sem)
  *   failure.  Possible failures include:
  *
  * Assumptions:
- *   The network is locked on entry, unlocked on return.  This logic is
+ *   The local sockets are locked on entry, unlocked on return.  This logic is
  *   an integral part of the lock_connect() implementation and was
  *   separated out only to improve readability.
  *
@@ -214,7 +214,7 @@ int32_t local_generate_instance_id(void)
   static int32_t g_next_instance_id = 0;
   int32_t id;
 
-  /* Called from local_connect with net_lock held. */
+  /* Called from local_connect with local_lock held. */
 
   id = g_next_instance_id++;
   if (g_next_instance_id < 0)
@@ -264,7 +264,7 @@ int psock_local_connect(FAR struct socket *psock,
 
   /* Find the matching server connection */
 
-  net_lock();
+  local_lock();
   while ((conn = local_nextconn(conn)) != NULL)
     {
       /* Handle according to the server connection type */
@@ -275,7 +275,7 @@ int psock_local_connect(FAR struct socket *psock,
         case LOCAL_TYPE_ABSTRACT:  /* lc_path is length zero */
           {
 #warning Missing logic
-            net_unlock();
+            local_unlock();
             return OK;
           }
           break;
@@ -315,7 +315,7 @@ int psock_local_connect(FAR struct socket *psock,
                         _SS_ISNONBLOCK(client->lc_conn.s_flags));
                   }
 
-                net_unlock();
+                local_unlock();
                 return ret;
               }
           }
@@ -326,13 +326,13 @@ int psock_local_connect(FAR struct socket *psock,
 
         case LOCAL_TYPE_UNTYPED: /* Type is not determined until the socket is bound */
           {
-            net_unlock();
+            local_unlock();
             return -EINVAL;
           }
         }
     }
 
-  net_unlock();
+  local_unlock();
   return -EADDRNOTAVAIL;
 }
 
@@ -97,6 +97,7 @@ int local_listen(FAR struct socket *psock, int backlog)
   /* Set the backlog value */
 
   DEBUGASSERT((unsigned)backlog < 256);
+  local_lock();
   server->u.server.lc_backlog = backlog;
 
   /* Is this the first time since being bound to an address and that
@@ -114,6 +115,7 @@ int local_listen(FAR struct socket *psock, int backlog)
       server->lc_state = LOCAL_STATE_LISTENING;
     }
 
+  local_unlock();
   return OK;
 }
 
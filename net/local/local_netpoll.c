@@ -49,7 +49,7 @@ static int local_event_pollsetup(FAR struct local_conn_s *conn,
   int ret = OK;
   int i;
 
-  net_lock();
+  local_lock();
   if (setup)
     {
       /* This is a request to set up the poll.  Find an available
@@ -108,11 +108,30 @@ static int local_event_pollsetup(FAR struct local_conn_s *conn,
     }
 
 errout:
-  net_unlock();
+  local_unlock();
   return ret;
 }
 #endif
 
+/****************************************************************************
+ * Name: local_inout_poll_cb
+ *
+ * Description:
+ *   Forward the events reported on one of the shadow pollfds of a socket
+ *   that is polled for both input and output to the pollfd of the socket.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+static void local_inout_poll_cb(FAR struct pollfd *fds)
+{
+  FAR struct pollfd *originfds = fds->arg;
+
+  originfds->revents |= fds->revents;
+  poll_notify(originfds);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -136,7 +155,7 @@ void local_event_pollnotify(FAR struct local_conn_s *conn,
           if (fds->revents != 0)
             {
               ninfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -202,7 +221,7 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 
           /* Find shadow pollfds. */
 
-          net_lock();
+          local_lock();
 
           shadowfds = conn->lc_inout_fds;
           while (shadowfds->fd != 0)
@@ -210,7 +229,7 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
               shadowfds += 2;
               if (shadowfds >= &conn->lc_inout_fds[2*LOCAL_NPOLLWAITERS])
                 {
-                  net_unlock();
+                  local_unlock();
                   return -ENOMEM;
                 }
             }
@@ -218,12 +237,16 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
           shadowfds[0].fd     = 1; /* Does not matter */
           shadowfds[0].sem    = fds->sem;
           shadowfds[0].events = fds->events & ~POLLOUT;
+          shadowfds[0].cb     = local_inout_poll_cb;
+          shadowfds[0].arg    = fds;
 
           shadowfds[1].fd     = 0; /* Does not matter */
           shadowfds[1].sem    = fds->sem;
           shadowfds[1].events = fds->events & ~POLLIN;
+          shadowfds[1].cb     = local_inout_poll_cb;
+          shadowfds[1].arg    = fds;
 
-          net_unlock();
+          local_unlock();
 
           /* Setup poll for both shadow pollfds. */
 
@@ -289,7 +312,7 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 #ifdef CONFIG_NET_LOCAL_STREAM
 pollerr:
   fds->revents |= POLLERR;
-  nxsem_post(fds->sem);
+  poll_notify(fds);
   return OK;
 #endif
 }
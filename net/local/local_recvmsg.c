@@ -129,7 +129,7 @@ static void local_recvctl(FAR struct local_conn_s *conn,
   int *fds;
   int i;
 
-  net_lock();
+  local_lock();
 
   cmsg  = CMSG_FIRSTHDR(msg);
   count = (cmsg->cmsg_len - sizeof(struct cmsghdr)) / sizeof(int);
@@ -190,7 +190,7 @@ static void local_recvctl(FAR struct local_conn_s *conn,
     }
 
 out:
-  net_unlock();
+  local_unlock();
 }
 #endif /* CONFIG_NET_LOCAL_SCM */
 
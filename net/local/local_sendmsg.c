@@ -70,7 +70,7 @@ static int local_sendctl(FAR struct local_conn_s *conn,
   int ret;
   int i;
 
-  net_lock();
+  local_lock();
 
   peer = conn->lc_peer;
   if (peer == NULL)
@@ -123,7 +123,7 @@ static int local_sendctl(FAR struct local_conn_s *conn,
         }
     }
 
-  net_unlock();
+  local_unlock();
 
   return count;
 
@@ -135,7 +135,7 @@ fail:
       peer->lc_cfps[peer->lc_cfpcount] = NULL;
     }
 
-  net_unlock();
+  local_unlock();
 
   return ret;
 }
@@ -408,7 +408,7 @@ ssize_t local_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 #ifdef CONFIG_NET_LOCAL_SCM
   if (len < 0 && count > 0)
     {
-      net_lock();
+      local_lock();
 
       while (count-- > 0)
         {
@@ -417,7 +417,7 @@ ssize_t local_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
           conn->lc_cfps[conn->lc_cfpcount] = NULL;
         }
 
-      net_unlock();
+      local_unlock();
     }
 #endif
 
@@ -241,8 +241,10 @@ static void local_addref(FAR struct socket *psock)
               psock->s_domain == PF_LOCAL);
 
   conn = psock->s_conn;
+  local_lock();
   DEBUGASSERT(conn->lc_crefs > 0 && conn->lc_crefs < 255);
   conn->lc_crefs++;
+  local_unlock();
 }
 
 /****************************************************************************
@@ -588,7 +590,7 @@ static int local_connect(FAR struct socket *psock,
  *   value.  See accept() for a description of the appropriate error value.
  *
  * Assumptions:
- *   The network is locked.
+ *   The local sockets are NOT locked.
  *
  ****************************************************************************/
 
@@ -673,6 +675,7 @@ static int local_close(FAR struct socket *psock)
            * could be more if the socket was dup'ed).
            */
 
+          local_lock();
           if (conn->lc_crefs <= 1)
             {
               conn->lc_crefs = 0;
@@ -685,6 +688,7 @@ static int local_close(FAR struct socket *psock)
              conn->lc_crefs--;
            }
 
+          local_unlock();
           return OK;
         }
 #endif /* CONFIG_NET_LOCAL_STREAM || CONFIG_NET_LOCAL_DGRAM */
@@ -27,6 +27,7 @@
  ****************************************************************************/
 
 #include <stdint.h>
+#include <queue.h>
 
 #include <net/ethernet.h>
 
@@ -37,6 +38,21 @@
 
 #ifdef CONFIG_NET_IPv6
 
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* One slot of the Neighbor table.  A slot in use is also on the hash chain
+ * selected by neighbor_hash().
+ */
+
+struct neighbor_slot_s
+{
+  dq_entry_t                  ns_node;   /* LRU list link */
+  FAR struct neighbor_slot_s *ns_hnext;  /* Next slot in the hash chain */
+  struct neighbor_entry_s     ns_entry;  /* The address mapping */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -45,7 +61,16 @@
  * this table.
  */
 
-extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern struct neighbor_slot_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
+/* The hash chains of the slots in use.  There is one chain per slot. */
+
+extern FAR struct neighbor_slot_s *
+  g_neighbor_hash[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
+/* All slots, unused and least recently used first */
+
+extern dq_queue_t g_neighbor_lru;
 
 /****************************************************************************
  * Public Function Prototypes
@@ -53,6 +78,44 @@ extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
 struct net_driver_s; /* Forward reference */
 
+/****************************************************************************
+ * Name: neighbor_initialize
+ *
+ * Description:
+ *   Initialize the Neighbor table.  Called once from net_initialize().
+ *
+ ****************************************************************************/
+
+void neighbor_initialize(void);
+
+/****************************************************************************
+ * Name: neighbor_hash
+ *
+ * Description:
+ *   Return the index of the hash chain for an IPv6 address.
+ *
+ ****************************************************************************/
+
+unsigned int neighbor_hash(const net_ipv6addr_t ipaddr);
+
+/****************************************************************************
+ * Name: neighbor_findslot
+ *
+ * Description:
+ *   Find the Neighbor table slot of an IPv6 address.  This interface is
+ *   internal to the neighbor implementation.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address to use in the lookup;
+ *
+ * Returned Value:
+ *   The slot holding the IPv6 address; NULL is returned if there is no
+ *   matching entry in the Neighbor Table.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_slot_s *neighbor_findslot(const net_ipv6addr_t ipaddr);
+
 /****************************************************************************
  * Name: neighbor_findentry
  *
@@ -131,6 +194,27 @@ int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
 
 void neighbor_update(const net_ipv6addr_t ipaddr);
 
+/****************************************************************************
+ * Name: neighbor_timer
+ *
+ * Description:
+ *   Release the expired entries of the Neighbor Table.  Each call examines
+ *   only a few hash chains, continuing where the previous call stopped, so
+ *   the whole table is swept over a number of calls.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called periodically from devif_timer().  The network must be locked.
+ *
+ ****************************************************************************/
+
+void neighbor_timer(void);
+
 /****************************************************************************
  * Name: neighbor_ethernet_out
  *
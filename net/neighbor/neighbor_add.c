@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include <string.h>
 #include <assert.h>
+#include <queue.h>
 #include <debug.h>
 
 #include <net/if.h>
@@ -36,6 +37,7 @@
 #include <nuttx/net/neighbor.h>
 
 #include "netdev/netdev.h"
+#include "inet/inet.h"
 #include "neighbor/neighbor.h"
 
 /****************************************************************************
@@ -62,53 +64,71 @@
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
                   FAR uint8_t *addr)
 {
+  FAR struct neighbor_slot_s *slot;
+  FAR struct neighbor_slot_s **prev;
+  unsigned int hash;
   uint8_t lltype;
-  clock_t oldest_time;
-  int     oldest_ndx;
-  int     i;
 
   DEBUGASSERT(dev != NULL && addr != NULL);
 
-  /* Find the matching entry, first unused entry, or the oldest used entry.
-   * The unused entry will have ne_time == 0 and should generate the oldest
-   * time.  REVISIT:  Could this fail on clock wraparound?  A more explicit
-   * check might be to compare ne_ipaddr with the IPv6 unspecified address.
-   */
+  /* Find the matching entry on the hash chain of the address */
 
-  oldest_time = g_neighbors[0].ne_time;
-  oldest_ndx  = 0;
-  lltype      = dev->d_lltype;
+  lltype = dev->d_lltype;
+  hash   = neighbor_hash(ipaddr);
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  for (slot = g_neighbor_hash[hash]; slot != NULL; slot = slot->ns_hnext)
     {
-      if (g_neighbors[i].ne_addr.na_lltype == lltype &&
-          net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr, ipaddr))
+      if (slot->ns_entry.ne_addr.na_lltype == lltype &&
+          net_ipv6addr_cmp(slot->ns_entry.ne_ipaddr, ipaddr))
         {
-          oldest_ndx = i;
           break;
         }
+    }
+
+  if (slot == NULL)
+    {
+      /* Not found.  Reuse the slot at the old end of the LRU list:  The
+       * first unused slot or else the least recently used entry.
+       */
+
+      slot = (FAR struct neighbor_slot_s *)dq_peek(&g_neighbor_lru);
+      DEBUGASSERT(slot != NULL);
 
-      if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
+      /* An unused slot holds the IPv6 unspecified address and is on no hash
+       * chain.  Otherwise, remove the old entry from its hash chain.
+       */
+
+      if (!net_ipv6addr_cmp(slot->ns_entry.ne_ipaddr, g_ipv6_unspecaddr))
         {
-          oldest_ndx = i;
-          oldest_time = g_neighbors[i].ne_time;
+          prev = &g_neighbor_hash[neighbor_hash(slot->ns_entry.ne_ipaddr)];
+          while (*prev != slot)
+            {
+              DEBUGASSERT(*prev != NULL);
+              prev = &(*prev)->ns_hnext;
+            }
+
+          *prev = slot->ns_hnext;
         }
+
+      net_ipv6addr_copy(slot->ns_entry.ne_ipaddr, ipaddr);
+      slot->ns_hnext        = g_neighbor_hash[hash];
+      g_neighbor_hash[hash] = slot;
     }
 
-  /* Use the oldest or first free entry (either pointed to by the
-   * "oldest_ndx" variable).
-   */
+  /* Fill in the entry and make it the most recently used */
+
+  slot->ns_entry.ne_time = clock_systime_ticks();
 
-  g_neighbors[oldest_ndx].ne_time = clock_systime_ticks();
-  net_ipv6addr_copy(g_neighbors[oldest_ndx].ne_ipaddr, ipaddr);
+  slot->ns_entry.ne_addr.na_lltype = lltype;
+  slot->ns_entry.ne_addr.na_llsize = netdev_lladdrsize(dev);
 
-  g_neighbors[oldest_ndx].ne_addr.na_lltype = lltype;
-  g_neighbors[oldest_ndx].ne_addr.na_llsize = netdev_lladdrsize(dev);
+  memcpy(&slot->ns_entry.ne_addr.u, addr,
+         slot->ns_entry.ne_addr.na_llsize);
 
-  memcpy(&g_neighbors[oldest_ndx].ne_addr.u, addr,
-         g_neighbors[oldest_ndx].ne_addr.na_llsize);
+  dq_rem(&slot->ns_node, &g_neighbor_lru);
+  dq_addlast(&slot->ns_node, &g_neighbor_lru);
 
   /* Dump the contents of the new entry */
 
-  neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
+  neighbor_dumpentry("Added entry", &slot->ns_entry);
 }
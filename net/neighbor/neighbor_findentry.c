@@ -33,6 +33,39 @@
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: neighbor_findslot
+ *
+ * Description:
+ *   Find the Neighbor table slot of an IPv6 address.  This interface is
+ *   internal to the neighbor implementation.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address to use in the lookup;
+ *
+ * Returned Value:
+ *   The slot holding the IPv6 address; NULL is returned if there is no
+ *   matching entry in the Neighbor Table.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_slot_s *neighbor_findslot(const net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_slot_s *slot;
+
+  for (slot = g_neighbor_hash[neighbor_hash(ipaddr)];
+       slot != NULL;
+       slot = slot->ns_hnext)
+    {
+      if (net_ipv6addr_cmp(slot->ns_entry.ne_ipaddr, ipaddr))
+        {
+          return slot;
+        }
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
  * Name: neighbor_findentry
  *
@@ -51,17 +84,13 @@
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
-  int i;
+  FAR struct neighbor_slot_s *slot;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  slot = neighbor_findslot(ipaddr);
+  if (slot != NULL)
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
-
-      if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
-        {
-          neighbor_dumpentry("Entry found", neighbor);
-          return neighbor;
-        }
+      neighbor_dumpentry("Entry found", &slot->ns_entry);
+      return &slot->ns_entry;
     }
 
   neighbor_dumpipaddr("Not found", ipaddr);
@@ -24,6 +24,8 @@
 
 #include <nuttx/config.h>
 
+#include <queue.h>
+
 #include "neighbor/neighbor.h"
 
 /****************************************************************************
@@ -34,8 +36,58 @@
  * this table.
  */
 
-struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+struct neighbor_slot_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
+/* The hash chains of the slots in use.  There is one chain per slot. */
+
+FAR struct neighbor_slot_s *g_neighbor_hash[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
+/* All slots, unused and least recently used first */
+
+dq_queue_t g_neighbor_lru;
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_initialize
+ *
+ * Description:
+ *   Initialize the Neighbor table.  Called once from net_initialize().
+ *
+ ****************************************************************************/
+
+void neighbor_initialize(void)
+{
+  int i;
+
+  /* All slots start out unused, at the old end of the LRU list */
+
+  dq_init(&g_neighbor_lru);
+  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; i++)
+    {
+      dq_addlast(&g_neighbors[i].ns_node, &g_neighbor_lru);
+    }
+}
+
+/****************************************************************************
+ * Name: neighbor_hash
+ *
+ * Description:
+ *   Return the index of the hash chain for an IPv6 address.
+ *
+ ****************************************************************************/
+
+unsigned int neighbor_hash(const net_ipv6addr_t ipaddr)
+{
+  unsigned int hash = 0;
+  int i;
+
+  for (i = 0; i < 8; i++)
+    {
+      hash ^= ipaddr[i];
+    }
+
+  return hash % CONFIG_NET_IPv6_NCONF_ENTRIES;
+}
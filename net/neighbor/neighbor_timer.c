@@ -0,0 +1,120 @@
+/****************************************************************************
+ * net/neighbor/neighbor_timer.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <queue.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/neighbor.h>
+
+#include "neighbor/neighbor.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_IPv6_NCONF_MAXAGE
+#  define CONFIG_NET_IPv6_NCONF_MAXAGE 1200
+#endif
+
+#define NEIGHBOR_MAXAGE_TICK SEC2TICK(CONFIG_NET_IPv6_NCONF_MAXAGE)
+
+/* The number of hash chains examined by each call to neighbor_timer() */
+
+#define NEIGHBOR_AGE_NCHAINS 4
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The next hash chain to be examined by neighbor_timer() */
+
+static unsigned int g_neighbor_age;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_timer
+ *
+ * Description:
+ *   Release the expired entries of the Neighbor Table.  Each call examines
+ *   only NEIGHBOR_AGE_NCHAINS hash chains, continuing where the previous
+ *   call stopped, so the whole table is swept over a number of calls.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called periodically from devif_timer().  The network must be locked.
+ *
+ ****************************************************************************/
+
+void neighbor_timer(void)
+{
+  FAR struct neighbor_slot_s **prev;
+  FAR struct neighbor_slot_s *slot;
+  clock_t now = clock_systime_ticks();
+  int i;
+
+  for (i = 0;
+       i < NEIGHBOR_AGE_NCHAINS && i < CONFIG_NET_IPv6_NCONF_ENTRIES;
+       i++)
+    {
+      prev = &g_neighbor_hash[g_neighbor_age];
+      while ((slot = *prev) != NULL)
+        {
+          if (now - slot->ns_entry.ne_time <= NEIGHBOR_MAXAGE_TICK)
+            {
+              prev = &slot->ns_hnext;
+              continue;
+            }
+
+          neighbor_dumpentry("Expired entry", &slot->ns_entry);
+
+          /* Remove the entry from its hash chain.  An unused slot holds
+           * the IPv6 unspecified address and goes to the old end of the
+           * LRU list, where neighbor_add() will reuse it first.
+           */
+
+          *prev          = slot->ns_hnext;
+          slot->ns_hnext = NULL;
+          memset(&slot->ns_entry, 0, sizeof(struct neighbor_entry_s));
+
+          dq_rem(&slot->ns_node, &g_neighbor_lru);
+          dq_addfirst(&slot->ns_node, &g_neighbor_lru);
+        }
+
+      if (++g_neighbor_age >= CONFIG_NET_IPv6_NCONF_ENTRIES)
+        {
+          g_neighbor_age = 0;
+        }
+    }
+}
@@ -24,6 +24,8 @@
 
 #include <nuttx/config.h>
 
+#include <queue.h>
+
 #include "neighbor/neighbor.h"
 
 /****************************************************************************
@@ -48,11 +50,16 @@
 
 void neighbor_update(const net_ipv6addr_t ipaddr)
 {
-  struct neighbor_entry_s *neighbor;
+  FAR struct neighbor_slot_s *slot;
 
-  neighbor = neighbor_findentry(ipaddr);
-  if (neighbor != NULL)
+  slot = neighbor_findslot(ipaddr);
+  if (slot != NULL)
     {
-      neighbor->ne_time = clock_systime_ticks();
+      slot->ns_entry.ne_time = clock_systime_ticks();
+
+      /* Move the slot to the most recently used end of the LRU list */
+
+      dq_rem(&slot->ns_node, &g_neighbor_lru);
+      dq_addlast(&slot->ns_node, &g_neighbor_lru);
     }
 }
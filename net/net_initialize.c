@@ -32,6 +32,8 @@
 #include "socket/socket.h"
 #include "devif/devif.h"
 #include "netdev/netdev.h"
+#include "arp/arp.h"
+#include "neighbor/neighbor.h"
 #include "ipforward/ipforward.h"
 #include "sixlowpan/sixlowpan.h"
 #include "icmp/icmp.h"
@@ -109,6 +111,18 @@ void net_initialize(void)
   pkt_initialize();
 #endif
 
+#ifdef CONFIG_NET_ARP
+  /* Initialize the ARP table */
+
+  arp_initialize();
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  /* Initialize the IPv6 Neighbor table */
+
+  neighbor_initialize();
+#endif
+
 #ifdef CONFIG_NET_ROUTE
   /* Initialize the routing table */
 
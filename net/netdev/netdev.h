@@ -114,6 +114,22 @@ void netdev_ifdown(FAR struct net_driver_s *dev);
 
 bool netdev_verify(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: netdev_queue_initialize
+ *
+ * Description:
+ *   Validate and set up the RX/TX queues that a multi-queue device
+ *   provides in d_queues.  Called by netdev_register().
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the queues are not usable.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+int netdev_queue_initialize(FAR struct net_driver_s *dev);
+#endif
+
 /****************************************************************************
  * Name: netdev_findbyname
  *
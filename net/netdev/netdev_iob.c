@@ -0,0 +1,199 @@
+/****************************************************************************
+ * net/netdev/netdev_iob.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/uio.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netdev.h>
+
+#ifdef CONFIG_NETDEV_IOB_SG
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_iob_iovec
+ *
+ * Description:
+ *   Describe the outgoing packet as a list of contiguous segments for
+ *   scatter-gather transmission.  The first segment holds the part of the
+ *   packet in d_buf; if d_iob is non-NULL, the following segments hold the
+ *   payload in the I/O buffer chain.  This is only used by drivers that
+ *   set NETDEV_FEATURE_SG.
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure with the packet to send
+ *   iov    - The segment list to fill in
+ *   iovcnt - The number of entries in iov
+ *
+ * Returned Value:
+ *   The number of segments on success; -E2BIG if the packet needs more
+ *   than iovcnt segments.  In that case the driver may call
+ *   netdev_iob_linearize() and send d_buf instead.
+ *
+ * Assumptions:
+ *   Called from the network driver with the network locked.
+ *
+ ****************************************************************************/
+
+int netdev_iob_iovec(FAR struct net_driver_s *dev, FAR struct iovec *iov,
+                     int iovcnt)
+{
+  FAR struct iob_s *iob;
+  unsigned int offset;
+  unsigned int remaining;
+  unsigned int seglen;
+  int nseg;
+
+  DEBUGASSERT(dev != NULL && iov != NULL && iovcnt > 0);
+
+  /* The first segment is whatever is in d_buf:  The complete packet or
+   * just the headers if the payload is in d_iob.
+   */
+
+  iov[0].iov_base = dev->d_buf;
+  iov[0].iov_len  = dev->d_len;
+  nseg            = 1;
+
+  if (dev->d_iob == NULL)
+    {
+      return nseg;
+    }
+
+  DEBUGASSERT(dev->d_len >= dev->d_ioblen);
+  iov[0].iov_len = dev->d_len - dev->d_ioblen;
+
+  /* Skip to the I/O buffer containing the start of the payload */
+
+  iob    = dev->d_iob;
+  offset = dev->d_iobofs;
+
+  while (iob != NULL && offset >= iob->io_len)
+    {
+      offset -= iob->io_len;
+      iob     = iob->io_flink;
+    }
+
+  /* Then add one segment for each I/O buffer holding payload */
+
+  for (remaining = dev->d_ioblen; remaining > 0; iob = iob->io_flink)
+    {
+      DEBUGASSERT(iob != NULL);
+
+      if (nseg >= iovcnt)
+        {
+          return -E2BIG;
+        }
+
+      seglen = iob->io_len - offset;
+      if (seglen > remaining)
+        {
+          seglen = remaining;
+        }
+
+      iov[nseg].iov_base = &iob->io_data[iob->io_offset + offset];
+      iov[nseg].iov_len  = seglen;
+      nseg++;
+
+      remaining -= seglen;
+      offset     = 0;
+    }
+
+  NETDEV_TXSG(dev);
+  return nseg;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_linearize
+ *
+ * Description:
+ *   If the payload of the outgoing packet is held in d_iob, copy it to
+ *   d_buf behind the headers and release d_iob, so that the whole packet
+ *   is contiguous in d_buf.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure with the packet to send
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void netdev_iob_linearize(FAR struct net_driver_s *dev)
+{
+  DEBUGASSERT(dev != NULL);
+
+  if (dev->d_iob != NULL)
+    {
+      DEBUGASSERT(dev->d_len >= dev->d_ioblen);
+
+      iob_copyout(&dev->d_buf[dev->d_len - dev->d_ioblen], dev->d_iob,
+                  dev->d_ioblen, dev->d_iobofs);
+      netdev_iob_release(dev);
+
+      NETDEV_TXLINEAR(dev);
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_iob_release
+ *
+ * Description:
+ *   Detach the I/O buffer chain holding the payload of the outgoing packet
+ *   from the device, freeing it if the device owns it.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void netdev_iob_release(FAR struct net_driver_s *dev)
+{
+  DEBUGASSERT(dev != NULL);
+
+  if (dev->d_iob != NULL)
+    {
+      if (dev->d_iobuser != IOBUSER_UNKNOWN)
+        {
+          iob_free_chain(dev->d_iob, (enum iob_user_e)dev->d_iobuser);
+        }
+
+      dev->d_iob     = NULL;
+      dev->d_iobofs  = 0;
+      dev->d_ioblen  = 0;
+      dev->d_iobuser = IOBUSER_UNKNOWN;
+      dev->d_iobsum  = -1;
+    }
+}
+
+#endif /* CONFIG_NETDEV_IOB_SG */
@@ -0,0 +1,403 @@
+/****************************************************************************
+ * net/netdev/netdev_queue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/ethernet.h>
+
+#include "netdev/netdev.h"
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The network should never run on the high priority work queue */
+
+#define NETDEV_QUEUEWORK LPWORK
+
+/* Size of the largest hashed tuple:  Two IPv6 addresses and two ports */
+
+#define NETDEV_MAXTUPLE  (2 * 16 + 4)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The standard RSS key.  It is long enough for the largest tuple plus the
+ * 32-bit window of the Toeplitz hash.
+ */
+
+static const uint8_t g_rsskey[NETDEV_MAXTUPLE + 4] =
+{
+  0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+  0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+  0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+  0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+  0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_toeplitz
+ *
+ * Description:
+ *   Calculate the Toeplitz hash of a tuple with the standard RSS key.
+ *
+ ****************************************************************************/
+
+static uint32_t netdev_toeplitz(FAR const uint8_t *tuple, unsigned int len)
+{
+  uint32_t window;
+  uint32_t hash = 0;
+  unsigned int i;
+  int bit;
+
+  window = ((uint32_t)g_rsskey[0] << 24) | ((uint32_t)g_rsskey[1] << 16) |
+           ((uint32_t)g_rsskey[2] << 8) | g_rsskey[3];
+
+  for (i = 0; i < len; i++)
+    {
+      for (bit = 7; bit >= 0; bit--)
+        {
+          if ((tuple[i] & (1 << bit)) != 0)
+            {
+              hash ^= window;
+            }
+
+          /* Slide the key window by one bit */
+
+          window <<= 1;
+          if ((g_rsskey[i + 4] & (1 << bit)) != 0)
+            {
+              window |= 1;
+            }
+        }
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_queue_initialize
+ *
+ * Description:
+ *   Validate and set up the RX/TX queues that a multi-queue device
+ *   provides in d_queues.  Called by netdev_register().
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the queues are not usable.
+ *
+ ****************************************************************************/
+
+int netdev_queue_initialize(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_queue_s *q;
+  int i;
+
+  if (dev->d_queues == NULL || dev->d_nqueues > CONFIG_NETDEV_MAXQUEUES)
+    {
+      nerr("ERROR: Bad queues: %p, %u\n",
+           dev->d_queues, dev->d_nqueues);
+      return -EINVAL;
+    }
+
+  for (i = 0; i < dev->d_nqueues; i++)
+    {
+      q = &dev->d_queues[i];
+      if (q->q_buf == NULL)
+        {
+          nerr("ERROR: Queue %d has no packet buffer\n", i);
+          return -EINVAL;
+        }
+
+      q->q_dev    = dev;
+      q->q_devbuf = NULL;
+      q->q_len    = 0;
+      q->q_index  = i;
+#ifdef CONFIG_SMP
+      q->q_cpu    = i % CONFIG_SMP_NCPUS;
+#else
+      q->q_cpu    = 0;
+#endif
+      memset(&q->q_work, 0, sizeof(struct work_s));
+#ifdef CONFIG_NETDEV_STATISTICS
+      memset(&q->q_statistics, 0, sizeof(struct netdev_qstatistics_s));
+#endif
+    }
+
+  dev->d_queue = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: netdev_flowhash
+ *
+ * Description:
+ *   Calculate the RSS (Toeplitz) hash of the flow that a received packet
+ *   belongs to from its IP addresses and, for TCP and UDP, its ports.  The
+ *   standard RSS key is used, so the hash matches the one reported by
+ *   hardware that implements RSS with its default key.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure that received the packet
+ *   buf - The packet, starting with the link layer header
+ *   len - The length of the packet
+ *
+ * Returned Value:
+ *   The flow hash, or zero if the packet is not an IP packet.
+ *
+ ****************************************************************************/
+
+uint32_t netdev_flowhash(FAR struct net_driver_s *dev,
+                         FAR const uint8_t *buf, unsigned int len)
+{
+  uint8_t tuple[NETDEV_MAXTUPLE];
+  FAR const uint8_t *ip;
+  unsigned int llhdrlen = NET_LL_HDRLEN(dev);
+  unsigned int tuplen;
+  unsigned int hdrlen;
+  uint8_t proto;
+
+  if (len <= llhdrlen)
+    {
+      return 0;
+    }
+
+#if defined(CONFIG_NET_ETHERNET) || defined(CONFIG_DRIVERS_IEEE80211)
+  /* Only IP frames are hashed */
+
+  if (dev->d_lltype == NET_LL_ETHERNET || dev->d_lltype == NET_LL_IEEE80211)
+    {
+      FAR const struct eth_hdr_s *eth = (FAR const struct eth_hdr_s *)buf;
+
+      if (eth->type != HTONS(ETHTYPE_IP) && eth->type != HTONS(ETHTYPE_IP6))
+        {
+          return 0;
+        }
+    }
+#endif
+
+  ip   = &buf[llhdrlen];
+  len -= llhdrlen;
+
+#ifdef CONFIG_NET_IPv4
+  if ((ip[0] & IP_VERSION_MASK) == IPv4_VERSION && len >= IPv4_HDRLEN)
+    {
+      FAR const struct ipv4_hdr_s *ipv4 = (FAR const struct ipv4_hdr_s *)ip;
+
+      memcpy(tuple, ipv4->srcipaddr, 2 * sizeof(in_addr_t));
+      tuplen = 2 * sizeof(in_addr_t);
+      hdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
+      proto  = ipv4->proto;
+
+      /* Fragments are hashed by address only, so that all fragments of a
+       * datagram go to the same queue.
+       */
+
+      if ((ipv4->ipoffset[0] & ((IP_FLAG_MOREFRAGS >> 8) | 0x1f)) != 0 ||
+          ipv4->ipoffset[1] != 0)
+        {
+          proto = 0;
+        }
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if ((ip[0] & IP_VERSION_MASK) == IPv6_VERSION && len >= IPv6_HDRLEN)
+    {
+      FAR const struct ipv6_hdr_s *ipv6 = (FAR const struct ipv6_hdr_s *)ip;
+
+      memcpy(tuple, ipv6->srcipaddr, 2 * sizeof(net_ipv6addr_t));
+      tuplen = 2 * sizeof(net_ipv6addr_t);
+      hdrlen = IPv6_HDRLEN;
+      proto  = ipv6->proto;
+    }
+  else
+#endif
+    {
+      return 0;
+    }
+
+  /* Add the source and destination ports of TCP and UDP packets */
+
+  if ((proto == IP_PROTO_TCP || proto == IP_PROTO_UDP) && len >= hdrlen + 4)
+    {
+      memcpy(&tuple[tuplen], &ip[hdrlen], 4);
+      tuplen += 4;
+    }
+
+  return netdev_toeplitz(tuple, tuplen);
+}
+
+/****************************************************************************
+ * Name: netdev_queue_rxselect
+ *
+ * Description:
+ *   Select the queue that processes the packets of a flow.
+ *
+ * Input Parameters:
+ *   dev  - The multi-queue device
+ *   hash - The flow hash, from netdev_flowhash() or from the hardware
+ *
+ * Returned Value:
+ *   The queue for the flow.
+ *
+ ****************************************************************************/
+
+FAR struct netdev_queue_s *
+netdev_queue_rxselect(FAR struct net_driver_s *dev, uint32_t hash)
+{
+  DEBUGASSERT(dev->d_nqueues > 0);
+  return &dev->d_queues[hash % dev->d_nqueues];
+}
+
+/****************************************************************************
+ * Name: netdev_queue_txselect
+ *
+ * Description:
+ *   Select the queue that the calling CPU transmits on, so that CPUs do not
+ *   contend for the TX queues.
+ *
+ * Input Parameters:
+ *   dev - The multi-queue device
+ *
+ * Returned Value:
+ *   The queue for the calling CPU.
+ *
+ ****************************************************************************/
+
+FAR struct netdev_queue_s *
+netdev_queue_txselect(FAR struct net_driver_s *dev)
+{
+  DEBUGASSERT(dev->d_nqueues > 0);
+  return &dev->d_queues[up_cpu_index() % dev->d_nqueues];
+}
+
+/****************************************************************************
+ * Name: netdev_queue_schedule
+ *
+ * Description:
+ *   Schedule the work item of a queue, usually from the interrupt handler
+ *   of the queue.  Each queue has its own work item, which runs on the low
+ *   priority worker threads of the queue's CPU (q_cpu) if the work queues
+ *   are per-CPU (CONFIG_SCHED_WORKQUEUE_PERCPU).  The queues are then
+ *   serviced in parallel by different CPUs.
+ *
+ * Input Parameters:
+ *   q      - The queue to service
+ *   worker - The driver function that services the queue.  It receives q
+ *            as its argument.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int netdev_queue_schedule(FAR struct netdev_queue_s *q, worker_t worker)
+{
+  /* The queue is serviced completely each time, so there is nothing to do
+   * if its work is already pending.
+   */
+
+  if (!work_available(&q->q_work))
+    {
+      return OK;
+    }
+
+  return work_queue_cpu(NETDEV_QUEUEWORK, &q->q_work, worker, q, q->q_cpu);
+}
+
+/****************************************************************************
+ * Name: netdev_queue_enter
+ *
+ * Description:
+ *   Lock the network and make the packet buffer of a queue the device's
+ *   d_buf, with d_len set to q_len.  The caller owns the packet buffer of
+ *   the queue until netdev_queue_leave().
+ *
+ * Input Parameters:
+ *   q - The queue to process
+ *
+ ****************************************************************************/
+
+void netdev_queue_enter(FAR struct netdev_queue_s *q)
+{
+  FAR struct net_driver_s *dev = q->q_dev;
+
+  net_lock();
+
+  DEBUGASSERT(dev->d_queue == NULL);
+  q->q_devbuf  = dev->d_buf;
+  dev->d_buf   = q->q_buf;
+  dev->d_len   = q->q_len;
+  dev->d_queue = q;
+}
+
+/****************************************************************************
+ * Name: netdev_queue_leave
+ *
+ * Description:
+ *   Record the length of the packet left in the queue's buffer in q_len,
+ *   restore the device's d_buf and unlock the network.
+ *
+ * Input Parameters:
+ *   q - The queue passed to netdev_queue_enter()
+ *
+ ****************************************************************************/
+
+void netdev_queue_leave(FAR struct netdev_queue_s *q)
+{
+  FAR struct net_driver_s *dev = q->q_dev;
+
+  DEBUGASSERT(dev->d_queue == q);
+  q->q_len     = dev->d_len;
+  dev->d_buf   = q->q_devbuf;
+  dev->d_len   = 0;
+  dev->d_queue = NULL;
+  q->q_devbuf  = NULL;
+
+  net_unlock();
+}
+
+#endif /* CONFIG_NETDEV_MULTIQUEUE */
@@ -367,6 +367,19 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
       dev->d_conncb_tail = NULL;
       dev->d_devcb = NULL;
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+      /* Set up the RX/TX queues of a multi-queue device */
+
+      if (dev->d_nqueues > 0)
+        {
+          int ret = netdev_queue_initialize(dev);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+#endif
+
       /* We need exclusive access for the following operations */
 
       net_lock();
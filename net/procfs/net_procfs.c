@@ -57,11 +57,12 @@
 
 #ifdef CONFIG_NET_STATISTICS
 #  define STAT_INDEX     0
+#  define LOCK_INDEX     1
 #  ifdef CONFIG_NET_MLD
-#    define MLD_INDEX    1
-#    define _ROUTE_INDEX 2
+#    define MLD_INDEX    2
+#    define _ROUTE_INDEX 3
 #  else
-#    define _ROUTE_INDEX 1
+#    define _ROUTE_INDEX 2
 #  endif
 #else
 #  define _ROUTE_INDEX   0
@@ -156,8 +157,8 @@ static int netprocfs_open(FAR struct file *filep, FAR const char *relpath,
     }
 
 #ifdef CONFIG_NET_STATISTICS
-  /* "net/stat" is an acceptable value for the relpath only if network layer
-   * statistics are enabled.
+  /* "net/stat" and "net/lock" are acceptable values for the relpath only
+   * if network layer statistics are enabled.
    */
 
   if (strcmp(relpath, "net/stat") == 0)
@@ -165,6 +166,11 @@ static int netprocfs_open(FAR struct file *filep, FAR const char *relpath,
       entry = NETPROCFS_SUBDIR_STAT;
       dev   = NULL;
     }
+  else if (strcmp(relpath, "net/lock") == 0)
+    {
+      entry = NETPROCFS_SUBDIR_LOCK;
+      dev   = NULL;
+    }
   else
 #ifdef CONFIG_NET_MLD
   /* "net/mld" is an acceptable value for the relpath only if MLD is
@@ -300,6 +306,13 @@ static ssize_t netprocfs_read(FAR struct file *filep, FAR char *buffer,
         nreturned = netprocfs_read_netstats(priv, buffer, buflen);
         break;
 
+      case NETPROCFS_SUBDIR_LOCK:
+
+        /* Show the network lock statistics */
+
+        nreturned = netprocfs_read_lockstats(priv, buffer, buflen);
+        break;
+
 #ifdef CONFIG_NET_MLD
       case NETPROCFS_SUBDIR_MLD:
 
@@ -427,7 +440,7 @@ static int netprocfs_opendir(FAR const char *relpath,
 
       level1->base.nentries = ndevs;
 #ifdef CONFIG_NET_STATISTICS
-      level1->base.nentries++;
+      level1->base.nentries += 2;
 #ifdef CONFIG_NET_MLD
       level1->base.nentries++;
 #endif
@@ -526,6 +539,13 @@ static int netprocfs_readdir(FAR struct fs_dirent_s *dir)
           dir->fd_dir.d_type = DTYPE_FILE;
           strncpy(dir->fd_dir.d_name, "stat", NAME_MAX + 1);
         }
+      else if (index == LOCK_INDEX)
+        {
+          /* Copy the network lock statistics directory entry */
+
+          dir->fd_dir.d_type = DTYPE_FILE;
+          strncpy(dir->fd_dir.d_name, "lock", NAME_MAX + 1);
+        }
       else
 #ifdef CONFIG_NET_MLD
       if (index == MLD_INDEX)
@@ -654,7 +674,8 @@ static int netprocfs_stat(FAR const char *relpath, FAR struct stat *buf)
 #ifdef CONFIG_NET_STATISTICS
   /* Check for network statistics "net/stat" */
 
-  if (strcmp(relpath, "net/stat") == 0)
+  if (strcmp(relpath, "net/stat") == 0 ||
+      strcmp(relpath, "net/lock") == 0)
     {
       buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
     }
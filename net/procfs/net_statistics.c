@@ -59,6 +59,9 @@ static int netprocfs_checksum(FAR struct netprocfs_file_s *netfile);
 #ifdef CONFIG_NET_TCP
 static int netprocfs_tcp_dropped_1(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_tcp_dropped_2(FAR struct netprocfs_file_s *netfile);
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+static int netprocfs_tcp_dropped_3(FAR struct netprocfs_file_s *netfile);
+#endif
 #endif /* CONFIG_NET_TCP */
 static int netprocfs_prototype(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_sent(FAR struct netprocfs_file_s *netfile);
@@ -91,6 +94,9 @@ static const linegen_t g_stat_linegen[] =
 #ifdef CONFIG_NET_TCP
   netprocfs_tcp_dropped_1,
   netprocfs_tcp_dropped_2,
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+  netprocfs_tcp_dropped_3,
+#endif
 #endif /* CONFIG_NET_TCP */
 
   netprocfs_prototype,
@@ -310,6 +316,19 @@ static int netprocfs_tcp_dropped_2(FAR struct netprocfs_file_s *netfile)
 }
 #endif /* CONFIG_NET_STATISTICS && CONFIG_NET_TCP */
 
+/****************************************************************************
+ * Name: netprocfs_tcp_dropped_3
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_STATISTICS) && defined(CONFIG_NET_TCP_OUT_OF_ORDER)
+static int netprocfs_tcp_dropped_3(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "              OOO: %04x  %04x\n",
+                  g_netstats.tcp.ofodrop, g_netstats.tcp.ofoqueued);
+}
+#endif /* CONFIG_NET_STATISTICS && CONFIG_NET_TCP_OUT_OF_ORDER */
+
 /****************************************************************************
  * Name: netprocfs_prototype
  ****************************************************************************/
@@ -67,6 +67,10 @@ static int netprocfs_rxpackets(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_txstatistics_header(
     FAR struct netprocfs_file_s *netfile);
 static int netprocfs_txstatistics(FAR struct netprocfs_file_s *netfile);
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+static int netprocfs_queues_header(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_queue(FAR struct netprocfs_file_s *netfile);
+#endif
 static int netprocfs_errors(FAR struct netprocfs_file_s *netfile);
 #endif /* CONFIG_NETDEV_STATISTICS */
 
@@ -97,12 +101,41 @@ static const linegen_t g_netstat_linegen[] =
   netprocfs_rxpackets,
   netprocfs_txstatistics_header,
   netprocfs_txstatistics,
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  netprocfs_queues_header,
+  netprocfs_queue,
+  netprocfs_queue,
+#if CONFIG_NETDEV_MAXQUEUES > 2
+  netprocfs_queue,
+#endif
+#if CONFIG_NETDEV_MAXQUEUES > 3
+  netprocfs_queue,
+#endif
+#if CONFIG_NETDEV_MAXQUEUES > 4
+  netprocfs_queue,
+#endif
+#if CONFIG_NETDEV_MAXQUEUES > 5
+  netprocfs_queue,
+#endif
+#if CONFIG_NETDEV_MAXQUEUES > 6
+  netprocfs_queue,
+#endif
+#if CONFIG_NETDEV_MAXQUEUES > 7
+  netprocfs_queue,
+#endif
+#endif
   netprocfs_errors
 #endif /* CONFIG_NETDEV_STATISTICS */
 };
 
 #define NSTAT_LINES (sizeof(g_netstat_linegen) / sizeof(linegen_t))
 
+/* The per-queue lines come just before the last line */
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+#  define NSTAT_QUEUE0 (NSTAT_LINES - 1 - CONFIG_NETDEV_MAXQUEUES)
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -485,10 +518,22 @@ static int netprocfs_rxpackets(FAR struct netprocfs_file_s *netfile)
 static int netprocfs_txstatistics_header(
     FAR struct netprocfs_file_s *netfile)
 {
+  FAR char *fmt;
+
   DEBUGASSERT(netfile != NULL);
 
-  return snprintf(netfile->line, NET_LINELEN, "\tTX: %-8s %-8s %-8s %-8s\n",
-                 "Queued", "Sent", "Errors", "Timeouts");
+  fmt = "\tTX: %-8s %-8s %-8s "
+#ifdef CONFIG_NETDEV_IOB_SG
+        "%-8s %-8s "
+#endif
+        "%-8s\n";
+
+  return snprintf(netfile->line, NET_LINELEN, fmt,
+                  "Queued", "Sent", "Errors"
+#ifdef CONFIG_NETDEV_IOB_SG
+                  , "SG", "Linear"
+#endif
+                  , "Timeouts");
 }
 #endif /* CONFIG_NETDEV_STATISTICS */
 
@@ -501,20 +546,81 @@ static int netprocfs_txstatistics(FAR struct netprocfs_file_s *netfile)
 {
   FAR struct netdev_statistics_s *stats;
   FAR struct net_driver_s *dev;
+  FAR char *fmt;
 
   DEBUGASSERT(netfile != NULL && netfile->dev != NULL);
   dev = netfile->dev;
   stats = &dev->d_statistics;
 
-  return snprintf(netfile->line, NET_LINELEN,
-                  "\t    %08lx %08lx %08lx %08lx\n",
+  fmt = "\t    %08lx %08lx %08lx "
+#ifdef CONFIG_NETDEV_IOB_SG
+        "%08lx %08lx "
+#endif
+        "%08lx\n";
+
+  return snprintf(netfile->line, NET_LINELEN, fmt,
                   (unsigned long)stats->tx_packets,
                   (unsigned long)stats->tx_done,
-                  (unsigned long)stats->tx_errors,
-                  (unsigned long)stats->tx_timeouts);
+                  (unsigned long)stats->tx_errors
+#ifdef CONFIG_NETDEV_IOB_SG
+                  , (unsigned long)stats->tx_sg
+                  , (unsigned long)stats->tx_linear
+#endif
+                  , (unsigned long)stats->tx_timeouts);
 }
 #endif /* CONFIG_NETDEV_STATISTICS */
 
+/****************************************************************************
+ * Name: netprocfs_queues_header
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_STATISTICS) && defined(CONFIG_NETDEV_MULTIQUEUE)
+static int netprocfs_queues_header(FAR struct netprocfs_file_s *netfile)
+{
+  DEBUGASSERT(netfile != NULL && netfile->dev != NULL);
+
+  if (netfile->dev->d_nqueues == 0)
+    {
+      return 0;
+    }
+
+  return snprintf(netfile->line, NET_LINELEN,
+                  "\tQueue %-8s %-8s %-8s %-8s %-8s\n",
+                  "RX", "Dropped", "TX", "Sent", "Errors");
+}
+#endif
+
+/****************************************************************************
+ * Name: netprocfs_queue
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_STATISTICS) && defined(CONFIG_NETDEV_MULTIQUEUE)
+static int netprocfs_queue(FAR struct netprocfs_file_s *netfile)
+{
+  FAR struct netdev_qstatistics_s *stats;
+  FAR struct net_driver_s *dev;
+  unsigned int index;
+
+  DEBUGASSERT(netfile != NULL && netfile->dev != NULL);
+  dev   = netfile->dev;
+  index = netfile->lineno - NSTAT_QUEUE0;
+
+  if (index >= dev->d_nqueues)
+    {
+      return 0;
+    }
+
+  stats = &dev->d_queues[index].q_statistics;
+  return snprintf(netfile->line, NET_LINELEN,
+                  "\t%5u %08lx %08lx %08lx %08lx %08lx\n", index,
+                  (unsigned long)stats->rx_packets,
+                  (unsigned long)stats->rx_dropped,
+                  (unsigned long)stats->tx_packets,
+                  (unsigned long)stats->tx_done,
+                  (unsigned long)(stats->rx_errors + stats->tx_errors));
+}
+#endif
+
 /****************************************************************************
  * Name: netprocfs_errors
  ****************************************************************************/
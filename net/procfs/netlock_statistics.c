@@ -0,0 +1,204 @@
+/****************************************************************************
+ * net/procfs/netlock_statistics.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* Output format:
+ *
+ *   Lock   Acquired Contended  Wait(us)   Max(us)
+ *   net    xxxxxxxx  xxxxxxxx  xxxxxxxx  xxxxxxxx
+ *   local  xxxxxxxx  xxxxxxxx  xxxxxxxx  xxxxxxxx
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <debug.h>
+
+#include <nuttx/net/netstats.h>
+
+#include "utils/utils.h"
+#include "procfs/procfs.h"
+#ifdef CONFIG_NET_TCP
+#  include "tcp/tcp.h"
+#endif
+#ifdef CONFIG_NET_UDP
+#  include "udp/udp.h"
+#endif
+#ifdef CONFIG_NET_LOCAL
+#  include "local/local.h"
+#endif
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NET) && defined(CONFIG_NET_STATISTICS)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Line generating functions */
+
+static int netprocfs_lock_header(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_lock_net(FAR struct netprocfs_file_s *netfile);
+#ifdef CONFIG_NET_TCP
+static int netprocfs_lock_tcp(FAR struct netprocfs_file_s *netfile);
+#endif
+#ifdef CONFIG_NET_UDP
+static int netprocfs_lock_udp(FAR struct netprocfs_file_s *netfile);
+#endif
+#ifdef CONFIG_NET_LOCAL
+static int netprocfs_lock_local(FAR struct netprocfs_file_s *netfile);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Line generating functions */
+
+static const linegen_t g_lock_linegen[] =
+{
+  netprocfs_lock_header,
+  netprocfs_lock_net
+#ifdef CONFIG_NET_TCP
+  , netprocfs_lock_tcp
+#endif
+#ifdef CONFIG_NET_UDP
+  , netprocfs_lock_udp
+#endif
+#ifdef CONFIG_NET_LOCAL
+  , netprocfs_lock_local
+#endif
+};
+
+#define NSTAT_LINES (sizeof(g_lock_linegen) / sizeof(linegen_t))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_lock_line
+ *
+ * Description:
+ *   Format the statistics of one network lock.
+ *
+ ****************************************************************************/
+
+static int netprocfs_lock_line(FAR struct netprocfs_file_s *netfile,
+                               FAR const char *name,
+                               FAR const struct netlock_s *lock)
+{
+  FAR const struct netlock_stats_s *stats = &lock->nl_stats;
+
+  return snprintf(netfile->line, NET_LINELEN,
+                  "%-6s %08lx  %08lx  %08lx  %08lx\n", name,
+                  (unsigned long)stats->acquired,
+                  (unsigned long)stats->contended,
+                  (unsigned long)stats->waitus,
+                  (unsigned long)stats->maxwait);
+}
+
+/****************************************************************************
+ * Name: netprocfs_lock_header
+ ****************************************************************************/
+
+static int netprocfs_lock_header(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "Lock   Acquired Contended  Wait(us)   Max(us)\n");
+}
+
+/****************************************************************************
+ * Name: netprocfs_lock_net
+ ****************************************************************************/
+
+static int netprocfs_lock_net(FAR struct netprocfs_file_s *netfile)
+{
+  return netprocfs_lock_line(netfile, "net", &g_netlock);
+}
+
+/****************************************************************************
+ * Name: netprocfs_lock_tcp
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP
+static int netprocfs_lock_tcp(FAR struct netprocfs_file_s *netfile)
+{
+  return netprocfs_lock_line(netfile, "tcp", &g_tcp_lock);
+}
+#endif
+
+/****************************************************************************
+ * Name: netprocfs_lock_udp
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP
+static int netprocfs_lock_udp(FAR struct netprocfs_file_s *netfile)
+{
+  return netprocfs_lock_line(netfile, "udp", &g_udp_lock);
+}
+#endif
+
+/****************************************************************************
+ * Name: netprocfs_lock_local
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL
+static int netprocfs_lock_local(FAR struct netprocfs_file_s *netfile)
+{
+  return netprocfs_lock_line(netfile, "local", &g_local_lock);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_lockstats
+ *
+ * Description:
+ *   Read and format network lock contention statistics.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_lockstats(FAR struct netprocfs_file_s *priv,
+                                 FAR char *buffer, size_t buflen)
+{
+  return netprocfs_read_linegen(priv, buffer, buflen,
+                                g_lock_linegen, NSTAT_LINES);
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_NET && CONFIG_NET_STATISTICS */
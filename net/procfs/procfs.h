@@ -56,6 +56,7 @@ enum netprocfs_entry_e
   NETPROCFS_SUBDIR_DEV = 0           /* Multiple instances, e.g. /proc/net/eth0 */
 #ifdef CONFIG_NET_STATISTICS
   , NETPROCFS_SUBDIR_STAT            /* /proc/net/stat */
+  , NETPROCFS_SUBDIR_LOCK            /* /proc/net/lock */
 #ifdef CONFIG_NET_MLD
   , NETPROCFS_SUBDIR_MLD             /* /proc/net/mld */
 #endif
@@ -180,6 +181,29 @@ ssize_t netprocfs_read_mldstats(FAR struct netprocfs_file_s *priv,
                                 FAR char *buffer, size_t buflen);
 #endif
 
+/****************************************************************************
+ * Name: netprocfs_read_lockstats
+ *
+ * Description:
+ *   Read and format network lock contention statistics.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_STATISTICS
+ssize_t netprocfs_read_lockstats(FAR struct netprocfs_file_s *priv,
+                                 FAR char *buffer, size_t buflen);
+#endif
+
 /****************************************************************************
  * Name: netprocfs_read_routes
  *
@@ -0,0 +1,117 @@
+/****************************************************************************
+ * net/route/lpmroute.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __NET_ROUTE_LPMROUTE_H
+#define __NET_ROUTE_LPMROUTE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include "route/route.h"
+
+#if defined(CONFIG_ROUTE_IPv4_LPMROUTE) || defined(CONFIG_ROUTE_IPv6_LPMROUTE)
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest-prefix-match index and build it from the
+ *   current content of the routing tables.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+void net_init_lpmroute(void);
+
+/****************************************************************************
+ * Name: net_updatelpm_ipv4 and net_updatelpm_ipv6
+ *
+ * Description:
+ *   Rebuild the longest-prefix-match index after the routing table has
+ *   been modified.  The new index is built in the spare node pool and then
+ *   made visible to lookups with a single pointer update.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None.  If the routing table cannot be indexed, the index is disabled
+ *   and net_lpmroute_ipv4/6() will return -ENOSYS until the next update.
+ *
+ * Assumptions:
+ *   The caller holds the network lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_LPMROUTE
+void net_updatelpm_ipv4(void);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPMROUTE
+void net_updatelpm_ipv6(void);
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv4 and net_lpmroute_ipv6
+ *
+ * Description:
+ *   Visit the routes whose prefix contains 'target', starting with the
+ *   longest prefix.  The traversal stops when the handler returns a
+ *   non-zero value.
+ *
+ * Input Parameters:
+ *   target  - The address to be routed.
+ *   handler - Will be called for each covering route.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   The non-zero value returned by the handler; zero (OK) if no route
+ *   was accepted by the handler; -ENOSYS if the index is not available and
+ *   the caller must fall back to net_foreachroute_ipv4/6().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_LPMROUTE
+int net_lpmroute_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                      FAR void *arg);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPMROUTE
+int net_lpmroute_ipv6(const net_ipv6addr_t target,
+                      route_handler_ipv6_t handler, FAR void *arg);
+#endif
+
+#endif /* CONFIG_ROUTE_IPv4_LPMROUTE || CONFIG_ROUTE_IPv6_LPMROUTE */
+#endif /* __NET_ROUTE_LPMROUTE_H */
@@ -30,9 +30,11 @@
 #include <debug.h>
 
 #include <arpa/inet.h>
+#include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 
 #include "route/ramroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
@@ -202,6 +204,9 @@ static int net_match_ipv6(
 int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 {
   struct route_match_ipv4_s match;
+#ifdef CONFIG_ROUTE_IPv4_LPMROUTE
+  int ret;
+#endif
 
   /* Set up the comparison structure */
 
@@ -209,9 +214,25 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
   net_ipv4addr_copy(match.target, target);
   net_ipv4addr_copy(match.netmask, netmask);
 
+#ifdef CONFIG_ROUTE_IPv4_LPMROUTE
+  /* Hold the network lock until the index no longer refers to the freed
+   * entry.
+   */
+
+  net_lock();
+  ret = net_foreachroute_ipv4(net_match_ipv4, &match);
+  if (ret > 0)
+    {
+      net_updatelpm_ipv4();
+    }
+
+  net_unlock();
+  return ret > 0 ? OK : -ENOENT;
+#else
   /* Then remove the entry from the routing table */
 
   return net_foreachroute_ipv4(net_match_ipv4, &match) ? OK : -ENOENT;
+#endif
 }
 #endif
 
@@ -219,6 +240,9 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 {
   struct route_match_ipv6_s match;
+#ifdef CONFIG_ROUTE_IPv6_LPMROUTE
+  int ret;
+#endif
 
   /* Set up the comparison structure */
 
@@ -226,9 +250,25 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
   net_ipv6addr_copy(match.target, target);
   net_ipv6addr_copy(match.netmask, netmask);
 
+#ifdef CONFIG_ROUTE_IPv6_LPMROUTE
+  /* Hold the network lock until the index no longer refers to the freed
+   * entry.
+   */
+
+  net_lock();
+  ret = net_foreachroute_ipv6(net_match_ipv6, &match);
+  if (ret > 0)
+    {
+      net_updatelpm_ipv6();
+    }
+
+  net_unlock();
+  return ret > 0 ? OK : -ENOENT;
+#else
   /* Then remove the entry from the routing table */
 
   return net_foreachroute_ipv6(net_match_ipv6, &match) ? OK : -ENOENT;
+#endif
 }
 #endif
 
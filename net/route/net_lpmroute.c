@@ -0,0 +1,655 @@
+/****************************************************************************
+ * net/route/net_lpmroute.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/ip.h>
+
+#include "route/lpmroute.h"
+#include "route/route.h"
+
+#if defined(CONFIG_ROUTE_IPv4_LPMROUTE) || defined(CONFIG_ROUTE_IPv6_LPMROUTE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Size of the key held in each trie node */
+
+#ifdef CONFIG_ROUTE_IPv6_LPMROUTE
+#  define LPM_KEYLEN       16
+#else
+#  define LPM_KEYLEN       4
+#endif
+
+/* Every route adds at most one prefix node and one branch node to the
+ * trie.
+ */
+
+#ifdef CONFIG_ROUTE_IPv4_LPMROUTE
+#  ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+#    define LPM_IPv4_NNODES (2 * CONFIG_ROUTE_MAX_IPv4_RAMROUTES)
+#  else
+#    define LPM_IPv4_NNODES (2 * CONFIG_ROUTE_MAX_IPv4_LPMROUTES)
+#  endif
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPMROUTE
+#  ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+#    define LPM_IPv6_NNODES (2 * CONFIG_ROUTE_MAX_IPv6_RAMROUTES)
+#  else
+#    define LPM_IPv6_NNODES (2 * CONFIG_ROUTE_MAX_IPv6_LPMROUTES)
+#  endif
+#endif
+
+/* Return bit 'n' of a key, counting from the most significant bit */
+
+#define LPM_BIT(k,n)       (((k)[(n) >> 3] >> (7 - ((n) & 7))) & 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One node of the path-compressed trie.  A node either carries a route
+ * whose prefix is 'key/plen' or is a branch node with two children that
+ * first differ at bit 'plen'.  Further routes with the same prefix (the
+ * routing table does not prevent duplicates) are kept on the 'dup' list
+ * in table order, so that the first one still wins.
+ */
+
+struct lpm_node_s
+{
+  FAR struct lpm_node_s *parent;   /* Parent node; NULL for the root */
+  FAR struct lpm_node_s *child[2]; /* Sub-tries for next bit 0 and 1 */
+  FAR struct lpm_node_s *dup;      /* Next route with the same prefix */
+  FAR void *route;                 /* Routing table entry; NULL if branch */
+  uint8_t plen;                    /* Prefix length in bits */
+  uint8_t key[LPM_KEYLEN];         /* Prefix, remaining bits are zero */
+};
+
+/* One complete trie built from a snapshot of the routing table */
+
+struct lpm_table_s
+{
+  FAR struct lpm_node_s *root;     /* Root of the trie */
+  FAR struct lpm_node_s *pool;     /* Node storage */
+  uint16_t nnodes;                 /* Number of nodes in 'pool' */
+  uint16_t nused;                  /* Number of nodes allocated */
+  uint8_t keylen;                  /* Size of the address in bytes */
+};
+
+/* The index for one address family.  Lookups use 'active' while updates
+ * are built in the other table.
+ */
+
+struct lpm_index_s
+{
+  FAR struct lpm_table_s *active;  /* Published table; NULL if disabled */
+  struct lpm_table_s table[2];     /* Current and spare table */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_LPMROUTE
+static struct lpm_node_s g_ipv4_lpmnodes[2][LPM_IPv4_NNODES];
+static struct lpm_index_s g_ipv4_lpm;
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPMROUTE
+static struct lpm_node_s g_ipv6_lpmnodes[2][LPM_IPv6_NNODES];
+static struct lpm_index_s g_ipv6_lpm;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lpm_prefixlen
+ *
+ * Description:
+ *   Convert a network mask in network order to a prefix length.  Returns
+ *   -EINVAL if the mask is not contiguous.
+ *
+ ****************************************************************************/
+
+static int lpm_prefixlen(FAR const uint8_t *mask, int keylen)
+{
+  int plen = 0;
+  int i;
+
+  for (i = 0; i < keylen && mask[i] == 0xff; i++)
+    {
+      plen += 8;
+    }
+
+  if (i < keylen)
+    {
+      uint8_t inv = ~mask[i];
+
+      /* The inverted byte must be of the form 0..01..1 */
+
+      if ((inv & (inv + 1)) != 0)
+        {
+          return -EINVAL;
+        }
+
+      while ((mask[i] << (plen & 7)) & 0x80)
+        {
+          plen++;
+        }
+
+      for (i++; i < keylen; i++)
+        {
+          if (mask[i] != 0)
+            {
+              return -EINVAL;
+            }
+        }
+    }
+
+  return plen;
+}
+
+/****************************************************************************
+ * Name: lpm_common
+ *
+ * Description:
+ *   Return the number of leading bits, up to 'maxlen', that two keys have
+ *   in common.
+ *
+ ****************************************************************************/
+
+static int lpm_common(FAR const uint8_t *k1, FAR const uint8_t *k2,
+                      int maxlen)
+{
+  int nbits = 0;
+  int i;
+
+  for (i = 0; nbits < maxlen; i++)
+    {
+      uint8_t diff = k1[i] ^ k2[i];
+
+      if (diff != 0)
+        {
+          while ((diff & 0x80) == 0)
+            {
+              diff <<= 1;
+              nbits++;
+            }
+
+          break;
+        }
+
+      nbits += 8;
+    }
+
+  return nbits < maxlen ? nbits : maxlen;
+}
+
+/****************************************************************************
+ * Name: lpm_allocnode
+ *
+ * Description:
+ *   Allocate and initialize a node from the table's pool.  The key is
+ *   truncated to 'plen' bits.
+ *
+ ****************************************************************************/
+
+static FAR struct lpm_node_s *lpm_allocnode(FAR struct lpm_table_s *table,
+                                            FAR const uint8_t *key,
+                                            int plen, FAR void *route)
+{
+  FAR struct lpm_node_s *node;
+  int nbytes = (plen + 7) >> 3;
+
+  if (table->nused >= table->nnodes)
+    {
+      return NULL;
+    }
+
+  node = &table->pool[table->nused++];
+  memset(node, 0, sizeof(struct lpm_node_s));
+
+  memcpy(node->key, key, nbytes);
+  if ((plen & 7) != 0)
+    {
+      node->key[nbytes - 1] &= 0xff << (8 - (plen & 7));
+    }
+
+  node->plen  = plen;
+  node->route = route;
+  return node;
+}
+
+/****************************************************************************
+ * Name: lpm_insert
+ *
+ * Description:
+ *   Add a route with the prefix 'key/plen' to the trie.
+ *
+ ****************************************************************************/
+
+static int lpm_insert(FAR struct lpm_table_s *table, FAR const uint8_t *key,
+                      int plen, FAR void *route)
+{
+  FAR struct lpm_node_s **link = &table->root;
+  FAR struct lpm_node_s *parent = NULL;
+  FAR struct lpm_node_s *node;
+  FAR struct lpm_node_s *newnode;
+  FAR struct lpm_node_s *leaf;
+  int common;
+
+  /* Descend while the node's prefix is a prefix of the new key */
+
+  while ((node = *link) != NULL)
+    {
+      common = lpm_common(node->key, key,
+                          node->plen < plen ? node->plen : plen);
+      if (common < node->plen)
+        {
+          break;
+        }
+
+      if (node->plen == plen)
+        {
+          /* Same prefix.  Convert a branch node to a route node or append
+           * to the list of duplicates.
+           */
+
+          if (node->route == NULL)
+            {
+              node->route = route;
+              return OK;
+            }
+
+          newnode = lpm_allocnode(table, key, plen, route);
+          if (newnode == NULL)
+            {
+              return -ENOMEM;
+            }
+
+          while (node->dup != NULL)
+            {
+              node = node->dup;
+            }
+
+          node->dup = newnode;
+          return OK;
+        }
+
+      parent = node;
+      link   = &node->child[LPM_BIT(key, node->plen)];
+    }
+
+  if (node == NULL)
+    {
+      /* Add a new leaf at the end of the path */
+
+      leaf = lpm_allocnode(table, key, plen, route);
+      if (leaf == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      leaf->parent = parent;
+      *link        = leaf;
+      return OK;
+    }
+
+  /* The new prefix diverges from 'node' at bit 'common' */
+
+  if (common == plen)
+    {
+      /* The new prefix covers 'node':  Insert it above 'node' */
+
+      newnode = lpm_allocnode(table, key, plen, route);
+      if (newnode == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+  else
+    {
+      /* Insert a branch node above 'node' with the new leaf as its other
+       * child.
+       */
+
+      if (table->nused + 2 > table->nnodes)
+        {
+          return -ENOMEM;
+        }
+
+      newnode = lpm_allocnode(table, key, common, NULL);
+      leaf    = lpm_allocnode(table, key, plen, route);
+
+      leaf->parent = newnode;
+      newnode->child[LPM_BIT(key, common)] = leaf;
+    }
+
+  newnode->parent = parent;
+  newnode->child[LPM_BIT(node->key, common)] = node;
+  node->parent    = newnode;
+  *link           = newnode;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lpm_lookup
+ *
+ * Description:
+ *   Return the deepest node whose prefix contains 'key'.  All of the routes
+ *   covering 'key' are then found on the path from that node to the root,
+ *   longest prefix first.
+ *
+ ****************************************************************************/
+
+static FAR struct lpm_node_s *lpm_lookup(FAR struct lpm_table_s *table,
+                                         FAR const uint8_t *key)
+{
+  FAR struct lpm_node_s *node = table->root;
+  FAR struct lpm_node_s *best = NULL;
+  int maxbits = table->keylen << 3;
+
+  while (node != NULL &&
+         lpm_common(node->key, key, node->plen) == node->plen)
+    {
+      best = node;
+      if (node->plen >= maxbits)
+        {
+          break;
+        }
+
+      node = node->child[LPM_BIT(key, node->plen)];
+    }
+
+  return best;
+}
+
+/****************************************************************************
+ * Name: lpm_spare
+ *
+ * Description:
+ *   Return the table that is not being used for lookups, emptied and ready
+ *   to be rebuilt.
+ *
+ ****************************************************************************/
+
+static FAR struct lpm_table_s *lpm_spare(FAR struct lpm_index_s *index)
+{
+  FAR struct lpm_table_s *table;
+
+  table = index->active == &index->table[0] ?
+          &index->table[1] : &index->table[0];
+
+  table->root  = NULL;
+  table->nused = 0;
+  return table;
+}
+
+/****************************************************************************
+ * Name: lpm_insert_ipv4 and lpm_insert_ipv6
+ *
+ * Description:
+ *   Routing table traversal handlers that add each route to the table
+ *   being built.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_LPMROUTE
+static int lpm_insert_ipv4(FAR struct net_route_ipv4_s *route,
+                           FAR void *arg)
+{
+  FAR struct lpm_table_s *table = (FAR struct lpm_table_s *)arg;
+  int plen;
+
+  plen = lpm_prefixlen((FAR const uint8_t *)&route->netmask,
+                       sizeof(in_addr_t));
+  if (plen < 0)
+    {
+      return plen;
+    }
+
+  return lpm_insert(table, (FAR const uint8_t *)&route->target, plen,
+                    route);
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPMROUTE
+static int lpm_insert_ipv6(FAR struct net_route_ipv6_s *route,
+                           FAR void *arg)
+{
+  FAR struct lpm_table_s *table = (FAR struct lpm_table_s *)arg;
+  int plen;
+
+  plen = lpm_prefixlen((FAR const uint8_t *)route->netmask,
+                       sizeof(net_ipv6addr_t));
+  if (plen < 0)
+    {
+      return plen;
+    }
+
+  return lpm_insert(table, (FAR const uint8_t *)route->target, plen,
+                    route);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest-prefix-match index and build it from the
+ *   current content of the routing tables.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+void net_init_lpmroute(void)
+{
+  int i;
+
+  for (i = 0; i < 2; i++)
+    {
+#ifdef CONFIG_ROUTE_IPv4_LPMROUTE
+      g_ipv4_lpm.table[i].pool   = g_ipv4_lpmnodes[i];
+      g_ipv4_lpm.table[i].nnodes = LPM_IPv4_NNODES;
+      g_ipv4_lpm.table[i].keylen = sizeof(in_addr_t);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPMROUTE
+      g_ipv6_lpm.table[i].pool   = g_ipv6_lpmnodes[i];
+      g_ipv6_lpm.table[i].nnodes = LPM_IPv6_NNODES;
+      g_ipv6_lpm.table[i].keylen = sizeof(net_ipv6addr_t);
+#endif
+    }
+
+  /* A read-only routing table is only indexed here */
+
+#ifdef CONFIG_ROUTE_IPv4_LPMROUTE
+  net_updatelpm_ipv4();
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPMROUTE
+  net_updatelpm_ipv6();
+#endif
+}
+
+/****************************************************************************
+ * Name: net_updatelpm_ipv4 and net_updatelpm_ipv6
+ *
+ * Description:
+ *   Rebuild the longest-prefix-match index after the routing table has
+ *   been modified.  The new index is built in the spare node pool and then
+ *   made visible to lookups with a single pointer update.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None.  If the routing table cannot be indexed, the index is disabled
+ *   and net_lpmroute_ipv4/6() will return -ENOSYS until the next update.
+ *
+ * Assumptions:
+ *   The caller holds the network lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_LPMROUTE
+void net_updatelpm_ipv4(void)
+{
+  FAR struct lpm_table_s *table = lpm_spare(&g_ipv4_lpm);
+  int ret;
+
+  ret = net_foreachroute_ipv4(lpm_insert_ipv4, table);
+  if (ret < 0)
+    {
+      nwarn("WARNING: IPv4 routing table not indexed: %d\n", ret);
+      table = NULL;
+    }
+
+  g_ipv4_lpm.active = table;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPMROUTE
+void net_updatelpm_ipv6(void)
+{
+  FAR struct lpm_table_s *table = lpm_spare(&g_ipv6_lpm);
+  int ret;
+
+  ret = net_foreachroute_ipv6(lpm_insert_ipv6, table);
+  if (ret < 0)
+    {
+      nwarn("WARNING: IPv6 routing table not indexed: %d\n", ret);
+      table = NULL;
+    }
+
+  g_ipv6_lpm.active = table;
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv4 and net_lpmroute_ipv6
+ *
+ * Description:
+ *   Visit the routes whose prefix contains 'target', starting with the
+ *   longest prefix.  The traversal stops when the handler returns a
+ *   non-zero value.
+ *
+ * Input Parameters:
+ *   target  - The address to be routed.
+ *   handler - Will be called for each covering route.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   The non-zero value returned by the handler; zero (OK) if no route
+ *   was accepted by the handler; -ENOSYS if the index is not available and
+ *   the caller must fall back to net_foreachroute_ipv4/6().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_LPMROUTE
+int net_lpmroute_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                      FAR void *arg)
+{
+  FAR struct lpm_table_s *table = g_ipv4_lpm.active;
+  FAR struct lpm_node_s *node;
+  FAR struct lpm_node_s *dup;
+  int ret;
+
+  if (table == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  node = lpm_lookup(table, (FAR const uint8_t *)&target);
+  for (; node != NULL; node = node->parent)
+    {
+      for (dup = node; dup != NULL && dup->route != NULL; dup = dup->dup)
+        {
+          ret = handler((FAR struct net_route_ipv4_s *)dup->route, arg);
+          if (ret != 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPMROUTE
+int net_lpmroute_ipv6(const net_ipv6addr_t target,
+                      route_handler_ipv6_t handler, FAR void *arg)
+{
+  FAR struct lpm_table_s *table = g_ipv6_lpm.active;
+  FAR struct lpm_node_s *node;
+  FAR struct lpm_node_s *dup;
+  int ret;
+
+  if (table == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  node = lpm_lookup(table, (FAR const uint8_t *)target);
+  for (; node != NULL; node = node->parent)
+    {
+      for (dup = node; dup != NULL && dup->route != NULL; dup = dup->dup)
+        {
+          ret = handler((FAR struct net_route_ipv6_s *)dup->route, arg);
+          if (ret != 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+#endif
+
+#endif /* CONFIG_ROUTE_IPv4_LPMROUTE || CONFIG_ROUTE_IPv6_LPMROUTE */
@@ -33,6 +33,7 @@
 
 #include "netdev/netdev.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE)
@@ -224,11 +225,18 @@ void netdev_ipv4_router(FAR struct net_driver_s *dev, in_addr_t target,
   match.dev = dev;
   net_ipv4addr_copy(match.target, target);
 
-#ifdef CONFIG_ROUTE_IPv4_CACHEROUTE
+#if defined(CONFIG_ROUTE_IPv4_CACHEROUTE)
   /* First see if we can find a router entry in the cache */
 
   ret = net_foreachcache_ipv4(net_ipv4_devmatch, &match);
   if (ret <= 0)
+#elif defined(CONFIG_ROUTE_IPv4_LPMROUTE)
+  /* Use the index to visit only the covering routes, most specific first.
+   * The routing table is searched only if it could not be indexed.
+   */
+
+  ret = net_lpmroute_ipv4(match.target, net_ipv4_devmatch, &match);
+  if (ret < 0)
 #endif
     {
       /* Not found in the cache.  Try to find a router entry with the
@@ -303,11 +311,18 @@ void netdev_ipv6_router(FAR struct net_driver_s *dev,
   match.dev = dev;
   net_ipv6addr_copy(match.target, target);
 
-#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
+#if defined(CONFIG_ROUTE_IPv6_CACHEROUTE)
   /* First see if we can find a router entry in the cache */
 
   ret = net_foreachcache_ipv6(net_ipv6_devmatch, &match);
   if (ret <= 0)
+#elif defined(CONFIG_ROUTE_IPv6_LPMROUTE)
+  /* Use the index to visit only the covering routes, most specific first.
+   * The routing table is searched only if it could not be indexed.
+   */
+
+  ret = net_lpmroute_ipv6(match.target, net_ipv6_devmatch, &match);
+  if (ret < 0)
 #endif
     {
       /* Not found in the cache.  Try to find a router entry with the
@@ -30,6 +30,7 @@
 #include <string.h>
 #include <debug.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mm/circbuf.h>
 #include <nuttx/rptun/openamp.h>
@@ -220,7 +221,7 @@ static void rpmsg_socket_pollnotify(FAR struct rpmsg_socket_conn_s *conn,
 
           if (fds->revents != 0)
             {
-              rpmsg_socket_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -114,6 +114,7 @@ int psock_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
                  FAR socklen_t *addrlen, FAR struct socket *newsock)
 {
   FAR struct socket_conn_s *conn;
+  bool netlocked;
   int ret;
 
   DEBUGASSERT(psock != NULL && psock->s_conn != NULL && newsock != NULL);
@@ -139,7 +140,12 @@ int psock_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
 
   DEBUGASSERT(psock->s_sockif != NULL && psock->s_sockif->si_accept != NULL);
 
-  net_lock();
+  netlocked = _SS_NETLOCKED(psock);
+  if (netlocked)
+    {
+      net_lock();
+    }
+
   ret = psock->s_sockif->si_accept(psock, addr, addrlen, newsock);
   if (ret >= 0)
     {
@@ -154,7 +160,11 @@ int psock_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
       nerr("ERROR: si_accept failed: %d\n", ret);
     }
 
-  net_unlock();
+  if (netlocked)
+    {
+      net_unlock();
+    }
+
   return ret;
 }
 
@@ -0,0 +1,244 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <time.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives several messages from a socket with a single
+ *   call.  This is an internal OS interface.  It is functionally equivalent
+ *   to recvmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    Buffers to receive the messages
+ *   vlen      The number of messages in msgvec
+ *   flags     Receive flags
+ *   timeout   The time limit for the operation or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  Otherwise, if no
+ *   message was received, a negated errno value is returned (see comments
+ *   with recvmsg() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout)
+{
+  clock_t deadline = 0;
+  unsigned int count = 0;
+  ssize_t ret = OK;
+  bool netlocked;
+
+  /* Verify that non-NULL pointers were passed */
+
+  if (msgvec == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_conn == NULL)
+    {
+      return -EBADF;
+    }
+
+  if (timeout != NULL)
+    {
+      sclock_t ticks;
+
+      if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+          timeout->tv_nsec >= NSEC_PER_SEC)
+        {
+          return -EINVAL;
+        }
+
+      clock_time2ticks(timeout, &ticks);
+      deadline = clock_systime_ticks() + ticks;
+    }
+
+  /* Receive the messages with the network locked.  The lock is released
+   * only while waiting for data, so messages that are already queued on the
+   * socket are all dequeued without contending for the lock again.  Local
+   * sockets have a lock of their own and are not affected by the network
+   * lock.
+   */
+
+  netlocked = _SS_NETLOCKED(psock);
+  if (netlocked)
+    {
+      net_lock();
+    }
+
+  while (count < vlen)
+    {
+      ret = psock_recvmsg(psock, &msgvec[count].msg_hdr,
+                          flags & ~MSG_WAITFORONE);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[count++].msg_len = ret;
+
+      /* With MSG_WAITFORONE, only wait for the first message */
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      /* The time limit is checked after each message is received */
+
+      if (timeout != NULL &&
+          (sclock_t)(clock_systime_ticks() - deadline) >= 0)
+        {
+          break;
+        }
+    }
+
+  if (netlocked)
+    {
+      net_unlock();
+    }
+
+  /* Errors are only reported if no message was received */
+
+  return count > 0 ? (int)count : (int)ret;
+}
+
+/****************************************************************************
+ * Name: nx_recvmmsg
+ *
+ * Description:
+ *   nx_recvmmsg() receives several messages from a socket with a single
+ *   call.  This is an internal OS interface.  It is functionally equivalent
+ *   to recvmmsg() except that:
+ *
+ *   - It is not a cancellation point, and
+ *   - It does not modify the errno variable.
+ *
+ * Input Parameters:
+ *   sockfd  - Socket descriptor of socket
+ *   msgvec  - Buffers to receive the messages
+ *   vlen    - The number of messages in msgvec
+ *   flags   - Receive flags
+ *   timeout - The time limit for the operation or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  Otherwise, if no
+ *   message was received, a negated errno value is returned (see comments
+ *   with recvmsg() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int nx_recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+                int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* Then let psock_recvmmsg() do all of the work */
+
+  return psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+}
+
+/****************************************************************************
+ * Function: recvmmsg
+ *
+ * Description:
+ *   recvmmsg() receives several messages from a socket with a single call.
+ *   Each message is received as with recvmsg() and the length of the
+ *   message is returned in the msg_len field of its mmsghdr.
+ *
+ *   If MSG_WAITFORONE is set in flags, then MSG_DONTWAIT is applied after
+ *   the first message has been received.  The timeout is checked after each
+ *   message is received.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   Buffers to receive the messages
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *   timeout  The time limit for the operation or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  On error, -1 is
+ *   returned, and errno is set appropriately (see recvmsg()).  An error
+ *   that occurs after at least one message was received is not reported.
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Let nx_recvmmsg() do all of the work */
+
+  ret = nx_recvmmsg(sockfd, msgvec, vlen, flags, timeout);
+  if (ret < 0)
+    {
+      _SO_SETERRNO(sockfd_socket(sockfd), -ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
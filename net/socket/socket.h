@@ -57,6 +57,7 @@
 #define _SO_RCVLOWAT     _SO_BIT(SO_RCVLOWAT)
 #define _SO_RCVTIMEO     _SO_BIT(SO_RCVTIMEO)
 #define _SO_REUSEADDR    _SO_BIT(SO_REUSEADDR)
+#define _SO_REUSEPORT    _SO_BIT(SO_REUSEPORT)
 #define _SO_SNDBUF       _SO_BIT(SO_SNDBUF)
 #define _SO_SNDLOWAT     _SO_BIT(SO_SNDLOWAT)
 #define _SO_SNDTIMEO     _SO_BIT(SO_SNDTIMEO)
@@ -64,7 +65,7 @@
 
 /* This is the largest option value.  REVISIT: belongs in sys/socket.h */
 
-#define _SO_MAXOPT       (16)
+#define _SO_MAXOPT       (17)
 
 /* Macros to set, test, clear options */
 
@@ -107,6 +108,18 @@
 #  define _SO_SETERRNO(s,e) set_errno(e)
 #endif /* CONFIG_NET_SOCKOPTS */
 
+/* Local sockets are protected by a lock of their own rather than by the
+ * network lock (see net/local/local.h).  The socket layer must not hold
+ * the network lock across their operations, which may wait without
+ * releasing it.
+ */
+
+#ifdef CONFIG_NET_LOCAL
+#  define _SS_NETLOCKED(s) ((s)->s_domain != PF_LOCAL)
+#else
+#  define _SS_NETLOCKED(s) true
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
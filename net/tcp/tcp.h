@@ -36,7 +36,7 @@
 #include <nuttx/net/ip.h>
 #include <nuttx/net/net.h>
 
-#ifdef CONFIG_NET_TCP_NOTIFIER
+#if defined(CONFIG_NET_TCP_NOTIFIER) || defined(CONFIG_NET_TCP_CONN_TIMER)
 #  include <nuttx/wqueue.h>
 #endif
 
@@ -69,6 +69,9 @@
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 #  define TCP_WBNACK(wrb)            ((wrb)->wb_nack)
 #endif
+#ifdef CONFIG_NET_TCP_SACK
+#  define TCP_WBSACKED(wrb)          ((wrb)->wb_sacked)
+#endif
 #  define TCP_WBIOB(wrb)             ((wrb)->wb_iob)
 #  define TCP_WBCOPYOUT(wrb,dest,n)  (iob_copyout(dest,(wrb)->wb_iob,(n),0))
 #  define TCP_WBCOPYIN(wrb,src,n,off) \
@@ -103,6 +106,38 @@
 /* The TCP options flags */
 
 #define TCP_WSCALE            0x01U /* Window Scale option enabled */
+#define TCP_SACKOK            0x02U /* Selective ACK option enabled */
+#define TCP_TSTAMP            0x04U /* Timestamps option enabled */
+
+/* Space taken by the options that are added to every segment once they
+ * have been negotiated:  Two NOOPs for alignment plus the option itself.
+ */
+
+#define TCP_OPT_TS_SPACE      (2 + TCP_OPT_TS_LEN)
+#define TCP_OPT_SACK_SPACE(n) (4 + (n) * TCP_OPT_SACK_BLOCK)
+
+/* The number of out-of-order blocks remembered for SACK generation.  Only
+ * three of them fit in a segment that also carries a timestamp.
+ */
+
+#define TCP_SACK_NBLOCKS      4
+
+/* The timestamp clock (units: milliseconds) */
+
+#define TCP_TSNOW()           ((uint32_t)TICK2MSEC(clock_systime_ticks()))
+
+/* TCP timing (units: clock ticks).  TCP_RTO and TCP_TIME_WAIT_TIMEOUT are
+ * configured in half-seconds and seconds, respectively.
+ */
+
+#define TCP_RTO_TICKS         (TCP_RTO * TICK_PER_HSEC)
+#define TCP_RTO_MIN_TICKS     MSEC2TICK(CONFIG_NET_TCP_RTO_MIN)
+#define TCP_RTO_MAX_TICKS     SEC2TICK(60)
+#define TCP_TIME_WAIT_TICKS   SEC2TICK(TCP_TIME_WAIT_TIMEOUT)
+
+/* True if the clock tick value 'a' is at or past 'b' */
+
+#define TCP_TICK_GTE(a, b)    ((sclock_t)((a) - (b)) >= 0)
 
 /* After receiving 3 duplicate ACKs, TCP performs a retransmission
  * (RFC 5681 (3.2))
@@ -132,6 +167,66 @@ struct net_driver_s;      /* Forward reference */
 struct devif_callback_s;  /* Forward reference */
 struct tcp_backlog_s;     /* Forward reference */
 struct tcp_hdr_s;         /* Forward reference */
+struct tcp_conn_s;        /* Forward reference */
+
+#ifdef CONFIG_NET_TCP_CC
+/* A congestion control algorithm.  The common logic in tcp_cc.c performs
+ * slow start and fast recovery; the algorithm decides how the congestion
+ * window grows during congestion avoidance and how far the window is
+ * reduced when a loss is detected.
+ */
+
+struct tcp_cc_ops_s
+{
+  FAR const char *name;    /* Name used with the TCP_CONGESTION option */
+
+  /* Reset the algorithm-specific state of a connection */
+
+  void (*init)(FAR struct tcp_conn_s *conn);
+
+  /* Grow cwnd in congestion avoidance when 'acked' new bytes were ACKed */
+
+  void (*cong_avoid)(FAR struct tcp_conn_s *conn, uint32_t acked);
+
+  /* Return the new slow start threshold when a loss is detected */
+
+  uint32_t (*ssthresh)(FAR struct tcp_conn_s *conn);
+};
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+/* Per-connection CUBIC state.  Windows are in bytes. */
+
+struct tcp_cubic_s
+{
+  clock_t  epoch;         /* Start of the congestion avoidance epoch, or 0 */
+  uint32_t w_max;         /* Window before the last reduction */
+  uint32_t origin;        /* Plateau of the cubic function */
+  uint32_t k;             /* Time to reach the plateau (msec) */
+  uint32_t w_est;         /* Window that standard TCP would have */
+};
+#endif
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+/* One block of contiguous data, [left, right) in sequence space */
+
+struct tcp_sack_s
+{
+  uint32_t left;          /* First sequence number of the block */
+  uint32_t right;         /* Sequence number following the block */
+};
+#endif
+
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+/* A block of data received ahead of the next expected sequence number */
+
+struct tcp_ofoseg_s
+{
+  uint32_t left;          /* First sequence number of the block */
+  uint32_t right;         /* Sequence number following the block */
+  FAR struct iob_s *data; /* I/O buffer chain holding the block */
+};
+#endif
 
 /* This is a container that holds the poll-related information */
 
@@ -174,6 +269,11 @@ struct tcp_conn_s
 
   /* TCP-specific content follows */
 
+  FAR struct tcp_conn_s *hnext; /* Next connection in the 4-tuple hash chain */
+  FAR struct tcp_conn_s *pnext; /* Next connection in the local port hash
+                                 * chain */
+  FAR struct tcp_conn_s *lnext; /* Next connection in the listener hash
+                                 * chain */
   union ip_binding_u u;   /* IP address binding */
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
@@ -186,18 +286,31 @@ struct tcp_conn_s
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
   uint8_t  domain;        /* IP domain: PF_INET or PF_INET6 */
 #endif
-  uint8_t  sa;            /* Retransmission time-out calculation state
+  uint32_t sa;            /* Retransmission time-out calculation state
                            * variable */
-  uint8_t  sv;            /* Retransmission time-out calculation state
+  uint32_t sv;            /* Retransmission time-out calculation state
                            * variable */
-  uint8_t  rto;           /* Retransmission time-out */
+  uint32_t rto;           /* Retransmission time-out (units: clock ticks) */
+  clock_t  timer;         /* Expiration time of the retransmission timer or,
+                           * in TIME_WAIT and FIN_WAIT_2, of the connection */
+  uint32_t timer_rto;     /* The time-out that the retransmission timer was
+                           * last started with */
+  bool     timer_armed;   /* True: The retransmission timer is running */
   uint8_t  tcpstateflags; /* TCP state and flags */
-  uint8_t  timer;         /* The retransmission timer (units: half-seconds) */
   uint8_t  nrtx;          /* The number of retransmissions for the last
                            * segment sent */
 #ifdef CONFIG_NET_TCP_DELAYED_ACK
   uint8_t  rx_unackseg;   /* Number of un-ACKed received segments */
-  uint8_t  rx_acktimer;   /* Time since last ACK sent (units: half-seconds) */
+  clock_t  rx_acktime;    /* Time that the ACK was delayed */
+#endif
+#ifdef CONFIG_NET_TCP_CONN_TIMER
+  bool     timeout;       /* True: The timer has expired, poll the
+                           * connection with tcp_timer() */
+  bool     freed;         /* True: tcp_free() has been called, the timer
+                           * work releases the connection */
+  uint8_t  nwork;         /* Number of instances of the timer work that are
+                           * queued or have been dequeued but not run */
+  struct work_s work;     /* Runs the timer of this connection */
 #endif
   uint16_t lport;         /* The local TCP port, in network byte order */
   uint16_t rport;         /* The remoteTCP port, in network byte order */
@@ -229,6 +342,14 @@ struct tcp_conn_s
   uint16_t tx_unacked;    /* Number bytes sent but not yet ACKed */
 #endif
   uint16_t flags;         /* Flags of TCP-specific options */
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  uint32_t ts_recent;     /* The last timestamp received from the peer */
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+  uint8_t  rcv_nsack;     /* Number of valid entries in rcv_sack[] */
+  struct tcp_sack_s rcv_sack[TCP_SACK_NBLOCKS]; /* Out-of-order data held,
+                                                 * most recent first */
+#endif
 
   /* If the TCP socket is bound to a local address, then this is
    * a reference to the device that routes traffic on the corresponding
@@ -245,6 +366,20 @@ struct tcp_conn_s
 
   struct iob_s *readahead;   /* Read-ahead buffering */
 
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+  /* Out-of-order buffering
+   *
+   *   ofosegs   - The blocks received beyond a hole in sequence number
+   *               order.  Adjacent and overlapping blocks are merged.
+   *   nofosegs  - The number of valid entries in ofosegs[]
+   *   ofobytes  - The total number of bytes held in ofosegs[]
+   */
+
+  struct tcp_ofoseg_s ofosegs[CONFIG_NET_TCP_OUT_OF_ORDER_SEGMENTS];
+  uint8_t  nofosegs;
+  uint32_t ofobytes;
+#endif
+
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   /* Write buffering
    *
@@ -264,6 +399,20 @@ struct tcp_conn_s
                            * segment (next greater sndseq) */
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+  /* Congestion control.  Windows are in bytes. */
+
+  FAR const struct tcp_cc_ops_s *cc_ops; /* Congestion control algorithm */
+  uint32_t   cwnd;        /* Congestion window */
+  uint32_t   ssthresh;    /* Slow start threshold */
+  uint32_t   recover;     /* Highest sequence number sent when fast
+                           * recovery was entered */
+  bool       inrecovery;  /* True: in fast recovery */
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  struct tcp_cubic_s cubic; /* CUBIC algorithm state */
+#endif
+#endif
+
 #ifdef CONFIG_NET_TCPBACKLOG
   /* Listen backlog support
    *
@@ -348,6 +497,9 @@ struct tcp_wrbuffer_s
                             * segment sent */
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
   uint8_t    wb_nack;      /* The number of ack count */
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+  bool       wb_sacked;    /* True: The peer reported all of it received */
 #endif
   struct iob_s *wb_iob;    /* Head of the I/O buffer chain */
 };
@@ -383,6 +535,22 @@ extern "C"
 {
 #endif
 
+/* The lock that protects the list of free TCP connections.  It may be
+ * taken while holding the network lock, but the network lock must never be
+ * taken while holding it.
+ */
+
+extern struct netlock_s g_tcp_lock;
+
+#ifdef CONFIG_NET_TCP_CC
+/* The available congestion control algorithms */
+
+extern const struct tcp_cc_ops_s g_tcp_cc_newreno;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+extern const struct tcp_cc_ops_s g_tcp_cc_cubic;
+#endif
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -422,6 +590,21 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain);
 
 void tcp_free(FAR struct tcp_conn_s *conn);
 
+/****************************************************************************
+ * Name: tcp_release
+ *
+ * Description:
+ *   Return the storage of a connection that has been freed by tcp_free()
+ *   to the free list.  This is normally done by tcp_free() itself, but is
+ *   left to the timer work of the connection if that was already running.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+void tcp_release(FAR struct tcp_conn_s *conn);
+
 /****************************************************************************
  * Name: tcp_active
  *
@@ -812,12 +995,11 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn);
  * Name: tcp_timer
  *
  * Description:
- *   Handle a TCP timer expiration for the provided TCP connection
+ *   Handle the TCP timers that have expired for the provided TCP connection
  *
  * Input Parameters:
  *   dev  - The device driver structure to use in the send operation
  *   conn - The TCP "connection" to poll for TX data
- *   hsec - The polling interval in halves of a second
  *
  * Returned Value:
  *   None
@@ -827,8 +1009,52 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn);
  *
  ****************************************************************************/
 
-void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
-               int hsec);
+void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_update_timer
+ *
+ * Description:
+ *   Start the retransmission timer if data has become outstanding and, with
+ *   CONFIG_NET_TCP_CONN_TIMER, schedule the timer work of the connection
+ *   for the earliest pending timer.  This must be called after any change
+ *   of the TCP state that is relevant to the timers.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+void tcp_update_timer(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_stop_timer
+ *
+ * Description:
+ *   Stop the timer work of a connection that is being freed.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONN_TIMER
+void tcp_stop_timer(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_stop_timer(conn)
+#endif
 
 /****************************************************************************
  * Name: tcp_findlistener
@@ -1947,6 +2173,329 @@ int tcp_ioctl(FAR struct tcp_conn_s *conn, int cmd,
 void tcp_sendbuffer_notify(FAR struct tcp_conn_s *conn);
 #endif /* CONFIG_NET_SEND_BUFSIZE */
 
+/****************************************************************************
+ * Name: tcp_gso_unsent
+ *
+ * Description:
+ *   The driver stopped accepting packets before all segments of a TCP
+ *   super-segment were passed to it.  Return the data of the segments that
+ *   were not sent to the write queue.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection of interest
+ *   seqno - The sequence number of the first byte that was not sent
+ *   len   - The number of bytes that were not sent
+ *
+ * Assumptions:
+ *   Called from the network driver with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_GSO
+void tcp_gso_unsent(FAR struct tcp_conn_s *conn, uint32_t seqno,
+                    uint32_t len);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_find
+ *
+ * Description:
+ *   Look up a congestion control algorithm by name.  A NULL name returns
+ *   the default algorithm.
+ *
+ * Input Parameters:
+ *   name - The algorithm name, as used with the TCP_CONGESTION option
+ *
+ * Returned Value:
+ *   The algorithm, or NULL if there is no algorithm with that name.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+FAR const struct tcp_cc_ops_s *tcp_cc_find(FAR const char *name);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Switch the connection to a different congestion control algorithm.
+ *   The current congestion window is preserved.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *   ops  - The new congestion control algorithm
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_select(FAR struct tcp_conn_s *conn,
+                   FAR const struct tcp_cc_ops_s *ops);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Set up the initial congestion window when a connection enters the
+ *   ESTABLISHED state and the MSS is known.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_init(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_cc_init(conn)
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion window when an ACK covers new data.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   ackseq - The acknowledgement number of the segment
+ *   acked  - The number of newly acknowledged bytes
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackseq,
+                uint32_t acked);
+#else
+#  define tcp_cc_ack(conn, ackseq, acked)
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_dupack
+ *
+ * Description:
+ *   Inflate the congestion window for each further duplicate ACK received
+ *   during fast recovery.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_dupack(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_cc_dupack(conn)
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_loss
+ *
+ * Description:
+ *   Reduce the congestion window when a loss is detected, either by
+ *   duplicate ACKs (fast retransmit) or by the retransmission timer.
+ *
+ * Input Parameters:
+ *   conn    - The TCP connection of interest
+ *   timeout - True if the retransmission timer expired
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_loss(FAR struct tcp_conn_s *conn, bool timeout);
+#else
+#  define tcp_cc_loss(conn, timeout)
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_mark
+ *
+ * Description:
+ *   Update the SACK scoreboard from a SACK option received from the peer:
+ *   Each un-ACKed write buffer that lies entirely within one of the
+ *   reported blocks is marked so that it is not sent again on fast
+ *   retransmit.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *   opt  - The SACK option, starting with the option kind
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+void tcp_sack_mark(FAR struct tcp_conn_s *conn, FAR const uint8_t *opt);
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_clear
+ *
+ * Description:
+ *   Forget everything that the peer has reported with SACK options.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+void tcp_sack_clear(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_sack_clear(conn)
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_add
+ *
+ * Description:
+ *   Remember a block of out-of-order data that has been received and
+ *   retained so that it is reported to the peer.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection of interest
+ *   left  - The first sequence number of the received data
+ *   right - The sequence number following the received data
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+void tcp_sack_add(FAR struct tcp_conn_s *conn, uint32_t left,
+                  uint32_t right);
+#else
+#  define tcp_sack_add(conn, left, right)
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_trim
+ *
+ * Description:
+ *   Drop the out-of-order blocks, or the parts of them, that are now
+ *   covered by the cumulative acknowledgement.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+void tcp_sack_trim(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_sack_trim(conn)
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_build
+ *
+ * Description:
+ *   Format a SACK option reporting the retained out-of-order blocks.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection of interest
+ *   buf   - The location in the TCP header to write the option to
+ *   space - The number of bytes available for the option
+ *
+ * Returned Value:
+ *   The number of bytes written; zero if there is nothing to report.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+unsigned int tcp_sack_build(FAR struct tcp_conn_s *conn, FAR uint8_t *buf,
+                            unsigned int space);
+#endif
+
+/****************************************************************************
+ * Name: tcp_ofoseg_input
+ *
+ * Description:
+ *   Retain the payload of a segment that was received beyond the next
+ *   expected sequence number.  The payload is merged with any held blocks
+ *   that it overlaps or adjoins.  The data is dropped if the configured
+ *   limits would be exceeded or no I/O buffers are available.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure containing the received segment;
+ *          d_appdata and d_len describe the payload.
+ *   conn - The TCP connection of interest
+ *   seq  - The sequence number of the first byte of the payload
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+void tcp_ofoseg_input(FAR struct net_driver_s *dev,
+                      FAR struct tcp_conn_s *conn, uint32_t seq);
+#endif
+
+/****************************************************************************
+ * Name: tcp_ofoseg_deliver
+ *
+ * Description:
+ *   Move the held blocks that have become contiguous with the received
+ *   data to the read-ahead buffer and advance rcvseq past them.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+void tcp_ofoseg_deliver(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_ofoseg_free
+ *
+ * Description:
+ *   Release all of the blocks held for a connection.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+void tcp_ofoseg_free(FAR struct tcp_conn_s *conn);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
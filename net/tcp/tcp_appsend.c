@@ -49,6 +49,7 @@
 #include <assert.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/tcp.h>
@@ -106,10 +107,6 @@ void tcp_appsend(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
     {
       /* Yes.. Handle delayed acknowledgments */
 
-      /* Reset the ACK timer in any event. */
-
-      conn->rx_acktimer = 0;
-
       /* Per RFC 1122:  "...in a stream of full-sized segments there
        * SHOULD be an ACK for at least every second segment."
        *
@@ -142,6 +139,8 @@ void tcp_appsend(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
            */
 
           conn->rx_unackseg = 1;
+          conn->rx_acktime  = clock_systime_ticks();
+          tcp_update_timer(conn);
           return;
         }
     }
@@ -264,7 +264,8 @@ uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
 
       if (iob == NULL)
         {
-          iob = iob_tryalloc(throttled, IOBUSER_NET_TCP_READAHEAD);
+          iob = iob_tryalloc_size(throttled, buflen - copied,
+                                  IOBUSER_NET_TCP_READAHEAD);
           if (iob == NULL)
             {
               continue;
@@ -0,0 +1,423 @@
+/****************************************************************************
+ * net/tcp/tcp_cc.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The congestion window never needs to be larger than the largest window
+ * that the peer can advertise.
+ */
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+#  define TCP_CC_MAXWND(conn) ((uint32_t)UINT16_MAX << (conn)->snd_scale)
+#else
+#  define TCP_CC_MAXWND(conn) ((uint32_t)UINT16_MAX)
+#endif
+
+#ifdef CONFIG_NET_TCP_CC_DEFAULT_CUBIC
+#  define TCP_CC_DEFAULT      (&g_tcp_cc_cubic)
+#else
+#  define TCP_CC_DEFAULT      (&g_tcp_cc_newreno)
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void newreno_init(FAR struct tcp_conn_s *conn);
+static void newreno_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked);
+static uint32_t newreno_ssthresh(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_newreno =
+{
+  "newreno",                   /* name */
+  newreno_init,                /* init */
+  newreno_cong_avoid,          /* cong_avoid */
+  newreno_ssthresh             /* ssthresh */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All of the algorithms that can be selected with TCP_CONGESTION */
+
+static FAR const struct tcp_cc_ops_s * const g_tcp_cc_algorithms[] =
+{
+  &g_tcp_cc_newreno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  &g_tcp_cc_cubic,
+#endif
+};
+
+#define TCP_CC_NALGORITHMS \
+  (sizeof(g_tcp_cc_algorithms) / sizeof(g_tcp_cc_algorithms[0]))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: newreno_init
+ *
+ * Description:
+ *   NewReno keeps no state of its own.
+ *
+ ****************************************************************************/
+
+static void newreno_init(FAR struct tcp_conn_s *conn)
+{
+}
+
+/****************************************************************************
+ * Name: newreno_cong_avoid
+ *
+ * Description:
+ *   Grow the congestion window by about one MSS per round trip
+ *   (RFC 5681, section 3.1).
+ *
+ ****************************************************************************/
+
+static void newreno_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  uint32_t incr;
+
+  incr = (uint32_t)conn->mss * conn->mss / conn->cwnd;
+  conn->cwnd += incr > 0 ? incr : 1;
+}
+
+/****************************************************************************
+ * Name: newreno_ssthresh
+ *
+ * Description:
+ *   Halve the amount of data in flight, but keep at least two segments
+ *   (RFC 5681, equation 4).
+ *
+ ****************************************************************************/
+
+static uint32_t newreno_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  uint32_t ssthresh = conn->tx_unacked / 2;
+
+  return ssthresh > 2 * conn->mss ? ssthresh : 2 * conn->mss;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_find
+ *
+ * Description:
+ *   Look up a congestion control algorithm by name.  A NULL name returns
+ *   the default algorithm.
+ *
+ * Input Parameters:
+ *   name - The algorithm name, as used with the TCP_CONGESTION option
+ *
+ * Returned Value:
+ *   The algorithm, or NULL if there is no algorithm with that name.
+ *
+ ****************************************************************************/
+
+FAR const struct tcp_cc_ops_s *tcp_cc_find(FAR const char *name)
+{
+  int i;
+
+  if (name == NULL)
+    {
+      return TCP_CC_DEFAULT;
+    }
+
+  for (i = 0; i < TCP_CC_NALGORITHMS; i++)
+    {
+      if (strcmp(g_tcp_cc_algorithms[i]->name, name) == 0)
+        {
+          return g_tcp_cc_algorithms[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Switch the connection to a different congestion control algorithm.
+ *   The current congestion window is preserved.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *   ops  - The new congestion control algorithm
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_select(FAR struct tcp_conn_s *conn,
+                   FAR const struct tcp_cc_ops_s *ops)
+{
+  DEBUGASSERT(conn != NULL && ops != NULL);
+
+  conn->cc_ops = ops;
+  ops->init(conn);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Set up the initial congestion window when a connection enters the
+ *   ESTABLISHED state and the MSS is known.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_init(FAR struct tcp_conn_s *conn)
+{
+  uint32_t mss = conn->mss;
+
+  if (conn->cc_ops == NULL)
+    {
+      conn->cc_ops = TCP_CC_DEFAULT;
+    }
+
+  /* Initial window per RFC 5681, section 3.1 */
+
+  if (mss > 2190)
+    {
+      conn->cwnd = 2 * mss;
+    }
+  else if (mss > 1095)
+    {
+      conn->cwnd = 3 * mss;
+    }
+  else
+    {
+      conn->cwnd = 4 * mss;
+    }
+
+  /* Start with an arbitrarily high slow start threshold so that the path
+   * is probed until the first loss.
+   */
+
+  conn->ssthresh   = UINT32_MAX;
+  conn->recover    = 0;
+  conn->inrecovery = false;
+
+  conn->cc_ops->init(conn);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion window when an ACK covers new data.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   ackseq - The acknowledgement number of the segment
+ *   acked  - The number of newly acknowledged bytes
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackseq,
+                uint32_t acked)
+{
+  uint32_t mss = conn->mss;
+
+  if (conn->cwnd == 0)
+    {
+      /* Not yet initialized:  The connection is not ESTABLISHED */
+
+      return;
+    }
+
+  if (conn->inrecovery)
+    {
+      if (TCP_SEQ_GTE(ackseq, conn->recover))
+        {
+          /* Full acknowledgement:  Leave fast recovery and deflate the
+           * window (RFC 6582, section 3.2, step 3).
+           */
+
+          conn->cwnd       = conn->ssthresh;
+          conn->inrecovery = false;
+          ninfo("cwnd=%" PRIu32 " recovered\n", conn->cwnd);
+        }
+      else
+        {
+          /* Partial acknowledgement:  Deflate the window by the amount of
+           * new data acknowledged, then add back one MSS if at least that
+           * much was acknowledged (RFC 6582, section 3.2, step 4).
+           */
+
+          conn->cwnd = conn->cwnd > acked ? conn->cwnd - acked : 0;
+          if (acked >= mss)
+            {
+              conn->cwnd += mss;
+            }
+
+          if (conn->cwnd < mss)
+            {
+              conn->cwnd = mss;
+            }
+        }
+
+      return;
+    }
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      /* Slow start:  Grow by the number of bytes acknowledged, but by no
+       * more than one MSS per ACK (RFC 5681, section 3.1).
+       */
+
+      conn->cwnd += acked < mss ? acked : mss;
+    }
+  else
+    {
+      conn->cc_ops->cong_avoid(conn, acked);
+    }
+
+  if (conn->cwnd > TCP_CC_MAXWND(conn))
+    {
+      conn->cwnd = TCP_CC_MAXWND(conn);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_dupack
+ *
+ * Description:
+ *   Inflate the congestion window for each further duplicate ACK received
+ *   during fast recovery.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_dupack(FAR struct tcp_conn_s *conn)
+{
+  if (conn->inrecovery && conn->cwnd < TCP_CC_MAXWND(conn))
+    {
+      conn->cwnd += conn->mss;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_loss
+ *
+ * Description:
+ *   Reduce the congestion window when a loss is detected, either by
+ *   duplicate ACKs (fast retransmit) or by the retransmission timer.
+ *
+ * Input Parameters:
+ *   conn    - The TCP connection of interest
+ *   timeout - True if the retransmission timer expired
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_loss(FAR struct tcp_conn_s *conn, bool timeout)
+{
+  uint32_t mss = conn->mss;
+
+  if (conn->cwnd == 0)
+    {
+      return;
+    }
+
+  if (timeout)
+    {
+      /* The retransmission timer expired:  Only the loss window is left
+       * and the connection returns to slow start (RFC 5681, section 3.1).
+       * Don't reduce ssthresh again for the backed-off retransmissions of
+       * the same segment.
+       */
+
+      if (conn->nrtx <= 1)
+        {
+          conn->ssthresh = conn->cc_ops->ssthresh(conn);
+        }
+
+      conn->cwnd       = mss;
+      conn->inrecovery = false;
+    }
+  else if (!conn->inrecovery)
+    {
+      /* Fast retransmit:  Enter fast recovery.  The window is inflated by
+       * the three segments that have left the network (RFC 6582, section
+       * 3.2, step 2).
+       */
+
+      conn->ssthresh   = conn->cc_ops->ssthresh(conn);
+      conn->cwnd       = conn->ssthresh + 3 * mss;
+      conn->recover    = conn->sndseq_max;
+      conn->inrecovery = true;
+    }
+
+  ninfo("cwnd=%" PRIu32 " ssthresh=%" PRIu32 " timeout=%d\n",
+        conn->cwnd, conn->ssthresh, timeout);
+}
+
+#endif /* CONFIG_NET_TCP_CC */
@@ -0,0 +1,247 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_cubic.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The CUBIC constants of RFC 8312 are C = 0.4 and beta_cubic = 0.7.  They
+ * are applied as fractions below:
+ *
+ *   C          = 2 / 5 segments per second^3
+ *   beta_cubic = 7 / 10
+ *   (1 + beta_cubic) / 2         = 17 / 20 (fast convergence)
+ *   3 (1 - beta) / (1 + beta)    = 9 / 17  (TCP-friendly increase)
+ */
+
+/* Limit of |t - K| in msec so that the cube cannot overflow */
+
+#define CUBIC_MAXDELTA   (1 << 18)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn);
+static void cubic_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked);
+static uint32_t cubic_ssthresh(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_cubic =
+{
+  "cubic",                     /* name */
+  cubic_init,                  /* init */
+  cubic_cong_avoid,            /* cong_avoid */
+  cubic_ssthresh               /* ssthresh */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cubic_cbrt
+ *
+ * Description:
+ *   Integer cube root, rounded down.
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+  uint32_t lo = 0;
+  uint32_t hi = 1 << 21;   /* (2^21)^3 = 2^63 */
+
+  while (lo < hi)
+    {
+      uint32_t mid = lo + (hi - lo + 1) / 2;
+
+      if ((uint64_t)mid * mid * mid <= x)
+        {
+          lo = mid;
+        }
+      else
+        {
+          hi = mid - 1;
+        }
+    }
+
+  return lo;
+}
+
+/****************************************************************************
+ * Name: cubic_init
+ *
+ * Description:
+ *   Forget any previous congestion epoch.
+ *
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn)
+{
+  memset(&conn->cubic, 0, sizeof(struct tcp_cubic_s));
+}
+
+/****************************************************************************
+ * Name: cubic_cong_avoid
+ *
+ * Description:
+ *   Grow the congestion window towards the cubic function of the time
+ *   since the start of the epoch (RFC 8312, section 4).
+ *
+ ****************************************************************************/
+
+static void cubic_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->cubic;
+  uint32_t cwnd = conn->cwnd;
+  uint32_t mss = conn->mss;
+  clock_t now = clock_systime_ticks();
+  int64_t delta;
+  int64_t target;
+  uint32_t incr;
+
+  if (cubic->epoch == 0)
+    {
+      /* A new epoch begins with the first ACK after a reduction.  K is the
+       * time that the cubic function needs to return to the plateau:
+       *
+       *   K = cbrt((W_max - cwnd) / C)
+       */
+
+      cubic->epoch = now != 0 ? now : 1;
+      if (cwnd < cubic->w_max)
+        {
+          cubic->k      = cubic_cbrt((uint64_t)(cubic->w_max - cwnd) *
+                                     2500000000ull / mss);
+          cubic->origin = cubic->w_max;
+        }
+      else
+        {
+          cubic->k      = 0;
+          cubic->origin = cwnd;
+        }
+
+      cubic->w_est = cwnd;
+    }
+
+  /* W_cubic(t) = C * (t - K)^3 + W_max, with t and K in msec */
+
+  delta = (int64_t)TICK2MSEC(now - cubic->epoch) - cubic->k;
+  if (delta > CUBIC_MAXDELTA)
+    {
+      delta = CUBIC_MAXDELTA;
+    }
+  else if (delta < -CUBIC_MAXDELTA)
+    {
+      delta = -CUBIC_MAXDELTA;
+    }
+
+  target = (int64_t)cubic->origin +
+           delta * delta * delta / 1000 * 2 * mss / 5000000;
+
+  /* Move towards the target by (target - cwnd) / cwnd per ACK in the
+   * convex and concave regions, but by no more than half a segment.
+   * Above the target, the window only creeps up.
+   */
+
+  if (target > cwnd)
+    {
+      uint64_t diff = (uint64_t)(target - cwnd) * mss / cwnd;
+
+      incr = diff > mss / 2 ? mss / 2 : (uint32_t)diff;
+    }
+  else
+    {
+      incr = (uint32_t)mss * mss / (100 * cwnd);
+    }
+
+  /* In the TCP-friendly region, CUBIC must be at least as aggressive as
+   * standard TCP would be (RFC 8312, section 4.2).
+   */
+
+  cubic->w_est += (uint32_t)((uint64_t)9 * mss * acked / (17 * cwnd));
+  if (cubic->w_est > cwnd + incr)
+    {
+      conn->cwnd = cubic->w_est;
+    }
+  else
+    {
+      conn->cwnd = cwnd + (incr > 0 ? incr : 1);
+    }
+}
+
+/****************************************************************************
+ * Name: cubic_ssthresh
+ *
+ * Description:
+ *   Reduce the window by beta_cubic and remember the window at which the
+ *   loss happened (RFC 8312, sections 4.5 and 4.6).
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->cubic;
+  uint32_t cwnd = conn->cwnd;
+  uint32_t ssthresh;
+
+  cubic->epoch = 0;
+
+  /* Fast convergence:  Release bandwidth to new flows if the window
+   * could not even reach the previous plateau.
+   */
+
+  if (cwnd < cubic->w_max)
+    {
+      cubic->w_max = (uint32_t)((uint64_t)cwnd * 17 / 20);
+    }
+  else
+    {
+      cubic->w_max = cwnd;
+    }
+
+  ssthresh = (uint32_t)((uint64_t)cwnd * 7 / 10);
+  return ssthresh > 2 * conn->mss ? ssthresh : 2 * conn->mss;
+}
+
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
@@ -56,6 +56,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/mm/slab.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -65,6 +66,7 @@
 #include "devif/devif.h"
 #include "inet/inet.h"
 #include "tcp/tcp.h"
+#include "utils/utils.h"
 #include "arp/arp.h"
 #include "icmpv6/icmpv6.h"
 
@@ -75,6 +77,14 @@
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The lock that protects the list of free TCP connections */
+
+struct netlock_s g_tcp_lock = NETLOCK_INITIALIZER;
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -83,9 +93,15 @@
 
 #ifndef CONFIG_NET_ALLOC_CONNS
 static struct tcp_conn_s g_tcp_connections[CONFIG_NET_TCP_CONNS];
+#elif defined(CONFIG_MM_SLAB)
+/* The slab cache from which TCP connections are allocated */
+
+static SLAB_HANDLE g_tcp_slab;
 #endif
 
-/* A list of all free TCP connections */
+/* A list of all free TCP connections.  The free list is protected by
+ * g_tcp_lock, so that sockets can be created without the network lock.
+ */
 
 static dq_queue_t g_free_tcp_connections;
 
@@ -93,10 +109,170 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+/* Hash tables of the connections in g_active_tcp_connections.
+ *
+ *   g_tcp_conn_hash - Indexed by the remote address, the remote port and
+ *     the local port.  The local address is not part of the key because a
+ *     connection may be bound to INADDR_ANY.  Used to demultiplex incoming
+ *     segments.
+ *   g_tcp_port_hash - Indexed by the local port only.  Used by bind() and
+ *     by the ephemeral port selection.
+ */
+
+static FAR struct tcp_conn_s *g_tcp_conn_hash[CONFIG_NET_TCP_HASHSIZE];
+static FAR struct tcp_conn_s *g_tcp_port_hash[CONFIG_NET_TCP_HASHSIZE];
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_hash_mix
+ *
+ * Description:
+ *   Fold an address key and a port pair into an index of the 4-tuple hash
+ *   table.
+ *
+ ****************************************************************************/
+
+static inline unsigned int tcp_hash_mix(uint32_t key, uint16_t lport,
+                                        uint16_t rport)
+{
+  key ^= ((uint32_t)lport << 16) | rport;
+  key ^= key >> 16;
+  key *= 0x45d9f3b;
+  key ^= key >> 16;
+
+  return key % CONFIG_NET_TCP_HASHSIZE;
+}
+
+/****************************************************************************
+ * Name: tcp_ipv4_hash and tcp_ipv6_hash
+ *
+ * Description:
+ *   Return the 4-tuple hash table index for the remote address, remote port
+ *   and local port (all in network order).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static inline unsigned int tcp_ipv4_hash(in_addr_t raddr, uint16_t lport,
+                                         uint16_t rport)
+{
+  return tcp_hash_mix((uint32_t)raddr, lport, rport);
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static inline unsigned int tcp_ipv6_hash(FAR const uint16_t *raddr,
+                                         uint16_t lport, uint16_t rport)
+{
+  uint32_t key;
+
+  key = ((uint32_t)(raddr[0] ^ raddr[2] ^ raddr[4] ^ raddr[6]) << 16) |
+        (raddr[1] ^ raddr[3] ^ raddr[5] ^ raddr[7]);
+
+  return tcp_hash_mix(key, lport, rport);
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_conn_hash
+ *
+ * Description:
+ *   Return the 4-tuple hash table index of a connection.
+ *
+ ****************************************************************************/
+
+static unsigned int tcp_conn_hash(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return tcp_ipv4_hash(conn->u.ipv4.raddr, conn->lport, conn->rport);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return tcp_ipv6_hash(conn->u.ipv6.raddr, conn->lport, conn->rport);
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+
+/****************************************************************************
+ * Name: tcp_hash_insert
+ *
+ * Description:
+ *   Add a connection that is being placed in the active list to the
+ *   4-tuple and local port hash tables.
+ *
+ * Assumptions:
+ *   This function is called from network logic with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_hash_insert(FAR struct tcp_conn_s *conn)
+{
+  unsigned int ndx;
+
+  ndx                   = tcp_conn_hash(conn);
+  conn->hnext           = g_tcp_conn_hash[ndx];
+  g_tcp_conn_hash[ndx]  = conn;
+
+  ndx                   = NTOHS(conn->lport) % CONFIG_NET_TCP_HASHSIZE;
+  conn->pnext           = g_tcp_port_hash[ndx];
+  g_tcp_port_hash[ndx]  = conn;
+}
+
+/****************************************************************************
+ * Name: tcp_hash_remove
+ *
+ * Description:
+ *   Remove a connection that is leaving the active list from the 4-tuple
+ *   and local port hash tables.
+ *
+ * Assumptions:
+ *   This function is called from network logic with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_hash_remove(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **link;
+
+  for (link = &g_tcp_conn_hash[tcp_conn_hash(conn)];
+       *link != NULL;
+       link = &(*link)->hnext)
+    {
+      if (*link == conn)
+        {
+          *link = conn->hnext;
+          break;
+        }
+    }
+
+  for (link = &g_tcp_port_hash[NTOHS(conn->lport) %
+                               CONFIG_NET_TCP_HASHSIZE];
+       *link != NULL;
+       link = &(*link)->pnext)
+    {
+      if (*link == conn)
+        {
+          *link = conn->pnext;
+          break;
+        }
+    }
+
+  conn->hnext = NULL;
+  conn->pnext = NULL;
+}
+
 /****************************************************************************
  * Name: tcp_listener
  *
@@ -113,11 +289,15 @@ static FAR struct tcp_conn_s *
   tcp_listener(uint8_t domain, FAR const union ip_addr_u *ipaddr,
                uint16_t portno)
 {
-  FAR struct tcp_conn_s *conn = NULL;
+  FAR struct tcp_conn_s *conn;
 
-  /* Check if this port number is in use by any active UIP TCP connection */
+  /* Check if this port number is in use by any active UIP TCP connection.
+   * Only the connections in the local port hash bucket need be examined.
+   */
 
-  while ((conn = tcp_nextconn(conn)) != NULL)
+  for (conn = g_tcp_port_hash[NTOHS(portno) % CONFIG_NET_TCP_HASHSIZE];
+       conn != NULL;
+       conn = conn->pnext)
     {
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -278,9 +458,10 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
+  conn       = g_tcp_conn_hash[tcp_ipv4_hash(srcipaddr, tcp->destport,
+                                             tcp->srcport)];
 
   while (conn)
     {
@@ -315,9 +496,9 @@ static inline FAR struct tcp_conn_s *
           break;
         }
 
-      /* Look at the next active connection */
+      /* Look at the next connection in the same hash bucket */
 
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+      conn = conn->hnext;
     }
 
   return conn;
@@ -345,9 +526,10 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
+  conn       = g_tcp_conn_hash[tcp_ipv6_hash(ip->srcipaddr, tcp->destport,
+                                             tcp->srcport)];
 
   while (conn)
     {
@@ -382,9 +564,9 @@ static inline FAR struct tcp_conn_s *
           break;
         }
 
-      /* Look at the next active connection */
+      /* Look at the next connection in the same hash bucket */
 
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+      conn = conn->hnext;
     }
 
   return conn;
@@ -529,11 +711,19 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
  * Description:
  *   Find or allocate a free TCP/IP connection structure for use.
  *
+ * Assumptions:
+ *   The caller holds g_tcp_lock.
+ *
  ****************************************************************************/
 
 #ifdef CONFIG_NET_ALLOC_CONNS
 FAR struct tcp_conn_s *tcp_alloc_conn(void)
 {
+#ifdef CONFIG_MM_SLAB
+  /* Connections are taken from and returned to the slab cache */
+
+  return (FAR struct tcp_conn_s *)slab_alloc(g_tcp_slab);
+#else
   FAR struct tcp_conn_s *conn;
   int i;
 
@@ -560,6 +750,7 @@ FAR struct tcp_conn_s *tcp_alloc_conn(void)
     }
 
   return (FAR struct tcp_conn_s *)dq_remfirst(&g_free_tcp_connections);
+#endif
 }
 #endif
 
@@ -588,6 +779,10 @@ void tcp_initialize(void)
       g_tcp_connections[i].tcpstateflags = TCP_CLOSED;
       dq_addlast(&g_tcp_connections[i].sconn.node, &g_free_tcp_connections);
     }
+#elif defined(CONFIG_MM_SLAB)
+  g_tcp_slab = slab_create("tcp_conn", sizeof(struct tcp_conn_s), 0,
+                           NULL, NULL);
+  DEBUGASSERT(g_tcp_slab != NULL);
 #endif
 }
 
@@ -606,12 +801,12 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
 {
   FAR struct tcp_conn_s *conn;
 
-  /* Because this routine is called from both event processing (with the
-   * network locked) and and from user level.  Make sure that the network
-   * locked in any cased while accessing g_free_tcp_connections[];
+  /* This routine is called both from event processing (with the network
+   * locked) and from user level.  The free list has a lock of its own, so
+   * the network is only locked if an active connection has to be reclaimed.
    */
 
-  net_lock();
+  netlock_take(&g_tcp_lock);
 
   /* Return the entry from the head of the free list */
 
@@ -622,14 +817,22 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
 
   if (!conn)
     {
+      FAR struct tcp_conn_s *tmp;
+
+      /* The active list can only be searched with the network locked, and
+       * the network lock must never be taken while holding g_tcp_lock.
+       */
+
+      netlock_give(&g_tcp_lock);
+      net_lock();
+
       /* As a fall-back, check for connection structures which can be
        * stalled.
        * Search the active connection list for the oldest connection
        * that is about to be closed anyway.
        */
 
-      FAR struct tcp_conn_s *tmp =
-        (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+      tmp = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
 
       while (tmp)
         {
@@ -649,7 +852,7 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
             {
               /* Yes.. Is it the oldest one we have seen so far? */
 
-              if (!conn || tmp->timer > conn->timer)
+              if (!conn || (sclock_t)(tmp->timer - conn->timer) < 0)
                 {
                   /* Yes.. remember it */
 
@@ -682,12 +885,16 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
            */
 
           tcp_free(conn);
+        }
 
-          /* Now there is guaranteed to be one free connection.  Get it! */
+      /* Now there is one free connection, unless its release was left to
+       * its timer work (or another thread got it first).  Get it!
+       */
 
-          conn = (FAR struct tcp_conn_s *)
-            dq_remfirst(&g_free_tcp_connections);
-        }
+      netlock_take(&g_tcp_lock);
+      net_unlock();
+
+      conn = (FAR struct tcp_conn_s *)dq_remfirst(&g_free_tcp_connections);
     }
 #endif
 
@@ -700,7 +907,7 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
     }
 #endif
 
-  net_unlock();
+  netlock_give(&g_tcp_lock);
 
   /* Mark the connection allocated */
 
@@ -717,6 +924,9 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
       conn->keepintvl     = 2 * DSEC_PER_SEC;
       conn->keepcnt       = 3;
 #endif
+#ifdef CONFIG_NET_TCP_CC
+      conn->cc_ops        = tcp_cc_find(NULL);
+#endif
 #if CONFIG_NET_RECV_BUFSIZE > 0
       conn->rcv_bufs      = CONFIG_NET_RECV_BUFSIZE;
 #endif
@@ -748,8 +958,8 @@ void tcp_free(FAR struct tcp_conn_s *conn)
   FAR struct tcp_wrbuffer_s *wrbuffer;
 #endif
 
-  /* Because g_free_tcp_connections is accessed from user level and event
-   * processing logic, it is necessary to keep the network locked during this
+  /* The active list and the hash tables are used by the event processing
+   * logic, so it is necessary to keep the network locked during this
    * operation.
    */
 
@@ -772,9 +982,10 @@ void tcp_free(FAR struct tcp_conn_s *conn)
 
   if (conn->tcpstateflags != TCP_ALLOCATED)
     {
-      /* Remove the connection from the active list */
+      /* Remove the connection from the active list and hash tables */
 
       dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_hash_remove(conn);
     }
 
   /* Release any read-ahead buffers attached to the connection */
@@ -782,6 +993,12 @@ void tcp_free(FAR struct tcp_conn_s *conn)
   iob_free_chain(conn->readahead, IOBUSER_NET_TCP_READAHEAD);
   conn->readahead = NULL;
 
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+  /* Release any out-of-order data */
+
+  tcp_ofoseg_free(conn);
+#endif
+
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   /* Release any write buffers attached to the connection */
 
@@ -823,11 +1040,55 @@ void tcp_free(FAR struct tcp_conn_s *conn)
     }
 #endif
 
+  /* Stop the timers of the connection */
+
+  tcp_stop_timer(conn);
+
+  conn->tcpstateflags = TCP_CLOSED;
+
+#ifdef CONFIG_NET_TCP_CONN_TIMER
+  /* If the timer work has already been dequeued, it is blocked on the
+   * network lock and will still access the connection.  The last instance
+   * of it releases the connection.
+   */
+
+  if (conn->nwork > 0)
+    {
+      conn->freed = true;
+      net_unlock();
+      return;
+    }
+#endif
+
+  tcp_release(conn);
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: tcp_release
+ *
+ * Description:
+ *   Return the storage of a connection that has been freed by tcp_free()
+ *   to the free list.  This is normally done by tcp_free() itself, but is
+ *   left to the timer work of the connection if that was already running.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+void tcp_release(FAR struct tcp_conn_s *conn)
+{
   /* Mark the connection available and put it into the free list */
 
   conn->tcpstateflags = TCP_CLOSED;
+#if defined(CONFIG_NET_ALLOC_CONNS) && defined(CONFIG_MM_SLAB)
+  slab_free(g_tcp_slab, conn);
+#else
+  netlock_take(&g_tcp_lock);
   dq_addlast(&conn->sconn.node, &g_free_tcp_connections);
-  net_unlock();
+  netlock_give(&g_tcp_lock);
+#endif
 }
 
 /****************************************************************************
@@ -1006,10 +1267,10 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
 
       /* Fill in the necessary fields for the new connection. */
 
-      conn->rto           = TCP_RTO;
-      conn->timer         = TCP_RTO;
+      conn->rto           = TCP_RTO_TICKS;
+      conn->timer_armed   = false;
       conn->sa            = 0;
-      conn->sv            = 4;
+      conn->sv            = 4 * TICK_PER_HSEC;
       conn->nrtx          = 0;
       conn->lport         = tcp->destport;
       conn->rport         = tcp->srcport;
@@ -1040,11 +1301,13 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
       sq_init(&conn->unacked_q);
 #endif
 
-      /* And, finally, put the connection structure into the active list.
-       * Interrupts should already be disabled in this context.
+      /* And, finally, put the connection structure into the active list
+       * and hash tables.  Interrupts should already be disabled in this
+       * context.
        */
 
       dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_hash_insert(conn);
     }
 
   return conn;
@@ -1291,11 +1554,16 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
   conn->tx_unacked = 1;    /* TCP length of the SYN is one. */
   conn->nrtx       = 0;
-  conn->timer      = 0;    /* Send the SYN immediately. */
-  conn->rto        = TCP_RTO;
+  conn->rto        = TCP_RTO_TICKS;
   conn->sa         = 0;
-  conn->sv         = 16;   /* Initial value of the RTT variance. */
+  conn->sv         = 16 * TICK_PER_HSEC; /* Initial RTT variance. */
   conn->lport      = (uint16_t)port;
+
+  /* Send the SYN immediately */
+
+  conn->timer       = clock_systime_ticks();
+  conn->timer_armed = true;
+
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   conn->expired    = 0;
   conn->isn        = 0;
@@ -1314,9 +1582,13 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   sq_init(&conn->unacked_q);
 #endif
 
-  /* And, finally, put the connection structure into the active list. */
+  /* And, finally, put the connection structure into the active list and
+   * hash tables.
+   */
 
   dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+  tcp_hash_insert(conn);
+  tcp_update_timer(conn);
   ret = OK;
 
 errout_with_lock:
@@ -262,6 +262,148 @@ static void tcp_snd_wnd_update(FAR struct tcp_conn_s *conn,
     }
 }
 
+/****************************************************************************
+ * Name: tcp_rtt_update
+ *
+ * Description:
+ *   Update the retransmission time-out from a round-trip time sample using
+ *   the estimator from Van Jacobson's paper.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *   m    - The round-trip time sample (units: clock ticks)
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_rtt_update(FAR struct tcp_conn_s *conn, int32_t m)
+{
+  uint32_t rto;
+
+  /* This is taken directly from VJs original code in his paper */
+
+  m = m - (int32_t)(conn->sa >> 3);
+  conn->sa += m;
+  if (m < 0)
+    {
+      m = -m;
+    }
+
+  m = m - (int32_t)(conn->sv >> 2);
+  conn->sv += m;
+  rto = (conn->sa >> 3) + conn->sv;
+
+  /* Keep the time-out within the configured bounds */
+
+  if (rto < TCP_RTO_MIN_TICKS)
+    {
+      rto = TCP_RTO_MIN_TICKS;
+    }
+  else if (rto > TCP_RTO_MAX_TICKS)
+    {
+      rto = TCP_RTO_MAX_TICKS;
+    }
+
+  conn->rto = rto;
+}
+
+/****************************************************************************
+ * Name: tcp_input_options
+ *
+ * Description:
+ *   Process the options that may be carried by any segment once they have
+ *   been negotiated in the SYN exchange:  Remember the peer's timestamp so
+ *   that it is echoed and update the SACK scoreboard.
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure containing the received packet.
+ *   conn   - The TCP connection the segment belongs to
+ *   tcp    - The TCP header
+ *   hdrlen - Offset of the TCP options in d_buf
+ *
+ * Returned Value:
+ *   The echoed timestamp of an ACK segment, or zero if there is none.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS) || defined(CONFIG_NET_TCP_SACK)
+static uint32_t tcp_input_options(FAR struct net_driver_s *dev,
+                                  FAR struct tcp_conn_s *conn,
+                                  FAR struct tcp_hdr_s *tcp,
+                                  unsigned int hdrlen)
+{
+  FAR uint8_t *optdata = &dev->d_buf[hdrlen];
+  int optlen = ((tcp->tcpoffset >> 4) - 5) << 2;
+  uint32_t tsecr = 0;
+  int i;
+
+  for (i = 0; i < optlen; )
+    {
+      uint8_t opt = optdata[i];
+
+      if (opt == TCP_OPT_END)
+        {
+          break;
+        }
+      else if (opt == TCP_OPT_NOOP)
+        {
+          ++i;
+          continue;
+        }
+
+      /* Stop at a malformed option */
+
+      if (i + 1 >= optlen || optdata[i + 1] < 2 ||
+          i + optdata[i + 1] > optlen)
+        {
+          break;
+        }
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+      if (opt == TCP_OPT_TS && optdata[i + 1] == TCP_OPT_TS_LEN &&
+          (conn->flags & TCP_TSTAMP) != 0)
+        {
+          uint32_t tsval = tcp_getsequence(&optdata[i + 2]);
+
+          /* Only a segment that does not lie beyond the next expected
+           * sequence number may update the timestamp to echo (RFC 7323,
+           * section 4.3).
+           */
+
+          if (TCP_SEQ_LTE(tcp_getsequence(tcp->seqno),
+                          tcp_getsequence(conn->rcvseq)) &&
+              TCP_SEQ_GTE(tsval, conn->ts_recent))
+            {
+              conn->ts_recent = tsval;
+            }
+
+          if ((tcp->flags & TCP_ACK) != 0)
+            {
+              tsecr = tcp_getsequence(&optdata[i + 6]);
+            }
+        }
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+      if (opt == TCP_OPT_SACK && (conn->flags & TCP_SACKOK) != 0 &&
+          (tcp->flags & TCP_ACK) != 0)
+        {
+          tcp_sack_mark(conn, &optdata[i]);
+        }
+#endif
+
+      i += optdata[i + 1];
+    }
+
+  return tsecr;
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_input
  *
@@ -292,6 +434,9 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   uint16_t tmp16;
   uint16_t flags;
   uint16_t result;
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  uint32_t tsecr = 0;
+#endif
   uint8_t  opt;
   int      len;
   int      i;
@@ -322,9 +467,15 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   hdrlen = tcpiplen + NET_LL_HDRLEN(dev);
 
-  /* Start of TCP input header processing code. */
+  /* Start of TCP input header processing code.  The checksums of segments
+   * merged by GRO have been verified already.
+   */
 
+#ifdef CONFIG_NET_TCP_GRO
+  if (!dev->d_gro && tcp_chksum(dev) != 0xffff)
+#else
   if (tcp_chksum(dev) != 0xffff)
+#endif
     {
       /* Compute and check the TCP checksum. */
 
@@ -488,6 +639,23 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
                       conn->rcv_scale = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
                       conn->flags    |= TCP_WSCALE;
                     }
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+                  else if (opt == TCP_OPT_SACK_PERM &&
+                          dev->d_buf[hdrlen + 1 + i] ==
+                          TCP_OPT_SACK_PERM_LEN)
+                    {
+                      conn->flags    |= TCP_SACKOK;
+                    }
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+                  else if (opt == TCP_OPT_TS &&
+                          dev->d_buf[hdrlen + 1 + i] == TCP_OPT_TS_LEN)
+                    {
+                      conn->ts_recent =
+                        tcp_getsequence(&dev->d_buf[hdrlen + 2 + i]);
+                      conn->flags    |= TCP_TSTAMP;
+                    }
 #endif
                   else
                     {
@@ -509,6 +677,15 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
                 }
             }
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+          /* Every segment will carry the timestamps option */
+
+          if ((conn->flags & TCP_TSTAMP) != 0)
+            {
+              conn->mss -= TCP_OPT_TS_SPACE;
+            }
+#endif
+
           /* Our response will be a SYNACK. */
 
           tcp_synack(dev, conn, TCP_ACK | TCP_SYN);
@@ -616,6 +793,20 @@ found:
       goto drop;
     }
 
+#if defined(CONFIG_NET_TCP_TIMESTAMPS) || defined(CONFIG_NET_TCP_SACK)
+  /* Process the options carried by every segment, if negotiated */
+
+  if ((conn->flags & (TCP_TSTAMP | TCP_SACKOK)) != 0 &&
+      (tcp->tcpoffset & 0xf0) > 0x50)
+    {
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+      tsecr = tcp_input_options(dev, conn, tcp, hdrlen);
+#else
+      tcp_input_options(dev, conn, tcp, hdrlen);
+#endif
+    }
+#endif
+
   /* Calculated the length of the data, if the application has sent
    * any data to us.
    */
@@ -629,6 +820,10 @@ found:
 
   dev->d_len -= (len + iplen);
 
+  /* The payload follows the TCP options, if any */
+
+  dev->d_appdata = (FAR uint8_t *)tcp + len;
+
   /* Check if the sequence number of the incoming packet is what we are
    * expecting next.  If not, we send out an ACK with the correct numbers
    * in, unless we are in the SYN_RCVD state and receive a SYN, in which
@@ -667,7 +862,18 @@ found:
             }
           else
             {
-              /* We never queue out-of-order segments. */
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+              /* Hold the data received beyond the hole until the hole
+               * is filled.  The ACK below is a duplicate ACK.
+               */
+
+              if ((conn->tcpstateflags & TCP_STATE_MASK) ==
+                  TCP_ESTABLISHED &&
+                  (conn->tcpstateflags & TCP_STOPPED) == 0)
+                {
+                  tcp_ofoseg_input(dev, conn, seq);
+                }
+#endif
 
               tcp_send(dev, conn, TCP_ACK, tcpiplen);
               return;
@@ -711,6 +917,18 @@ found:
 
       ackseq = tcp_getsequence(tcp->ackno);
 
+      /* Open the congestion window if new data was acknowledged.  snd_wl2
+       * still holds the highest acknowledgement number seen before this
+       * segment.
+       */
+
+      if ((conn->tcpstateflags & TCP_STATE_MASK) == TCP_ESTABLISHED &&
+          TCP_SEQ_GT(ackseq, conn->snd_wl2) &&
+          TCP_SEQ_LTE(ackseq, unackseq))
+        {
+          tcp_cc_ack(conn, ackseq, TCP_SEQ_SUB(ackseq, conn->snd_wl2));
+        }
+
       /* Check how many of the outstanding bytes have been acknowledged. For
        * most send operations, this should always be true.  However,
        * the send() API sends data ahead when it can without waiting for
@@ -769,23 +987,28 @@ found:
 
       /* Do RTT estimation, unless we have done retransmissions. */
 
-      if (conn->nrtx == 0)
-        {
-          signed char m;
-          m = conn->rto - conn->timer;
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+      /* The echoed timestamp measures the round-trip time even when the
+       * data has been retransmitted (RFC 7323, section 4.1).
+       */
 
-          /* This is taken directly from VJs original code in his paper */
+      if (tsecr != 0 && TCP_SEQ_GT(ackseq, conn->snd_wl2))
+        {
+          uint32_t rtt = MSEC2TICK(TCP_TSNOW() - tsecr);
 
-          m = m - (conn->sa >> 3);
-          conn->sa += m;
-          if (m < 0)
-            {
-              m = -m;
-            }
+          tcp_rtt_update(conn, rtt > TCP_RTO_MAX_TICKS ?
+                               TCP_RTO_MAX_TICKS : rtt);
+        }
+      else
+#endif
+      if (conn->nrtx == 0 && conn->timer_armed)
+        {
+          /* The timer was started conn->timer_rto before its expiration.
+           * conn->rto may have changed since.
+           */
 
-          m = m - (conn->sv >> 2);
-          conn->sv += m;
-          conn->rto = (conn->sa >> 3) + conn->sv;
+          tcp_rtt_update(conn, (int32_t)(clock_systime_ticks() -
+                                         (conn->timer - conn->timer_rto)));
         }
 
       /* Set the acknowledged flag. */
@@ -794,7 +1017,8 @@ found:
 
       /* Reset the retransmission timer. */
 
-      conn->timer = conn->rto;
+      conn->timer     = clock_systime_ticks() + conn->rto;
+      conn->timer_rto = conn->rto;
     }
 
   /* Update the connection's window size */
@@ -862,6 +1086,7 @@ found:
             conn->tx_unacked    = 0;
             tcp_snd_wnd_init(conn, tcp);
             tcp_snd_wnd_update(conn, tcp);
+            tcp_cc_init(conn);
 
             flags               = TCP_CONNECTED;
             ninfo("TCP state: TCP_ESTABLISHED\n");
@@ -942,6 +1167,23 @@ found:
                         conn->rcv_scale = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
                         conn->flags    |= TCP_WSCALE;
                       }
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+                    else if (opt == TCP_OPT_SACK_PERM &&
+                            dev->d_buf[hdrlen + 1 + i] ==
+                            TCP_OPT_SACK_PERM_LEN)
+                      {
+                        conn->flags    |= TCP_SACKOK;
+                      }
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+                    else if (opt == TCP_OPT_TS &&
+                            dev->d_buf[hdrlen + 1 + i] == TCP_OPT_TS_LEN)
+                      {
+                        conn->ts_recent =
+                          tcp_getsequence(&dev->d_buf[hdrlen + 2 + i]);
+                        conn->flags    |= TCP_TSTAMP;
+                      }
 #endif
                     else
                       {
@@ -963,6 +1205,15 @@ found:
                   }
               }
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+            /* Every segment will carry the timestamps option */
+
+            if ((conn->flags & TCP_TSTAMP) != 0)
+              {
+                conn->mss -= TCP_OPT_TS_SPACE;
+              }
+#endif
+
             conn->tcpstateflags = TCP_ESTABLISHED;
             memcpy(conn->rcvseq, tcp->seqno, 4);
             conn->rcv_adv = tcp_getsequence(conn->rcvseq);
@@ -971,6 +1222,7 @@ found:
 
             net_incr32(conn->rcvseq, 1); /* ack SYN */
             conn->tx_unacked    = 0;
+            tcp_cc_init(conn);
 
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
             conn->isn           = tcp_getsequence(tcp->ackno);
@@ -1191,6 +1443,17 @@ found:
 
             result = tcp_callback(dev, conn, flags);
 
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+            /* The new data may have filled the hole before the data that
+             * is held out of order.
+             */
+
+            if ((flags & TCP_NEWDATA) != 0 && conn->nofosegs > 0)
+              {
+                tcp_ofoseg_deliver(conn);
+              }
+#endif
+
             /* Send the response, ACKing the data or not, as appropriate */
 
             tcp_appsend(dev, conn, result);
@@ -1229,7 +1492,8 @@ found:
             if ((flags & TCP_ACKDATA) != 0 && conn->tx_unacked == 0)
               {
                 conn->tcpstateflags = TCP_TIME_WAIT;
-                conn->timer         = 0;
+                conn->timer         = clock_systime_ticks() +
+                                      TCP_TIME_WAIT_TICKS;
                 ninfo("TCP state: TCP_TIME_WAIT\n");
               }
             else
@@ -1246,6 +1510,8 @@ found:
         else if ((flags & TCP_ACKDATA) != 0 && conn->tx_unacked == 0)
           {
             conn->tcpstateflags = TCP_FIN_WAIT_2;
+            conn->timer         = clock_systime_ticks() +
+                                  TCP_TIME_WAIT_TICKS;
             ninfo("TCP state: TCP_FIN_WAIT_2\n");
             goto drop;
           }
@@ -1267,7 +1533,8 @@ found:
         if ((tcp->flags & TCP_FIN) != 0)
           {
             conn->tcpstateflags = TCP_TIME_WAIT;
-            conn->timer         = 0;
+            conn->timer         = clock_systime_ticks() +
+                                  TCP_TIME_WAIT_TICKS;
             ninfo("TCP state: TCP_TIME_WAIT\n");
 
             net_incr32(conn->rcvseq, 1); /* ack FIN */
@@ -1292,7 +1559,8 @@ found:
         if ((flags & TCP_ACKDATA) != 0)
           {
             conn->tcpstateflags = TCP_TIME_WAIT;
-            conn->timer        = 0;
+            conn->timer        = clock_systime_ticks() +
+                                 TCP_TIME_WAIT_TICKS;
             ninfo("TCP state: TCP_TIME_WAIT\n");
           }
 
@@ -1301,6 +1569,13 @@ found:
     }
 
 drop:
+  if (conn != NULL)
+    {
+      /* The state of the connection may have changed */
+
+      tcp_update_timer(conn);
+    }
+
   dev->d_len = 0;
 }
 
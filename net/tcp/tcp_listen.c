@@ -55,13 +55,25 @@
 #include "inet/inet.h"
 #include "tcp/tcp.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TCP_LISTEN_HASH(portno) (NTOHS(portno) % CONFIG_NET_TCP_HASHSIZE)
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
-/* The tcp_listenports list all currently listening ports. */
+/* The tcp_listenports hash table holds all currently listening
+ * connections, indexed by their local port number.
+ */
+
+static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_TCP_HASHSIZE];
 
-static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
+/* The number of connections in tcp_listenports */
+
+static int tcp_nlisteners;
 
 /****************************************************************************
  * Private Functions
@@ -87,21 +99,20 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
                                         uint16_t portno)
 #endif
 {
-  int ndx;
+  FAR struct tcp_conn_s *conn;
 
-  /* Examine each connection structure in each slot of the listener list */
+  /* Examine each connection structure in the hash bucket for this port */
 
-  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+  for (conn = tcp_listenports[TCP_LISTEN_HASH(portno)];
+       conn != NULL;
+       conn = conn->lnext)
     {
-      /* Is this slot assigned?  If so, does the connection have the same
-       * local port number?
-       */
+      /* Does the connection have the same local port number? */
 
-      FAR struct tcp_conn_s *conn = tcp_listenports[ndx];
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-      if (conn && conn->lport == portno && conn->domain == domain)
+      if (conn->lport == portno && conn->domain == domain)
 #else
-      if (conn && conn->lport == portno)
+      if (conn->lport == portno)
 #endif
         {
 #ifdef CONFIG_NET_IPv6
@@ -158,15 +169,19 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
 
 int tcp_unlisten(FAR struct tcp_conn_s *conn)
 {
-  int ndx;
+  FAR struct tcp_conn_s **link;
   int ret = -EINVAL;
 
   net_lock();
-  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+  for (link = &tcp_listenports[TCP_LISTEN_HASH(conn->lport)];
+       *link != NULL;
+       link = &(*link)->lnext)
     {
-      if (tcp_listenports[ndx] == conn)
+      if (*link == conn)
         {
-          tcp_listenports[ndx] = NULL;
+          *link       = conn->lnext;
+          conn->lnext = NULL;
+          tcp_nlisteners--;
           ret = OK;
           break;
         }
@@ -210,29 +225,23 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 
       ret = -EADDRINUSE;
     }
+  else if (tcp_nlisteners >= CONFIG_NET_MAX_LISTENPORTS)
+    {
+      /* There are already too many listening ports */
+
+      ret = -ENOBUFS;
+    }
   else
     {
       /* Otherwise, save a reference to the connection structure in the
-       * "listener" list.
+       * "listener" hash table.
        */
 
-      ret = -ENOBUFS; /* Assume failure */
-
-      /* Search all slots until an available slot is found */
-
-      for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
-        {
-          /* Is the next slot available? */
-
-          if (!tcp_listenports[ndx])
-            {
-              /* Yes.. we found it */
-
-              tcp_listenports[ndx] = conn;
-              ret = OK;
-              break;
-            }
-        }
+      ndx                  = TCP_LISTEN_HASH(conn->lport);
+      conn->lnext          = tcp_listenports[ndx];
+      tcp_listenports[ndx] = conn;
+      tcp_nlisteners++;
+      ret = OK;
     }
 
   net_unlock();
@@ -0,0 +1,360 @@
+/****************************************************************************
+ * net/tcp/tcp_ofoseg.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
+#include <nuttx/net/tcp.h>
+
+#include "devif/devif.h"
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_ofoseg_remove
+ *
+ * Description:
+ *   Remove one entry from the list of held blocks.  The caller is
+ *   responsible for the I/O buffer chain of the entry.
+ *
+ ****************************************************************************/
+
+static void tcp_ofoseg_remove(FAR struct tcp_conn_s *conn, int index)
+{
+  FAR struct tcp_ofoseg_s *ofoseg = &conn->ofosegs[index];
+
+  conn->ofobytes -= TCP_SEQ_SUB(ofoseg->right, ofoseg->left);
+  conn->nofosegs--;
+  memmove(ofoseg, ofoseg + 1,
+          (conn->nofosegs - index) * sizeof(struct tcp_ofoseg_s));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_ofoseg_input
+ *
+ * Description:
+ *   Retain the payload of a segment that was received beyond the next
+ *   expected sequence number.  The payload is merged with any held blocks
+ *   that it overlaps or adjoins.  The data is dropped if the configured
+ *   limits would be exceeded or no I/O buffers are available.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure containing the received segment;
+ *          d_appdata and d_len describe the payload.
+ *   conn - The TCP connection of interest
+ *   seq  - The sequence number of the first byte of the payload
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_ofoseg_input(FAR struct net_driver_s *dev,
+                      FAR struct tcp_conn_s *conn, uint32_t seq)
+{
+  FAR struct tcp_ofoseg_s *ofoseg;
+  FAR struct iob_s *iob;
+  uint32_t left = seq;
+  uint32_t right;
+  uint32_t len = dev->d_len;
+  bool merged = false;
+  int ret;
+  int i;
+
+  if (len == 0)
+    {
+      return;
+    }
+
+  /* Only keep the part of the payload that lies within the window that
+   * was advertised to the peer.
+   */
+
+  if (TCP_SEQ_GT(TCP_SEQ_ADD(left, len), conn->rcv_adv))
+    {
+      if (!TCP_SEQ_LT(left, conn->rcv_adv))
+        {
+          goto drop;
+        }
+
+      len = TCP_SEQ_SUB(conn->rcv_adv, left);
+    }
+
+  right = TCP_SEQ_ADD(left, len);
+
+  if (conn->ofobytes + len > CONFIG_NET_TCP_OUT_OF_ORDER_BUFSIZE)
+    {
+      ninfo("Out-of-order buffer full: %" PRIu32 " bytes\n",
+            conn->ofobytes);
+      goto drop;
+    }
+
+  /* Copy the payload into a new I/O buffer chain without waiting.  Use the
+   * throttled pool so that in-order data can still be buffered.
+   */
+
+  iob = iob_tryalloc_size(true, len, IOBUSER_NET_TCP_READAHEAD);
+  if (iob == NULL)
+    {
+      goto drop;
+    }
+
+  iob->io_pktlen = 0;
+  ret = iob_trycopyin(iob, dev->d_appdata, len, 0, true,
+                      IOBUSER_NET_TCP_READAHEAD);
+  if (ret < 0)
+    {
+      iob_free_chain(iob, IOBUSER_NET_TCP_READAHEAD);
+      goto drop;
+    }
+
+  /* Merge with the held blocks that overlap or adjoin the new one.  The
+   * blocks are in sequence number order, so these are consecutive.
+   */
+
+  for (i = 0; i < conn->nofosegs; )
+    {
+      ofoseg = &conn->ofosegs[i];
+
+      if (TCP_SEQ_LT(ofoseg->right, left))
+        {
+          i++;
+          continue;
+        }
+
+      if (TCP_SEQ_GT(ofoseg->left, right))
+        {
+          break;
+        }
+
+      if (TCP_SEQ_LTE(ofoseg->left, left) &&
+          TCP_SEQ_GTE(ofoseg->right, right))
+        {
+          /* Everything in the segment is already held */
+
+          iob_free_chain(iob, IOBUSER_NET_TCP_READAHEAD);
+          tcp_sack_add(conn, ofoseg->left, ofoseg->right);
+          return;
+        }
+
+      if (TCP_SEQ_LT(ofoseg->left, left))
+        {
+          /* The held block starts first:  Append the new data to it */
+
+          iob = iob_trimhead(iob, TCP_SEQ_SUB(ofoseg->right, left),
+                             IOBUSER_NET_TCP_READAHEAD);
+          iob_concat(ofoseg->data, iob);
+          iob  = ofoseg->data;
+          left = ofoseg->left;
+        }
+      else if (TCP_SEQ_GT(ofoseg->right, right))
+        {
+          /* The held block ends last:  Append it to the new data */
+
+          ofoseg->data = iob_trimhead(ofoseg->data,
+                                      TCP_SEQ_SUB(right, ofoseg->left),
+                                      IOBUSER_NET_TCP_READAHEAD);
+          iob_concat(iob, ofoseg->data);
+          right = ofoseg->right;
+        }
+      else
+        {
+          /* The new data covers all of the held block */
+
+          iob_free_chain(ofoseg->data, IOBUSER_NET_TCP_READAHEAD);
+        }
+
+      tcp_ofoseg_remove(conn, i);
+      merged = true;
+    }
+
+  /* A block that was not merged with any other needs a free entry */
+
+  if (!merged && conn->nofosegs >= CONFIG_NET_TCP_OUT_OF_ORDER_SEGMENTS)
+    {
+      ninfo("Out-of-order blocks exhausted\n");
+      iob_free_chain(iob, IOBUSER_NET_TCP_READAHEAD);
+      goto drop;
+    }
+
+  ofoseg = &conn->ofosegs[i];
+  memmove(ofoseg + 1, ofoseg,
+          (conn->nofosegs - i) * sizeof(struct tcp_ofoseg_s));
+
+  ofoseg->left  = left;
+  ofoseg->right = right;
+  ofoseg->data  = iob;
+  conn->nofosegs++;
+  conn->ofobytes += TCP_SEQ_SUB(right, left);
+
+  ninfo("Holding %" PRIu32 "-%" PRIu32 " in %u blocks\n",
+        left, right, conn->nofosegs);
+
+#ifdef CONFIG_NET_STATISTICS
+  g_netstats.tcp.ofoqueued++;
+#endif
+
+  /* Report the block to the peer */
+
+  tcp_sack_add(conn, left, right);
+  return;
+
+drop:
+  ninfo("Dropped out-of-order segment seq=%" PRIu32 " len=%" PRIu16 "\n",
+        seq, dev->d_len);
+
+#ifdef CONFIG_NET_STATISTICS
+  g_netstats.tcp.ofodrop++;
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_ofoseg_deliver
+ *
+ * Description:
+ *   Move the held blocks that have become contiguous with the received
+ *   data to the read-ahead buffer and advance rcvseq past them.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_ofoseg_deliver(FAR struct tcp_conn_s *conn)
+{
+  FAR struct iob_s *iob;
+  uint32_t rcvseq;
+  uint32_t left;
+  uint32_t right;
+#ifdef CONFIG_NET_TCP_NOTIFIER
+  bool delivered = false;
+#endif
+
+  while (conn->nofosegs > 0)
+    {
+      rcvseq = tcp_getsequence(conn->rcvseq);
+      left   = conn->ofosegs[0].left;
+      right  = conn->ofosegs[0].right;
+
+      if (TCP_SEQ_GT(left, rcvseq))
+        {
+          /* There is still a hole before the first block */
+
+          break;
+        }
+
+      iob = conn->ofosegs[0].data;
+      tcp_ofoseg_remove(conn, 0);
+
+      if (TCP_SEQ_LTE(right, rcvseq))
+        {
+          /* All of it was retransmitted and received in order */
+
+          iob_free_chain(iob, IOBUSER_NET_TCP_READAHEAD);
+          continue;
+        }
+
+      iob = iob_trimhead(iob, TCP_SEQ_SUB(rcvseq, left),
+                         IOBUSER_NET_TCP_READAHEAD);
+
+      if (conn->readahead == NULL)
+        {
+          conn->readahead = iob;
+        }
+      else
+        {
+          iob_concat(conn->readahead, iob);
+        }
+
+      ninfo("Delivered %" PRIu32 " out-of-order bytes\n",
+            TCP_SEQ_SUB(right, rcvseq));
+
+      net_incr32(conn->rcvseq, TCP_SEQ_SUB(right, rcvseq));
+#ifdef CONFIG_NET_TCP_NOTIFIER
+      delivered = true;
+#endif
+    }
+
+#ifdef CONFIG_NET_TCP_NOTIFIER
+  /* Provide notification(s) that additional TCP read-ahead data is
+   * available.
+   */
+
+  if (delivered)
+    {
+      tcp_readahead_signal(conn);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_ofoseg_free
+ *
+ * Description:
+ *   Release all of the blocks held for a connection.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_ofoseg_free(FAR struct tcp_conn_s *conn)
+{
+  int i;
+
+  for (i = 0; i < conn->nofosegs; i++)
+    {
+      iob_free_chain(conn->ofosegs[i].data, IOBUSER_NET_TCP_READAHEAD);
+    }
+
+  conn->nofosegs = 0;
+  conn->ofobytes = 0;
+}
+
+#endif /* CONFIG_NET_TCP_OUT_OF_ORDER */
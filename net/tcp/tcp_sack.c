@@ -0,0 +1,319 @@
+/****************************************************************************
+ * net/tcp/tcp_sack.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <queue.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_SACK
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_sack_remove
+ *
+ * Description:
+ *   Remove one entry from the list of received out-of-order blocks.
+ *
+ ****************************************************************************/
+
+static void tcp_sack_remove(FAR struct tcp_conn_s *conn, int index)
+{
+  conn->rcv_nsack--;
+  memmove(&conn->rcv_sack[index], &conn->rcv_sack[index + 1],
+          (conn->rcv_nsack - index) * sizeof(struct tcp_sack_s));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_sack_mark
+ *
+ * Description:
+ *   Update the SACK scoreboard from a SACK option received from the peer:
+ *   Each un-ACKed write buffer that lies entirely within one of the
+ *   reported blocks is marked so that it is not sent again on fast
+ *   retransmit.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *   opt  - The SACK option, starting with the option kind
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_sack_mark(FAR struct tcp_conn_s *conn, FAR const uint8_t *opt)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR sq_entry_t *entry;
+  int nblocks;
+  int i;
+
+  DEBUGASSERT(opt[0] == TCP_OPT_SACK);
+
+  nblocks = (opt[1] - 2) / TCP_OPT_SACK_BLOCK;
+  for (i = 0, opt += 2; i < nblocks; i++, opt += TCP_OPT_SACK_BLOCK)
+    {
+      uint32_t left  = tcp_getsequence((FAR uint8_t *)&opt[0]);
+      uint32_t right = tcp_getsequence((FAR uint8_t *)&opt[4]);
+
+      if (!TCP_SEQ_LT(left, right))
+        {
+          continue;
+        }
+
+      ninfo("SACK: left=%" PRIu32 " right=%" PRIu32 "\n", left, right);
+
+      for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+        {
+          wrb = (FAR struct tcp_wrbuffer_s *)entry;
+
+          if (TCP_SEQ_GTE(TCP_WBSEQNO(wrb), right))
+            {
+              /* The unacked_q is in sequence number order */
+
+              break;
+            }
+
+          if (TCP_SEQ_GTE(TCP_WBSEQNO(wrb), left) &&
+              TCP_SEQ_LTE(TCP_WBSEQNO(wrb) + TCP_WBPKTLEN(wrb), right))
+            {
+              TCP_WBSACKED(wrb) = true;
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_sack_clear
+ *
+ * Description:
+ *   Forget everything that the peer has reported with SACK options.  The
+ *   peer is allowed to discard data that it has SACKed, so the scoreboard
+ *   must be cleared when the retransmission timer expires (RFC 2018,
+ *   section 8).
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_sack_clear(FAR struct tcp_conn_s *conn)
+{
+  FAR sq_entry_t *entry;
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      TCP_WBSACKED((FAR struct tcp_wrbuffer_s *)entry) = false;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_sack_add
+ *
+ * Description:
+ *   Remember a block of out-of-order data that has been received and
+ *   retained so that it is reported to the peer.  The block is merged
+ *   with any blocks that it overlaps or touches and becomes the first
+ *   block reported, as required by RFC 2018, section 4.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection of interest
+ *   left  - The first sequence number of the received data
+ *   right - The sequence number following the received data
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_sack_add(FAR struct tcp_conn_s *conn, uint32_t left,
+                  uint32_t right)
+{
+  int i;
+
+  if ((conn->flags & TCP_SACKOK) == 0 || !TCP_SEQ_LT(left, right))
+    {
+      return;
+    }
+
+  /* Absorb every block that overlaps or adjoins the new one */
+
+  for (i = 0; i < conn->rcv_nsack; )
+    {
+      FAR struct tcp_sack_s *sack = &conn->rcv_sack[i];
+
+      if (TCP_SEQ_LTE(sack->left, right) && TCP_SEQ_GTE(sack->right, left))
+        {
+          if (TCP_SEQ_LT(sack->left, left))
+            {
+              left = sack->left;
+            }
+
+          if (TCP_SEQ_GT(sack->right, right))
+            {
+              right = sack->right;
+            }
+
+          tcp_sack_remove(conn, i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+
+  /* Insert the result at the head, dropping the oldest block if full */
+
+  if (conn->rcv_nsack >= TCP_SACK_NBLOCKS)
+    {
+      conn->rcv_nsack = TCP_SACK_NBLOCKS - 1;
+    }
+
+  memmove(&conn->rcv_sack[1], &conn->rcv_sack[0],
+          conn->rcv_nsack * sizeof(struct tcp_sack_s));
+
+  conn->rcv_sack[0].left  = left;
+  conn->rcv_sack[0].right = right;
+  conn->rcv_nsack++;
+}
+
+/****************************************************************************
+ * Name: tcp_sack_trim
+ *
+ * Description:
+ *   Drop the out-of-order blocks, or the parts of them, that are now
+ *   covered by the cumulative acknowledgement.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_sack_trim(FAR struct tcp_conn_s *conn)
+{
+  uint32_t rcvseq = tcp_getsequence(conn->rcvseq);
+  int i;
+
+  for (i = 0; i < conn->rcv_nsack; )
+    {
+      FAR struct tcp_sack_s *sack = &conn->rcv_sack[i];
+
+      if (TCP_SEQ_LTE(sack->right, rcvseq))
+        {
+          tcp_sack_remove(conn, i);
+          continue;
+        }
+
+      if (TCP_SEQ_LT(sack->left, rcvseq))
+        {
+          sack->left = rcvseq;
+        }
+
+      i++;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_sack_build
+ *
+ * Description:
+ *   Format a SACK option reporting the retained out-of-order blocks.  The
+ *   option is preceded by two NOOPs to keep the blocks 32-bit aligned.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection of interest
+ *   buf   - The location in the TCP header to write the option to
+ *   space - The number of bytes available for the option
+ *
+ * Returned Value:
+ *   The number of bytes written; zero if there is nothing to report.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network locked.
+ *
+ ****************************************************************************/
+
+unsigned int tcp_sack_build(FAR struct tcp_conn_s *conn, FAR uint8_t *buf,
+                            unsigned int space)
+{
+  unsigned int optlen = 0;
+  int nblocks;
+  int i;
+
+  /* Forget the blocks that have been delivered in the meantime */
+
+  tcp_sack_trim(conn);
+
+  if ((conn->flags & TCP_SACKOK) == 0 || conn->rcv_nsack == 0 ||
+      space < TCP_OPT_SACK_SPACE(1))
+    {
+      return 0;
+    }
+
+  nblocks = (space - TCP_OPT_SACK_SPACE(0)) / TCP_OPT_SACK_BLOCK;
+  if (nblocks > conn->rcv_nsack)
+    {
+      nblocks = conn->rcv_nsack;
+    }
+
+  buf[optlen++] = TCP_OPT_NOOP;
+  buf[optlen++] = TCP_OPT_NOOP;
+  buf[optlen++] = TCP_OPT_SACK;
+  buf[optlen++] = 2 + nblocks * TCP_OPT_SACK_BLOCK;
+
+  for (i = 0; i < nblocks; i++)
+    {
+      tcp_setsequence(&buf[optlen], conn->rcv_sack[i].left);
+      tcp_setsequence(&buf[optlen + 4], conn->rcv_sack[i].right);
+      optlen += TCP_OPT_SACK_BLOCK;
+    }
+
+  return optlen;
+}
+
+#endif /* CONFIG_NET_TCP_SACK */
@@ -264,6 +264,15 @@ static inline void tcp_ipv6_sendcomplete(FAR struct net_driver_s *dev,
 static void tcp_sendcomplete(FAR struct net_driver_s *dev,
                              FAR struct tcp_hdr_s *tcp)
 {
+  /* A segment without application data must not carry the payload that
+   * may still be attached to the device.
+   */
+
+  if (dev->d_sndlen == 0)
+    {
+      netdev_iob_release(dev);
+    }
+
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
   if (IFF_IS_IPv6(dev->d_flags))
@@ -289,6 +298,114 @@ static void tcp_sendcomplete(FAR struct net_driver_s *dev,
 #endif
 }
 
+/****************************************************************************
+ * Name: tcp_sendopts
+ *
+ * Description:
+ *   Add the options that are carried by every segment once they have been
+ *   negotiated:  The timestamps option and, in segments without data, the
+ *   SACK option.  Any payload in d_buf is moved up to make room for them.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure to use in the send operation
+ *   conn - The TCP connection structure holding connection information
+ *   tcp  - The TCP header of the outgoing segment
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS) || defined(CONFIG_NET_TCP_SACK)
+static void tcp_sendopts(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn,
+                         FAR struct tcp_hdr_s *tcp)
+{
+  uint8_t opts[TCP_MAX_HDRLEN - TCP_HDRLEN];
+  FAR uint8_t *optdata;
+  unsigned int iphdrlen;
+  unsigned int hdrlen;
+  unsigned int paylen;
+  unsigned int space;
+  unsigned int optlen = 0;
+
+  /* The SYN exchange negotiates the options in tcp_synack() */
+
+  if ((tcp->flags & TCP_SYN) != 0)
+    {
+      return;
+    }
+
+  hdrlen   = (tcp->tcpoffset >> 4) << 2;
+  optdata  = (FAR uint8_t *)tcp + hdrlen;
+  iphdrlen = (FAR uint8_t *)tcp - &dev->d_buf[NET_LL_HDRLEN(dev)];
+
+  /* The part of the payload that follows the header in d_buf */
+
+  paylen   = dev->d_len - iphdrlen - hdrlen;
+#ifdef CONFIG_NETDEV_IOB_SG
+  paylen  -= dev->d_ioblen;
+#endif
+
+  /* The room left for options in the TCP header and in d_buf */
+
+  space    = NET_LL_HDRLEN(dev) + iphdrlen + hdrlen + paylen;
+  space    = space < NETDEV_PKTSIZE(dev) ? NETDEV_PKTSIZE(dev) - space : 0;
+  if (space > TCP_MAX_HDRLEN - hdrlen)
+    {
+      space = TCP_MAX_HDRLEN - hdrlen;
+    }
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  if ((conn->flags & TCP_TSTAMP) != 0)
+    {
+      /* RFC 7323 requires the option in every segment once it has been
+       * negotiated.  The MSS was reduced by TCP_OPT_TS_SPACE when the
+       * connection was established, so there is always room for it.
+       */
+
+      DEBUGASSERT(space >= TCP_OPT_TS_SPACE);
+
+      opts[optlen++] = TCP_OPT_NOOP;
+      opts[optlen++] = TCP_OPT_NOOP;
+      opts[optlen++] = TCP_OPT_TS;
+      opts[optlen++] = TCP_OPT_TS_LEN;
+      tcp_setsequence(&opts[optlen], TCP_TSNOW());
+      tcp_setsequence(&opts[optlen + 4], conn->ts_recent);
+      optlen += 8;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* Out-of-order data is reported in pure ACKs only, so that the SACK
+   * option never competes with payload for space.
+   */
+
+  if (dev->d_len == iphdrlen + hdrlen && space > optlen)
+    {
+      optlen += tcp_sack_build(conn, &opts[optlen], space - optlen);
+    }
+#endif
+
+  if (optlen == 0)
+    {
+      return;
+    }
+
+  if (paylen > 0)
+    {
+      memmove(optdata + optlen, optdata, paylen);
+    }
+
+  memcpy(optdata, opts, optlen);
+  tcp->tcpoffset = ((hdrlen + optlen) / 4) << 4;
+  dev->d_len    += optlen;
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_sendcommon
  *
@@ -379,6 +496,12 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
       tcp->wnd[1] = recvwndo & 0xff;
     }
 
+#if defined(CONFIG_NET_TCP_TIMESTAMPS) || defined(CONFIG_NET_TCP_SACK)
+  /* Add the negotiated per-segment options */
+
+  tcp_sendopts(dev, conn, tcp);
+#endif
+
   /* Finish the IP portion of the message and calculate checksums */
 
   tcp_sendcomplete(dev, tcp);
@@ -401,6 +524,10 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
 #else
   /* REVISIT for the buffered mode */
 #endif
+
+  /* Start or re-schedule the timers of the connection */
+
+  tcp_update_timer(conn);
 }
 
 /****************************************************************************
@@ -709,6 +836,31 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
     }
 #endif
 
+#ifdef CONFIG_NET_TCP_SACK
+  if (tcp->flags == TCP_SYN ||
+      ((tcp->flags == (TCP_ACK | TCP_SYN)) && (conn->flags & TCP_SACKOK)))
+    {
+      tcp->optdata[optlen++] = TCP_OPT_NOOP;
+      tcp->optdata[optlen++] = TCP_OPT_NOOP;
+      tcp->optdata[optlen++] = TCP_OPT_SACK_PERM;
+      tcp->optdata[optlen++] = TCP_OPT_SACK_PERM_LEN;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  if (tcp->flags == TCP_SYN ||
+      ((tcp->flags == (TCP_ACK | TCP_SYN)) && (conn->flags & TCP_TSTAMP)))
+    {
+      tcp->optdata[optlen++] = TCP_OPT_NOOP;
+      tcp->optdata[optlen++] = TCP_OPT_NOOP;
+      tcp->optdata[optlen++] = TCP_OPT_TS;
+      tcp->optdata[optlen++] = TCP_OPT_TS_LEN;
+      tcp_setsequence(&tcp->optdata[optlen], TCP_TSNOW());
+      tcp_setsequence(&tcp->optdata[optlen + 4], conn->ts_recent);
+      optlen += 8;
+    }
+#endif
+
   tcp->tcpoffset         = ((TCP_HDRLEN + optlen) / 4) << 4;
   dev->d_len            += optlen;
 
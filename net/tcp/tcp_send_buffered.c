@@ -330,6 +330,92 @@ static inline void send_ipselect(FAR struct net_driver_s *dev,
 }
 #endif
 
+/****************************************************************************
+ * Name: psock_sack_split
+ *
+ * Description:
+ *   Use the SACK scoreboard to decide what a fast retransmit has to send
+ *   again:  Only the write buffers below the highest SACKed one that have
+ *   not been SACKed themselves were lost.  All other write buffers are
+ *   moved from the unacked_q to 'keep'.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *   keep - Receives the write buffers that must not be retransmitted
+ *
+ * Returned Value:
+ *   True if the peer has SACKed anything; false if there is no SACK
+ *   information and everything un-ACKed must be retransmitted.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+static bool psock_sack_split(FAR struct tcp_conn_s *conn,
+                             FAR sq_queue_t *keep)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR sq_entry_t *entry;
+  FAR sq_entry_t *prev;
+  FAR sq_entry_t *next;
+  FAR sq_entry_t *high = NULL;
+
+  /* Find the highest SACKed write buffer */
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      if (TCP_WBSACKED((FAR struct tcp_wrbuffer_s *)entry))
+        {
+          high = entry;
+        }
+    }
+
+  if (high == NULL)
+    {
+      return false;
+    }
+
+  /* The unacked_q is in sequence number order, so every write buffer from
+   * the highest SACKed one onward stays where it is.
+   */
+
+  for (prev = NULL, entry = sq_peek(&conn->unacked_q); entry; entry = next)
+    {
+      next = sq_next(entry);
+      wrb  = (FAR struct tcp_wrbuffer_s *)entry;
+
+      if (TCP_WBSACKED(wrb) || high == NULL)
+        {
+          if (prev == NULL)
+            {
+              sq_remfirst(&conn->unacked_q);
+            }
+          else
+            {
+              sq_remafter(prev, &conn->unacked_q);
+            }
+
+          sq_addlast(entry, keep);
+        }
+      else
+        {
+          prev = entry;
+        }
+
+      if (entry == high)
+        {
+          high = NULL;
+        }
+    }
+
+  ninfo("SACK: %zu write buffers need no retransmission\n",
+        sq_count(keep));
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  *
@@ -543,12 +629,20 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
                   rexmit = true;
                 }
-              else if ((TCP_WBNACK(wrb) > TCP_FAST_RETRANSMISSION_THRESH) &&
-                       TCP_WBNACK(wrb) == sq_count(&conn->unacked_q) - 1)
+              else if (TCP_WBNACK(wrb) > TCP_FAST_RETRANSMISSION_THRESH)
                 {
-                  /* Reset the duplicate ack counter */
+                  /* Each further duplicate ACK means that another segment
+                   * has left the network.
+                   */
 
-                  TCP_WBNACK(wrb) = 0;
+                  tcp_cc_dupack(conn);
+
+                  if (TCP_WBNACK(wrb) == sq_count(&conn->unacked_q) - 1)
+                    {
+                      /* Reset the duplicate ack counter */
+
+                      TCP_WBNACK(wrb) = 0;
+                    }
                 }
             }
 #endif
@@ -624,14 +718,50 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
     {
       FAR struct tcp_wrbuffer_s *wrb;
       FAR sq_entry_t *entry;
+#ifdef CONFIG_NET_TCP_SACK
+      sq_queue_t sacked;
+      bool selective = false;
+#endif
 
       ninfo("REXMIT: %04x\n", flags);
 
+      /* Let congestion control react to the loss.  TCP_REXMIT comes from
+       * the retransmission timer, otherwise this is a fast retransmit.
+       */
+
+      tcp_cc_loss(conn, (flags & TCP_REXMIT) != 0);
+
+#ifdef CONFIG_NET_TCP_SACK
+      /* A fast retransmit only resends the holes that the peer reported.
+       * The peer may discard SACKed data, so the retransmission timer
+       * forgets the scoreboard and resends everything (RFC 2018).
+       */
+
+      sq_init(&sacked);
+      if ((flags & TCP_REXMIT) != 0)
+        {
+          tcp_sack_clear(conn);
+        }
+      else if ((conn->flags & TCP_SACKOK) != 0)
+        {
+          selective = psock_sack_split(conn, &sacked);
+        }
+#endif
+
       /* If there is a partially sent write buffer at the head of the
        * write_q?  Has anything been sent from that write buffer?
        */
 
       wrb = (FAR struct tcp_wrbuffer_s *)sq_peek(&conn->write_q);
+#ifdef CONFIG_NET_TCP_SACK
+      if (selective)
+        {
+          /* It lies beyond the SACKed data and is still in flight */
+
+          wrb = NULL;
+        }
+#endif
+
       ninfo("REXMIT: wrb=%p sent=%u\n", wrb, wrb ? TCP_WBSENT(wrb) : 0);
 
       if (wrb != NULL && TCP_WBSENT(wrb) > 0)
@@ -781,6 +911,12 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
               psock_insert_segment(wrb, &conn->write_q);
             }
         }
+
+#ifdef CONFIG_NET_TCP_SACK
+      /* The write buffers that are not resent keep waiting for an ACK */
+
+      sq_move(&sacked, &conn->unacked_q);
+#endif
     }
 
 #if CONFIG_NET_SEND_BUFSIZE > 0
@@ -845,14 +981,36 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
       seq = TCP_WBSEQNO(wrb) + TCP_WBSENT(wrb);
       snd_wnd_edge = conn->snd_wl2 + conn->snd_wnd;
+
+#ifdef CONFIG_NET_TCP_CC
+      /* Don't have more data in flight than the congestion window allows */
+
+      if (TCP_SEQ_LT(conn->snd_wl2 + conn->cwnd, snd_wnd_edge))
+        {
+          snd_wnd_edge = conn->snd_wl2 + conn->cwnd;
+        }
+#endif
       if (TCP_SEQ_LT(seq, snd_wnd_edge))
         {
           uint32_t remaining_snd_wnd;
 
+          uint32_t maxlen = conn->mss;
+
+#ifdef CONFIG_NET_TCP_GSO
+          /* While the device is polled, several MSS may be sent as one
+           * super-segment that is split up again for the driver.
+           */
+
+          if (dev->d_gsomax >= 2 * conn->mss)
+            {
+              maxlen = dev->d_gsomax - dev->d_gsomax % conn->mss;
+            }
+#endif
+
           sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-          if (sndlen > conn->mss)
+          if (sndlen > maxlen)
             {
-              sndlen = conn->mss;
+              sndlen = maxlen;
             }
 
           remaining_snd_wnd = TCP_SEQ_SUB(snd_wnd_edge, seq);
@@ -861,6 +1019,13 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
               sndlen = remaining_snd_wnd;
             }
 
+#ifdef CONFIG_NET_TCP_GSO
+          if (sndlen > conn->mss)
+            {
+              dev->d_gsosize = conn->mss;
+            }
+#endif
+
           ninfo("SEND: wrb=%p seq=%" PRIu32 " pktlen=%u sent=%u sndlen=%zu "
                 "mss=%u snd_wnd=%u seq=%" PRIu32
                 " remaining_snd_wnd=%" PRIu32 "\n",
@@ -1555,4 +1720,87 @@ void tcp_sendbuffer_notify(FAR struct tcp_conn_s *conn)
 }
 #endif /* CONFIG_NET_SEND_BUFSIZE */
 
+/****************************************************************************
+ * Name: tcp_gso_unsent
+ *
+ * Description:
+ *   The driver stopped accepting packets before all segments of a TCP
+ *   super-segment were passed to it.  Return the data of the segments that
+ *   were not sent to the write queue, so that it is sent again on the next
+ *   poll instead of waiting for a retransmission.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection of interest
+ *   seqno - The sequence number of the first byte that was not sent
+ *   len   - The number of bytes that were not sent.  These are the last
+ *           bytes of the super-segment.
+ *
+ * Assumptions:
+ *   Called from the network driver with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_GSO
+void tcp_gso_unsent(FAR struct tcp_conn_s *conn, uint32_t seqno,
+                    uint32_t len)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  uint32_t endseq = seqno + len;
+
+  /* The super-segment was taken from the write buffer at the head of the
+   * write queue.  If that was all of the remaining data in the buffer, it
+   * has been moved to the unacked queue already.
+   */
+
+  wrb = (FAR struct tcp_wrbuffer_s *)sq_peek(&conn->write_q);
+  if (wrb == NULL || TCP_WBSEQNO(wrb) == (unsigned)-1 ||
+      TCP_WBSEQNO(wrb) + TCP_WBSENT(wrb) != endseq)
+    {
+      for (wrb = (FAR struct tcp_wrbuffer_s *)sq_peek(&conn->unacked_q);
+           wrb != NULL;
+           wrb = (FAR struct tcp_wrbuffer_s *)sq_next(&wrb->wb_node))
+        {
+          if (TCP_WBSEQNO(wrb) + TCP_WBSENT(wrb) == endseq)
+            {
+              break;
+            }
+        }
+
+      if (wrb == NULL)
+        {
+          nwarn("WARNING: No write buffer ends at %" PRIu32 "\n", endseq);
+          return;
+        }
+
+      sq_rem(&wrb->wb_node, &conn->unacked_q);
+      sq_addfirst(&wrb->wb_node, &conn->write_q);
+    }
+
+  /* An ACK may have trimmed the acknowledged data from the buffer in the
+   * meantime.  Trimming advances the sequence number of the buffer by as
+   * much as it reduces the sent count, so the buffer still ends at endseq,
+   * but less than len of its bytes may remain unacknowledged.
+   */
+
+  if (len > TCP_WBSENT(wrb))
+    {
+      len   = TCP_WBSENT(wrb);
+      seqno = endseq - len;
+    }
+
+  ninfo("UNSENT: wrb=%p seqno=%" PRIu32 " len=%" PRIu32 "\n",
+        wrb, seqno, len);
+
+  TCP_WBSENT(wrb) -= len;
+
+  conn->tx_unacked = conn->tx_unacked > len ? conn->tx_unacked - len : 0;
+  conn->sent       = conn->sent > len ? conn->sent - len : 0;
+
+  if (conn->sndseq_max == endseq)
+    {
+      conn->sndseq_max = seqno;
+    }
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 #endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_WRITE_BUFFERS */
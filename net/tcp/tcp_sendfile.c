@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <sys/stat.h>
+#include <sys/statfs.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 
@@ -42,6 +43,8 @@
 #include <arch/irq.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/arp.h>
@@ -65,6 +68,14 @@
 #define TCPIPv4BUF ((FAR struct tcp_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev) + IPv4_HDRLEN])
 #define TCPIPv6BUF ((FAR struct tcp_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev) + IPv6_HDRLEN])
 
+/* File data mapped in memory can be passed to drivers that gather the
+ * payload from I/O buffers if the I/O buffers can refer to external memory.
+ */
+
+#if defined(CONFIG_NETDEV_IOB_SG) && defined(CONFIG_IOB_LARGE)
+#  define SENDFILE_ZEROCOPY 1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -78,6 +89,11 @@ struct sendfile_s
   FAR struct socket *snd_sock;             /* Points to the parent socket structure */
   FAR struct devif_callback_s *snd_cb;     /* Reference to callback instance */
   FAR struct file   *snd_file;             /* File structure of the input file */
+  FAR const uint8_t *snd_map;              /* Start of the file if it is mapped
+                                            * in memory, otherwise NULL */
+#ifdef SENDFILE_ZEROCOPY
+  struct iob_s       snd_iob;              /* Refers to the mapped file data */
+#endif
   sem_t              snd_sem;              /* Used to wake up the waiting thread */
   off_t              snd_foffset;          /* Input file offset */
   size_t             snd_flen;             /* File length */
@@ -101,6 +117,132 @@ struct sendfile_s
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: sendfile_mmap
+ *
+ * Description:
+ *   Return the address of the input file in memory if its data can be sent
+ *   from there directly.  That is only the case for romfs (on XIP media),
+ *   whose file data never changes or moves.  tmpfs maps its files too, but
+ *   it reallocates or frees the data when a file is written, truncated or
+ *   removed, which may happen while the data is being sent.  Empty files
+ *   are also read through the file system, since whatever maps them does
+ *   not report how much data there is.
+ *
+ * Input Parameters:
+ *   infile - The input file
+ *   st     - Receives the status of the file if it is mapped
+ *
+ * Returned Value:
+ *   The start of the file in memory, or NULL if the file must be read
+ *   through the file system.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *sendfile_mmap(FAR struct file *infile,
+                                  FAR struct stat *st)
+{
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+  FAR struct inode *inode = infile->f_inode;
+  FAR uint8_t *map = NULL;
+  struct statfs buf;
+
+  if (inode == NULL || !INODE_IS_MOUNTPT(inode) ||
+      inode->u.i_mops == NULL || inode->u.i_mops->statfs == NULL ||
+      inode->u.i_mops->statfs(inode, &buf) < 0 ||
+      buf.f_type != ROMFS_MAGIC)
+    {
+      return NULL;
+    }
+
+  if (file_ioctl(infile, FIOC_MMAP, (unsigned long)((uintptr_t)&map)) < 0 ||
+      file_fstat(infile, st) < 0 || st->st_size <= 0)
+    {
+      return NULL;
+    }
+
+  return map;
+#else
+  return NULL;
+#endif
+}
+
+/****************************************************************************
+ * Name: sendfile_copyin
+ *
+ * Description:
+ *   Set up the payload of the next packet from the input file.  If the file
+ *   is mapped in memory, the data is taken from there instead of being
+ *   read through the file system.  Drivers that gather the payload from
+ *   I/O buffers then even send it from where it is, without any copy.
+ *
+ * Input Parameters:
+ *   dev    - The structure of the network driver that sends the packet
+ *   pstate - The state of the send operation
+ *   offset - The offset of the data relative to snd_foffset
+ *   sndlen - The amount of data to send
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+static int sendfile_copyin(FAR struct net_driver_s *dev,
+                           FAR struct sendfile_s *pstate,
+                           uint32_t offset, uint32_t sndlen)
+{
+  off_t pos = pstate->snd_foffset + offset;
+  int ret;
+
+  if (pstate->snd_map != NULL)
+    {
+#ifdef SENDFILE_ZEROCOPY
+      if ((dev->d_features & NETDEV_FEATURE_SG) != 0)
+        {
+          FAR struct iob_s *iob = &pstate->snd_iob;
+
+          /* Describe the data with an I/O buffer that the device only
+           * borrows.  It is never freed.
+           */
+
+          iob->io_flink   = NULL;
+          iob->io_len     = sndlen;
+          iob->io_offset  = 0;
+          iob->io_pktlen  = sndlen;
+          iob->io_bufsize = sndlen;
+          iob->io_data    = (FAR uint8_t *)&pstate->snd_map[pos];
+
+          devif_iob_send(dev, iob, sndlen, 0);
+          return OK;
+        }
+#endif
+
+      memcpy(dev->d_appdata, &pstate->snd_map[pos], sndlen);
+      dev->d_sndlen = sndlen;
+      return OK;
+    }
+
+  ret = file_seek(pstate->snd_file, pos, SEEK_SET);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to lseek: %d\n", ret);
+      return ret;
+    }
+
+  ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
+      return ret;
+    }
+
+  dev->d_sndlen = sndlen;
+  return OK;
+}
+
 /****************************************************************************
  * Name: sendfile_eventhandler
  *
@@ -302,25 +444,13 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
        * happen until the polling cycle completes).
        */
 
-      ret = file_seek(pstate->snd_file,
-                      pstate->snd_foffset + pstate->snd_acked, SEEK_SET);
+      ret = sendfile_copyin(dev, pstate, pstate->snd_acked, sndlen);
       if (ret < 0)
         {
-          nerr("ERROR: Failed to lseek: %d\n", ret);
           pstate->snd_sent = ret;
           goto end_wait;
         }
 
-      ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
-      if (ret < 0)
-        {
-          nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
-          pstate->snd_sent = ret;
-          goto end_wait;
-        }
-
-      dev->d_sndlen = sndlen;
-
       /* Continue waiting */
 
       return flags;
@@ -380,25 +510,13 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
            * happen until the polling cycle completes).
            */
 
-          ret = file_seek(pstate->snd_file,
-                          pstate->snd_foffset + pstate->snd_sent, SEEK_SET);
-          if (ret < 0)
-            {
-              nerr("ERROR: Failed to lseek: %d\n", ret);
-              pstate->snd_sent = ret;
-              goto end_wait;
-            }
-
-          ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
+          ret = sendfile_copyin(dev, pstate, pstate->snd_sent, sndlen);
           if (ret < 0)
             {
-              nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
               pstate->snd_sent = ret;
               goto end_wait;
             }
 
-          dev->d_sndlen = sndlen;
-
           /* Update the amount of data sent (but not necessarily ACKed) */
 
           pstate->snd_sent += sndlen;
@@ -465,7 +583,10 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
 {
   FAR struct tcp_conn_s *conn;
   struct sendfile_s state;
+  FAR uint8_t *map;
+  struct stat st;
   off_t startpos;
+  off_t foffset;
   int ret;
 
   conn = psock->s_conn;
@@ -520,6 +641,28 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
       return startpos;
     }
 
+  foffset = offset ? *offset : startpos;
+
+  /* Send the data directly from memory if the file is mapped there and
+   * stays in place.  Other files are read through the file system.
+   */
+
+  map = sendfile_mmap(infile, &st);
+  if (map != NULL)
+    {
+      /* Data is never taken from beyond the end of the mapped file */
+
+      if (foffset >= st.st_size)
+        {
+          return 0;
+        }
+
+      if (count > st.st_size - foffset)
+        {
+          count = st.st_size - foffset;
+        }
+    }
+
   /* Initialize the state structure.  This is done with the network
    * locked because we don't want anything to happen until we are
    * ready.
@@ -539,9 +682,10 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
   nxsem_set_protocol(&state.snd_sem, SEM_PRIO_NONE);
 
   state.snd_sock    = psock;                       /* Socket descriptor to use */
-  state.snd_foffset = offset ? *offset : startpos; /* Input file offset */
+  state.snd_foffset = foffset;                     /* Input file offset */
   state.snd_flen    = count;                       /* Number of bytes to send */
   state.snd_file    = infile;                      /* File to read from */
+  state.snd_map     = map;                         /* Mapped file or NULL */
 
   /* Allocate resources to receive a callback */
 
@@ -596,9 +740,31 @@ errout_locked:
 #endif
   net_unlock();
 
+  /* The file position was not used if the file is mapped.  It follows the
+   * data sent unless the caller provided the offset.
+   */
+
+  if (map != NULL)
+    {
+      off_t endpos = foffset + (state.snd_sent > 0 ? state.snd_sent : 0);
+
+      if (offset)
+        {
+          *offset = endpos;
+        }
+      else
+        {
+          endpos = file_seek(infile, endpos, SEEK_SET);
+          if (endpos < 0)
+            {
+              return endpos;
+            }
+        }
+    }
+
   /* Return the current file position */
 
-  if (offset)
+  else if (offset)
     {
       /* Use lseek to get the current file position */
 
@@ -26,6 +26,7 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -72,9 +73,9 @@
 int tcp_setsockopt(FAR struct socket *psock, int option,
                    FAR const void *value, socklen_t value_len)
 {
-#ifdef CONFIG_NET_TCP_KEEPALIVE
-  /* Keep alive options are the only TCP protocol socket option currently
-   * supported.
+#if defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_CC)
+  /* Keep alive and congestion control options are the only TCP protocol
+   * socket options currently supported.
    */
 
   FAR struct tcp_conn_s *conn;
@@ -98,6 +99,7 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
 
   switch (option)
     {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       /* Handle the SO_KEEPALIVE socket-level option.
        *
        * NOTE: SO_KEEPALIVE is not really a socket-level option; it is a
@@ -131,6 +133,7 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
               }
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
 
       case TCP_NODELAY: /* Avoid coalescing of small segments. */
         if (value_len != sizeof(int))
@@ -153,6 +156,7 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
           }
         break;
 
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       case TCP_KEEPIDLE:  /* Start keepalives after this IDLE period */
       case TCP_KEEPINTVL: /* Interval between keepalives */
         {
@@ -224,6 +228,45 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
               }
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
+
+#ifdef CONFIG_NET_TCP_CC
+      case TCP_CONGESTION: /* Congestion control algorithm */
+        if (value_len == 0)
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            FAR const struct tcp_cc_ops_s *ops;
+            char name[TCP_CA_NAME_MAX];
+
+            /* The name does not need to be NUL-terminated */
+
+            if (value_len >= TCP_CA_NAME_MAX)
+              {
+                value_len = TCP_CA_NAME_MAX - 1;
+              }
+
+            memcpy(name, value, value_len);
+            name[value_len] = '\0';
+
+            ops = tcp_cc_find(name);
+            if (ops == NULL)
+              {
+                nerr("ERROR: Unknown congestion control: %s\n", name);
+                ret = -ENOENT;
+              }
+            else
+              {
+                net_lock();
+                tcp_cc_select(conn, ops);
+                net_unlock();
+                ret = OK;
+              }
+          }
+        break;
+#endif /* CONFIG_NET_TCP_CC */
 
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
@@ -231,10 +274,21 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
         break;
     }
 
+#ifdef CONFIG_NET_TCP_KEEPALIVE
+  /* The keep-alive timer of the connection may have changed */
+
+  if (ret == OK)
+    {
+      net_lock();
+      tcp_update_timer(conn);
+      net_unlock();
+    }
+#endif
+
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_TCP_KEEPALIVE */
+#endif /* CONFIG_NET_TCP_KEEPALIVE || CONFIG_NET_TCP_CC */
 }
 
 #endif /* CONFIG_NET_TCPPROTO_OPTIONS */
@@ -57,7 +57,9 @@
 #include <nuttx/net/tcp.h>
 
 #include "devif/devif.h"
+#include "netdev/netdev.h"
 #include "socket/socket.h"
+#include "utils/utils.h"
 #include "tcp/tcp.h"
 
 /****************************************************************************
@@ -67,17 +69,212 @@
 /* Per RFC 1122:  "... an ACK should not be excessively delayed; in
  * particular, the delay MUST be less than 0.5 seconds ..."
  *
- * NOTE:  We only have 0.5 timing resolution here so the delay will be
- * between 0.5 and 1.0 seconds, and may be delayed further, depending on the
- * polling rate of the the driver (often 1 second).
+ * NOTE:  Without CONFIG_NET_TCP_CONN_TIMER, the timers are only examined
+ * at the polling rate of the driver (often 1 second), so the ACK may be
+ * delayed further.
  */
 
-#define ACK_DELAY (1)
+#define ACK_DELAY MSEC2TICK(200)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_timer_expiry
+ *
+ * Description:
+ *   The timer work of a connection has run:  Mark the connection and ask
+ *   the driver to poll for it.  tcp_timer() is then called for this
+ *   connection from the poll, when the device buffer is available.
+ *
+ * Assumptions:
+ *   This function is called from a work queue thread.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONN_TIMER
+static void tcp_timer_expiry(FAR void *arg)
+{
+  FAR struct tcp_conn_s *conn = (FAR struct tcp_conn_s *)arg;
+
+  net_lock();
+
+  /* tcp_free() may have run while this work was waiting for the network
+   * lock.  work_cancel() cannot stop work that has already been dequeued,
+   * so tcp_free() then leaves the connection to be released by the last
+   * such instance of the work.
+   */
+
+  DEBUGASSERT(conn->nwork > 0);
+  conn->nwork--;
+
+  if (conn->freed)
+    {
+      if (conn->nwork == 0)
+        {
+          tcp_release(conn);
+        }
+    }
+  else if (conn->tcpstateflags != TCP_CLOSED && conn->dev != NULL)
+    {
+      conn->timeout = true;
+      netdev_txnotify_dev(conn->dev);
+    }
+
+  net_unlock();
+}
+#endif
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_update_timer
+ *
+ * Description:
+ *   Start the retransmission timer if data has become outstanding and, with
+ *   CONFIG_NET_TCP_CONN_TIMER, schedule the timer work of the connection
+ *   for the earliest pending timer.  This must be called after any change
+ *   of the TCP state that is relevant to the timers.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+void tcp_update_timer(FAR struct tcp_conn_s *conn)
+{
+  clock_t now = clock_systime_ticks();
+  bool pending = false;
+  clock_t next = 0;
+  uint8_t state = conn->tcpstateflags & TCP_STATE_MASK;
+
+  if (state == TCP_CLOSED || state == TCP_ALLOCATED)
+    {
+      tcp_stop_timer(conn);
+      return;
+    }
+
+  if (state == TCP_TIME_WAIT || state == TCP_FIN_WAIT_2)
+    {
+      /* The connection expires at conn->timer, which was set when the
+       * state was entered.
+       */
+
+      next    = conn->timer;
+      pending = true;
+    }
+  else if (conn->tx_unacked > 0)
+    {
+      /* Start the retransmission timer when data becomes outstanding */
+
+      if (!conn->timer_armed)
+        {
+          conn->timer       = now + conn->rto;
+          conn->timer_rto   = conn->rto;
+          conn->timer_armed = true;
+        }
+
+      next    = conn->timer;
+      pending = true;
+    }
+  else
+    {
+      conn->timer_armed = false;
+
+#if defined(CONFIG_NET_TCP_CONN_TIMER) && \
+    (defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_DELAYED_ACK))
+      if (state == TCP_ESTABLISHED)
+        {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
+          if (conn->keepalive)
+            {
+              next    = conn->keeptime +
+                        DSEC2TICK(conn->keepretries > 0 ? conn->keepintvl :
+                                                          conn->keepidle);
+              pending = true;
+            }
+#endif
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+          if (conn->rx_unackseg > 0 &&
+              (!pending ||
+               TCP_TICK_GTE(next, conn->rx_acktime + ACK_DELAY)))
+            {
+              next    = conn->rx_acktime + ACK_DELAY;
+              pending = true;
+            }
+#endif
+        }
+#endif
+    }
+
+#ifdef CONFIG_NET_TCP_CONN_TIMER
+  if (pending)
+    {
+      sclock_t delay = (sclock_t)(next - now);
+
+      /* Re-queueing replaces a queued instance of the work, otherwise
+       * there is one more instance.
+       */
+
+      if (work_cancel(LPWORK, &conn->work) != OK)
+        {
+          conn->nwork++;
+        }
+
+      work_queue(LPWORK, &conn->work, tcp_timer_expiry, conn,
+                 delay > 0 ? delay : 0);
+    }
+  else
+    {
+      tcp_stop_timer(conn);
+    }
+#else
+  UNUSED(next);
+  UNUSED(pending);
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_stop_timer
+ *
+ * Description:
+ *   Stop the timer work of a connection.  Work that has already been
+ *   dequeued cannot be stopped and is still counted in conn->nwork.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONN_TIMER
+void tcp_stop_timer(FAR struct tcp_conn_s *conn)
+{
+  if (work_cancel(LPWORK, &conn->work) == OK)
+    {
+      DEBUGASSERT(conn->nwork > 0);
+      conn->nwork--;
+    }
+
+  conn->timeout = false;
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_timer
  *
@@ -87,7 +284,6 @@
  * Input Parameters:
  *   dev  - The device driver structure to use in the send operation
  *   conn - The TCP "connection" to poll for TX data
- *   hsec - The polling interval in units of halves of a second
  *
  * Returned Value:
  *   None
@@ -100,18 +296,12 @@
  *
  ****************************************************************************/
 
-void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
-               int hsec)
+void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
 {
+  clock_t now = clock_systime_ticks();
   uint16_t result;
   uint8_t hdrlen;
 
-  /* NOTE: It is important to decrease conn->timer at "hsec" pace,
-   * not faster. Excessive (false) decrements of conn->timer are not allowed
-   * here. Otherwise, it breaks TCP timings and leads to TCP spurious
-   * retransmissions and other issues due to premature timeouts.
-   */
-
   DEBUGASSERT(dev != NULL && conn != NULL && dev == conn->dev);
 
   /* Set up for the callback.  We can't know in advance if the application
@@ -167,19 +357,10 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   if (conn->tcpstateflags == TCP_TIME_WAIT ||
       conn->tcpstateflags == TCP_FIN_WAIT_2)
     {
-      unsigned int newtimer;
-
-      /* Increment the connection timer */
-
-      newtimer = (unsigned int)conn->timer + hsec;
+      /* Check if the connection has timed out */
 
-      /* Check if the timer exceeds the timeout value */
-
-      if (newtimer >= (TCP_TIME_WAIT_TIMEOUT * HSEC_PER_SEC))
+      if (TCP_TICK_GTE(now, conn->timer))
         {
-          /* Set the timer to the maximum value */
-
-          conn->timer = TCP_TIME_WAIT_TIMEOUT * HSEC_PER_SEC;
           conn->tcpstateflags = TCP_CLOSED;
 
           /* Notify upper layers about the timeout */
@@ -188,12 +369,6 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
           ninfo("TCP state: TCP_CLOSED\n");
         }
-      else
-        {
-          /* No timeout. Just update the incremented timer */
-
-          conn->timer = newtimer;
-        }
     }
   else if (conn->tcpstateflags != TCP_CLOSED)
     {
@@ -204,20 +379,13 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
       if (conn->tx_unacked > 0)
         {
-          /* The connection has outstanding data */
-
-          if (conn->timer > hsec)
-            {
-              /* Will not yet decrement to zero */
+          /* The connection has outstanding data.  Has the retransmission
+           * timer expired?  It is started by tcp_update_timer() if it is
+           * not yet running.
+           */
 
-              conn->timer -= hsec;
-            }
-          else
+          if (conn->timer_armed && TCP_TICK_GTE(now, conn->timer))
             {
-              /* Will decrement to zero */
-
-              conn->timer = 0;
-
               /* Check for a timeout on connection in the TCP_SYN_RCVD state.
                * On such timeouts, we would normally resend the SYNACK until
                * the ACK is received, completing the 3-way handshake.  But if
@@ -259,7 +427,7 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
                   conn->crefs = 0;
                   tcp_free(conn);
-                  goto done;
+                  return;
                 }
 
               /* Otherwise, check for a timeout on an established connection.
@@ -300,7 +468,10 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
               /* Exponential backoff. */
 
-              conn->timer = TCP_RTO << (conn->nrtx > 4 ? 4: conn->nrtx);
+              conn->timer_rto =
+                MIN(conn->rto << (conn->nrtx > 4 ? 4: conn->nrtx),
+                    TCP_RTO_MAX_TICKS);
+              conn->timer     = now + conn->timer_rto;
               (conn->nrtx)++;
 
               /* Ok, so we need to retransmit. We do this differently
@@ -486,23 +657,18 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
           if (conn->rx_unackseg > 0)
             {
-              /* Increment the ACK delay. */
-
-              conn->rx_acktimer += hsec;
-
               /* Per RFC 1122:  "...an ACK should not be excessively
                * delayed; in particular, the delay must be less than
                * 0.5 seconds..."
                */
 
-              if (conn->rx_acktimer >= ACK_DELAY)
+              if (TCP_TICK_GTE(now, conn->rx_acktime + ACK_DELAY))
                 {
                   /* Reset the delayed ACK state and send the ACK
                    * packet.
                    */
 
                   conn->rx_unackseg = 0;
-                  conn->rx_acktimer = 0;
                   tcp_synack(dev, conn, TCP_ACK);
                   goto done;
                 }
@@ -526,7 +692,10 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   dev->d_len = 0;
 
 done:
-  return;
+
+  /* Schedule the next timer event of this connection */
+
+  tcp_update_timer(conn);
 }
 
 #endif /* CONFIG_NET && CONFIG_NET_TCP */
@@ -104,6 +104,8 @@ struct udp_conn_s
 
   /* UDP-specific content follows */
 
+  FAR struct udp_conn_s *pnext; /* Next connection in the local port hash
+                                 * chain */
   union ip_binding_u u;   /* IP address binding */
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
@@ -164,6 +166,9 @@ struct udp_wrbuffer_s
   sq_entry_t wb_node;              /* Supports a singly linked list */
   struct sockaddr_storage wb_dest; /* Destination address */
   struct iob_s *wb_iob;            /* Head of the I/O buffer chain */
+#ifdef CONFIG_NETDEV_IOB_SG
+  uint16_t wb_chksum;              /* Raw checksum of the data in wb_iob */
+#endif
 };
 #endif
 
@@ -179,6 +184,13 @@ extern "C"
 #  define EXTERN extern
 #endif
 
+/* The lock that protects the lists of free and allocated UDP connections.
+ * It may be taken while holding the network lock, but the network lock
+ * must never be taken while holding it.
+ */
+
+EXTERN struct netlock_s g_udp_lock;
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -260,6 +272,17 @@ FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn);
 
 uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u);
 
+/****************************************************************************
+ * Name: udp_bindport
+ *
+ * Description:
+ *   Assign the local port number of a connection and index the connection
+ *   by that port number.  A port number of zero unbinds the connection.
+ *
+ ****************************************************************************/
+
+void udp_bindport(FAR struct udp_conn_s *conn, uint16_t portno);
+
 /****************************************************************************
  * Name: udp_bind
  *
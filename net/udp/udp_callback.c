@@ -95,7 +95,7 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
    * We will not wait for an I/O buffer to become available in this context.
    */
 
-  iob = iob_tryalloc(true, IOBUSER_NET_UDP_READAHEAD);
+  iob = iob_tryalloc_size(true, buflen, IOBUSER_NET_UDP_READAHEAD);
   if (iob == NULL)
     {
       nerr("ERROR: Failed to create new I/O buffer chain\n");
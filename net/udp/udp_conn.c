@@ -56,6 +56,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/mm/slab.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
@@ -66,7 +67,9 @@
 #include "devif/devif.h"
 #include "netdev/netdev.h"
 #include "inet/inet.h"
+#include "socket/socket.h"
 #include "udp/udp.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -75,6 +78,22 @@
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/* True if SO_REUSEPORT is set on the socket of a connection */
+
+#ifdef CONFIG_NET_SOCKOPTS
+#  define UDP_REUSEPORT(c) _SO_GETOPT((c)->sconn.s_options, SO_REUSEPORT)
+#else
+#  define UDP_REUSEPORT(c) false
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The lock that protects the lists of free and allocated UDP connections */
+
+struct netlock_s g_udp_lock = NETLOCK_INITIALIZER;
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -83,41 +102,106 @@
 
 #ifndef CONFIG_NET_ALLOC_CONNS
 struct udp_conn_s g_udp_connections[CONFIG_NET_UDP_CONNS];
+#elif defined(CONFIG_MM_SLAB)
+/* The slab cache from which UDP connections are allocated */
+
+static SLAB_HANDLE g_udp_slab;
 #endif
 
 /* A list of all free UDP connections */
 
 static dq_queue_t g_free_udp_connections;
-static sem_t g_free_sem = SEM_INITIALIZER(1);
 
 /* A list of all allocated UDP connections */
 
 static dq_queue_t g_active_udp_connections;
 
+/* Hash table of the connections in g_active_udp_connections that have a
+ * local port, indexed by the local port.  Used to demultiplex incoming
+ * datagrams, by bind() and by the ephemeral port selection.
+ */
+
+static FAR struct udp_conn_s *g_udp_port_hash[CONFIG_NET_UDP_HASHSIZE];
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: _udp_semtake() and _udp_semgive()
+ * Name: udp_port_hash
  *
  * Description:
- *   Take/give semaphore
+ *   Return the index of the local port hash table for a port number (in
+ *   network order).
  *
  ****************************************************************************/
 
-static inline void _udp_semtake(FAR sem_t *sem)
+static inline unsigned int udp_port_hash(uint16_t portno)
 {
-  net_lockedwait_uninterruptible(sem);
+  return NTOHS(portno) % CONFIG_NET_UDP_HASHSIZE;
 }
 
-#define _udp_semgive(sem) nxsem_post(sem)
+/****************************************************************************
+ * Name: udp_flow_mix
+ *
+ * Description:
+ *   Fold the source address key and the source port of a datagram into a
+ *   flow hash.  All datagrams of one flow produce the same value, so they
+ *   are delivered to the same SO_REUSEPORT socket.
+ *
+ ****************************************************************************/
+
+static inline uint32_t udp_flow_mix(uint32_t key, uint16_t srcport)
+{
+  key ^= srcport;
+  key ^= key >> 16;
+  key *= 0x45d9f3b;
+  key ^= key >> 16;
+
+  return key;
+}
+
+/****************************************************************************
+ * Name: udp_hash_remove
+ *
+ * Description:
+ *   Remove a connection from the local port hash table.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+static void udp_hash_remove(FAR struct udp_conn_s *conn)
+{
+  FAR struct udp_conn_s **link;
+
+  if (conn->lport == 0)
+    {
+      return;
+    }
+
+  for (link = &g_udp_port_hash[udp_port_hash(conn->lport)];
+       *link != NULL;
+       link = &(*link)->pnext)
+    {
+      if (*link == conn)
+        {
+          *link = conn->pnext;
+          break;
+        }
+    }
+
+  conn->pnext = NULL;
+}
 
 /****************************************************************************
  * Name: udp_find_conn()
  *
  * Description:
- *   Find the UDP connection that uses this local port number.
+ *   Find the UDP connection that uses this local port number.  Connections
+ *   that have SO_REUSEPORT set are not reported if 'reuseport' is true,
+ *   i.e., if the connection being bound has SO_REUSEPORT set as well.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -126,14 +210,23 @@ static inline void _udp_semtake(FAR sem_t *sem)
 
 static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             FAR union ip_binding_u *ipaddr,
-                                            uint16_t portno)
+                                            uint16_t portno, bool reuseport)
 {
-  FAR struct udp_conn_s *conn = NULL;
+  FAR struct udp_conn_s *conn;
 
-  /* Now search each connection structure. */
+  /* Only the connections in the local port hash bucket need be searched */
 
-  while ((conn = udp_nextconn(conn)) != NULL)
+  for (conn = g_udp_port_hash[udp_port_hash(portno)];
+       conn != NULL;
+       conn = conn->pnext)
     {
+      /* Sockets that all have SO_REUSEPORT set may share the port */
+
+      if (reuseport && UDP_REUSEPORT(conn))
+        {
+          continue;
+        }
+
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
        * reference to the connection structure.  INADDR_ANY is a special
@@ -173,11 +266,11 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
 }
 
 /****************************************************************************
- * Name: udp_ipv4_active
+ * Name: udp_ipv4_match
  *
  * Description:
- *   Find a connection structure that is the appropriate connection to be
- *   used within the provided UDP header
+ *   Check if a connection is the appropriate connection to be used within
+ *   the provided UDP header.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -185,141 +278,121 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
  ****************************************************************************/
 
 #ifdef CONFIG_NET_IPv4
-static inline FAR struct udp_conn_s *
-  udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_hdr_s *udp)
+static inline bool udp_ipv4_match(FAR struct udp_conn_s *conn,
+                                  FAR struct ipv4_hdr_s *ip,
+                                  FAR struct udp_hdr_s *udp)
 {
 #ifdef CONFIG_NET_BROADCAST
   static const in_addr_t bcast = INADDR_BROADCAST;
 #endif
-  FAR struct ipv4_hdr_s *ip = IPv4BUF;
-  FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
-  while (conn)
-    {
-      /* If the local UDP port is non-zero, the connection is considered
-       * to be used. If so, then the following checks are performed:
-       *
-       * 1. The destination address is verified against the bound address
-       *    of the connection.
-       *
-       *   - The local port number is checked against the destination port
-       *     number in the received packet.
-       *   - If multiple network interfaces are supported, then the local
-       *     IP address is available and we will insist that the
-       *     destination IP matches the bound address (or the destination
-       *     IP address is a broadcast address). If a socket is bound to
-       *     INADDRY_ANY (laddr), then it should receive all packets
-       *     directed to the port.
-       *
-       * 2. If this is a connection mode UDP socket, then the source address
-       *    is verified against the connected remote address.
-       *
-       *   - The remote port number is checked if the connection is bound
-       *     to a remote port.
-       *   - Finally, if the connection is bound to a remote IP address,
-       *     the source IP address of the packet is checked. Broadcast
-       *     addresses are also accepted.
-       *
-       * If all of the above are true then the newly received UDP packet
-       * is destined for this UDP connection.
-       *
-       * To send and receive multicast packets, the application should:
-       *
-       *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
-       *     or to a specific <multicast-address>
-       *   - setsockopt to SO_BROADCAST (for all-nodes address)
-       *
-       * For connection-less UDP sockets:
-       *
-       *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
-       *   - call recvfrom.
-       *
-       * For connection-mode UDP sockets:
-       *
-       *   - call connect() to connect the UDP socket to a specific remote
-       *     address, then
-       *   - Call send() with no address address information
-       *   - call recv() (from address information should not be needed)
-       *
-       * REVISIT: SO_BROADCAST flag is currently ignored.
-       */
+  /* If the local UDP port is non-zero, the connection is considered
+   * to be used. If so, then the following checks are performed:
+   *
+   * 1. The destination address is verified against the bound address
+   *    of the connection.
+   *
+   *   - The local port number is checked against the destination port
+   *     number in the received packet.
+   *   - If multiple network interfaces are supported, then the local
+   *     IP address is available and we will insist that the
+   *     destination IP matches the bound address (or the destination
+   *     IP address is a broadcast address). If a socket is bound to
+   *     INADDRY_ANY (laddr), then it should receive all packets
+   *     directed to the port.
+   *
+   * 2. If this is a connection mode UDP socket, then the source address
+   *    is verified against the connected remote address.
+   *
+   *   - The remote port number is checked if the connection is bound
+   *     to a remote port.
+   *   - Finally, if the connection is bound to a remote IP address,
+   *     the source IP address of the packet is checked. Broadcast
+   *     addresses are also accepted.
+   *
+   * If all of the above are true then the newly received UDP packet
+   * is destined for this UDP connection.
+   *
+   * To send and receive multicast packets, the application should:
+   *
+   *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
+   *     or to a specific <multicast-address>
+   *   - setsockopt to SO_BROADCAST (for all-nodes address)
+   *
+   * For connection-less UDP sockets:
+   *
+   *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
+   *   - call recvfrom.
+   *
+   * For connection-mode UDP sockets:
+   *
+   *   - call connect() to connect the UDP socket to a specific remote
+   *     address, then
+   *   - Call send() with no address address information
+   *   - call recv() (from address information should not be needed)
+   *
+   * REVISIT: SO_BROADCAST flag is currently ignored.
+   */
 
-      /* Check that there is a local port number and this matches
-       * the port number in the destination address.
-       */
+  /* Check that there is a local port number and this matches
+   * the port number in the destination address.
+   */
 
-      if (conn->lport != 0 && udp->destport == conn->lport &&
+  if (conn->lport != 0 && udp->destport == conn->lport &&
 
-          /* Local port accepts any address on this port or there
-           * is an exact match in destipaddr and the bound local
-           * address.  This catches the receipt of a broadcast when
-           * the socket is bound to INADDR_ANY.
-           */
+      /* Local port accepts any address on this port or there
+       * is an exact match in destipaddr and the bound local
+       * address.  This catches the receipt of a broadcast when
+       * the socket is bound to INADDR_ANY.
+       */
 
-          (net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY) ||
-           net_ipv4addr_hdrcmp(ip->destipaddr, &conn->u.ipv4.laddr)))
+      (net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY) ||
+       net_ipv4addr_hdrcmp(ip->destipaddr, &conn->u.ipv4.laddr)))
+    {
+      /* Check if the socket is connection mode.  In this case, only
+       * packets with source addresses from the connected remote peer
+       * will be accepted.
+       */
+
+      if (_UDP_ISCONNECTMODE(conn->flags))
         {
-          /* Check if the socket is connection mode.  In this case, only
-           * packets with source addresses from the connected remote peer
-           * will be accepted.
+          /* Check if the UDP connection is either (1) accepting packets
+           * from any port or (2) the packet srcport matches the local
+           * bound port number.
            */
 
-          if (_UDP_ISCONNECTMODE(conn->flags))
-            {
-              /* Check if the UDP connection is either (1) accepting packets
-               * from any port or (2) the packet srcport matches the local
-               * bound port number.
-               */
-
-              if ((conn->rport == 0 || udp->srcport == conn->rport) &&
+          return (conn->rport == 0 || udp->srcport == conn->rport) &&
 
-              /* If (1) not connected to a remote address, or (2) a
-               * broadcast destipaddr was received, or (3) there is an
-               * exact match between the srcipaddr and the bound remote IP
-               * address, then accept the packet.
-               */
+          /* If (1) not connected to a remote address, or (2) a
+           * broadcast destipaddr was received, or (3) there is an
+           * exact match between the srcipaddr and the bound remote IP
+           * address, then accept the packet.
+           */
 
-                  (net_ipv4addr_cmp(conn->u.ipv4.raddr, INADDR_ANY) ||
+                 (net_ipv4addr_cmp(conn->u.ipv4.raddr, INADDR_ANY) ||
 #ifdef CONFIG_NET_BROADCAST
-                   net_ipv4addr_hdrcmp(ip->destipaddr, &bcast) ||
+                  net_ipv4addr_hdrcmp(ip->destipaddr, &bcast) ||
 #endif
-                   net_ipv4addr_hdrcmp(ip->srcipaddr, &conn->u.ipv4.raddr)))
-                {
-                  /* Matching connection found.. Break out of the loop and
-                   * return this reference to it.
-                   */
-
-                  break;
-                }
-            }
-          else
-            {
-              /* This UDP socket is not connected.  We need to match only
-               * the destination address with the bound socket address.
-               * Break out out of the loop and return this reference to
-               * the matching connection structure.
-               */
-
-              break;
-            }
+                  net_ipv4addr_hdrcmp(ip->srcipaddr, &conn->u.ipv4.raddr));
         }
 
-      /* Look at the next active connection */
+      /* This UDP socket is not connected.  We need to match only
+       * the destination address with the bound socket address.
+       */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+      return true;
     }
 
-  return conn;
+  return false;
 }
 #endif /* CONFIG_NET_IPv4 */
 
 /****************************************************************************
- * Name: udp_ipv6_active
+ * Name: udp_ipv6_match
  *
  * Description:
- *   Find a connection structure that is the appropriate connection to be
- *   used within the provided UDP header
+ *   Check if a connection is the appropriate connection to be used within
+ *   the provided UDP header.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -327,132 +400,188 @@ static inline FAR struct udp_conn_s *
  ****************************************************************************/
 
 #ifdef CONFIG_NET_IPv6
-static inline FAR struct udp_conn_s *
-  udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_hdr_s *udp)
+static inline bool udp_ipv6_match(FAR struct udp_conn_s *conn,
+                                  FAR struct ipv6_hdr_s *ip,
+                                  FAR struct udp_hdr_s *udp)
 {
-  FAR struct ipv6_hdr_s *ip = IPv6BUF;
-  FAR struct udp_conn_s *conn;
+  /* If the local UDP port is non-zero, the connection is considered
+   * to be used. If so, then the following checks are performed:
+   *
+   * 1. The destination address is verified against the bound address
+   *    of the connection.
+   *
+   *    - The local port number is checked against the destination port
+   *      number in the received packet.
+   *    - If multiple network interfaces are supported, then the local
+   *      IP address is available and we will insist that the
+   *      destination IP matches the bound address. If a socket is bound
+   *      to INADDR6_ANY (laddr), then it should receive all packets
+   *      directed to the port. REVISIT: Should also depend on
+   *      SO_BROADCAST.
+   *
+   * 2. If this is a connection mode UDP socket, then the source address
+   *    is verified against the connected remote address.
+   *
+   *    - The remote port number is checked if the connection is bound
+   *      to a remote port.
+   *    - Finally, if the connection is bound to a remote IP address,
+   *      the source IP address of the packet is checked.
+   *
+   * If all of the above are true then the newly received UDP packet
+   * is destined for this UDP connection.
+   *
+   * To send and receive multicast packets, the application should:
+   *
+   *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
+   *     or to a specific <multicast-address>
+   *   - setsockopt to SO_BROADCAST (for all-nodes address)
+   *
+   * For connection-less UDP sockets:
+   *
+   *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
+   *   - call recvfrom.
+   *
+   * For connection-mode UDP sockets:
+   *
+   *   - call connect() to connect the UDP socket to a specific remote
+   *     address, then
+   *   - Call send() with no address address information
+   *   - call recv() (from address information should not be needed)
+   *
+   * REVISIT: SO_BROADCAST flag is currently ignored.
+   */
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
-  while (conn != NULL)
-    {
-      /* If the local UDP port is non-zero, the connection is considered
-       * to be used. If so, then the following checks are performed:
-       *
-       * 1. The destination address is verified against the bound address
-       *    of the connection.
-       *
-       *    - The local port number is checked against the destination port
-       *      number in the received packet.
-       *    - If multiple network interfaces are supported, then the local
-       *      IP address is available and we will insist that the
-       *      destination IP matches the bound address. If a socket is bound
-       *      to INADDR6_ANY (laddr), then it should receive all packets
-       *      directed to the port. REVISIT: Should also depend on
-       *      SO_BROADCAST.
-       *
-       * 2. If this is a connection mode UDP socket, then the source address
-       *    is verified against the connected remote address.
-       *
-       *    - The remote port number is checked if the connection is bound
-       *      to a remote port.
-       *    - Finally, if the connection is bound to a remote IP address,
-       *      the source IP address of the packet is checked.
-       *
-       * If all of the above are true then the newly received UDP packet
-       * is destined for this UDP connection.
-       *
-       * To send and receive multicast packets, the application should:
-       *
-       *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
-       *     or to a specific <multicast-address>
-       *   - setsockopt to SO_BROADCAST (for all-nodes address)
-       *
-       * For connection-less UDP sockets:
-       *
-       *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
-       *   - call recvfrom.
-       *
-       * For connection-mode UDP sockets:
-       *
-       *   - call connect() to connect the UDP socket to a specific remote
-       *     address, then
-       *   - Call send() with no address address information
-       *   - call recv() (from address information should not be needed)
-       *
-       * REVISIT: SO_BROADCAST flag is currently ignored.
-       */
+  /* Check that there is a local port number and this matches
+   * the port number in the destination address.
+   */
 
-      /* Check that there is a local port number and this matches
-       * the port number in the destination address.
-       */
+  if ((conn->lport != 0 && udp->destport == conn->lport &&
 
-      if ((conn->lport != 0 && udp->destport == conn->lport &&
+      /* Check if the local port accepts any address on this port or
+       * that there is an exact match between the destipaddr and the
+       * bound local address.  This catches the case of the all nodes
+       * multicast when the socket is bound to the IPv6 unspecified
+       * address.
+       */
 
-          /* Check if the local port accepts any address on this port or
-           * that there is an exact match between the destipaddr and the
-           * bound local address.  This catches the case of the all nodes
-           * multicast when the socket is bound to the IPv6 unspecified
-           * address.
-           */
+      (net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr) ||
+       net_ipv6addr_hdrcmp(ip->destipaddr, conn->u.ipv6.laddr))))
+    {
+      /* Check if the socket is connection mode.  In this case, only
+       * packets with source addresses from the connected remote peer
+       * will be accepted.
+       */
 
-          (net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr) ||
-           net_ipv6addr_hdrcmp(ip->destipaddr, conn->u.ipv6.laddr))))
+      if (_UDP_ISCONNECTMODE(conn->flags))
         {
-          /* Check if the socket is connection mode.  In this case, only
-           * packets with source addresses from the connected remote peer
-           * will be accepted.
+          /* Check if the UDP connection is either (1) accepting packets
+           * from any port or (2) the packet srcport matches the local
+           * bound port number.
            */
 
-          if (_UDP_ISCONNECTMODE(conn->flags))
-            {
-              /* Check if the UDP connection is either (1) accepting packets
-               * from any port or (2) the packet srcport matches the local
-               * bound port number.
-               */
+          return (conn->rport == 0 || udp->srcport == conn->rport) &&
 
-              if ((conn->rport == 0 || udp->srcport == conn->rport) &&
-
-              /* If (1) not connected to a remote address, or (2) a all-
-               * nodes multicast destipaddr was received, or (3) there is an
-               * exact match between the srcipaddr and the bound remote IP
-               * address, then accept the packet.
-               */
+          /* If (1) not connected to a remote address, or (2) a all-
+           * nodes multicast destipaddr was received, or (3) there is an
+           * exact match between the srcipaddr and the bound remote IP
+           * address, then accept the packet.
+           */
 
-                  (net_ipv6addr_cmp(conn->u.ipv6.raddr, g_ipv6_unspecaddr) ||
+                 (net_ipv6addr_cmp(conn->u.ipv6.raddr, g_ipv6_unspecaddr) ||
 #ifdef CONFIG_NET_BROADCAST
-                   net_ipv6addr_hdrcmp(ip->destipaddr, g_ipv6_allnodes) ||
+                  net_ipv6addr_hdrcmp(ip->destipaddr, g_ipv6_allnodes) ||
 #endif
-                   net_ipv6addr_hdrcmp(ip->srcipaddr, conn->u.ipv6.raddr)))
-                {
-                  /* Matching connection found.. Break out of the loop and
-                   * return this reference to it.
-                   */
-
-                  break;
-                }
-            }
-          else
-            {
-              /* This UDP socket is not connected.  We need to match only
-               * the destination address with the bound socket address.
-               * Break out out of the loop and return this reference to
-               * the matching connection structure.
-               */
-
-              break;
-            }
+                  net_ipv6addr_hdrcmp(ip->srcipaddr, conn->u.ipv6.raddr));
         }
 
-      /* Look at the next active connection */
+      /* This UDP socket is not connected.  We need to match only
+       * the destination address with the bound socket address.
+       */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+      return true;
     }
 
-  return conn;
+  return false;
+}
+#endif /* CONFIG_NET_IPv6 */
+
+/****************************************************************************
+ * Name: udp_match
+ *
+ * Description:
+ *   Check if a connection is the appropriate connection to be used within
+ *   the UDP packet in the device buffer.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+static bool udp_match(FAR struct net_driver_s *dev,
+                      FAR struct udp_conn_s *conn,
+                      FAR struct udp_hdr_s *udp)
+{
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      return udp_ipv6_match(conn, IPv6BUF, udp);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      return udp_ipv4_match(conn, IPv4BUF, udp);
+    }
+#endif /* CONFIG_NET_IPv4 */
 }
+
+/****************************************************************************
+ * Name: udp_flow_hash
+ *
+ * Description:
+ *   Return the flow hash of the UDP packet in the device buffer, computed
+ *   from its source address and source port.
+ *
+ ****************************************************************************/
+
+static uint32_t udp_flow_hash(FAR struct net_driver_s *dev,
+                              FAR struct udp_hdr_s *udp)
+{
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      FAR struct ipv6_hdr_s *ip = IPv6BUF;
+      FAR const uint16_t *srcipaddr = ip->srcipaddr;
+      uint32_t key;
+
+      key = ((uint32_t)(srcipaddr[0] ^ srcipaddr[2] ^
+                        srcipaddr[4] ^ srcipaddr[6]) << 16) |
+            (srcipaddr[1] ^ srcipaddr[3] ^ srcipaddr[5] ^ srcipaddr[7]);
+
+      return udp_flow_mix(key, udp->srcport);
+    }
 #endif /* CONFIG_NET_IPv6 */
 
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ip = IPv4BUF;
+
+      return udp_flow_mix(net_ip4addr_conv32(ip->srcipaddr),
+                          udp->srcport);
+    }
+#endif /* CONFIG_NET_IPv4 */
+}
+
 /****************************************************************************
  * Name: udp_alloc_conn
  *
@@ -465,6 +594,20 @@ static inline FAR struct udp_conn_s *
 FAR struct udp_conn_s *udp_alloc_conn(void)
 {
   FAR struct udp_conn_s *conn;
+#ifdef CONFIG_MM_SLAB
+  /* Connections are taken from and returned to the slab cache.  Slab
+   * objects are not zeroed, so clear the connection here as udp_free()
+   * does for connections on the free list.
+   */
+
+  conn = (FAR struct udp_conn_s *)slab_alloc(g_udp_slab);
+  if (conn != NULL)
+    {
+      memset(conn, 0, sizeof(*conn));
+    }
+
+  return conn;
+#else
   int i;
 
   /* Return the entry from the head of the free list */
@@ -490,6 +633,7 @@ FAR struct udp_conn_s *udp_alloc_conn(void)
     }
 
   return (FAR struct udp_conn_s *)dq_remfirst(&g_free_udp_connections);
+#endif
 }
 #endif
 
@@ -555,7 +699,7 @@ uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u)
           g_last_udp_port = 4096;
         }
     }
-  while (udp_find_conn(domain, u, HTONS(g_last_udp_port)) != NULL);
+  while (udp_find_conn(domain, u, HTONS(g_last_udp_port), false) != NULL);
 
   /* Initialize and return the connection structure, bind it to the
    * port number
@@ -588,6 +732,10 @@ void udp_initialize(void)
       g_udp_connections[i].lport = 0;
       dq_addlast(&g_udp_connections[i].sconn.node, &g_free_udp_connections);
     }
+#elif defined(CONFIG_MM_SLAB)
+  g_udp_slab = slab_create("udp_conn", sizeof(struct udp_conn_s), 0,
+                           NULL, NULL);
+  DEBUGASSERT(g_udp_slab != NULL);
 #endif
 }
 
@@ -604,9 +752,11 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
 {
   FAR struct udp_conn_s *conn;
 
-  /* The free list is protected by a semaphore (that behaves like a mutex). */
+  /* The free list is protected by a lock of its own, so that sockets can be
+   * created without the network lock.
+   */
 
-  _udp_semtake(&g_free_sem);
+  netlock_take(&g_udp_lock);
 #ifndef CONFIG_NET_ALLOC_CONNS
   conn = (FAR struct udp_conn_s *)dq_remfirst(&g_free_udp_connections);
 #else
@@ -645,7 +795,7 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
       dq_addlast(&conn->sconn.node, &g_active_udp_connections);
     }
 
-  _udp_semgive(&g_free_sem);
+  netlock_give(&g_udp_lock);
   return conn;
 }
 
@@ -664,11 +814,16 @@ void udp_free(FAR struct udp_conn_s *conn)
   FAR struct udp_wrbuffer_s *wrbuffer;
 #endif
 
-  /* The free list is protected by a semaphore (that behaves like a mutex). */
+  /* The free list is protected by g_udp_lock.  The hash table and the
+   * active list are also used by udp_active() from the network stack, so
+   * the network must be locked as well, and always before g_udp_lock.
+   */
 
   DEBUGASSERT(conn->crefs == 0);
 
-  _udp_semtake(&g_free_sem);
+  net_lock();
+  netlock_take(&g_udp_lock);
+  udp_hash_remove(conn);
   conn->lport = 0;
 
   /* Remove the connection from the active list */
@@ -702,8 +857,13 @@ void udp_free(FAR struct udp_conn_s *conn)
 
   /* Free the connection */
 
+#if defined(CONFIG_NET_ALLOC_CONNS) && defined(CONFIG_MM_SLAB)
+  slab_free(g_udp_slab, conn);
+#else
   dq_addlast(&conn->sconn.node, &g_free_udp_connections);
-  _udp_semgive(&g_free_sem);
+#endif
+  netlock_give(&g_udp_lock);
+  net_unlock();
 }
 
 /****************************************************************************
@@ -711,7 +871,9 @@ void udp_free(FAR struct udp_conn_s *conn)
  *
  * Description:
  *   Find a connection structure that is the appropriate
- *   connection to be used within the provided UDP header
+ *   connection to be used within the provided UDP header.  If several
+ *   sockets share the destination port with SO_REUSEPORT, one of them is
+ *   selected by the flow hash of the datagram.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -721,23 +883,99 @@ void udp_free(FAR struct udp_conn_s *conn)
 FAR struct udp_conn_s *udp_active(FAR struct net_driver_s *dev,
                                   FAR struct udp_hdr_s *udp)
 {
-#ifdef CONFIG_NET_IPv6
-#ifdef CONFIG_NET_IPv4
-  if (IFF_IS_IPv6(dev->d_flags))
-#endif
+  FAR struct udp_conn_s *conn;
+  FAR struct udp_conn_s *first = NULL;
+  unsigned int nreuse = 0;
+  unsigned int select;
+
+  /* Only the connections in the hash bucket of the destination port can
+   * match.
+   */
+
+  for (conn = g_udp_port_hash[udp_port_hash(udp->destport)];
+       conn != NULL;
+       conn = conn->pnext)
     {
-      return udp_ipv6_active(dev, udp);
+      if (!udp_match(dev, conn, udp))
+        {
+          continue;
+        }
+
+      /* A connected socket is the most specific match */
+
+      if (_UDP_ISCONNECTMODE(conn->flags))
+        {
+          return conn;
+        }
+
+      if (first == NULL)
+        {
+          first = conn;
+        }
+
+      if (UDP_REUSEPORT(conn))
+        {
+          nreuse++;
+        }
     }
-#endif /* CONFIG_NET_IPv6 */
 
-#ifdef CONFIG_NET_IPv4
-#ifdef CONFIG_NET_IPv6
-  else
-#endif
+  if (nreuse < 2)
     {
-      return udp_ipv4_active(dev, udp);
+      return first;
     }
-#endif /* CONFIG_NET_IPv4 */
+
+  /* Several sockets share the port with SO_REUSEPORT.  Distribute the
+   * datagrams among them by the flow hash so that all datagrams of one
+   * flow are received by the same socket.
+   */
+
+  select = udp_flow_hash(dev, udp) % nreuse;
+
+  for (conn = g_udp_port_hash[udp_port_hash(udp->destport)];
+       conn != NULL;
+       conn = conn->pnext)
+    {
+      if (UDP_REUSEPORT(conn) &&
+          udp_match(dev, conn, udp) && select-- == 0)
+        {
+          break;
+        }
+    }
+
+  return conn;
+}
+
+/****************************************************************************
+ * Name: udp_bindport
+ *
+ * Description:
+ *   Assign the local port number of a connection and index the connection
+ *   by that port number.
+ *
+ * Input Parameters:
+ *   conn   - The UDP connection of interest
+ *   portno - The local port number (network order).  Zero unbinds the
+ *            connection from its port.
+ *
+ ****************************************************************************/
+
+void udp_bindport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+  unsigned int ndx;
+
+  net_lock();
+
+  udp_hash_remove(conn);
+  conn->lport = portno;
+
+  if (portno != 0)
+    {
+      ndx                   = udp_port_hash(portno);
+      conn->pnext           = g_udp_port_hash[ndx];
+      g_udp_port_hash[ndx]  = conn;
+    }
+
+  net_unlock();
 }
 
 /****************************************************************************
@@ -829,8 +1067,8 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     {
       /* Yes.. Select any unused local port number */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
-      ret         = OK;
+      udp_bindport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
+      ret = OK;
     }
   else
     {
@@ -839,14 +1077,15 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
       net_lock();
 
       /* Is any other UDP connection already bound to this address
-       * and port ?
+       * and port?  Sockets that all have SO_REUSEPORT set may share it.
        */
 
-      if (udp_find_conn(conn->domain, &conn->u, portno) == NULL)
+      if (udp_find_conn(conn->domain, &conn->u, portno,
+                        UDP_REUSEPORT(conn)) == NULL)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
+          udp_bindport(conn, portno);
           ret         = OK;
         }
       else
@@ -899,7 +1138,7 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_bindport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
     }
 
   /* Is there a remote port (rport)? */
@@ -294,7 +294,7 @@ static int sendto_next_transfer(FAR struct udp_conn_s *conn)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_bindport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
     }
 
   /* Get the device that will handle the remote packet transfers.  This
@@ -482,6 +482,20 @@ static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
 
       devif_iob_send(dev, wrb->wb_iob, sndlen, 0);
 
+#ifdef CONFIG_NETDEV_IOB_SG
+      /* If the device took the I/O buffer chain without copying it, hand
+       * the chain over to the device so that it survives the release of
+       * the write buffer below.
+       */
+
+      if (dev->d_iob == wrb->wb_iob)
+        {
+          dev->d_iobuser = IOBUSER_NET_UDP_WRITEBUFFER;
+          dev->d_iobsum  = wrb->wb_chksum;
+          wrb->wb_iob    = NULL;
+        }
+#endif
+
       /* Free the write buffer at the head of the queue and attempt to
        * setup the next transfer.
        */
@@ -758,13 +772,22 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
         }
 
       /* Copy the user data into the write buffer.  We cannot wait for
-       * buffer space if the socket was opened non-blocking.
+       * buffer space if the socket was opened non-blocking.  If the device
+       * may send the data straight from the write buffer, the checksum of
+       * the data is calculated while it is copied.
        */
 
       if (nonblock)
         {
+#ifdef CONFIG_NETDEV_IOB_SG
+          wrb->wb_chksum = 0;
+          ret = chksum_iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf, len,
+                                  false, false, IOBUSER_NET_SOCK_UDP,
+                                  &wrb->wb_chksum);
+#else
           ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf, len, 0, false,
                               IOBUSER_NET_SOCK_UDP);
+#endif
         }
       else
         {
@@ -777,8 +800,15 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
            */
 
           blresult = net_breaklock(&count);
+#ifdef CONFIG_NETDEV_IOB_SG
+          wrb->wb_chksum = 0;
+          ret = chksum_iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf, len,
+                                  false, true, IOBUSER_NET_SOCK_UDP,
+                                  &wrb->wb_chksum);
+#else
           ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf, len, 0, false,
                            IOBUSER_NET_SOCK_UDP);
+#endif
           if (blresult >= 0)
             {
               net_restorelock(count);
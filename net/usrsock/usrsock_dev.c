@@ -296,7 +296,7 @@ static void usrsockdev_pollnotify(FAR struct usrsockdev_s *dev,
           if (fds->revents != 0)
             {
               ninfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
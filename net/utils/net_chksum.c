@@ -25,8 +25,90 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+
 #include "utils/utils.h"
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Used to sum a single byte as one half of a 16-bit word in host order */
+
+union chksum_edge_u
+{
+  uint8_t  b[2];
+  uint16_t h;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: chksum_add
+ *
+ * Description:
+ *   One's complement addition of two 16-bit values.
+ *
+ ****************************************************************************/
+
+static inline uint16_t chksum_add(uint16_t sum, uint16_t t)
+{
+  sum += t;
+  if (sum < t)
+    {
+      sum++; /* carry */
+    }
+
+  return sum;
+}
+
+/****************************************************************************
+ * Name: chksum_finish
+ *
+ * Description:
+ *   Fold a 64-bit accumulator of 16-bit words in host byte order to 16 bits
+ *   and add it to a raw checksum in host byte order.
+ *
+ * Input Parameters:
+ *   sum - The raw checksum to add to
+ *   acc - The accumulated words
+ *   odd - True if the words were summed starting at an odd address, so
+ *         that the bytes of the folded sum are swapped.
+ *
+ ****************************************************************************/
+
+static inline uint16_t chksum_finish(uint16_t sum, uint64_t acc, bool odd)
+{
+  uint16_t t;
+
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+
+  t = (uint16_t)acc;
+  if (odd)
+    {
+      t = (uint16_t)((t << 8) | (t >> 8));
+    }
+
+  /* The one's complement sum does not depend on the byte order in which
+   * it was accumulated.  Return it in host byte order.
+   */
+
+  return chksum_add(sum, NTOHS(t));
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -53,42 +135,386 @@
 #ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  FAR const uint32_t *words;
+  union chksum_edge_u edge;
+  uint64_t acc = 0;
+  bool odd;
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  /* A leading byte at an odd address is summed as the odd half of a
+   * 16-bit word.  The result is then swapped back at the end.
+   */
 
-  while (dataptr < last_byte)
+  odd = ((uintptr_t)data & 1) != 0;
+  if (odd && len > 0)
     {
-      /* At least two more bytes */
+      edge.b[0] = 0;
+      edge.b[1] = *data++;
+      acc       = edge.h;
+      len--;
+    }
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+  /* Align the data to a 32-bit boundary */
+
+  if (((uintptr_t)data & 2) != 0 && len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  /* Accumulate 32-bit words into the 64-bit sum, 16 bytes per iteration.
+   * The carries are folded back only once at the end.
+   */
+
+  words = (FAR const uint32_t *)data;
+  while (len >= 16)
+    {
+      acc += words[0];
+      acc += words[1];
+      acc += words[2];
+      acc += words[3];
+      words += 4;
+      len   -= 16;
+    }
+
+  while (len >= 4)
+    {
+      acc += *words++;
+      len -= 4;
+    }
+
+  data = (FAR const uint8_t *)words;
+  if (len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  /* A trailing odd byte is padded with zero */
+
+  if (len > 0)
+    {
+      edge.b[0] = *data;
+      edge.b[1] = 0;
+      acc      += edge.h;
+    }
+
+  return chksum_finish(sum, acc, odd);
+}
+#endif /* CONFIG_NET_ARCH_CHKSUM */
+
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy len bytes from src to dest and calculate the raw checksum of the
+ *   data in the same pass, so that the data is only read once.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call to
+ *          chksum().  This should be zero on the first time that check
+ *          sum is called.
+ *   dest - Destination of the copy
+ *   src  - Beginning of the data to copy and include in the checksum.
+ *   len  - Length of the data to copy and include in the checksum.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_ARCH_CHKSUM_COPY
+uint16_t chksum_copy(uint16_t sum, FAR uint8_t *dest,
+                     FAR const uint8_t *src, uint16_t len)
+{
+  FAR const uint32_t *sw;
+  FAR uint32_t *dw;
+  union chksum_edge_u edge;
+  uint64_t acc = 0;
+  bool odd;
+
+  /* The word loop needs the source and the destination to be equally
+   * aligned.  Otherwise copy first and sum the destination while it is
+   * still in the cache.
+   */
 
-      dataptr += 2;
+  if ((((uintptr_t)dest ^ (uintptr_t)src) & 3) != 0)
+    {
+      memcpy(dest, src, len);
+      return chksum(sum, dest, len);
     }
 
-  if (dataptr == last_byte)
+  odd = ((uintptr_t)src & 1) != 0;
+  if (odd && len > 0)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
+      edge.b[0] = 0;
+      edge.b[1] = *src;
+      acc       = edge.h;
+      *dest++   = *src++;
+      len--;
+    }
+
+  if (((uintptr_t)src & 2) != 0 && len >= 2)
+    {
+      uint16_t h = *(FAR const uint16_t *)src;
+
+      *(FAR uint16_t *)dest = h;
+      acc  += h;
+      src  += 2;
+      dest += 2;
+      len  -= 2;
+    }
+
+  sw = (FAR const uint32_t *)src;
+  dw = (FAR uint32_t *)dest;
+  while (len >= 16)
+    {
+      uint32_t w0 = sw[0];
+      uint32_t w1 = sw[1];
+      uint32_t w2 = sw[2];
+      uint32_t w3 = sw[3];
+
+      dw[0] = w0;
+      dw[1] = w1;
+      dw[2] = w2;
+      dw[3] = w3;
+      acc  += w0;
+      acc  += w1;
+      acc  += w2;
+      acc  += w3;
+      sw   += 4;
+      dw   += 4;
+      len  -= 16;
+    }
+
+  while (len >= 4)
+    {
+      uint32_t w = *sw++;
+
+      *dw++ = w;
+      acc  += w;
+      len  -= 4;
+    }
+
+  src  = (FAR const uint8_t *)sw;
+  dest = (FAR uint8_t *)dw;
+  if (len >= 2)
+    {
+      uint16_t h = *(FAR const uint16_t *)src;
+
+      *(FAR uint16_t *)dest = h;
+      acc  += h;
+      src  += 2;
+      dest += 2;
+      len  -= 2;
+    }
+
+  if (len > 0)
+    {
+      edge.b[0] = *src;
+      edge.b[1] = 0;
+      acc      += edge.h;
+      *dest     = *src;
+    }
+
+  return chksum_finish(sum, acc, odd);
+}
+#endif /* CONFIG_NET_ARCH_CHKSUM_COPY */
+
+/****************************************************************************
+ * Name: chksum_iob
+ *
+ * Description:
+ *   Continue the raw checksum calculation over len bytes of an I/O buffer
+ *   chain, starting at offset.  The I/O buffers may hold an odd number of
+ *   bytes.
+ *
+ * Input Parameters:
+ *   sum    - Partial calculations carried over from a previous call to
+ *            chksum().  The data summed before must be of even length.
+ *   iob    - The I/O buffer chain
+ *   offset - Offset of the data to include in the checksum
+ *   len    - Length of the data to include in the checksum.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_SG
+uint16_t chksum_iob(uint16_t sum, FAR struct iob_s *iob,
+                    unsigned int offset, unsigned int len)
+{
+  FAR const uint8_t *data;
+  unsigned int seglen;
+  uint8_t pair[2];
+  bool odd = false;
+
+  /* Skip to the I/O buffer containing the start of the data */
+
+  while (iob != NULL && offset >= iob->io_len)
+    {
+      offset -= iob->io_len;
+      iob     = iob->io_flink;
+    }
+
+  while (iob != NULL && len > 0)
+    {
+      data   = &iob->io_data[iob->io_offset + offset];
+      seglen = iob->io_len - offset;
+      if (seglen > len)
+        {
+          seglen = len;
+        }
+
+      len -= seglen;
+
+      /* Complete the 16-bit word left open by the previous I/O buffer.
+       * An empty I/O buffer has no byte to complete it with.
+       */
+
+      if (odd && seglen > 0)
+        {
+          pair[1] = *data++;
+          sum     = chksum(sum, pair, 2);
+          odd     = false;
+          seglen--;
+        }
+
+      /* Sum the even part of this I/O buffer and keep any odd byte for the
+       * next one.
+       */
+
+      sum = chksum(sum, data, seglen & ~1);
+      if ((seglen & 1) != 0)
         {
-          sum++; /* carry */
+          pair[0] = data[seglen - 1];
+          odd     = true;
         }
+
+      offset = 0;
+      iob    = iob->io_flink;
     }
 
-  /* Return sum in host byte order. */
+  /* A trailing odd byte is padded with zero, just as chksum() does */
+
+  if (odd)
+    {
+      sum = chksum(sum, pair, 1);
+    }
 
   return sum;
 }
-#endif /* CONFIG_NET_ARCH_CHKSUM */
+#endif /* CONFIG_NETDEV_IOB_SG */
+
+/****************************************************************************
+ * Name: chksum_iob_copyin
+ *
+ * Description:
+ *   Append len bytes from a user buffer to the end of an I/O buffer chain,
+ *   extending the chain as necessary, and continue the raw checksum of the
+ *   data in the chain while it is copied.  This is equivalent to
+ *   iob_copyin() at the offset io_pktlen followed by chksum_iob(), but
+ *   reads the user data only once.
+ *
+ * Input Parameters:
+ *   iob        - The I/O buffer chain to append to
+ *   src        - The user data to append
+ *   len        - The length of the user data
+ *   throttled  - An indication of the IOB allocation is "throttled"
+ *   can_block  - True if allowed to wait for I/O buffers
+ *   consumerid - ID representing who is consuming the IOB
+ *   sum        - The raw checksum of the data already in the chain.  This
+ *                is updated to include the new data.
+ *
+ * Returned Value:
+ *   The number of bytes copied on success, or a negated errno value on
+ *   failure.  On failure, the chain holds the part of the data that was
+ *   copied before the failure and *sum is undefined.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_IOB
+int chksum_iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
+                      unsigned int len, bool throttled, bool can_block,
+                      enum iob_user_e consumerid, FAR uint16_t *sum)
+{
+  FAR struct iob_s *head = iob;
+  FAR struct iob_s *next;
+  unsigned int total = len;
+  unsigned int ncopy;
+  uint16_t t;
+
+  DEBUGASSERT(iob != NULL && src != NULL && sum != NULL);
+
+  /* Skip to the last I/O buffer in the chain */
+
+  while (iob->io_flink != NULL)
+    {
+      iob = iob->io_flink;
+    }
+
+  while (len > 0)
+    {
+      /* Fill the free space at the end of this I/O buffer */
+
+      ncopy = IOB_FREESPACE(iob);
+      if (ncopy > len)
+        {
+          ncopy = len;
+        }
+
+      if (ncopy > 0)
+        {
+          t = chksum_copy(0, &iob->io_data[iob->io_offset + iob->io_len],
+                          src, ncopy);
+
+          /* Data that starts at an odd offset of the packet forms the
+           * opposite halves of the 16-bit words of the checksum.
+           */
+
+          if ((head->io_pktlen & 1) != 0)
+            {
+              t = (uint16_t)((t << 8) | (t >> 8));
+            }
+
+          *sum             = chksum_add(*sum, t);
+          iob->io_len     += ncopy;
+          head->io_pktlen += ncopy;
+          src             += ncopy;
+          len             -= ncopy;
+        }
+
+      if (len > 0)
+        {
+          /* Add a new buffer, as large as the rest of the data needs if
+           * possible.
+           */
+
+          if (can_block)
+            {
+              next = iob_alloc_size(throttled, len, consumerid);
+            }
+          else
+            {
+              next = iob_tryalloc_size(throttled, len, consumerid);
+            }
+
+          if (next == NULL)
+            {
+              nerr("ERROR: Failed to allocate I/O buffer\n");
+              return -ENOMEM;
+            }
+
+          iob->io_flink = next;
+          iob           = next;
+        }
+    }
+
+  return total;
+}
+#endif /* CONFIG_MM_IOB */
 
 /****************************************************************************
  * Name: net_chksum
@@ -98,9 +98,42 @@ uint16_t ipv4_upperlayer_chksum(FAR struct net_driver_s *dev, uint8_t proto)
 
   sum = chksum(sum, (FAR uint8_t *)&ipv4->srcipaddr, 2 * sizeof(in_addr_t));
 
-  /* Sum IP payload data. */
+  /* Sum IP payload data.  The application data may be held in an I/O
+   * buffer chain rather than in d_buf.
+   */
+
+#ifdef CONFIG_NETDEV_IOB_SG
+  if (dev->d_iob != NULL && dev->d_ioblen <= upperlen)
+    {
+      sum = chksum(sum, &dev->d_buf[iphdrlen + NET_LL_HDRLEN(dev)],
+                   upperlen - dev->d_ioblen);
+
+      /* The payload checksum may have been calculated when the data was
+       * copied into the I/O buffer chain.
+       */
+
+      if (dev->d_iobsum >= 0)
+        {
+          uint16_t t = (uint16_t)dev->d_iobsum;
+
+          sum += t;
+          if (sum < t)
+            {
+              sum++; /* carry */
+            }
+        }
+      else
+        {
+          sum = chksum_iob(sum, dev->d_iob, dev->d_iobofs, dev->d_ioblen);
+        }
+    }
+  else
+#endif
+    {
+      sum = chksum(sum, &dev->d_buf[iphdrlen + NET_LL_HDRLEN(dev)],
+                   upperlen);
+    }
 
-  sum = chksum(sum, &dev->d_buf[iphdrlen + NET_LL_HDRLEN(dev)], upperlen);
   return (sum == 0) ? 0xffff : HTONS(sum);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
@@ -165,9 +198,41 @@ uint16_t ipv6_upperlayer_chksum(FAR struct net_driver_s *dev,
   sum = chksum(sum, (FAR uint8_t *)&ipv6->srcipaddr,
                2 * sizeof(net_ipv6addr_t));
 
-  /* Sum IP payload data. */
+  /* Sum IP payload data.  The application data may be held in an I/O
+   * buffer chain rather than in d_buf.
+   */
+
+#ifdef CONFIG_NETDEV_IOB_SG
+  if (dev->d_iob != NULL && dev->d_ioblen <= upperlen)
+    {
+      sum = chksum(sum, &dev->d_buf[NET_LL_HDRLEN(dev) + iplen],
+                   upperlen - dev->d_ioblen);
+
+      /* The payload checksum may have been calculated when the data was
+       * copied into the I/O buffer chain.
+       */
+
+      if (dev->d_iobsum >= 0)
+        {
+          uint16_t t = (uint16_t)dev->d_iobsum;
+
+          sum += t;
+          if (sum < t)
+            {
+              sum++; /* carry */
+            }
+        }
+      else
+        {
+          sum = chksum_iob(sum, dev->d_iob, dev->d_iobofs, dev->d_ioblen);
+        }
+    }
+  else
+#endif
+    {
+      sum = chksum(sum, &dev->d_buf[NET_LL_HDRLEN(dev) + iplen], upperlen);
+    }
 
-  sum = chksum(sum, &dev->d_buf[NET_LL_HDRLEN(dev) + iplen], upperlen);
   return (sum == 0) ? 0xffff : HTONS(sum);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
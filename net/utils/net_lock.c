@@ -32,10 +32,12 @@
 #include <time.h>
 
 #include <nuttx/irq.h>
+#include <nuttx/arch.h>
 #include <nuttx/clock.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/net.h>
+#include <nuttx/net/netstats.h>
 
 #include "utils/utils.h"
 
@@ -46,103 +48,100 @@
 #define NO_HOLDER (pid_t)-1
 
 /****************************************************************************
- * Private Data
+ * Public Data
  ****************************************************************************/
 
-static sem_t        g_netlock = SEM_INITIALIZER(1);
-static pid_t        g_holder  = NO_HOLDER;
-static unsigned int g_count;
+/* The global network lock */
+
+struct netlock_s g_netlock = NETLOCK_INITIALIZER;
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_STATISTICS
 /****************************************************************************
- * Name: _net_takesem
+ * Name: netlock_gettime and netlock_elapsed
  *
  * Description:
- *   Take the semaphore, waiting indefinitely.
- *   REVISIT: Should this return if -EINTR?
+ *   Measure the time spent waiting for a lock, in microseconds.  The
+ *   architecture's performance counter is used if it provides one,
+ *   otherwise the wait can only be measured in whole clock ticks.
  *
  ****************************************************************************/
 
-static int _net_takesem(void)
+static inline uint32_t netlock_gettime(void)
 {
-  return nxsem_wait_uninterruptible(&g_netlock);
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+  return up_perf_gettime();
+#else
+  return (uint32_t)clock_systime_ticks();
+#endif
 }
 
-/****************************************************************************
- * Name: _net_timedwait
- ****************************************************************************/
-
-static int
-_net_timedwait(sem_t *sem, bool interruptible, unsigned int timeout)
+static uint32_t netlock_elapsed(uint32_t start)
 {
-  unsigned int count;
-  irqstate_t   flags;
-  int          blresult;
-  int          ret;
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+  struct timespec ts;
 
-  flags = enter_critical_section(); /* No interrupts */
-  sched_lock();                     /* No context switches */
+  up_perf_convert(up_perf_gettime() - start, &ts);
+  return ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+#else
+  return TICK2USEC((uint32_t)clock_systime_ticks() - start);
+#endif
+}
+#endif
 
-  /* Release the network lock, remembering my count.  net_breaklock will
-   * return a negated value if the caller does not hold the network lock.
-   */
+/****************************************************************************
+ * Name: netlock_takesem
+ *
+ * Description:
+ *   Take the semaphore of a lock, waiting indefinitely.  If network
+ *   statistics are enabled, the acquisition is counted and the time spent
+ *   waiting for a contended lock is accumulated in the lock's statistics.
+ *   REVISIT: Should this return if -EINTR?
+ *
+ ****************************************************************************/
 
-  blresult = net_breaklock(&count);
+static int netlock_takesem(FAR struct netlock_s *lock)
+{
+#ifdef CONFIG_NET_STATISTICS
+  uint32_t start;
+  uint32_t elapsed;
+  int ret;
 
-  /* Now take the semaphore, waiting if so requested. */
+  /* Try the uncontended case first */
 
-  if (timeout != UINT_MAX)
+  ret = nxsem_trywait(&lock->nl_sem);
+  if (ret >= 0)
     {
-      struct timespec abstime;
-
-      DEBUGVERIFY(clock_gettime(CLOCK_REALTIME, &abstime));
-
-      abstime.tv_sec  += timeout / MSEC_PER_SEC;
-      abstime.tv_nsec += timeout % MSEC_PER_SEC * NSEC_PER_MSEC;
-      if (abstime.tv_nsec >= NSEC_PER_SEC)
-        {
-          abstime.tv_sec++;
-          abstime.tv_nsec -= NSEC_PER_SEC;
-        }
+      lock->nl_stats.acquired++;
+      return ret;
+    }
 
-      /* Wait until we get the lock or until the timeout expires */
+  /* The lock is held by another thread.  Wait for it and measure how long
+   * we waited.  The statistics are updated only once we hold the lock.
+   */
 
-      if (interruptible)
-        {
-          ret = nxsem_timedwait(sem, &abstime);
-        }
-      else
-        {
-          ret = nxsem_timedwait_uninterruptible(sem, &abstime);
-        }
-    }
-  else
+  start = netlock_gettime();
+  ret   = nxsem_wait_uninterruptible(&lock->nl_sem);
+  if (ret >= 0)
     {
-      /* Wait as long as necessary to get the lock */
+      elapsed = netlock_elapsed(start);
 
-      if (interruptible)
+      lock->nl_stats.acquired++;
+      lock->nl_stats.contended++;
+      lock->nl_stats.waitus += elapsed;
+      if (elapsed > lock->nl_stats.maxwait)
         {
-          ret = nxsem_wait(sem);
+          lock->nl_stats.maxwait = elapsed;
         }
-      else
-        {
-          ret = nxsem_wait_uninterruptible(sem);
-        }
-    }
-
-  /* Recover the network lock at the proper count (if we held it before) */
-
-  if (blresult >= 0)
-    {
-      net_restorelock(count);
     }
 
-  sched_unlock();
-  leave_critical_section(flags);
   return ret;
+#else
+  return nxsem_wait_uninterruptible(&lock->nl_sem);
+#endif
 }
 
 /****************************************************************************
@@ -150,13 +149,14 @@ _net_timedwait(sem_t *sem, bool interruptible, unsigned int timeout)
  ****************************************************************************/
 
 /****************************************************************************
- * Name: net_lock
+ * Name: netlock_take
  *
  * Description:
- *   Take the network lock
+ *   Take a network lock, waiting if it is held by another thread.  The lock
+ *   is re-entrant.
  *
  * Input Parameters:
- *   None
+ *   lock - The network lock to take
  *
  * Returned Value:
  *   Zero (OK) is returned on success; a negated errno value is returned on
@@ -164,30 +164,30 @@ _net_timedwait(sem_t *sem, bool interruptible, unsigned int timeout)
  *
  ****************************************************************************/
 
-int net_lock(void)
+int netlock_take(FAR struct netlock_s *lock)
 {
   pid_t me = getpid();
   int ret = OK;
 
   /* Does this thread already hold the semaphore? */
 
-  if (g_holder == me)
+  if (lock->nl_holder == me)
     {
       /* Yes.. just increment the reference count */
 
-      g_count++;
+      lock->nl_count++;
     }
   else
     {
       /* No.. take the semaphore (perhaps waiting) */
 
-      ret = _net_takesem();
+      ret = netlock_takesem(lock);
       if (ret >= 0)
         {
           /* Now this thread holds the semaphore */
 
-          g_holder = me;
-          g_count  = 1;
+          lock->nl_holder = me;
+          lock->nl_count  = 1;
         }
     }
 
@@ -195,15 +195,13 @@ int net_lock(void)
 }
 
 /****************************************************************************
- * Name: net_trylock
+ * Name: netlock_trytake
  *
  * Description:
- *   Try to take the network lock only when it is currently not locked.
- *   Otherwise, it locks the semaphore.  In either
- *   case, the call returns without blocking.
+ *   Take a network lock only if that is possible without waiting.
  *
  * Input Parameters:
- *   None
+ *   lock - The network lock to take
  *
  * Returned Value:
  *   Zero (OK) is returned on success; a negated errno value is returned on
@@ -211,28 +209,31 @@ int net_lock(void)
  *
  ****************************************************************************/
 
-int net_trylock(void)
+int netlock_trytake(FAR struct netlock_s *lock)
 {
   pid_t me = getpid();
   int ret = OK;
 
   /* Does this thread already hold the semaphore? */
 
-  if (g_holder == me)
+  if (lock->nl_holder == me)
     {
       /* Yes.. just increment the reference count */
 
-      g_count++;
+      lock->nl_count++;
     }
   else
     {
-      ret = nxsem_trywait(&g_netlock);
+      ret = nxsem_trywait(&lock->nl_sem);
       if (ret >= 0)
         {
           /* Now this thread holds the semaphore */
 
-          g_holder = me;
-          g_count  = 1;
+          lock->nl_holder = me;
+          lock->nl_count  = 1;
+#ifdef CONFIG_NET_STATISTICS
+          lock->nl_stats.acquired++;
+#endif
         }
     }
 
@@ -240,51 +241,59 @@ int net_trylock(void)
 }
 
 /****************************************************************************
- * Name: net_unlock
+ * Name: netlock_give
  *
  * Description:
- *   Release the network lock.
+ *   Release a network lock taken by netlock_take() or netlock_trytake().
  *
  * Input Parameters:
- *   None
+ *   lock - The network lock to release
  *
  * Returned Value:
  *   None
  *
  ****************************************************************************/
 
-void net_unlock(void)
+void netlock_give(FAR struct netlock_s *lock)
 {
-  DEBUGASSERT(g_holder == getpid() && g_count > 0);
+  DEBUGASSERT(lock->nl_holder == getpid() && lock->nl_count > 0);
 
   /* If the count would go to zero, then release the semaphore */
 
-  if (g_count == 1)
+  if (lock->nl_count == 1)
     {
       /* We no longer hold the semaphore */
 
-      g_holder = NO_HOLDER;
-      g_count  = 0;
-      nxsem_post(&g_netlock);
+      lock->nl_holder = NO_HOLDER;
+      lock->nl_count  = 0;
+      nxsem_post(&lock->nl_sem);
     }
   else
     {
       /* We still hold the semaphore. Just decrement the count */
 
-      g_count--;
+      lock->nl_count--;
     }
 }
 
 /****************************************************************************
- * Name: net_breaklock
+ * Name: netlock_break
  *
  * Description:
- *   Break the lock, return information needed to restore re-entrant lock
- *   state.
+ *   Break a network lock, return information needed to restore re-entrant
+ *   lock state.
+ *
+ * Input Parameters:
+ *   lock  - The network lock to break
+ *   count - Location to return the number of times the lock was taken
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -EPERM is returned if the caller
+ *   does not hold the lock.
  *
  ****************************************************************************/
 
-int net_breaklock(FAR unsigned int *count)
+int netlock_break(FAR struct netlock_s *lock, FAR unsigned int *count)
 {
   irqstate_t flags;
   pid_t me = getpid();
@@ -293,19 +302,19 @@ int net_breaklock(FAR unsigned int *count)
   DEBUGASSERT(count != NULL);
 
   flags = enter_critical_section(); /* No interrupts */
-  if (g_holder == me)
+  if (lock->nl_holder == me)
     {
       /* Return the lock setting */
 
-      *count   = g_count;
+      *count          = lock->nl_count;
 
-      /* Release the network lock  */
+      /* Release the lock  */
 
-      g_holder = NO_HOLDER;
-      g_count  = 0;
+      lock->nl_holder = NO_HOLDER;
+      lock->nl_count  = 0;
 
-      nxsem_post(&g_netlock);
-      ret      = OK;
+      nxsem_post(&lock->nl_sem);
+      ret             = OK;
     }
 
   leave_critical_section(flags);
@@ -313,10 +322,14 @@ int net_breaklock(FAR unsigned int *count)
 }
 
 /****************************************************************************
- * Name: net_restorelock
+ * Name: netlock_restore
  *
  * Description:
- *   Restore the locked state
+ *   Restore the locked state of a network lock broken by netlock_break().
+ *
+ * Input Parameters:
+ *   lock  - The network lock to restore
+ *   count - The count returned by netlock_break()
  *
  * Returned Value:
  *   Zero (OK) is returned on success; a negated errno value is returned on
@@ -324,25 +337,175 @@ int net_breaklock(FAR unsigned int *count)
  *
  ****************************************************************************/
 
-int net_restorelock(unsigned int count)
+int netlock_restore(FAR struct netlock_s *lock, unsigned int count)
 {
   pid_t me = getpid();
   int ret;
 
-  DEBUGASSERT(g_holder != me);
+  DEBUGASSERT(lock->nl_holder != me);
 
-  /* Recover the network lock at the proper count */
+  /* Recover the lock at the proper count */
 
-  ret = _net_takesem();
+  ret = netlock_takesem(lock);
   if (ret >= 0)
     {
-      g_holder = me;
-      g_count  = count;
+      lock->nl_holder = me;
+      lock->nl_count  = count;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: netlock_timedwait
+ *
+ * Description:
+ *   Atomically wait for sem (or a timeout) while temporarily releasing
+ *   a network lock.  See net_timedwait().
+ *
+ * Input Parameters:
+ *   lock          - The network lock to release while waiting
+ *   sem           - A reference to the semaphore to be taken.
+ *   interruptible - True if the wait may be interrupted by a signal
+ *   timeout       - The relative time to wait until a timeout is declared.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int netlock_timedwait(FAR struct netlock_s *lock, FAR sem_t *sem,
+                      bool interruptible, unsigned int timeout)
+{
+  unsigned int count;
+  irqstate_t   flags;
+  int          blresult;
+  int          ret;
+
+  flags = enter_critical_section(); /* No interrupts */
+  sched_lock();                     /* No context switches */
+
+  /* Release the lock, remembering my count.  netlock_break will return a
+   * negated value if the caller does not hold the lock.
+   */
+
+  blresult = netlock_break(lock, &count);
+
+  /* Now take the semaphore, waiting if so requested. */
+
+  if (timeout != UINT_MAX)
+    {
+      struct timespec abstime;
+
+      DEBUGVERIFY(clock_gettime(CLOCK_REALTIME, &abstime));
+
+      abstime.tv_sec  += timeout / MSEC_PER_SEC;
+      abstime.tv_nsec += timeout % MSEC_PER_SEC * NSEC_PER_MSEC;
+      if (abstime.tv_nsec >= NSEC_PER_SEC)
+        {
+          abstime.tv_sec++;
+          abstime.tv_nsec -= NSEC_PER_SEC;
+        }
+
+      /* Wait until we get the lock or until the timeout expires */
+
+      if (interruptible)
+        {
+          ret = nxsem_timedwait(sem, &abstime);
+        }
+      else
+        {
+          ret = nxsem_timedwait_uninterruptible(sem, &abstime);
+        }
+    }
+  else
+    {
+      /* Wait as long as necessary to get the lock */
+
+      if (interruptible)
+        {
+          ret = nxsem_wait(sem);
+        }
+      else
+        {
+          ret = nxsem_wait_uninterruptible(sem);
+        }
+    }
+
+  /* Recover the lock at the proper count (if we held it before) */
+
+  if (blresult >= 0)
+    {
+      netlock_restore(lock, count);
     }
 
+  sched_unlock();
+  leave_critical_section(flags);
   return ret;
 }
 
+/****************************************************************************
+ * Name: net_lock
+ *
+ * Description:
+ *   Take the network lock
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failured (probably -ECANCELED).
+ *
+ ****************************************************************************/
+
+int net_lock(void)
+{
+  return netlock_take(&g_netlock);
+}
+
+/****************************************************************************
+ * Name: net_trylock
+ *
+ * Description:
+ *   Try to take the network lock only when it is currently not locked.
+ *   Otherwise, it locks the semaphore.  In either
+ *   case, the call returns without blocking.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failured (probably -EAGAIN).
+ *
+ ****************************************************************************/
+
+int net_trylock(void)
+{
+  return netlock_trytake(&g_netlock);
+}
+
+/****************************************************************************
+ * Name: net_unlock
+ *
+ * Description:
+ *   Release the network lock.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void net_unlock(void)
+{
+  netlock_give(&g_netlock);
+}
+
 /****************************************************************************
  * Name: net_timedwait
  *
@@ -367,7 +530,7 @@ int net_restorelock(unsigned int count)
 
 int net_timedwait(sem_t *sem, unsigned int timeout)
 {
-  return _net_timedwait(sem, true, timeout);
+  return netlock_timedwait(&g_netlock, sem, true, timeout);
 }
 
 /****************************************************************************
@@ -414,7 +577,7 @@ int net_lockedwait(sem_t *sem)
 
 int net_timedwait_uninterruptible(sem_t *sem, unsigned int timeout)
 {
-  return _net_timedwait(sem, false, timeout);
+  return netlock_timedwait(&g_netlock, sem, false, timeout);
 }
 
 /****************************************************************************
@@ -26,13 +26,50 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+
+#include <sys/types.h>
+
+#include <nuttx/semaphore.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
+#include <nuttx/net/netstats.h>
+
+#ifdef CONFIG_MM_IOB
+#  include <nuttx/mm/iob.h>
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Initializer for a statically allocated network lock */
+
+#define NETLOCK_INITIALIZER {SEM_INITIALIZER(1), (pid_t)-1, 0}
 
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+/* A re-entrant network lock.  The global network lock taken by net_lock()
+ * protects the network devices and every protocol that exchanges packets
+ * with them.  Protocols that never touch a network device, such as local
+ * sockets, are protected by a lock of their own so that they do not
+ * contend with network traffic.  So are the free lists of TCP and UDP
+ * connections, so that sockets can be created while packets are being
+ * processed.  Such a lock is always taken after the global network lock,
+ * never before it.
+ */
+
+struct netlock_s
+{
+  sem_t        nl_sem;     /* Implements the lock */
+  pid_t        nl_holder;  /* Thread that holds the lock */
+  unsigned int nl_count;   /* Number of times nl_holder took the lock */
+#ifdef CONFIG_NET_STATISTICS
+  struct netlock_stats_s nl_stats; /* Contention statistics */
+#endif
+};
+
 /* These values control the behavior of net_timeval2desc */
 
 enum tv2ds_remainder_e
@@ -54,6 +91,10 @@ extern "C"
 #define EXTERN extern
 #endif
 
+/* The global network lock */
+
+EXTERN struct netlock_s g_netlock;
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -61,6 +102,116 @@ extern "C"
 struct net_driver_s;      /* Forward reference */
 struct timeval;           /* Forward reference */
 
+/****************************************************************************
+ * Name: netlock_take
+ *
+ * Description:
+ *   Take a network lock, waiting if it is held by another thread.  The lock
+ *   is re-entrant.
+ *
+ * Input Parameters:
+ *   lock - The network lock to take
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failured (probably -ECANCELED).
+ *
+ ****************************************************************************/
+
+int netlock_take(FAR struct netlock_s *lock);
+
+/****************************************************************************
+ * Name: netlock_trytake
+ *
+ * Description:
+ *   Take a network lock only if that is possible without waiting.
+ *
+ * Input Parameters:
+ *   lock - The network lock to take
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failured (probably -EAGAIN).
+ *
+ ****************************************************************************/
+
+int netlock_trytake(FAR struct netlock_s *lock);
+
+/****************************************************************************
+ * Name: netlock_give
+ *
+ * Description:
+ *   Release a network lock taken by netlock_take() or netlock_trytake().
+ *
+ * Input Parameters:
+ *   lock - The network lock to release
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void netlock_give(FAR struct netlock_s *lock);
+
+/****************************************************************************
+ * Name: netlock_break
+ *
+ * Description:
+ *   Break a network lock, return information needed to restore re-entrant
+ *   lock state.
+ *
+ * Input Parameters:
+ *   lock  - The network lock to break
+ *   count - Location to return the number of times the lock was taken
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -EPERM is returned if the caller
+ *   does not hold the lock.
+ *
+ ****************************************************************************/
+
+int netlock_break(FAR struct netlock_s *lock, FAR unsigned int *count);
+
+/****************************************************************************
+ * Name: netlock_restore
+ *
+ * Description:
+ *   Restore the locked state of a network lock broken by netlock_break().
+ *
+ * Input Parameters:
+ *   lock  - The network lock to restore
+ *   count - The count returned by netlock_break()
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failured (probably -ECANCELED).
+ *
+ ****************************************************************************/
+
+int netlock_restore(FAR struct netlock_s *lock, unsigned int count);
+
+/****************************************************************************
+ * Name: netlock_timedwait
+ *
+ * Description:
+ *   Atomically wait for sem (or a timeout) while temporarily releasing
+ *   a network lock.  See net_timedwait().
+ *
+ * Input Parameters:
+ *   lock          - The network lock to release while waiting
+ *   sem           - A reference to the semaphore to be taken.
+ *   interruptible - True if the wait may be interrupted by a signal
+ *   timeout       - The relative time to wait until a timeout is declared.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int netlock_timedwait(FAR struct netlock_s *lock, FAR sem_t *sem,
+                      bool interruptible, unsigned int timeout);
+
 /****************************************************************************
  * Name: net_breaklock
  *
@@ -70,7 +221,7 @@ struct timeval;           /* Forward reference */
  *
  ****************************************************************************/
 
-int net_breaklock(FAR unsigned int *count);
+#define net_breaklock(count) netlock_break(&g_netlock, count)
 
 /****************************************************************************
  * Name: net_restorelock
@@ -84,7 +235,7 @@ int net_breaklock(FAR unsigned int *count);
  *
  ****************************************************************************/
 
-int net_restorelock(unsigned int count);
+#define net_restorelock(count) netlock_restore(&g_netlock, count)
 
 /****************************************************************************
  * Name: net_dsec2timeval
@@ -211,6 +362,88 @@ void net_ipv6_pref2mask(uint8_t preflen, net_ipv6addr_t mask);
 
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
 
+/****************************************************************************
+ * Name: chksum_iob
+ *
+ * Description:
+ *   Continue the raw checksum calculation over len bytes of an I/O buffer
+ *   chain, starting at offset.  The I/O buffers may hold an odd number of
+ *   bytes.
+ *
+ * Input Parameters:
+ *   sum    - Partial calculations carried over from a previous call to
+ *            chksum().  The data summed before must be of even length.
+ *   iob    - The I/O buffer chain
+ *   offset - Offset of the data to include in the checksum
+ *   len    - Length of the data to include in the checksum.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_SG
+struct iob_s;
+uint16_t chksum_iob(uint16_t sum, FAR struct iob_s *iob,
+                    unsigned int offset, unsigned int len);
+#endif
+
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy len bytes from src to dest and calculate the raw checksum of the
+ *   data in the same pass.
+ *
+ *   If CONFIG_NET_ARCH_CHKSUM_COPY is defined, then this function must be
+ *   provided by architecture-specific logic.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call to
+ *          chksum().  This should be zero on the first time that check
+ *          sum is called.
+ *   dest - Destination of the copy
+ *   src  - Beginning of the data to copy and include in the checksum.
+ *   len  - Length of the data to copy and include in the checksum.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+uint16_t chksum_copy(uint16_t sum, FAR uint8_t *dest,
+                     FAR const uint8_t *src, uint16_t len);
+
+/****************************************************************************
+ * Name: chksum_iob_copyin
+ *
+ * Description:
+ *   Append len bytes from a user buffer to the end of an I/O buffer chain,
+ *   extending the chain as necessary, and continue the raw checksum of the
+ *   data in the chain while it is copied.
+ *
+ * Input Parameters:
+ *   iob        - The I/O buffer chain to append to
+ *   src        - The user data to append
+ *   len        - The length of the user data
+ *   throttled  - An indication of the IOB allocation is "throttled"
+ *   can_block  - True if allowed to wait for I/O buffers
+ *   consumerid - ID representing who is consuming the IOB
+ *   sum        - The raw checksum of the data already in the chain.  This
+ *                is updated to include the new data.
+ *
+ * Returned Value:
+ *   The number of bytes copied on success, or a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_IOB
+int chksum_iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
+                      unsigned int len, bool throttled, bool can_block,
+                      enum iob_user_e consumerid, FAR uint16_t *sum);
+#endif
+
 /****************************************************************************
  * Name: net_chksum
  *
@@ -433,7 +433,7 @@ void nx_start(void)
 #else
       tasklist = TLIST_HEAD(TSTATE_TASK_RUNNING);
 #endif
-      dq_addfirst((FAR dq_entry_t *)&g_idletcb[i], tasklist);
+      nxsched_rq_addfirst(&g_idletcb[i].cmn, tasklist);
 
       /* Mark the idle task as the running task */
 
@@ -377,6 +377,9 @@ try_again_in_irq:
               /* Note that we have entered the critical section */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
+#  if CONFIG_SCHED_CRITMONITOR_SITES > 0
+              rtcb->crit_caller = return_address(0);
+#  endif
               nxsched_critmon_csection(rtcb, true);
 #endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION_CSECTION
@@ -420,6 +423,9 @@ irqstate_t enter_critical_section(void)
           /* Note that we have entered the critical section */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
+#  if CONFIG_SCHED_CRITMONITOR_SITES > 0
+          rtcb->crit_caller = return_address(0);
+#  endif
           nxsched_critmon_csection(rtcb, true);
 #endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION_CSECTION
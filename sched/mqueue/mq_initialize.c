@@ -26,6 +26,7 @@
 
 #include <stdint.h>
 #include <queue.h>
+#include <assert.h>
 #include <nuttx/kmalloc.h>
 
 #include "mqueue/mqueue.h"
@@ -34,6 +35,20 @@
  * Public Data
  ****************************************************************************/
 
+#ifdef CONFIG_MM_SLAB
+/* The g_msgcache is the slab cache of messages that are available for
+ * general use.
+ */
+
+SLAB_HANDLE g_msgcache;
+
+/* The g_msgcacheirq is the slab cache of messages that are reserved for
+ * use by interrupt handlers.
+ */
+
+SLAB_HANDLE g_msgcacheirq;
+
+#else
 /* The g_msgfree is a list of messages that are available for general
  * use.  The number of messages in this list is a system configuration
  * item.
@@ -47,6 +62,10 @@ sq_queue_t  g_msgfree;
 
 sq_queue_t  g_msgfreeirq;
 
+/* This spinlock protects both of the message free lists */
+
+spinlock_t  g_msgfreelock;
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -62,11 +81,29 @@ static struct mqueue_msg_s  *g_msgalloc;
  */
 
 static struct mqueue_msg_s  *g_msgfreeirqalloc;
+#endif
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_MM_SLAB
+/****************************************************************************
+ * Name: mq_msgctor
+ *
+ * Description:
+ *   Slab constructor:  Mark a new message with the type of its cache.
+ *
+ ****************************************************************************/
+
+static void mq_msgctor(FAR void *obj, FAR void *arg)
+{
+  FAR struct mqueue_msg_s *mqmsg = (FAR struct mqueue_msg_s *)obj;
+
+  mqmsg->type = (uint8_t)(uintptr_t)arg;
+}
+#else
+
 /****************************************************************************
  * Name: mq_msgblockalloc
  *
@@ -105,6 +142,7 @@ mq_msgblockalloc(FAR sq_queue_t *queue, uint16_t nmsgs,
 
   return mqmsgblock;
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -128,6 +166,23 @@ mq_msgblockalloc(FAR sq_queue_t *queue, uint16_t nmsgs,
 
 void nxmq_initialize(void)
 {
+#ifdef CONFIG_MM_SLAB
+  /* Create the message cache for general use */
+
+  g_msgcache =
+    slab_create("mq_msg", sizeof(struct mqueue_msg_s),
+                CONFIG_PREALLOC_MQ_MSGS, mq_msgctor,
+                (FAR void *)(uintptr_t)MQ_ALLOC_FIXED);
+  DEBUGASSERT(g_msgcache != NULL);
+
+  /* Create the message cache for use exclusively by interrupt handlers */
+
+  g_msgcacheirq =
+    slab_create("mq_msgirq", sizeof(struct mqueue_msg_s),
+                CONFIG_PREALLOC_MQ_IRQ_MSGS, mq_msgctor,
+                (FAR void *)(uintptr_t)MQ_ALLOC_IRQ);
+  DEBUGASSERT(g_msgcacheirq != NULL);
+#else
   /* Initialize the message free lists */
 
   sq_init(&g_msgfree);
@@ -146,4 +201,5 @@ void nxmq_initialize(void)
   g_msgfreeirqalloc =
     mq_msgblockalloc(&g_msgfreeirq, CONFIG_PREALLOC_MQ_IRQ_MSGS,
                      MQ_ALLOC_IRQ);
+#endif
 }
@@ -55,6 +55,24 @@
 
 void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
 {
+#ifdef CONFIG_MM_SLAB
+  /* Return the message to the slab cache it came from.  The slab
+   * allocator protects itself from concurrent interrupt handlers.
+   */
+
+  if (mqmsg->type == MQ_ALLOC_FIXED)
+    {
+      slab_free(g_msgcache, mqmsg);
+    }
+  else if (mqmsg->type == MQ_ALLOC_IRQ)
+    {
+      slab_free(g_msgcacheirq, mqmsg);
+    }
+  else
+    {
+      DEBUGPANIC();
+    }
+#else
   irqstate_t flags;
 
   /* If this is a generally available pre-allocated message,
@@ -67,9 +85,9 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
        * list from interrupt handlers.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave(&g_msgfreelock);
       sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfree);
-      leave_critical_section(flags);
+      spin_unlock_irqrestore(&g_msgfreelock, flags);
     }
 
   /* If this is a message pre-allocated for interrupts,
@@ -82,9 +100,9 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
        * list from interrupt handlers.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave(&g_msgfreelock);
       sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfreeirq);
-      leave_critical_section(flags);
+      spin_unlock_irqrestore(&g_msgfreelock, flags);
     }
 
   /* Otherwise, deallocate it.  Note:  interrupt handlers
@@ -100,4 +118,5 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
     {
       DEBUGPANIC();
     }
+#endif
 }
@@ -35,11 +35,55 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/cancelpt.h>
 
 #include "sched/sched.h"
 #include "mqueue/mqueue.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_remove_msg
+ *
+ * Description:
+ *   Remove the message at the head of a message queue.  Only the spinlock
+ *   of the message queue is held while the queue is modified.
+ *
+ * Input Parameters:
+ *   msgq - Message queue descriptor
+ *
+ * Returned Value:
+ *   The message removed or NULL if the message queue is empty.
+ *
+ ****************************************************************************/
+
+static FAR struct mqueue_msg_s *
+nxmq_remove_msg(FAR struct mqueue_inode_s *msgq)
+{
+  FAR struct mqueue_msg_s *msg;
+  irqstate_t flags;
+  bool wasfull = false;
+
+  flags = spin_lock_irqsave(&msgq->lock);
+  msg = (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->msglist);
+  if (msg != NULL)
+    {
+      wasfull = msgq->nmsgs-- == msgq->maxmsgs;
+    }
+
+  spin_unlock_irqrestore(&msgq->lock, flags);
+
+  if (wasfull)
+    {
+      nxmq_pollnotify(msgq, POLLOUT);
+    }
+
+  return msg;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -147,8 +191,7 @@ int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
 
   /* Get the message from the head of the queue */
 
-  while ((newmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->msglist))
-          == NULL)
+  while ((newmsg = nxmq_remove_msg(msgq)) == NULL)
     {
       /* The queue is empty!  Should we block until there the above condition
        * has been satisfied?
@@ -197,18 +240,6 @@ int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
         }
     }
 
-  /* If we got message, then decrement the number of messages in
-   * the queue while we are still in the critical section
-   */
-
-  if (newmsg)
-    {
-      if (msgq->nmsgs-- == msgq->maxmsgs)
-        {
-          nxmq_pollnotify(msgq, POLLOUT);
-        }
-    }
-
   *rcvmsg = newmsg;
   return OK;
 }
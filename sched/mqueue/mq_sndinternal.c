@@ -126,6 +126,18 @@ int nxmq_verify_send(FAR struct mqueue_inode_s *msgq, int oflags,
 FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 {
   FAR struct mqueue_msg_s *mqmsg;
+#ifdef CONFIG_MM_SLAB
+  /* Try the general cache first.  It grows on demand, except when called
+   * from an interrupt handler.  Then fall back to the messages reserved
+   * for interrupt handlers.
+   */
+
+  mqmsg = (FAR struct mqueue_msg_s *)slab_alloc(g_msgcache);
+  if (mqmsg == NULL && up_interrupt_context())
+    {
+      mqmsg = (FAR struct mqueue_msg_s *)slab_alloc(g_msgcacheirq);
+    }
+#else
   irqstate_t flags;
 
   /* If we were called from an interrupt handler, then try to get the message
@@ -137,6 +149,7 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
     {
       /* Try the general free list */
 
+      flags = spin_lock_irqsave(&g_msgfreelock);
       mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
       if (mqmsg == NULL)
         {
@@ -144,6 +157,8 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 
           mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfreeirq);
         }
+
+      spin_unlock_irqrestore(&g_msgfreelock, flags);
     }
 
   /* We were not called from an interrupt handler. */
@@ -154,9 +169,9 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
        * Disable interrupts -- we might be called from an interrupt handler.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave(&g_msgfreelock);
       mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
-      leave_critical_section(flags);
+      spin_unlock_irqrestore(&g_msgfreelock, flags);
 
       /* If we cannot a message from the free list, then we will have to
        * allocate one.
@@ -179,6 +194,7 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
             }
         }
     }
+#endif
 
   return mqmsg;
 }
@@ -326,6 +342,7 @@ int nxmq_do_send(FAR struct mqueue_inode_s *msgq,
   FAR struct mqueue_msg_s *next;
   FAR struct mqueue_msg_s *prev;
   irqstate_t flags;
+  int16_t nmsgs;
 
   /* Get a pointer to the message queue */
 
@@ -340,9 +357,12 @@ int nxmq_do_send(FAR struct mqueue_inode_s *msgq,
 
   memcpy((FAR void *)mqmsg->mail, (FAR const void *)msg, msglen);
 
-  /* Insert the new message in the message queue */
+  /* Insert the new message in the message queue.  Only the spinlock of the
+   * message queue is needed for this.  Waiting receivers are awakened
+   * below within the critical section.
+   */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave(&msgq->lock);
 
   /* Search the message list to find the location to insert the new
    * message. Each is list is maintained in ascending priority order.
@@ -366,13 +386,14 @@ int nxmq_do_send(FAR struct mqueue_inode_s *msgq,
 
   /* Increment the count of messages in the queue */
 
-  if (msgq->nmsgs++ == 0)
+  nmsgs = msgq->nmsgs++;
+  spin_unlock_irqrestore(&msgq->lock, flags);
+
+  if (nmsgs == 0)
     {
       nxmq_pollnotify(msgq, POLLIN);
     }
 
-  leave_critical_section(flags);
-
   /* Check if we need to notify any tasks that are attached to the
    * message queue
    */
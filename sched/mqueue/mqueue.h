@@ -36,6 +36,8 @@
 #include <sched.h>
 
 #include <nuttx/mqueue.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/slab.h>
 
 #if defined(CONFIG_MQ_MAXMSGSIZE) && CONFIG_MQ_MAXMSGSIZE > 0
 
@@ -85,6 +87,20 @@ extern "C"
 #define EXTERN extern
 #endif
 
+#ifdef CONFIG_MM_SLAB
+/* The g_msgcache is the slab cache of messages that are available for
+ * general use.  It starts with CONFIG_PREALLOC_MQ_MSGS messages and grows
+ * on demand.
+ */
+
+EXTERN SLAB_HANDLE g_msgcache;
+
+/* The g_msgcacheirq is the slab cache of messages that are reserved for
+ * use by interrupt handlers.  It never grows.
+ */
+
+EXTERN SLAB_HANDLE g_msgcacheirq;
+#else
 /* The g_msgfree is a list of messages that are available for general use.
  * The number of messages in this list is a system configuration item.
  */
@@ -97,6 +113,11 @@ EXTERN sq_queue_t  g_msgfree;
 
 EXTERN sq_queue_t  g_msgfreeirq;
 
+/* This spinlock protects both of the message free lists */
+
+EXTERN spinlock_t  g_msgfreelock;
+#endif
+
 /********************************************************************************
  * Public Function Prototypes
  ********************************************************************************/
@@ -326,6 +326,25 @@ void nxsched_add_blocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void nxsched_remove_blocked(FAR struct tcb_s *btcb);
 int  nxsched_set_priority(FAR struct tcb_s *tcb, int sched_priority);
 
+/* Priority index of the ready-to-run lists */
+
+#ifdef CONFIG_SCHED_READYQUEUE_BITMAP
+bool nxsched_rq_indexed(FAR dq_queue_t *list);
+bool nxsched_rq_add(FAR struct tcb_s *tcb, FAR dq_queue_t *list);
+void nxsched_rq_addfirst(FAR struct tcb_s *tcb, FAR dq_queue_t *list);
+void nxsched_rq_remove(FAR struct tcb_s *tcb, FAR dq_queue_t *list);
+void nxsched_rq_reset(FAR dq_queue_t *list);
+void nxsched_rq_setpriority(FAR struct tcb_s *tcb, uint8_t sched_priority);
+#else
+#  define nxsched_rq_addfirst(tcb,list) \
+     dq_addfirst((FAR dq_entry_t *)(tcb), (list))
+#  define nxsched_rq_remove(tcb,list) \
+     dq_rem((FAR dq_entry_t *)(tcb), (list))
+#  define nxsched_rq_reset(list)
+#  define nxsched_rq_setpriority(tcb,sched_priority) \
+     ((tcb)->sched_priority = (uint8_t)(sched_priority))
+#endif
+
 /* Priority inheritance support */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
@@ -380,6 +399,11 @@ int  nxsched_pause_cpu(FAR struct tcb_s *tcb);
 #  define nxsched_islocked_global() spin_islocked(&g_cpu_schedlock)
 #  define nxsched_islocked_tcb(tcb) nxsched_islocked_global()
 
+#ifdef CONFIG_SMP_LOAD_BALANCE
+FAR struct tcb_s *nxsched_steal_task(int cpu, uint8_t sched_priority);
+unsigned int nxsched_process_balance(uint32_t ticks, bool noswitches);
+#endif
+
 #else
 #  define nxsched_select_cpu(a)     (0)
 #  define nxsched_pause_cpu(t)      (-38)  /* -ENOSYS */
@@ -72,6 +72,15 @@ bool nxsched_add_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 
   DEBUGASSERT(sched_priority >= SCHED_PRIORITY_MIN);
 
+#ifdef CONFIG_SCHED_READYQUEUE_BITMAP
+  /* The ready-to-run lists are indexed by priority */
+
+  if (nxsched_rq_indexed((FAR dq_queue_t *)list))
+    {
+      return nxsched_rq_add(tcb, (FAR dq_queue_t *)list);
+    }
+#endif
+
   /* Search the list to find the location to insert the new Tcb.
    * Each is list is maintained in descending sched_priority order.
    */
@@ -200,6 +200,21 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
       cpu = btcb->cpu;
     }
 
+#ifdef CONFIG_SMP_LOAD_BALANCE
+  /* Otherwise, it will wait in the run queue of a CPU.  The CPU that it
+   * last ran on is preferred since its caches may still be warm.  Its
+   * running task has at least the priority of the one on the selected CPU.
+   */
+
+  else
+    {
+      task_state = TSTATE_TASK_ASSIGNED;
+      if ((btcb->affinity & (1 << btcb->cpu)) != 0)
+        {
+          cpu = btcb->cpu;
+        }
+    }
+#else
   /* Otherwise, it will be ready-to-run, but not not yet running */
 
   else
@@ -207,6 +222,7 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
       task_state = TSTATE_TASK_READYTORUN;
       cpu = 0;  /* CPU does not matter */
     }
+#endif
 
   /* If the selected state is TSTATE_TASK_RUNNING, then we would like to
    * start running the task.  Be we cannot do that if pre-emption is
@@ -311,22 +327,26 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
           /* If the following task is not locked to this CPU, then it must
            * be moved to the g_readytorun list.  Since it cannot be at the
            * head of the list, we can do this without invoking any heavy
-           * lifting machinery.
+           * lifting machinery.  With per-CPU run queues, it just stays in
+           * the run queue of this CPU.
            */
 
           DEBUGASSERT(btcb->flink != NULL);
           next = (FAR struct tcb_s *)btcb->flink;
 
+#ifndef CONFIG_SMP_LOAD_BALANCE
           if ((next->flags & TCB_FLAG_CPU_LOCKED) != 0)
+#endif
             {
               DEBUGASSERT(next->cpu == cpu);
               next->task_state = TSTATE_TASK_ASSIGNED;
             }
+#ifndef CONFIG_SMP_LOAD_BALANCE
           else
             {
               /* Remove the task from the assigned task list */
 
-              dq_rem((FAR dq_entry_t *)next, tasklist);
+              nxsched_rq_remove(next, tasklist);
 
               /* Add the task to the g_readytorun or to the g_pendingtasks
                * list.  NOTE: That the above operations may cause the
@@ -347,6 +367,7 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
 
               nxsched_add_prioritized(next, tasklist);
             }
+#endif
 
           doswitch = true;
         }
@@ -0,0 +1,410 @@
+/****************************************************************************
+ * sched/sched/sched_balance.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SMP_LOAD_BALANCE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if MSEC2TICK(CONFIG_SMP_LOAD_BALANCE_INTERVAL) > 0
+#  define BALANCE_TICKS MSEC2TICK(CONFIG_SMP_LOAD_BALANCE_INTERVAL)
+#else
+#  define BALANCE_TICKS 1
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Number of tasks that each CPU took from the run queue of another CPU and
+ * number of tasks that load balancing moved off the run queue of each CPU.
+ */
+
+uint32_t g_cpu_steals[CONFIG_SMP_NCPUS];
+uint32_t g_cpu_migrations[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Ticks elapsed since the run queues were last balanced */
+
+static uint32_t g_balance_ticks;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_movable
+ *
+ * Description:
+ *   Check if a task waiting in a run queue may be moved to another CPU.
+ *
+ ****************************************************************************/
+
+static inline bool nxsched_movable(FAR struct tcb_s *tcb, int cpu)
+{
+  return (tcb->flags & TCB_FLAG_CPU_LOCKED) == 0 &&
+         (tcb->affinity & (1 << cpu)) != 0;
+}
+
+/****************************************************************************
+ * Name: nxsched_balance_pick
+ *
+ * Description:
+ *   Select the highest priority task in the run queue of CPU src that can
+ *   be moved to the run queue of CPU dst without preempting the task that
+ *   runs there.  If dst is idle, any task that may run on it will do.
+ *
+ ****************************************************************************/
+
+static FAR struct tcb_s *nxsched_balance_pick(int src, int dst, bool idle)
+{
+  FAR struct tcb_s *dtcb = (FAR struct tcb_s *)g_assignedtasks[dst].head;
+  FAR struct tcb_s *tcb;
+
+  /* Skip the running task at the head of the list and stop at the IDLE
+   * task at its tail.
+   */
+
+  for (tcb = ((FAR struct tcb_s *)g_assignedtasks[src].head)->flink;
+       tcb != NULL && tcb->flink != NULL;
+       tcb = tcb->flink)
+    {
+      if (nxsched_movable(tcb, dst) &&
+          (idle || tcb->sched_priority <= dtcb->sched_priority))
+        {
+          return tcb;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: nxsched_balance_load
+ *
+ * Description:
+ *   Get the load of each CPU, which is the number of tasks in its assigned
+ *   task list, not counting its IDLE task.
+ *
+ ****************************************************************************/
+
+static void nxsched_balance_load(FAR int *load)
+{
+  FAR struct tcb_s *tcb;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      load[cpu] = 0;
+
+      for (tcb = (FAR struct tcb_s *)g_assignedtasks[cpu].head;
+           tcb != NULL && tcb->flink != NULL;
+           tcb = tcb->flink)
+        {
+          load[cpu]++;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_balance_uneven
+ *
+ * Description:
+ *   Check if the lengths of any two run queues differ by more than one.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS
+static bool nxsched_balance_uneven(void)
+{
+  int load[CONFIG_SMP_NCPUS];
+  int min;
+  int max;
+  int cpu;
+
+  nxsched_balance_load(load);
+
+  min = load[0];
+  max = load[0];
+
+  for (cpu = 1; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      if (load[cpu] < min)
+        {
+          min = load[cpu];
+        }
+
+      if (load[cpu] > max)
+        {
+          max = load[cpu];
+        }
+    }
+
+  return max - min > 1;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxsched_balance_queues
+ *
+ * Description:
+ *   Move tasks from the longest run queues to the shortest ones until their
+ *   lengths differ by at most one or no task can be moved.  Tasks for idle
+ *   CPUs are put in the g_pendingtasks list so that they are started the
+ *   same way as any other task that becomes ready-to-run.
+ *
+ * Returned Value:
+ *   true if tasks were added to the g_pendingtasks list.
+ *
+ ****************************************************************************/
+
+static bool nxsched_balance_queues(void)
+{
+  FAR struct tcb_s *tcb;
+  int load[CONFIG_SMP_NCPUS];
+  bool pending = false;
+  int src;
+  int dst;
+  int cpu;
+  int n;
+
+  nxsched_balance_load(load);
+
+  for (n = 0; n < CONFIG_SMP_NCPUS; n++)
+    {
+      src = 0;
+      dst = 0;
+
+      for (cpu = 1; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          if (load[cpu] > load[src])
+            {
+              src = cpu;
+            }
+
+          if (load[cpu] < load[dst])
+            {
+              dst = cpu;
+            }
+        }
+
+      if (load[src] - load[dst] < 2)
+        {
+          break;
+        }
+
+      tcb = nxsched_balance_pick(src, dst, load[dst] == 0);
+      if (tcb == NULL)
+        {
+          break;
+        }
+
+      /* The task is behind the running task, so the CPU src does not need
+       * to be paused to remove it.
+       */
+
+      nxsched_rq_remove(tcb, (FAR dq_queue_t *)&g_assignedtasks[src]);
+
+      if (load[dst] == 0)
+        {
+          tcb->task_state = TSTATE_TASK_PENDING;
+          nxsched_add_prioritized(tcb, (FAR dq_queue_t *)&g_pendingtasks);
+          pending = true;
+        }
+      else
+        {
+          tcb->cpu = dst;
+          nxsched_add_prioritized(tcb,
+                                  (FAR dq_queue_t *)&g_assignedtasks[dst]);
+        }
+
+      g_cpu_migrations[src]++;
+      load[src]--;
+      load[dst]++;
+    }
+
+  return pending;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_steal_task
+ *
+ * Description:
+ *   Take the highest priority task from the run queues of the other CPUs
+ *   that may run on this CPU and has a higher priority than the task that
+ *   would otherwise run next.  Only tasks waiting behind the running task
+ *   of a CPU are taken, so the other CPUs do not need to be paused.
+ *
+ * Input Parameters:
+ *   cpu            - The CPU that is looking for work
+ *   sched_priority - The priority of the task that would run next on cpu
+ *
+ * Returned Value:
+ *   The TCB of the task that was removed from the run queue of its CPU or
+ *   NULL if there is no such task.  The caller must add it to the assigned
+ *   task list of cpu.
+ *
+ * Assumptions:
+ *   Called from within a critical section.  Like all other task lists, the
+ *   run queues of the CPUs are protected by the critical section and not by
+ *   locks of their own.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *nxsched_steal_task(int cpu, uint8_t sched_priority)
+{
+  FAR struct tcb_s *stcb = NULL;
+  FAR struct tcb_s *tcb;
+  int victim = 0;
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (i == cpu || g_assignedtasks[i].head == NULL)
+        {
+          continue;
+        }
+
+      /* The list is sorted, so the first movable task is the best one */
+
+      for (tcb = ((FAR struct tcb_s *)g_assignedtasks[i].head)->flink;
+           tcb != NULL && tcb->sched_priority > sched_priority;
+           tcb = tcb->flink)
+        {
+          if (nxsched_movable(tcb, cpu))
+            {
+              if (stcb == NULL || tcb->sched_priority > stcb->sched_priority)
+                {
+                  stcb   = tcb;
+                  victim = i;
+                }
+
+              break;
+            }
+        }
+    }
+
+  if (stcb != NULL)
+    {
+      nxsched_rq_remove(stcb, (FAR dq_queue_t *)&g_assignedtasks[victim]);
+      g_cpu_steals[cpu]++;
+    }
+
+  return stcb;
+}
+
+/****************************************************************************
+ * Name: nxsched_process_balance
+ *
+ * Description:
+ *   Balance the run queues of the CPUs every
+ *   CONFIG_SMP_LOAD_BALANCE_INTERVAL milliseconds.  This is called from the
+ *   timer interrupt handler.
+ *
+ *   In the tickless mode, this is only called when the interval timer
+ *   expires or is reassessed.  The interval timer is then kept running for
+ *   as long as the run queues are uneven, so that a long tickless sleep
+ *   does not postpone balancing.  A task that is queued while the timer is
+ *   programmed for a later event is balanced at that event at the latest;
+ *   until then, it may still be stolen by a CPU whose running task goes
+ *   away.
+ *
+ * Input Parameters:
+ *   ticks - The number of ticks that have elapsed since the last call.
+ *   noswitches - True: Can't do context switches now.
+ *
+ * Returned Value:
+ *   In the tickless mode, the number of ticks until the run queues should
+ *   be balanced again.  Zero if they are even and there is nothing to be
+ *   timed.
+ *
+ ****************************************************************************/
+
+unsigned int nxsched_process_balance(uint32_t ticks, bool noswitches)
+{
+  irqstate_t flags;
+#ifdef CONFIG_SCHED_TICKLESS
+  bool uneven;
+#endif
+
+  g_balance_ticks += ticks;
+  if (g_balance_ticks >= BALANCE_TICKS && !noswitches)
+    {
+      flags = enter_critical_section();
+
+      /* Tasks cannot be started while pre-emption is disabled on any CPU.
+       * In that case, try again at the next timer event.
+       */
+
+      if (!nxsched_islocked_global())
+        {
+          g_balance_ticks = 0;
+
+          if (nxsched_balance_queues())
+            {
+              up_release_pending();
+            }
+        }
+
+      leave_critical_section(flags);
+    }
+
+#ifdef CONFIG_SCHED_TICKLESS
+  flags  = enter_critical_section();
+  uneven = nxsched_balance_uneven();
+  leave_critical_section(flags);
+
+  if (uneven)
+    {
+      return g_balance_ticks < BALANCE_TICKS ?
+             BALANCE_TICKS - g_balance_ticks : 1;
+    }
+#endif
+
+  return 0;
+}
+
+#endif /* CONFIG_SMP_LOAD_BALANCE */
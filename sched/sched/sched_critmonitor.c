@@ -114,6 +114,71 @@ static uint32_t g_crit_start[CONFIG_SMP_NCPUS];
 uint32_t g_premp_max[CONFIG_SMP_NCPUS];
 uint32_t g_crit_max[CONFIG_SMP_NCPUS];
 
+#if CONFIG_SCHED_CRITMONITOR_SITES > 0
+/* Maximum time within critical section for each call site. */
+
+struct critmon_site_s g_crit_sites[CONFIG_SCHED_CRITMONITOR_SITES];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_critmon_site
+ *
+ * Description:
+ *   Account the time that the critical section was held to the place in
+ *   the code that entered it.  If all entries of the table are in use, the
+ *   entry with the shortest maximum time is replaced.
+ *
+ * Assumptions:
+ *   - Called within a critical section.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_CRITMONITOR_SITES > 0
+static void nxsched_critmon_site(FAR void *caller, uint32_t elapsed)
+{
+  FAR struct critmon_site_s *site;
+  FAR struct critmon_site_s *min = &g_crit_sites[0];
+  int i;
+
+  for (i = 0; i < CONFIG_SCHED_CRITMONITOR_SITES; i++)
+    {
+      site = &g_crit_sites[i];
+      if (site->caller == caller)
+        {
+          site->count++;
+          if (elapsed > site->max)
+            {
+              site->max = elapsed;
+            }
+
+          return;
+        }
+
+      if (site->caller == NULL || site->max < min->max)
+        {
+          min = site;
+          if (site->caller == NULL)
+            {
+              break;
+            }
+        }
+    }
+
+  if (min->caller == NULL || elapsed > min->max)
+    {
+      min->caller = caller;
+      min->count  = 1;
+      min->max    = elapsed;
+    }
+}
+#else
+#  define nxsched_critmon_site(caller, elapsed)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -234,6 +299,10 @@ void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state)
           CHECK_CSECTION(tcb->pid, elapsed);
         }
 
+      /* Check for the max elapsed time of the call site */
+
+      nxsched_critmon_site(tcb->crit_caller, elapsed);
+
       /* Check for the global max elapsed time */
 
       if (g_crit_start[cpu] != 0)
@@ -385,6 +454,10 @@ void nxsched_suspend_critmon(FAR struct tcb_s *tcb)
           tcb->crit_max = elapsed;
           CHECK_CSECTION(tcb->pid, elapsed);
         }
+
+      /* Check for the max elapsed time of the call site */
+
+      nxsched_critmon_site(tcb->crit_caller, elapsed);
     }
 }
 
@@ -68,7 +68,7 @@
  *
  ****************************************************************************/
 
-#ifndef CONFIG_SMP
+#if !defined(CONFIG_SMP) && !defined(CONFIG_SCHED_READYQUEUE_BITMAP)
 bool nxsched_merge_pending(void)
 {
   FAR struct tcb_s *ptcb;
@@ -150,7 +150,62 @@ bool nxsched_merge_pending(void)
 
   return ret;
 }
-#endif /* !CONFIG_SMP */
+#endif /* !CONFIG_SMP && !CONFIG_SCHED_READYQUEUE_BITMAP */
+
+/****************************************************************************
+ * Name: nxsched_merge_pending
+ *
+ * Description:
+ *   This function merges the prioritized g_pendingtasks list into the
+ *   prioritized ready-to-run task list.  The ready-to-run list is indexed
+ *   by priority, so each pending task is inserted without a search.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   true if the head of the ready-to-run task list has changed indicating
+ *     a context switch is needed.
+ *
+ * Assumptions:
+ * - The caller has established a critical section before calling this
+ *   function.
+ * - The caller handles the condition that occurs if the head of the
+ *   ready-to-run task list is changed.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_SMP) && defined(CONFIG_SCHED_READYQUEUE_BITMAP)
+bool nxsched_merge_pending(void)
+{
+  FAR struct tcb_s *ptcb;
+  FAR struct tcb_s *rtcb;
+  bool ret = false;
+
+  /* Process every TCB in the g_pendingtasks list */
+
+  while ((ptcb = (FAR struct tcb_s *)
+          dq_remfirst((FAR dq_queue_t *)&g_pendingtasks)) != NULL)
+    {
+      rtcb = this_task();
+
+      if (nxsched_rq_add(ptcb, (FAR dq_queue_t *)&g_readytorun))
+        {
+          /* Special case: ptcb was inserted at the head of the list */
+
+          rtcb->task_state = TSTATE_TASK_READYTORUN;
+          ptcb->task_state = TSTATE_TASK_RUNNING;
+          ret              = true;
+        }
+      else
+        {
+          ptcb->task_state = TSTATE_TASK_READYTORUN;
+        }
+    }
+
+  return ret;
+}
+#endif /* !CONFIG_SMP && CONFIG_SCHED_READYQUEUE_BITMAP */
 
 /****************************************************************************
  * Name: nxsched_merge_pending
@@ -76,6 +76,7 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
    */
 
   dq_move(list1, &clone);
+  nxsched_rq_reset(list1);
 
   /* Get the TCB at the head of list1 */
 
@@ -99,6 +100,22 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
       tmp->task_state = task_state;
     }
 
+#ifdef CONFIG_SCHED_READYQUEUE_BITMAP
+  /* The position of each TCB in an indexed list is found without a
+   * search.
+   */
+
+  if (nxsched_rq_indexed(list2))
+    {
+      while ((tmp = (FAR struct tcb_s *)dq_remfirst(&clone)) != NULL)
+        {
+          nxsched_rq_add(tmp, list2);
+        }
+
+      goto out;
+    }
+#endif
+
   /* Get the head of list2 */
 
   tcb2 = (FAR struct tcb_s *)dq_peek(list2);
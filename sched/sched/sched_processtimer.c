@@ -244,6 +244,12 @@ void nxsched_process_timer(void)
 
   nxsched_process_scheduler();
 
+#ifdef CONFIG_SMP_LOAD_BALANCE
+  /* Balance the run queues of the CPUs */
+
+  nxsched_process_balance(1, false);
+#endif
+
   /* Process watchdogs */
 
   nxsched_process_wdtimer();
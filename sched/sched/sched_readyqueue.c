@@ -0,0 +1,359 @@
+/****************************************************************************
+ * sched/sched/sched_readyqueue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_READYQUEUE_BITMAP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* One bit for each priority level */
+
+#define RQ_NWORDS    ((SCHED_PRIORITY_MAX + 32) / 32)
+
+/* g_readytorun and, in the SMP case, each of the g_assignedtasks[] lists */
+
+#ifdef CONFIG_SMP
+#  define RQ_NLISTS  (CONFIG_SMP_NCPUS + 1)
+#else
+#  define RQ_NLISTS  1
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The index of a prioritized ready-to-run list.  The list itself stays
+ * sorted in descending priority order; the index only remembers where each
+ * priority level ends so that a new task can be inserted without walking
+ * the list.
+ */
+
+struct readyqueue_s
+{
+  uint32_t rq_bitmap[RQ_NWORDS];                     /* Populated levels */
+  FAR struct tcb_s *rq_tail[SCHED_PRIORITY_MAX + 1]; /* Last TCB of level */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct readyqueue_s g_rqindex[RQ_NLISTS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_rq_lookup
+ *
+ * Description:
+ *   Return the index of a ready-to-run list, or NULL if the list is not
+ *   indexed.
+ *
+ ****************************************************************************/
+
+static FAR struct readyqueue_s *nxsched_rq_lookup(FAR dq_queue_t *list)
+{
+  if (list == (FAR dq_queue_t *)&g_readytorun)
+    {
+      return &g_rqindex[0];
+    }
+
+#ifdef CONFIG_SMP
+  if (list >= (FAR dq_queue_t *)&g_assignedtasks[0] &&
+      list <  (FAR dq_queue_t *)&g_assignedtasks[CONFIG_SMP_NCPUS])
+    {
+      return &g_rqindex[1 + (list - (FAR dq_queue_t *)g_assignedtasks)];
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: nxsched_rq_find
+ *
+ * Description:
+ *   Find the lowest populated priority level that is not below
+ *   sched_priority.
+ *
+ * Returned Value:
+ *   The priority level found or -1 if all tasks in the list have a lower
+ *   priority.
+ *
+ ****************************************************************************/
+
+static int nxsched_rq_find(FAR struct readyqueue_s *rq, int sched_priority)
+{
+  int word = sched_priority >> 5;
+  uint32_t bits;
+
+  /* Mask off the lower levels in the first word */
+
+  bits = rq->rq_bitmap[word] & (UINT32_MAX << (sched_priority & 31));
+
+  for (; ; )
+    {
+      if (bits != 0)
+        {
+          return (word << 5) + ffs(bits) - 1;
+        }
+
+      if (++word >= RQ_NWORDS)
+        {
+          return -1;
+        }
+
+      bits = rq->rq_bitmap[word];
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_rq_link
+ *
+ * Description:
+ *   Record tcb as the last task of its priority level if the task that
+ *   follows it in the list has a lower priority.
+ *
+ ****************************************************************************/
+
+static void nxsched_rq_link(FAR struct readyqueue_s *rq,
+                            FAR struct tcb_s *tcb)
+{
+  uint8_t sched_priority = tcb->sched_priority;
+
+  if (tcb->flink == NULL || tcb->flink->sched_priority != sched_priority)
+    {
+      rq->rq_tail[sched_priority] = tcb;
+      rq->rq_bitmap[sched_priority >> 5] |=
+        (uint32_t)1 << (sched_priority & 31);
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_rq_unlink
+ *
+ * Description:
+ *   Forget tcb as the last task of its priority level.  The task that
+ *   precedes it takes its place if it has the same priority.
+ *
+ ****************************************************************************/
+
+static void nxsched_rq_unlink(FAR struct readyqueue_s *rq,
+                              FAR struct tcb_s *tcb)
+{
+  uint8_t sched_priority = tcb->sched_priority;
+  FAR struct tcb_s *prev;
+
+  if (rq->rq_tail[sched_priority] == tcb)
+    {
+      prev = tcb->blink;
+      if (prev != NULL && prev->sched_priority == sched_priority)
+        {
+          rq->rq_tail[sched_priority] = prev;
+        }
+      else
+        {
+          rq->rq_tail[sched_priority] = NULL;
+          rq->rq_bitmap[sched_priority >> 5] &=
+            ~((uint32_t)1 << (sched_priority & 31));
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_rq_indexed
+ *
+ * Description:
+ *   Check if a prioritized task list is one of the indexed ready-to-run
+ *   lists.
+ *
+ ****************************************************************************/
+
+bool nxsched_rq_indexed(FAR dq_queue_t *list)
+{
+  return nxsched_rq_lookup(list) != NULL;
+}
+
+/****************************************************************************
+ * Name: nxsched_rq_add
+ *
+ * Description:
+ *   Add a TCB to an indexed ready-to-run list behind all tasks of the same
+ *   or higher priority.  This has the same effect as
+ *   nxsched_add_prioritized() but does not walk the list.
+ *
+ * Input Parameters:
+ *   tcb  - Points to the TCB to add to the list
+ *   list - Points to the indexed ready-to-run list
+ *
+ * Returned Value:
+ *   true if the head of the list has changed.
+ *
+ * Assumptions:
+ *   The same as for nxsched_add_prioritized().
+ *
+ ****************************************************************************/
+
+bool nxsched_rq_add(FAR struct tcb_s *tcb, FAR dq_queue_t *list)
+{
+  FAR struct readyqueue_s *rq = nxsched_rq_lookup(list);
+  bool ret = false;
+  int prio;
+
+  DEBUGASSERT(rq != NULL);
+
+  prio = nxsched_rq_find(rq, tcb->sched_priority);
+  if (prio < 0)
+    {
+      /* No task has the same or a higher priority */
+
+      dq_addfirst((FAR dq_entry_t *)tcb, list);
+      ret = true;
+    }
+  else
+    {
+      dq_addafter((FAR dq_entry_t *)rq->rq_tail[prio],
+                  (FAR dq_entry_t *)tcb, list);
+    }
+
+  nxsched_rq_link(rq, tcb);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nxsched_rq_addfirst
+ *
+ * Description:
+ *   Add a TCB at the head of a ready-to-run list.  The caller guarantees
+ *   that this keeps the list in priority order.
+ *
+ ****************************************************************************/
+
+void nxsched_rq_addfirst(FAR struct tcb_s *tcb, FAR dq_queue_t *list)
+{
+  FAR struct readyqueue_s *rq = nxsched_rq_lookup(list);
+
+  dq_addfirst((FAR dq_entry_t *)tcb, list);
+  if (rq != NULL)
+    {
+      nxsched_rq_link(rq, tcb);
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_rq_remove
+ *
+ * Description:
+ *   Remove a TCB from a ready-to-run list.
+ *
+ ****************************************************************************/
+
+void nxsched_rq_remove(FAR struct tcb_s *tcb, FAR dq_queue_t *list)
+{
+  FAR struct readyqueue_s *rq = nxsched_rq_lookup(list);
+
+  if (rq != NULL)
+    {
+      nxsched_rq_unlink(rq, tcb);
+    }
+
+  dq_rem((FAR dq_entry_t *)tcb, list);
+}
+
+/****************************************************************************
+ * Name: nxsched_rq_reset
+ *
+ * Description:
+ *   Rebuild the index of a ready-to-run list after the list was modified
+ *   as a whole.
+ *
+ ****************************************************************************/
+
+void nxsched_rq_reset(FAR dq_queue_t *list)
+{
+  FAR struct readyqueue_s *rq = nxsched_rq_lookup(list);
+  FAR struct tcb_s *tcb;
+
+  if (rq != NULL)
+    {
+      memset(rq, 0, sizeof(struct readyqueue_s));
+
+      for (tcb = (FAR struct tcb_s *)list->head; tcb != NULL;
+           tcb = tcb->flink)
+        {
+          nxsched_rq_link(rq, tcb);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_rq_setpriority
+ *
+ * Description:
+ *   Change the priority of a task without moving it in its task list.  The
+ *   caller guarantees that this keeps the list in priority order.
+ *
+ ****************************************************************************/
+
+void nxsched_rq_setpriority(FAR struct tcb_s *tcb, uint8_t sched_priority)
+{
+  FAR struct readyqueue_s *rq;
+
+#ifdef CONFIG_SMP
+  rq = nxsched_rq_lookup(TLIST_HEAD(tcb->task_state, tcb->cpu));
+#else
+  rq = nxsched_rq_lookup(TLIST_HEAD(tcb->task_state));
+#endif
+
+  if (rq != NULL)
+    {
+      nxsched_rq_unlink(rq, tcb);
+      tcb->sched_priority = sched_priority;
+      nxsched_rq_link(rq, tcb);
+    }
+  else
+    {
+      tcb->sched_priority = sched_priority;
+    }
+}
+
+#endif /* CONFIG_SCHED_READYQUEUE_BITMAP */
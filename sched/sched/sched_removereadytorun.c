@@ -86,7 +86,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
-  dq_rem((FAR dq_entry_t *)rtcb, (FAR dq_queue_t *)&g_readytorun);
+  nxsched_rq_remove(rtcb, (FAR dq_queue_t *)&g_readytorun);
 
   /* Since the TCB is not in any list, it is now invalid */
 
@@ -177,7 +177,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
        * or the g_assignedtasks[cpu] list.
        */
 
-      dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+      nxsched_rq_remove(rtcb, tasklist);
 
       /* Which task will go at the head of the list?  It will be either the
        * next tcb in the assigned task list (nxttcb) or a TCB in the
@@ -214,13 +214,31 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
            * list and add to the head of the g_assignedtasks[cpu] list.
            */
 
-          dq_rem((FAR dq_entry_t *)rtrtcb, (FAR dq_queue_t *)&g_readytorun);
-          dq_addfirst((FAR dq_entry_t *)rtrtcb, tasklist);
+          nxsched_rq_remove(rtrtcb, (FAR dq_queue_t *)&g_readytorun);
+          nxsched_rq_addfirst(rtrtcb, tasklist);
 
           rtrtcb->cpu = cpu;
           nxttcb = rtrtcb;
         }
 
+#ifdef CONFIG_SMP_LOAD_BALANCE
+      /* Otherwise, take higher priority work from the run queue of another
+       * CPU before settling for nxttcb, which may be the IDLE task.
+       */
+
+      else if (!nxsched_islocked_global() && !irq_cpu_locked(me))
+        {
+          rtrtcb = nxsched_steal_task(cpu, nxttcb->sched_priority);
+          if (rtrtcb != NULL)
+            {
+              nxsched_rq_addfirst(rtrtcb, tasklist);
+
+              rtrtcb->cpu = cpu;
+              nxttcb = rtrtcb;
+            }
+        }
+#endif
+
       /* Will pre-emption be disabled after the switch?  If the lockcount is
        * greater than zero, then this task/this CPU holds the scheduler lock.
        */
@@ -268,7 +286,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
        * g_assignedtasks[cpu] list.
        */
 
-      dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+      nxsched_rq_remove(rtcb, tasklist);
     }
 
   /* Since the TCB is no longer in any list, it is now invalid */
@@ -402,6 +402,18 @@ static unsigned int nxsched_timer_process(unsigned int ticks,
       rettime = tmp;
     }
 
+#ifdef CONFIG_SMP_LOAD_BALANCE
+  /* Balance the run queues of the CPUs.  Keep the interval timer running
+   * while they are uneven.
+   */
+
+  tmp = nxsched_process_balance(ticks, noswitches);
+  if (tmp > 0 && (rettime == 0 || tmp < rettime))
+    {
+      rettime = tmp;
+    }
+#endif
+
   return rettime;
 }
 
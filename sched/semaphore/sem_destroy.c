@@ -58,6 +58,8 @@
 
 int nxsem_destroy (FAR sem_t *sem)
 {
+  irqstate_t flags;
+
   /* Assure a valid semaphore is specified */
 
   if (sem != NULL)
@@ -70,13 +72,19 @@ int nxsem_destroy (FAR sem_t *sem)
        * Check if other threads are waiting on the semaphore.
        * In this case, the behavior is undefined.  We will:
        * leave the count unchanged but still return OK.
+       *
+       * The count is also changed by sem_post() and sem_trywait() with
+       * only the spinlock of the semaphore held.
        */
 
+      flags = nxsem_lock(sem);
       if (sem->semcount >= 0)
         {
           sem->semcount = 1;
         }
 
+      nxsem_unlock(sem, flags);
+
       /* Release holders of the semaphore */
 
       nxsem_destroyholder(sem);
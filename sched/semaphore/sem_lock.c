@@ -0,0 +1,103 @@
+/****************************************************************************
+ * sched/semaphore/sem_lock.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/semaphore.h>
+
+#ifdef CONFIG_SMP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of spinlocks that protect the semaphore counts.  This must be
+ * a power of two.
+ */
+
+#define NXSEM_NLOCKS  32
+
+/* Select the spinlock of a semaphore from its address.  Semaphores are
+ * rarely closer together than eight bytes.
+ */
+
+#define nxsem_lockof(s) \
+  (&g_semlock[((uintptr_t)(s) >> 3) & (NXSEM_NLOCKS - 1)])
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static spinlock_t g_semlock[NXSEM_NLOCKS];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_lock
+ *
+ * Description:
+ *   Take the spinlock that protects the count of a semaphore and disable
+ *   local interrupts.
+ *
+ * Input Parameters:
+ *   sem - Semaphore descriptor
+ *
+ * Returned Value:
+ *   The interrupt state to be passed to nxsem_unlock().
+ *
+ ****************************************************************************/
+
+irqstate_t nxsem_lock(FAR sem_t *sem)
+{
+  return spin_lock_irqsave(nxsem_lockof(sem));
+}
+
+/****************************************************************************
+ * Name: nxsem_unlock
+ *
+ * Description:
+ *   Release the spinlock taken by nxsem_lock() and restore the local
+ *   interrupt state.
+ *
+ * Input Parameters:
+ *   sem   - Semaphore descriptor
+ *   flags - The value returned by nxsem_lock()
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxsem_unlock(FAR sem_t *sem, irqstate_t flags)
+{
+  spin_unlock_irqrestore(nxsem_lockof(sem), flags);
+}
+
+#endif /* CONFIG_SMP */
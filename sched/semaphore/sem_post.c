@@ -70,13 +70,32 @@
 int nxsem_post(FAR sem_t *sem)
 {
   FAR struct tcb_s *stcb = NULL;
+  irqstate_t lflags;
   irqstate_t flags;
+  int16_t semcount;
   int ret = -EINVAL;
 
   /* Make sure we were supplied with a valid semaphore. */
 
   if (sem != NULL)
     {
+      /* If no thread is waiting for the semaphore, then posting it only
+       * increments its count.  This does not need the critical section.
+       */
+
+      if (nxsem_fastpath(sem))
+        {
+          lflags = nxsem_lock(sem);
+          if (sem->semcount >= 0 && sem->semcount < SEM_VALUE_MAX)
+            {
+              sem->semcount++;
+              nxsem_unlock(sem, lflags);
+              return OK;
+            }
+
+          nxsem_unlock(sem, lflags);
+        }
+
       /* The following operations must be performed with interrupts
        * disabled because sem_post() may be called from an interrupt
        * handler.
@@ -84,16 +103,23 @@ int nxsem_post(FAR sem_t *sem)
 
       flags = enter_critical_section();
 
-      /* Check the maximum allowable value */
+      /* Check the maximum allowable value and increment the count on the
+       * semaphore.
+       */
 
+      lflags = nxsem_lock(sem);
       if (sem->semcount >= SEM_VALUE_MAX)
         {
+          nxsem_unlock(sem, lflags);
           leave_critical_section(flags);
           return -EOVERFLOW;
         }
 
-      /* Perform the semaphore unlock operation, releasing this task as a
-       * holder then also incrementing the count on the semaphore.
+      semcount = ++sem->semcount;
+      nxsem_unlock(sem, lflags);
+
+      /* Complete the semaphore unlock operation, releasing this task as a
+       * holder of the semaphore.
        *
        * NOTE:  When semaphores are used for signaling purposes, the holder
        * of the semaphore may not be this thread!  In this case,
@@ -110,7 +136,6 @@ int nxsem_post(FAR sem_t *sem)
        */
 
       nxsem_release_holder(sem);
-      sem->semcount++;
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
       /* Don't let any unblocked tasks run until we complete any priority
@@ -127,7 +152,7 @@ int nxsem_post(FAR sem_t *sem)
        * there must be some task waiting for the semaphore.
        */
 
-      if (sem->semcount <= 0)
+      if (semcount <= 0)
         {
           /* Check if there are any tasks in the waiting for semaphore
            * task list that are waiting for this semaphore. This is a
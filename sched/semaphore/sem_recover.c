@@ -64,6 +64,7 @@
 
 void nxsem_recover(FAR struct tcb_s *tcb)
 {
+  irqstate_t lflags;
   irqstate_t flags;
 
   /* The task is being deleted.  If it is waiting for a semaphore, then
@@ -97,7 +98,9 @@ void nxsem_recover(FAR struct tcb_s *tcb)
        * place.
        */
 
+      lflags = nxsem_lock(sem);
       sem->semcount++;
+      nxsem_unlock(sem, lflags);
 
       /* Clear the semaphore to assure that it is not reused.  But leave the
        * state as TSTATE_WAIT_SEM.  This is necessary because this is a
@@ -57,6 +57,7 @@
 
 int nxsem_reset(FAR sem_t *sem, int16_t count)
 {
+  irqstate_t lflags;
   irqstate_t flags;
 
   DEBUGASSERT(sem != NULL && count >= 0);
@@ -96,11 +97,14 @@ int nxsem_reset(FAR sem_t *sem, int16_t count)
    * value of sem->semcount is already correct in this case.
    */
 
+  lflags = nxsem_lock(sem);
   if (sem->semcount >= 0)
     {
       sem->semcount = count;
     }
 
+  nxsem_unlock(sem, lflags);
+
   /* Allow any pending context switches to occur now */
 
   leave_critical_section(flags);
@@ -67,7 +67,9 @@
 int nxsem_trywait(FAR sem_t *sem)
 {
   FAR struct tcb_s *rtcb = this_task();
+  irqstate_t lflags;
   irqstate_t flags;
+  int16_t semcount;
   int ret;
 
   /* This API should not be called from interrupt handlers & idleloop */
@@ -77,6 +79,23 @@ int nxsem_trywait(FAR sem_t *sem)
 
   if (sem != NULL)
     {
+      /* If no holder has to be recorded, an available count can be taken
+       * without the critical section.
+       */
+
+      if (nxsem_fastpath(sem))
+        {
+          lflags = nxsem_lock(sem);
+          semcount = sem->semcount;
+          if (semcount > 0)
+            {
+              sem->semcount--;
+            }
+
+          nxsem_unlock(sem, lflags);
+          return semcount > 0 ? OK : -EAGAIN;
+        }
+
       /* The following operations must be performed with interrupts disabled
        * because sem_post() may be called from an interrupt handler.
        */
@@ -85,11 +104,19 @@ int nxsem_trywait(FAR sem_t *sem)
 
       /* If the semaphore is available, give it to the requesting task */
 
-      if (sem->semcount > 0)
+      lflags = nxsem_lock(sem);
+      semcount = sem->semcount;
+      if (semcount > 0)
+        {
+          sem->semcount--;
+        }
+
+      nxsem_unlock(sem, lflags);
+
+      if (semcount > 0)
         {
           /* It is, let the task take the semaphore */
 
-          sem->semcount--;
           nxsem_add_holder(sem);
           rtcb->waitsem = NULL;
           ret = OK;
@@ -71,7 +71,9 @@
 int nxsem_wait(FAR sem_t *sem)
 {
   FAR struct tcb_s *rtcb = this_task();
+  irqstate_t lflags;
   irqstate_t flags;
+  int16_t semcount;
   int ret = -EINVAL;
 
   /* This API should not be called from interrupt handlers & idleloop */
@@ -79,6 +81,23 @@ int nxsem_wait(FAR sem_t *sem)
   DEBUGASSERT(sem != NULL && up_interrupt_context() == false);
   DEBUGASSERT(!OSINIT_IDLELOOP() || !sched_idletask());
 
+  /* If the semaphore is available and no holder has to be recorded, the
+   * count can be taken without the critical section.
+   */
+
+  if (sem != NULL && nxsem_fastpath(sem))
+    {
+      lflags = nxsem_lock(sem);
+      if (sem->semcount > 0)
+        {
+          sem->semcount--;
+          nxsem_unlock(sem, lflags);
+          return OK;
+        }
+
+      nxsem_unlock(sem, lflags);
+    }
+
   /* The following operations must be performed with interrupts
    * disabled because nxsem_post() may be called from an interrupt
    * handler.
@@ -90,13 +109,20 @@ int nxsem_wait(FAR sem_t *sem)
 
   if (sem != NULL)
     {
-      /* Check if the lock is available */
+      /* Take a count from the semaphore.  If the count was not positive,
+       * the negated count is the number of waiting threads.
+       */
 
-      if (sem->semcount > 0)
+      lflags = nxsem_lock(sem);
+      semcount = sem->semcount--;
+      nxsem_unlock(sem, lflags);
+
+      /* Check if the lock was available */
+
+      if (semcount > 0)
         {
           /* It is, let the task take the semaphore. */
 
-          sem->semcount--;
           nxsem_add_holder(sem);
           rtcb->waitsem = NULL;
           ret = OK;
@@ -114,10 +140,6 @@ int nxsem_wait(FAR sem_t *sem)
 
           DEBUGASSERT(rtcb->waitsem == NULL);
 
-          /* Handle the POSIX semaphore (but don't set the owner yet) */
-
-          sem->semcount--;
-
           /* Save the waited on semaphore in the TCB */
 
           rtcb->waitsem = sem;
@@ -65,6 +65,7 @@
 
 void nxsem_wait_irq(FAR struct tcb_s *wtcb, int errcode)
 {
+  irqstate_t lflags;
   irqstate_t flags;
 
   /* Disable interrupts.  This is necessary (unfortunately) because an
@@ -95,7 +96,9 @@ void nxsem_wait_irq(FAR struct tcb_s *wtcb, int errcode)
        * place.
        */
 
+      lflags = nxsem_lock(sem);
       sem->semcount++;
+      nxsem_unlock(sem, lflags);
 
       /* Indicate that the semaphore wait is over. */
 
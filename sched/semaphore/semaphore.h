@@ -34,6 +34,22 @@
 #include <stdbool.h>
 #include <queue.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* A count can be taken from or given back to a semaphore holding only the
+ * spinlock of the semaphore (see nxsem_lock()) if no thread has to be
+ * blocked or awakened and if priority inheritance does not keep track of
+ * the holders of the semaphore.
+ */
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+#  define nxsem_fastpath(s) (((s)->flags & PRIOINHERIT_FLAGS_DISABLE) != 0)
+#else
+#  define nxsem_fastpath(s) true
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
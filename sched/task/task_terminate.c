@@ -142,7 +142,7 @@ int nxtask_terminate(pid_t pid, bool nonblocking)
 
   /* Remove the task from the task list */
 
-  dq_rem((FAR dq_entry_t *)dtcb, tasklist);
+  nxsched_rq_remove(dtcb, tasklist);
 
   /* At this point, the TCB should no longer be accessible to the system */
 
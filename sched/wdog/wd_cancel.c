@@ -39,6 +39,82 @@
  * Public Functions
  ****************************************************************************/
 
+#ifndef CONFIG_WDOG_TIMER_WHEEL
+/****************************************************************************
+ * Name: wd_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the list of active watchdogs and mark it
+ *   inactive.  The watchdog that follows it inherits its remaining ticks.
+ *
+ * Input Parameters:
+ *   wdog - The active watchdog to remove
+ *
+ * Returned Value:
+ *   True if the watchdog was at the head of the list.
+ *
+ * Assumptions:
+ *   The caller holds the watchdog lock (see wd_lock()).
+ *
+ ****************************************************************************/
+
+bool wd_remove(FAR struct wdog_s *wdog)
+{
+  FAR struct wdog_s *curr;
+  FAR struct wdog_s *prev;
+
+  /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
+   * to do this because there are additional operations that need to be
+   * done.
+   */
+
+  prev = NULL;
+  curr = (FAR struct wdog_s *)g_wdactivelist.head;
+
+  while ((curr) && (curr != wdog))
+    {
+      prev = curr;
+      curr = curr->next;
+    }
+
+  /* Check if the watchdog was found in the list.  If not, then an OS
+   * error has occurred because the watchdog is marked active!
+   */
+
+  DEBUGASSERT(curr);
+
+  /* If there is a watchdog in the timer queue after the one that
+   * is being canceled, then it inherits the remaining ticks.
+   */
+
+  if (curr->next)
+    {
+      curr->next->lag += curr->lag;
+    }
+
+  /* Mark the watchdog inactive */
+
+  wdog->func = NULL;
+
+  /* Now, remove the watchdog from the timer queue */
+
+  if (prev)
+    {
+      /* Remove the watchdog from mid- or end-of-queue */
+
+      sq_remafter((FAR sq_entry_t *)prev, &g_wdactivelist);
+      return false;
+    }
+  else
+    {
+      /* Remove the watchdog at the head of the queue */
+
+      sq_remfirst(&g_wdactivelist);
+      return true;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: wd_cancel
  *
@@ -57,8 +133,6 @@
 
 int wd_cancel(FAR struct wdog_s *wdog)
 {
-  FAR struct wdog_s *curr;
-  FAR struct wdog_s *prev;
   irqstate_t flags;
   int ret = -EINVAL;
 
@@ -66,7 +140,7 @@ int wd_cancel(FAR struct wdog_s *wdog)
    * cancellation is complete
    */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
 
   /* Make sure that the watchdog is initialized (non-NULL) and is still
    * active.
@@ -74,49 +148,8 @@ int wd_cancel(FAR struct wdog_s *wdog)
 
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
-      /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
-       * to do this because there are additional operations that need to be
-       * done.
-       */
-
-      prev = NULL;
-      curr = (FAR struct wdog_s *)g_wdactivelist.head;
-
-      while ((curr) && (curr != wdog))
-        {
-          prev = curr;
-          curr = curr->next;
-        }
-
-      /* Check if the watchdog was found in the list.  If not, then an OS
-       * error has occurred because the watchdog is marked active!
-       */
-
-      DEBUGASSERT(curr);
-
-      /* If there is a watchdog in the timer queue after the one that
-       * is being canceled, then it inherits the remaining ticks.
-       */
-
-      if (curr->next)
-        {
-          curr->next->lag += curr->lag;
-        }
-
-      /* Now, remove the watchdog from the timer queue */
-
-      if (prev)
+      if (wd_remove(wdog))
         {
-          /* Remove the watchdog from mid- or end-of-queue */
-
-          sq_remafter((FAR sq_entry_t *)prev, &g_wdactivelist);
-        }
-      else
-        {
-          /* Remove the watchdog at the head of the queue */
-
-          sq_remfirst(&g_wdactivelist);
-
           /* Reassess the interval timer that will generate the next
            * interval event.
            */
@@ -124,15 +157,11 @@ int wd_cancel(FAR struct wdog_s *wdog)
           nxsched_reassess_timer();
         }
 
-      /* Mark the watchdog inactive */
-
-      wdog->func = NULL;
-
       /* Return success */
 
       ret = OK;
     }
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return ret;
 }
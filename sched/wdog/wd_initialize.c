@@ -32,12 +32,14 @@
  * Public Data
  ****************************************************************************/
 
+#ifndef CONFIG_WDOG_TIMER_WHEEL
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 sq_queue_t g_wdactivelist;
+#endif
 
 /* This is wdog tickbase, for wd_gettime() may called many times
  * between 2 times of wd_timer(), we use it to update wd_gettime().
@@ -47,6 +49,12 @@ sq_queue_t g_wdactivelist;
 clock_t g_wdtickbase;
 #endif
 
+/* This spinlock protects the active watchdogs in the SMP case */
+
+#ifdef WDOG_HAVE_SPINLOCK
+spinlock_t g_wdspinlock = SP_UNLOCKED;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
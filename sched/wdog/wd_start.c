@@ -50,34 +50,11 @@
 #  define MAX(a,b) (((a) > (b)) ? (a) : (b))
 #endif
 
-#ifndef CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG
-#  define CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG 0
-#endif
-
-#if CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG > 0
-#  define CALL_FUNC(func, arg) \
-     do \
-       { \
-         uint32_t start; \
-         uint32_t elapsed; \
-         start = up_perf_gettime(); \
-         func(arg); \
-         elapsed = up_perf_gettime() - start; \
-         if (elapsed > CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG) \
-           { \
-             serr("WDOG %p, %s IRQ, execute too long %"PRIu32"\n", \
-                   func, up_interrupt_context() ? "IN" : "NOT", elapsed); \
-           } \
-       } \
-     while (0)
-#else
-#  define CALL_FUNC(func, arg) func(arg)
-#endif
-
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifndef CONFIG_WDOG_TIMER_WHEEL
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -86,17 +63,23 @@
  *   run. If so, remove the watchdog from the list and execute it.
  *
  * Input Parameters:
- *   None
+ *   flags - The value returned by wd_lock()
  *
  * Returned Value:
- *   None
+ *   The value to be passed to wd_unlock()
+ *
+ * Assumptions:
+ *   The watchdog lock is held on entry and on return.  It is released
+ *   while the watchdog functions execute so that they may restart their
+ *   watchdogs.
  *
  ****************************************************************************/
 
-static inline void wd_expiration(void)
+static inline irqstate_t wd_expiration(irqstate_t flags)
 {
   FAR struct wdog_s *wdog;
   wdentry_t func;
+  wdparm_t arg;
 
   /* Process the watchdog at the head of the list as well as any
    * other watchdogs that became ready to run at this time
@@ -121,14 +104,20 @@ static inline void wd_expiration(void)
       /* Indicate that the watchdog is no longer active. */
 
       func = wdog->func;
+      arg  = wdog->arg;
       wdog->func = NULL;
 
       /* Execute the watchdog function */
 
       up_setpicbase(wdog->picbase);
-      CALL_FUNC(func, wdog->arg);
+      wd_unlock(flags);
+      CALL_FUNC(func, arg);
+      flags = wd_lock();
     }
+
+  return flags;
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -173,10 +162,12 @@ static inline void wd_expiration(void)
 int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
              wdentry_t wdentry, wdparm_t arg)
 {
+#ifndef CONFIG_WDOG_TIMER_WHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
   FAR struct wdog_s *next;
   sclock_t now;
+#endif
   irqstate_t flags;
 
   /* Verify the wdog and setup parameters */
@@ -189,13 +180,13 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
   /* Check if the watchdog has been started. If so, stop it.
    * NOTE:  There is a race condition here... the caller may receive
    * the watchdog between the time that wd_start is called and
-   * the critical section is established.
+   * the watchdog lock is taken.
    */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
   if (WDOG_ISACTIVE(wdog))
     {
-      wd_cancel(wdog);
+      wd_remove(wdog);
     }
 
   /* Save the data in the watchdog structure */
@@ -238,6 +229,13 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
   nxsched_cancel_timer();
 #endif
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  /* Add the watchdog to the slot of the timer wheel that matches the
+   * delay.
+   */
+
+  wd_insert(wdog, delay);
+#else
   /* Do the easy case first -- when the watchdog timer queue is empty. */
 
   if (g_wdactivelist.head == NULL)
@@ -331,6 +329,7 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
   /* Put the lag into the watchdog structure and mark it as active. */
 
   wdog->lag = delay;
+#endif
 
 #ifdef CONFIG_SCHED_TICKLESS
   /* Resume the interval timer that will generate the next interval event.
@@ -341,10 +340,11 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
   nxsched_resume_timer();
 #endif
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return OK;
 }
 
+#ifndef CONFIG_WDOG_TIMER_WHEEL
 /****************************************************************************
  * Name: wd_timer
  *
@@ -375,11 +375,13 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
 unsigned int wd_timer(int ticks, bool noswitches)
 {
   FAR struct wdog_s *wdog;
+  irqstate_t flags;
   unsigned int ret;
   int decr;
 
   /* Check if there are any active watchdogs to process */
 
+  flags = wd_lock();
   wdog = (FAR struct wdog_s *)g_wdactivelist.head;
   while (wdog != NULL && ticks > 0)
     {
@@ -400,7 +402,7 @@ unsigned int wd_timer(int ticks, bool noswitches)
 
   if (!noswitches)
     {
-      wd_expiration();
+      flags = wd_expiration(flags);
     }
 
   /* Update clock tickbase */
@@ -412,6 +414,8 @@ unsigned int wd_timer(int ticks, bool noswitches)
   ret = g_wdactivelist.head ?
         MAX(((FAR struct wdog_s *)g_wdactivelist.head)->lag, 1) : 0;
 
+  wd_unlock(flags);
+
   /* Return the delay for the next watchdog to expire */
 
   return ret;
@@ -420,8 +424,11 @@ unsigned int wd_timer(int ticks, bool noswitches)
 #else
 void wd_timer(void)
 {
+  irqstate_t flags;
+
   /* Check if there are any active watchdogs to process */
 
+  flags = wd_lock();
   if (g_wdactivelist.head)
     {
       /* There are.  Decrement the lag counter */
@@ -430,7 +437,10 @@ void wd_timer(void)
 
       /* Check if the watchdog at the head of the list is ready to run */
 
-      wd_expiration();
+      flags = wd_expiration(flags);
     }
+
+  wd_unlock(flags);
 }
 #endif /* CONFIG_SCHED_TICKLESS */
+#endif /* !CONFIG_WDOG_TIMER_WHEEL */
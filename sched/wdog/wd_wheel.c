@@ -0,0 +1,530 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/wdog.h>
+
+#include "sched/sched.h"
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The wheel has WHEEL_LEVELS levels of WHEEL_SIZE slots each.  A slot of
+ * level n covers WHEEL_SIZE^n ticks, so the wheel can hold delays of up to
+ * WHEEL_MAXDELAY ticks.  Longer delays are parked in the last level and
+ * moved back there until they are short enough.
+ */
+
+#define WHEEL_BITS       5
+#define WHEEL_SIZE       (1 << WHEEL_BITS)
+#define WHEEL_MASK       (WHEEL_SIZE - 1)
+#define WHEEL_LEVELS     5
+#define WHEEL_MAXDELAY   (((sclock_t)1 << (WHEEL_BITS * WHEEL_LEVELS)) - 1)
+
+#define WHEEL_SHIFT(l)   (WHEEL_BITS * (l))
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* This is the time up to which the timer wheel has been processed */
+
+clock_t g_wdtime;
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The slots of the timer wheel and one bit for each non-empty slot */
+
+static FAR struct wdog_s *g_wdwheel[WHEEL_LEVELS][WHEEL_SIZE];
+static uint32_t g_wdbitmap[WHEEL_LEVELS];
+
+/* Watchdogs that have expired but whose functions have not run yet */
+
+static FAR struct wdog_s *g_wdexpired;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_link
+ *
+ * Description:
+ *   Add a watchdog at the head of a slot.
+ *
+ ****************************************************************************/
+
+static inline void wd_link(FAR struct wdog_s **head,
+                           FAR struct wdog_s *wdog)
+{
+  wdog->next  = *head;
+  wdog->pprev = head;
+
+  if (*head != NULL)
+    {
+      (*head)->pprev = &wdog->next;
+    }
+
+  *head = wdog;
+}
+
+/****************************************************************************
+ * Name: wd_unlink
+ *
+ * Description:
+ *   Remove a watchdog from its slot and clear the bit of the slot if it
+ *   becomes empty.
+ *
+ ****************************************************************************/
+
+static inline void wd_unlink(FAR struct wdog_s *wdog)
+{
+  FAR struct wdog_s **head = wdog->pprev;
+  int index;
+
+  *head = wdog->next;
+  if (wdog->next != NULL)
+    {
+      wdog->next->pprev = head;
+    }
+
+  /* The link that pointed to the watchdog is either the next field of
+   * another watchdog, the head of the expired list or a slot of the wheel.
+   */
+
+  if (*head == NULL && head >= &g_wdwheel[0][0] &&
+      head < &g_wdwheel[0][0] + WHEEL_LEVELS * WHEEL_SIZE)
+    {
+      index = head - &g_wdwheel[0][0];
+      g_wdbitmap[index >> WHEEL_BITS] &=
+        ~((uint32_t)1 << (index & WHEEL_MASK));
+    }
+}
+
+/****************************************************************************
+ * Name: wd_enqueue
+ *
+ * Description:
+ *   Add a watchdog to the slot that matches its remaining delay, or to the
+ *   expired list if there is none.
+ *
+ ****************************************************************************/
+
+static void wd_enqueue(FAR struct wdog_s *wdog)
+{
+  sclock_t delay = (sclock_t)(wdog->expire - g_wdtime);
+  clock_t expire = wdog->expire;
+  int level;
+  int slot;
+
+  if (delay <= 0)
+    {
+      wd_link(&g_wdexpired, wdog);
+      return;
+    }
+
+  if (delay > WHEEL_MAXDELAY)
+    {
+      delay  = WHEEL_MAXDELAY;
+      expire = g_wdtime + WHEEL_MAXDELAY;
+    }
+
+  for (level = 0; level < WHEEL_LEVELS - 1; level++)
+    {
+      if (delay < ((sclock_t)1 << WHEEL_SHIFT(level + 1)))
+        {
+          break;
+        }
+    }
+
+  slot = (expire >> WHEEL_SHIFT(level)) & WHEEL_MASK;
+  wd_link(&g_wdwheel[level][slot], wdog);
+  g_wdbitmap[level] |= (uint32_t)1 << slot;
+}
+
+/****************************************************************************
+ * Name: wd_cascade
+ *
+ * Description:
+ *   Move the watchdogs of the current slot of a level to the slots of the
+ *   lower levels.  The watchdogs of the current slot of level 0 expire.
+ *
+ ****************************************************************************/
+
+static void wd_cascade(int level)
+{
+  FAR struct wdog_s *wdog;
+  FAR struct wdog_s *next;
+  int slot;
+
+  slot = (g_wdtime >> WHEEL_SHIFT(level)) & WHEEL_MASK;
+  if ((g_wdbitmap[level] & ((uint32_t)1 << slot)) == 0)
+    {
+      return;
+    }
+
+  wdog = g_wdwheel[level][slot];
+  g_wdwheel[level][slot] = NULL;
+  g_wdbitmap[level] &= ~((uint32_t)1 << slot);
+
+  for (; wdog != NULL; wdog = next)
+    {
+      next = wdog->next;
+      wd_enqueue(wdog);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_tick
+ *
+ * Description:
+ *   Advance the wheel by one tick.
+ *
+ ****************************************************************************/
+
+static void wd_tick(void)
+{
+  int level;
+
+  g_wdtime++;
+
+  /* Cascade every level whose slot has just changed, starting with the
+   * highest one so that its watchdogs can reach the lower levels before
+   * those are cascaded.
+   */
+
+  for (level = 1; level < WHEEL_LEVELS; level++)
+    {
+      if ((g_wdtime & (((clock_t)1 << WHEEL_SHIFT(level)) - 1)) != 0)
+        {
+          break;
+        }
+    }
+
+  while (level-- > 0)
+    {
+      wd_cascade(level);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_nextevent
+ *
+ * Description:
+ *   Return the number of ticks until the wheel has to be processed next,
+ *   either because watchdogs expire or because they must be cascaded.
+ *   Zero is returned if the wheel is empty.
+ *
+ ****************************************************************************/
+
+static clock_t wd_nextevent(void)
+{
+  clock_t next = 0;
+  clock_t base;
+  clock_t ticks;
+  uint32_t bitmap;
+  int level;
+  int rot;
+
+  for (level = 0; level < WHEEL_LEVELS; level++)
+    {
+      bitmap = g_wdbitmap[level];
+      if (bitmap == 0)
+        {
+          continue;
+        }
+
+      /* Find the first non-empty slot after the current one.  The current
+       * slot itself comes last.
+       */
+
+      base = (g_wdtime >> WHEEL_SHIFT(level)) + 1;
+      rot  = base & WHEEL_MASK;
+      if (rot != 0)
+        {
+          bitmap = (bitmap >> rot) | (bitmap << (WHEEL_SIZE - rot));
+        }
+
+      ticks = ((base + ffs((int)bitmap) - 1) << WHEEL_SHIFT(level)) -
+              g_wdtime;
+
+      if (next == 0 || ticks < next)
+        {
+          next = ticks;
+        }
+    }
+
+  return next;
+}
+
+#ifdef CONFIG_SCHED_TICKLESS
+/****************************************************************************
+ * Name: wd_advance
+ *
+ * Description:
+ *   Advance the wheel by a number of ticks, skipping the ticks where there
+ *   is nothing to do.
+ *
+ ****************************************************************************/
+
+static void wd_advance(clock_t ticks)
+{
+  clock_t next;
+
+  while (ticks > 0)
+    {
+      next = wd_nextevent();
+      if (next == 0 || next > ticks)
+        {
+          g_wdtime += ticks;
+          break;
+        }
+
+      g_wdtime += next - 1;
+      ticks    -= next;
+      wd_tick();
+    }
+}
+
+/****************************************************************************
+ * Name: wd_isempty
+ *
+ * Description:
+ *   Check if there are no active watchdogs.
+ *
+ ****************************************************************************/
+
+static bool wd_isempty(void)
+{
+  int level;
+
+  for (level = 0; level < WHEEL_LEVELS; level++)
+    {
+      if (g_wdbitmap[level] != 0)
+        {
+          return false;
+        }
+    }
+
+  return g_wdexpired == NULL;
+}
+#endif
+
+/****************************************************************************
+ * Name: wd_expiration
+ *
+ * Description:
+ *   Execute the watchdogs that have expired.
+ *
+ * Input Parameters:
+ *   flags - The value returned by wd_lock()
+ *
+ * Returned Value:
+ *   The value to be passed to wd_unlock()
+ *
+ * Assumptions:
+ *   The watchdog lock is held on entry and on return.  It is released
+ *   while the watchdog functions execute so that they may restart their
+ *   watchdogs.
+ *
+ ****************************************************************************/
+
+static inline irqstate_t wd_expiration(irqstate_t flags)
+{
+  FAR struct wdog_s *wdog;
+  wdentry_t func;
+  wdparm_t arg;
+
+  while ((wdog = g_wdexpired) != NULL)
+    {
+      wd_unlink(wdog);
+
+      /* Indicate that the watchdog is no longer active. */
+
+      func = wdog->func;
+      arg  = wdog->arg;
+      wdog->func = NULL;
+
+      /* Execute the watchdog function */
+
+      up_setpicbase(wdog->picbase);
+      wd_unlock(flags);
+      CALL_FUNC(func, arg);
+      flags = wd_lock();
+    }
+
+  return flags;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_insert
+ *
+ * Description:
+ *   Add a watchdog to the timer wheel.
+ *
+ * Input Parameters:
+ *   wdog  - The inactive watchdog to add
+ *   delay - The delay in clock ticks, at least one
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller holds the watchdog lock (see wd_lock()).
+ *
+ ****************************************************************************/
+
+void wd_insert(FAR struct wdog_s *wdog, sclock_t delay)
+{
+#ifdef CONFIG_SCHED_TICKLESS
+  /* wd_timer() is not called while there are no active watchdogs */
+
+  if (wd_isempty())
+    {
+      g_wdtickbase = clock_systime_ticks();
+    }
+#endif
+
+  wdog->expire = g_wdtime + delay;
+  wd_enqueue(wdog);
+}
+
+/****************************************************************************
+ * Name: wd_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the timer wheel and mark it inactive.
+ *
+ * Input Parameters:
+ *   wdog - The active watchdog to remove
+ *
+ * Returned Value:
+ *   True if the interval timer may need to be reassessed.
+ *
+ * Assumptions:
+ *   The caller holds the watchdog lock (see wd_lock()).
+ *
+ ****************************************************************************/
+
+bool wd_remove(FAR struct wdog_s *wdog)
+{
+#ifdef CONFIG_SCHED_TICKLESS
+  clock_t next = wd_nextevent();
+#endif
+
+  wd_unlink(wdog);
+  wdog->func = NULL;
+
+#ifdef CONFIG_SCHED_TICKLESS
+  return wd_nextevent() != next;
+#else
+  return false;
+#endif
+}
+
+/****************************************************************************
+ * Name: wd_timer
+ *
+ * Description:
+ *   This function is called from the timer interrupt handler to advance
+ *   the timer wheel and to execute the functions of the watchdogs that
+ *   have expired in the context of the timer interrupt handler.
+ *
+ * Input Parameters:
+ *   ticks - If CONFIG_SCHED_TICKLESS is defined then the number of ticks
+ *     in the interval that just expired is provided.  Otherwise,
+ *     this function is called on each timer interrupt and a value of one
+ *     is implicit.
+ *   noswitches - True: Can't do context switches now.
+ *
+ * Returned Value:
+ *   If CONFIG_SCHED_TICKLESS is defined then the number of ticks for the
+ *   next delay is provided (zero if no delay).  Otherwise, this function
+ *   has no returned value.
+ *
+ * Assumptions:
+ *   Called from interrupt handler logic with interrupts disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS
+unsigned int wd_timer(int ticks, bool noswitches)
+{
+  irqstate_t flags;
+  unsigned int ret;
+
+  flags = wd_lock();
+  if (ticks > 0)
+    {
+      wd_advance(ticks);
+      g_wdtickbase += ticks;
+    }
+
+  if (!noswitches)
+    {
+      flags = wd_expiration(flags);
+    }
+
+  /* Return the delay until the wheel must be processed again.  This may be
+   * earlier than the next expiration when watchdogs must be cascaded.
+   */
+
+  ret = g_wdexpired != NULL ? 1 : wd_nextevent();
+
+  wd_unlock(flags);
+  return ret;
+}
+
+#else
+void wd_timer(void)
+{
+  irqstate_t flags;
+
+  flags = wd_lock();
+  wd_tick();
+  flags = wd_expiration(flags);
+  wd_unlock(flags);
+}
+#endif /* CONFIG_SCHED_TICKLESS */
+
+#endif /* CONFIG_WDOG_TIMER_WHEEL */
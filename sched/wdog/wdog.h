@@ -32,12 +32,38 @@
 
 #include <nuttx/compiler.h>
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/wdog.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifndef CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG
+#  define CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG 0
+#endif
+
+#if CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG > 0
+#  define CALL_FUNC(func, arg) \
+     do \
+       { \
+         uint32_t start; \
+         uint32_t elapsed; \
+         start = up_perf_gettime(); \
+         func(arg); \
+         elapsed = up_perf_gettime() - start; \
+         if (elapsed > CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG) \
+           { \
+             serr("WDOG %p, %s IRQ, execute too long %"PRIu32"\n", \
+                   func, up_interrupt_context() ? "IN" : "NOT", elapsed); \
+           } \
+       } \
+     while (0)
+#else
+#  define CALL_FUNC(func, arg) func(arg)
+#endif
+
 /****************************************************************************
  * Name: wd_elapse
  *
@@ -55,6 +81,27 @@
 #  define wd_elapse() (0)
 #endif
 
+/****************************************************************************
+ * Name: wd_lock and wd_unlock
+ *
+ * Description:
+ *   Protect the list of active watchdogs.  In the SMP case the list has a
+ *   spinlock of its own so that wd_start() and wd_cancel() do not contend
+ *   for the global critical section.  In tickless mode these functions
+ *   also reprogram the interval timer, which requires the critical
+ *   section.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SMP) && !defined(CONFIG_SCHED_TICKLESS)
+#  define WDOG_HAVE_SPINLOCK 1
+#  define wd_lock()          spin_lock_irqsave(&g_wdspinlock)
+#  define wd_unlock(f)       spin_unlock_irqrestore(&g_wdspinlock, (f))
+#else
+#  define wd_lock()          enter_critical_section()
+#  define wd_unlock(f)       leave_critical_section(f)
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -67,12 +114,18 @@ extern "C"
 #define EXTERN extern
 #endif
 
+#ifndef CONFIG_WDOG_TIMER_WHEEL
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 extern sq_queue_t g_wdactivelist;
+#else
+/* This is the time up to which the timer wheel has been processed */
+
+extern clock_t g_wdtime;
+#endif
 
 /* This is wdog tickbase, for wd_gettime() may called many times
  * between 2 times of wd_timer(), we use it to update wd_gettime().
@@ -82,6 +135,12 @@ extern sq_queue_t g_wdactivelist;
 extern clock_t g_wdtickbase;
 #endif
 
+/* This spinlock protects the active watchdogs in the SMP case */
+
+#ifdef WDOG_HAVE_SPINLOCK
+extern spinlock_t g_wdspinlock;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -140,6 +199,49 @@ void wd_timer(void);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+/****************************************************************************
+ * Name: wd_insert
+ *
+ * Description:
+ *   Add a watchdog to the timer wheel.
+ *
+ * Input Parameters:
+ *   wdog  - The inactive watchdog to add
+ *   delay - The delay in clock ticks, at least one
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller holds the watchdog lock (see wd_lock()).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+void wd_insert(FAR struct wdog_s *wdog, sclock_t delay);
+#endif
+
+/****************************************************************************
+ * Name: wd_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the active watchdogs and mark it
+ *   inactive.
+ *
+ * Input Parameters:
+ *   wdog - The active watchdog to remove
+ *
+ * Returned Value:
+ *   True if the watchdog may have been the next one to expire, so that
+ *   the interval timer may need to be reassessed.
+ *
+ * Assumptions:
+ *   The caller holds the watchdog lock (see wd_lock()).
+ *
+ ****************************************************************************/
+
+bool wd_remove(FAR struct wdog_s *wdog);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
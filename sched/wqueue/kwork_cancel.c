@@ -24,12 +24,14 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <queue.h>
 #include <assert.h>
 #include <errno.h>
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/wqueue.h>
 
 #include "wqueue/wqueue.h"
@@ -40,6 +42,47 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_qremove
+ *
+ * Description:
+ *   Remove work from a queue of pending work if it is there.
+ *
+ * Returned Value:
+ *   True if the work was found in the queue.
+ *
+ ****************************************************************************/
+
+static bool work_qremove(FAR struct kwork_queue_s *queue,
+                         FAR struct work_s *work)
+{
+  FAR sq_entry_t *prev = NULL;
+  FAR sq_entry_t *curr;
+
+  for (curr = queue->q.head;
+       curr != NULL && curr != (FAR sq_entry_t *)work;
+       curr = curr->flink)
+    {
+      prev = curr;
+    }
+
+  if (curr == NULL)
+    {
+      return false;
+    }
+
+  if (prev == NULL)
+    {
+      sq_remfirst(&queue->q);
+    }
+  else
+    {
+      sq_remafter(prev, &queue->q);
+    }
+
+  return true;
+}
+
 /****************************************************************************
  * Name: work_qcancel
  *
@@ -49,7 +92,7 @@
  *   work_queue() again.
  *
  * Input Parameters:
- *   qid    - The work queue ID
+ *   wqueue - The work queue
  *   work   - The previously queued work structure to cancel
  *
  * Returned Value:
@@ -57,42 +100,76 @@
  *   reported:
  *
  *   -ENOENT - There is no such work queued.
- *   -EINVAL - An invalid work queue was specified
  *
  ****************************************************************************/
 
 static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
                         FAR struct work_s *work)
 {
+  FAR struct kwork_queue_s *queue;
   irqstate_t flags;
+  irqstate_t lflags;
   int ret = -ENOENT;
+  int i;
 
   DEBUGASSERT(work != NULL);
 
-  /* Cancelling the work is simply a matter of removing the work structure
-   * from the work queue.  This must be done with interrupts disabled because
-   * new work is typically added to the work queue from interrupt handlers.
+  /* Nothing to do if the work is not queued */
+
+  if (work->worker == NULL)
+    {
+      return ret;
+    }
+
+  /* The work may be waiting for its watchdog timer to expire, so the
+   * critical section is needed to keep the timer from expiring while the
+   * work is cancelled.  The queues of pending work are protected by their
+   * spinlocks because new work is typically added to them from interrupt
+   * handlers.
    */
 
   flags = enter_critical_section();
-  if (work->worker != NULL)
+  if (WDOG_ISACTIVE(&work->u.timer))
     {
-      /* Remove the entry from the work queue and make sure that it is
-       * marked as available (i.e., the worker field is nullified).
+      /* Cancel the timer and make sure that the work is marked as
+       * available (i.e., the worker field is nullified).
        */
 
-      if (WDOG_ISACTIVE(&work->u.timer))
-        {
-          wd_cancel(&work->u.timer);
-        }
-      else
-        {
-          sq_rem((FAR sq_entry_t *)work, &wqueue->q);
-        }
-
+      wd_cancel(&work->u.timer);
       work->worker = NULL;
       ret = OK;
     }
+  else
+    {
+      /* The work may be in the queue of any CPU */
+
+      for (i = 0; i < WQUEUE_NQUEUES && ret < 0; i++)
+        {
+          queue  = &wqueue->queue[i];
+          lflags = spin_lock_irqsave(&queue->lock);
+
+          /* The worker thread may have taken the work in the meantime */
+
+          if (work->worker == NULL)
+            {
+              spin_unlock_irqrestore(&queue->lock, lflags);
+              break;
+            }
+
+          /* If the work is in none of the queues, its timer has just
+           * expired and it is about to be queued.  Clearing the worker
+           * makes the worker thread skip it.
+           */
+
+          if (work_qremove(queue, work) || i == WQUEUE_NQUEUES - 1)
+            {
+              work->worker = NULL;
+              ret = OK;
+            }
+
+          spin_unlock_irqrestore(&queue->lock, lflags);
+        }
+    }
 
   leave_critical_section(flags);
   return ret;
@@ -102,6 +179,37 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_cancel_wq
+ *
+ * Description:
+ *   Cancel work previously queued with work_queue_wq().  After work has
+ *   been cancelled, it may be requeued by calling work_queue_wq() again.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue
+ *   work   - The previously queued work structure to cancel
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno on failure.  This error may be
+ *   reported:
+ *
+ *   -ENOENT - There is no such work queued.
+ *   -EINVAL - An invalid work queue was specified
+ *
+ ****************************************************************************/
+
+int work_cancel_wq(FAR struct kwork_wqueue_s *wqueue,
+                   FAR struct work_s *work)
+{
+  if (wqueue == NULL)
+    {
+      return -EINVAL;
+    }
+
+  return work_qcancel(wqueue, work);
+}
+
 /****************************************************************************
  * Name: work_cancel
  *
@@ -125,27 +233,7 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
 
 int work_cancel(int qid, FAR struct work_s *work)
 {
-#ifdef CONFIG_SCHED_HPWORK
-  if (qid == HPWORK)
-    {
-      /* Cancel high priority work */
-
-      return work_qcancel((FAR struct kwork_wqueue_s *)&g_hpwork, work);
-    }
-  else
-#endif
-#ifdef CONFIG_SCHED_LPWORK
-  if (qid == LPWORK)
-    {
-      /* Cancel low priority work */
-
-      return work_qcancel((FAR struct kwork_wqueue_s *)&g_lpwork, work);
-    }
-  else
-#endif
-    {
-      return -EINVAL;
-    }
+  return work_cancel_wq(work_qid2wq(qid), work);
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
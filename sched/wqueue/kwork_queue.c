@@ -32,6 +32,8 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/wqueue.h>
 
 #include "wqueue/wqueue.h"
@@ -43,37 +45,184 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: hp_work_timer_expiry
+ * Name: work_qselect
+ *
+ * Description:
+ *   Select the queue of pending work for new work.  With per-CPU queues,
+ *   this is the queue of the CPU that queues the work (typically the CPU
+ *   that took the interrupt) unless all of the worker threads of that CPU
+ *   are busy and another CPU has an idle worker thread.
+ *
  ****************************************************************************/
 
-#ifdef CONFIG_SCHED_HPWORK
-static void hp_work_timer_expiry(wdparm_t arg)
+static FAR struct kwork_queue_s *
+work_qselect(FAR struct kwork_wqueue_s *wqueue)
 {
-  irqstate_t flags = enter_critical_section();
-  sq_addlast((FAR sq_entry_t *)arg, &g_hpwork.q);
-  nxsem_post(&g_hpwork.sem);
-  leave_critical_section(flags);
-}
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  FAR struct kwork_queue_s *queue = &wqueue->queue[up_cpu_index()];
+  int semcount;
+  int cpu;
+
+  /* A negative count means that worker threads are waiting for work */
+
+  nxsem_get_value(&queue->sem, &semcount);
+  if (semcount >= 0)
+    {
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          nxsem_get_value(&wqueue->queue[cpu].sem, &semcount);
+          if (semcount < 0)
+            {
+              return &wqueue->queue[cpu];
+            }
+        }
+    }
+
+  return queue;
+#else
+  return &wqueue->queue[0];
 #endif
+}
 
 /****************************************************************************
- * Name: lp_work_timer_expiry
+ * Name: work_qqueue
+ *
+ * Description:
+ *   Add work at the end of a queue of pending work and wake up a worker
+ *   thread.  Only the queue's own spinlock is held while the queue is
+ *   modified.
+ *
  ****************************************************************************/
 
-#ifdef CONFIG_SCHED_LPWORK
-static void lp_work_timer_expiry(wdparm_t arg)
+static void work_qqueue(FAR struct kwork_queue_s *queue,
+                        FAR struct work_s *work)
 {
-  irqstate_t flags = enter_critical_section();
-  sq_addlast((FAR sq_entry_t *)arg, &g_lpwork.q);
-  nxsem_post(&g_lpwork.sem);
-  leave_critical_section(flags);
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&queue->lock);
+  sq_addlast((FAR sq_entry_t *)work, &queue->q);
+  spin_unlock_irqrestore(&queue->lock, flags);
+
+  nxsem_post(&queue->sem);
+}
+
+/****************************************************************************
+ * Name: work_timer_expiry
+ ****************************************************************************/
+
+static void work_timer_expiry(wdparm_t arg)
+{
+  FAR struct work_s *work = (FAR struct work_s *)arg;
+
+  work_qqueue(work_qselect(work->wq), work);
 }
-#endif
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_qid2wq
+ *
+ * Description:
+ *   Return the kernel-mode work queue that matches a work queue ID.
+ *
+ * Input Parameters:
+ *   qid - The work queue ID (HPWORK or LPWORK)
+ *
+ * Returned Value:
+ *   The work queue or NULL if the ID is not valid.
+ *
+ ****************************************************************************/
+
+FAR struct kwork_wqueue_s *work_qid2wq(int qid)
+{
+#ifdef CONFIG_SCHED_HPWORK
+  if (qid == HPWORK)
+    {
+      return (FAR struct kwork_wqueue_s *)&g_hpwork;
+    }
+  else
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+  if (qid == LPWORK)
+    {
+      return (FAR struct kwork_wqueue_s *)&g_lpwork;
+    }
+  else
+#endif
+    {
+      return NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: work_queue_wq
+ *
+ * Description:
+ *   Queue kernel-mode work to be performed at a later time on the worker
+ *   threads of a work queue.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.  The callback will be
+ *            invoked on the worker thread of execution.
+ *   arg    - The argument that will be passed to the worker callback when
+ *            int is invoked.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_queue_wq(FAR struct kwork_wqueue_s *wqueue,
+                  FAR struct work_s *work, worker_t worker,
+                  FAR void *arg, clock_t delay)
+{
+  irqstate_t flags;
+
+  if (wqueue == NULL || work == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* The work may be queued again from an interrupt handler or another CPU
+   * at any time, so it must be cancelled, set up and queued in one step.
+   * Otherwise, two callers could both find the work in no queue and add
+   * it twice.  The critical section also keeps its timer from expiring in
+   * the meantime.
+   */
+
+  flags = enter_critical_section();
+
+  /* Remove the entry from the timer and work queue. */
+
+  work_cancel_wq(wqueue, work);
+
+  /* Initialize the work structure */
+
+  work->worker = worker;           /* Work callback. non-NULL means queued */
+  work->arg = arg;                 /* Callback argument */
+  work->wq = wqueue;               /* Work queue */
+
+  /* Queue the new work */
+
+  if (!delay)
+    {
+      work_qqueue(work_qselect(wqueue), work);
+    }
+  else
+    {
+      wd_start(&work->u.timer, delay, work_timer_expiry, (wdparm_t)work);
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
 /****************************************************************************
  * Name: work_queue
  *
@@ -107,69 +256,59 @@ static void lp_work_timer_expiry(wdparm_t arg)
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, clock_t delay)
 {
-  irqstate_t flags;
-  int ret = OK;
+  return work_queue_wq(work_qid2wq(qid), work, worker, arg, delay);
+}
 
-  /* Remove the entry from the timer and work queue. */
+/****************************************************************************
+ * Name: work_queue_cpu
+ *
+ * Description:
+ *   Queue kernel-mode work to be performed immediately by the worker
+ *   threads of one CPU.  With CONFIG_SCHED_WORKQUEUE_PERCPU, the work is
+ *   always added to the queue of that CPU, even if its worker threads are
+ *   busy.  This keeps work that uses per-CPU resources on its CPU.
+ *   Otherwise, this is the same as work_queue() with no delay.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID (index)
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.  The callback will be
+ *            invoked on the worker thread of execution.
+ *   arg    - The argument that will be passed to the worker callback when
+ *            int is invoked.
+ *   cpu    - The CPU whose worker threads perform the work
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_queue_cpu(int qid, FAR struct work_s *work, worker_t worker,
+                   FAR void *arg, int cpu)
+{
+  FAR struct kwork_wqueue_s *wqueue = work_qid2wq(qid);
+  irqstate_t flags;
 
-  work_cancel(qid, work);
+  if (wqueue == NULL || work == NULL || cpu < 0)
+    {
+      return -EINVAL;
+    }
 
-  /* Interrupts are disabled so that this logic can be called from with
-   * task logic or from interrupt handling logic.
+  /* Cancel, set up and queue the work in one step, as work_queue_wq()
+   * does.
    */
 
   flags = enter_critical_section();
 
-  /* Initialize the work structure. */
-
-  work->worker = worker;           /* Work callback. non-NULL means queued */
-  work->arg = arg;                 /* Callback argument */
+  work_cancel_wq(wqueue, work);
 
-  /* Queue the new work */
-
-#ifdef CONFIG_SCHED_HPWORK
-  if (qid == HPWORK)
-    {
-      /* Queue high priority work */
-
-      if (!delay)
-        {
-          sq_addlast((FAR sq_entry_t *)work, &g_hpwork.q);
-          nxsem_post(&g_hpwork.sem);
-        }
-      else
-        {
-          wd_start(&work->u.timer, delay, hp_work_timer_expiry,
-                   (wdparm_t)work);
-        }
-    }
-  else
-#endif
-#ifdef CONFIG_SCHED_LPWORK
-  if (qid == LPWORK)
-    {
-      /* Queue low priority work */
-
-      if (!delay)
-        {
-          sq_addlast((FAR sq_entry_t *)work, &g_lpwork.q);
-          nxsem_post(&g_lpwork.sem);
-        }
-      else
-        {
-          wd_start(&work->u.timer, delay, lp_work_timer_expiry,
-                   (wdparm_t)work);
-        }
-    }
-  else
-#endif
-    {
-      ret = -EINVAL;
-    }
+  work->worker = worker;
+  work->arg = arg;
+  work->wq = wqueue;
 
+  work_qqueue(&wqueue->queue[cpu % WQUEUE_NQUEUES], work);
   leave_critical_section(flags);
-
-  return ret;
+  return OK;
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
@@ -34,8 +34,10 @@
 #include <queue.h>
 #include <debug.h>
 
+#include <nuttx/sched.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/kthread.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
 
 #include "wqueue/wqueue.h"
@@ -75,8 +77,12 @@
 
 struct hp_wqueue_s g_hpwork =
 {
-  {},
-  NXSEM_INITIALIZER(0, SEM_PRIO_NONE),
+  {
+    {
+      {},
+      NXSEM_INITIALIZER(0, SEM_PRIO_NONE),
+    },
+  },
 };
 
 #endif /* CONFIG_SCHED_HPWORK */
@@ -86,8 +92,12 @@ struct hp_wqueue_s g_hpwork =
 
 struct lp_wqueue_s g_lpwork =
 {
-  {},
-  NXSEM_INITIALIZER(0, SEM_PRIO_NONE),
+  {
+    {
+      {},
+      NXSEM_INITIALIZER(0, SEM_PRIO_NONE),
+    },
+  },
 };
 
 #endif /* CONFIG_SCHED_LPWORK */
@@ -111,16 +121,18 @@ struct lp_wqueue_s g_lpwork =
  *   not be accessed by application logic.
  *
  * Input Parameters:
- *   argc, argv
+ *   argc, argv - argv[1] is the work queue and argv[2] is the index of the
+ *     queue of pending work that the thread serves.
  *
  * Returned Value:
- *   Does not return
+ *   Does not return unless the work queue is freed
  *
  ****************************************************************************/
 
 static int work_thread(int argc, FAR char *argv[])
 {
   FAR struct kwork_wqueue_s *wqueue;
+  FAR struct kwork_queue_s *queue;
   FAR struct work_s *work;
   worker_t  worker;
   irqstate_t flags;
@@ -128,10 +140,9 @@ static int work_thread(int argc, FAR char *argv[])
 
   wqueue = (FAR struct kwork_wqueue_s *)
            ((uintptr_t)strtoul(argv[1], NULL, 0));
+  queue  = &wqueue->queue[atoi(argv[2])];
 
-  flags = enter_critical_section();
-
-  /* Loop forever */
+  /* Loop until the work queue is freed */
 
   for (; ; )
     {
@@ -140,16 +151,22 @@ static int work_thread(int argc, FAR char *argv[])
        * posted.
        */
 
-      nxsem_wait_uninterruptible(&wqueue->sem);
+      nxsem_wait_uninterruptible(&queue->sem);
+      if (wqueue->exit)
+        {
+          break;
+        }
 
-      /* And check each entry in the work queue.  Since we have disabled
-       * interrupts we know:  (1) we will not be suspended unless we do
-       * so ourselves, and (2) there will be no changes to the work queue
+      /* Remove the ready-to-execute work from the list.  Only the spinlock
+       * of the work queue is held, so neither the other CPUs nor the
+       * interrupt handlers that queue work need to wait for the global
+       * critical section.
        */
 
-      /* Remove the ready-to-execute work from the list */
+      flags = spin_lock_irqsave(&queue->lock);
 
-      work = (FAR struct work_s *)sq_remfirst(&wqueue->q);
+      worker = NULL;
+      work = (FAR struct work_s *)sq_remfirst(&queue->q);
       if (work && work->worker)
         {
           /* Extract the work description from the entry (in case the work
@@ -158,42 +175,48 @@ static int work_thread(int argc, FAR char *argv[])
 
           worker = work->worker;
 
-          /* Extract the work argument (before re-enabling interrupts) */
+          /* Extract the work argument (before releasing the lock) */
 
           arg = work->arg;
 
           /* Mark the work as no longer being queued */
 
           work->worker = NULL;
+        }
 
-          /* Do the work.  Re-enable interrupts while the work is being
-           * performed... we don't have any idea how long this will take!
-           */
+      spin_unlock_irqrestore(&queue->lock, flags);
+
+      /* Do the work.  We don't have any idea how long this will take! */
 
-          leave_critical_section(flags);
+      if (worker != NULL)
+        {
           CALL_WORKER(worker, arg);
-          flags = enter_critical_section();
         }
     }
 
-  leave_critical_section(flags);
+  /* Let work_queue_free() know that this thread no longer uses the work
+   * queue.
+   */
 
-  return OK; /* To keep some compilers happy */
+  nxsem_post(&wqueue->exsem);
+  return OK;
 }
 
 /****************************************************************************
  * Name: work_thread_create
  *
  * Description:
- *   This function creates and activates a work thread task with kernel-
- *   mode privileges.
+ *   This function creates and activates the work threads of a work queue
+ *   with kernel-mode privileges.  With per-CPU queues of pending work, the
+ *   threads are distributed over the CPUs and bound to them.
  *
  * Input Parameters:
  *   name       - Name of the new task
  *   priority   - Priority of the new task
  *   stack_size - size (in bytes) of the stack needed
- *   nthread    - Number of work thread should be created
- *   wqueue     - Work queue instance
+ *   wqueue     - Work queue instance.  wqueue->nthreads is the number of
+ *                work threads that should be created.  It is reduced to
+ *                the number of threads actually created on failure.
  *
  * Returned Value:
  *   A negated errno value is returned on failure.
@@ -201,26 +224,46 @@ static int work_thread(int argc, FAR char *argv[])
  ****************************************************************************/
 
 static int work_thread_create(FAR const char *name, int priority,
-                              int stack_size, int nthread,
+                              int stack_size,
                               FAR struct kwork_wqueue_s *wqueue)
 {
-  FAR char *argv[2];
-  char args[32];
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  cpu_set_t cpuset;
+#endif
+  FAR char *argv[3];
+  char arg0[32];
+  char arg1[8];
   int wndx;
   int pid;
 
-  snprintf(args, sizeof(args), "0x%" PRIxPTR, (uintptr_t)wqueue);
-  argv[0] = args;
-  argv[1] = NULL;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  /* The semaphores are only used for signaling.  This covers the work
+   * queues created by work_queue_create() as well as HPWORK and LPWORK.
+   */
+
+  for (wndx = 0; wndx < WQUEUE_NQUEUES; wndx++)
+    {
+      nxsem_set_protocol(&wqueue->queue[wndx].sem, SEM_PRIO_NONE);
+    }
+
+  nxsem_set_protocol(&wqueue->exsem, SEM_PRIO_NONE);
+#endif
+
+  snprintf(arg0, sizeof(arg0), "0x%" PRIxPTR, (uintptr_t)wqueue);
+  argv[0] = arg0;
+  argv[1] = arg1;
+  argv[2] = NULL;
 
   /* Don't permit any of the threads to run until we have fully initialized
-   * g_hpwork and g_lpwork.
+   * the work queue.
    */
 
   sched_lock();
 
-  for (wndx = 0; wndx < nthread; wndx++)
+  for (wndx = 0; wndx < wqueue->nthreads; wndx++)
     {
+      snprintf(arg1, sizeof(arg1), "%d", wndx % WQUEUE_NQUEUES);
+
       pid = kthread_create(name, priority, stack_size,
                            (main_t)work_thread, argv);
 
@@ -228,10 +271,19 @@ static int work_thread_create(FAR const char *name, int priority,
       if (pid < 0)
         {
           serr("ERROR: work_thread_create %d failed: %d\n", wndx, pid);
+          wqueue->nthreads = wndx;
           sched_unlock();
           return pid;
         }
 
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+      /* The thread only serves the queue of one CPU, so keep it there */
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(wndx % WQUEUE_NQUEUES, &cpuset);
+      nxsched_set_affinity(pid, sizeof(cpu_set_t), &cpuset);
+#endif
+
 #ifdef CONFIG_PRIORITY_INHERITANCE
       wqueue->worker[wndx].pid  = pid;
 #endif
@@ -266,9 +318,9 @@ int work_start_highpri(void)
 
   sinfo("Starting high-priority kernel worker thread(s)\n");
 
+  g_hpwork.nthreads = CONFIG_SCHED_HPNTHREADS * WQUEUE_NQUEUES;
   return work_thread_create(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
                             CONFIG_SCHED_HPWORKSTACKSIZE,
-                            CONFIG_SCHED_HPNTHREADS,
                             (FAR struct kwork_wqueue_s *)&g_hpwork);
 }
 #endif /* CONFIG_SCHED_HPWORK */
@@ -294,11 +346,120 @@ int work_start_lowpri(void)
 
   sinfo("Starting low-priority kernel worker thread(s)\n");
 
+  g_lpwork.nthreads = CONFIG_SCHED_LPNTHREADS * WQUEUE_NQUEUES;
   return work_thread_create(LPWORKNAME, CONFIG_SCHED_LPWORKPRIORITY,
                             CONFIG_SCHED_LPWORKSTACKSIZE,
-                            CONFIG_SCHED_LPNTHREADS,
                             (FAR struct kwork_wqueue_s *)&g_lpwork);
 }
 #endif /* CONFIG_SCHED_LPWORK */
 
+/****************************************************************************
+ * Name: work_queue_create
+ *
+ * Description:
+ *   Create a new kernel-mode work queue with its own pool of worker
+ *   threads.
+ *
+ * Input Parameters:
+ *   name       - Name of the worker threads
+ *   priority   - Priority of the worker threads
+ *   stack_size - Stack size of each worker thread
+ *   nthreads   - Number of worker threads (per CPU if
+ *                CONFIG_SCHED_WORKQUEUE_PERCPU is selected)
+ *
+ * Returned Value:
+ *   The new work queue on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR struct kwork_wqueue_s *work_queue_create(FAR const char *name,
+                                             int priority, int stack_size,
+                                             int nthreads)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  int ret;
+  int i;
+
+  if (nthreads < 1 || nthreads * WQUEUE_NQUEUES > UINT8_MAX)
+    {
+      return NULL;
+    }
+
+  nthreads *= WQUEUE_NQUEUES;
+
+  /* The work queue ends with one kworker_s for each thread */
+
+  wqueue = kmm_zalloc(sizeof(struct kwork_wqueue_s) +
+                      (nthreads - 1) * sizeof(struct kworker_s));
+  if (wqueue == NULL)
+    {
+      return NULL;
+    }
+
+  for (i = 0; i < WQUEUE_NQUEUES; i++)
+    {
+      nxsem_init(&wqueue->queue[i].sem, 0, 0);
+    }
+
+  nxsem_init(&wqueue->exsem, 0, 0);
+  wqueue->nthreads = nthreads;
+
+  ret = work_thread_create(name, priority, stack_size, wqueue);
+  if (ret < 0)
+    {
+      work_queue_free(wqueue);
+      return NULL;
+    }
+
+  return wqueue;
+}
+
+/****************************************************************************
+ * Name: work_queue_free
+ *
+ * Description:
+ *   Stop the worker threads of a work queue created by work_queue_create()
+ *   and free the work queue.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue to free
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_queue_free(FAR struct kwork_wqueue_s *wqueue)
+{
+  int wndx;
+
+  if (wqueue == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* Wake up each thread and wait until all of them have exited */
+
+  wqueue->exit = true;
+
+  for (wndx = 0; wndx < wqueue->nthreads; wndx++)
+    {
+      nxsem_post(&wqueue->queue[wndx % WQUEUE_NQUEUES].sem);
+    }
+
+  for (wndx = 0; wndx < wqueue->nthreads; wndx++)
+    {
+      nxsem_wait_uninterruptible(&wqueue->exsem);
+    }
+
+  for (wndx = 0; wndx < WQUEUE_NQUEUES; wndx++)
+    {
+      nxsem_destroy(&wqueue->queue[wndx].sem);
+    }
+
+  nxsem_destroy(&wqueue->exsem);
+  kmm_free(wqueue);
+  return OK;
+}
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
@@ -31,6 +31,7 @@
 #include <queue.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
@@ -43,6 +44,14 @@
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
 
+/* Number of queues of pending work in each work queue */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+#  define WQUEUE_NQUEUES CONFIG_SMP_NCPUS
+#else
+#  define WQUEUE_NQUEUES 1
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -56,12 +65,27 @@ struct kworker_s
 #endif
 };
 
+/* This is one queue of pending work together with the semaphore that its
+ * worker threads wait on.  With CONFIG_SCHED_WORKQUEUE_PERCPU, there is
+ * one of these for each CPU and the worker threads that serve it only run
+ * on that CPU.
+ */
+
+struct kwork_queue_s
+{
+  struct sq_queue_s q;         /* The queue of pending work */
+  sem_t             sem;       /* The counting semaphore of the queue */
+  spinlock_t        lock;      /* Protects the queue of pending work */
+};
+
 /* This structure defines the state of one kernel-mode work queue */
 
 struct kwork_wqueue_s
 {
-  struct sq_queue_s q;         /* The queue of pending work */
-  sem_t             sem;       /* The counting semaphore of the wqueue */
+  struct kwork_queue_s queue[WQUEUE_NQUEUES]; /* Queues of pending work */
+  sem_t             exsem;     /* Posted by each exiting worker thread */
+  uint8_t           nthreads;  /* Number of worker threads */
+  bool              exit;      /* True: The worker threads must exit */
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -72,12 +96,14 @@ struct kwork_wqueue_s
 #ifdef CONFIG_SCHED_HPWORK
 struct hp_wqueue_s
 {
-  struct sq_queue_s q;         /* The queue of pending work */
-  sem_t             sem;       /* The counting semaphore of the wqueue */
+  struct kwork_queue_s queue[WQUEUE_NQUEUES]; /* Queues of pending work */
+  sem_t             exsem;     /* Posted by each exiting worker thread */
+  uint8_t           nthreads;  /* Number of worker threads */
+  bool              exit;      /* True: The worker threads must exit */
 
   /* Describes each thread in the high priority queue's thread pool */
 
-  struct kworker_s  worker[CONFIG_SCHED_HPNTHREADS];
+  struct kworker_s  worker[CONFIG_SCHED_HPNTHREADS * WQUEUE_NQUEUES];
 };
 #endif
 
@@ -88,12 +114,14 @@ struct hp_wqueue_s
 #ifdef CONFIG_SCHED_LPWORK
 struct lp_wqueue_s
 {
-  struct sq_queue_s q;         /* The queue of pending work */
-  sem_t             sem;       /* The counting semaphore of the wqueue */
+  struct kwork_queue_s queue[WQUEUE_NQUEUES]; /* Queues of pending work */
+  sem_t             exsem;     /* Posted by each exiting worker thread */
+  uint8_t           nthreads;  /* Number of worker threads */
+  bool              exit;      /* True: The worker threads must exit */
 
   /* Describes each thread in the low priority queue's thread pool */
 
-  struct kworker_s  worker[CONFIG_SCHED_LPNTHREADS];
+  struct kworker_s  worker[CONFIG_SCHED_LPNTHREADS * WQUEUE_NQUEUES];
 };
 #endif
 
@@ -117,6 +145,22 @@ extern struct lp_wqueue_s g_lpwork;
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_qid2wq
+ *
+ * Description:
+ *   Return the kernel-mode work queue that matches a work queue ID.
+ *
+ * Input Parameters:
+ *   qid - The work queue ID (HPWORK or LPWORK)
+ *
+ * Returned Value:
+ *   The work queue or NULL if the ID is not valid.
+ *
+ ****************************************************************************/
+
+FAR struct kwork_wqueue_s *work_qid2wq(int qid);
+
 /****************************************************************************
  * Name: work_start_highpri
  *